@@ -5,13 +5,14 @@
 // Receives color, normal, AO factor and world position from vertex shader.
 // Applies simple directional lighting + AO darkening.
 // No texture sampling — color comes from the palette (resolved in vertex shader).
+// The palette alpha is passed through: opaque pipelines ignore it, the liquid pass blends with it.
 //
 // NOTE: fragNormal and fragAO are 'flat' — they must match the vertex shader
 //   declaration exactly. 'flat' means the provoking vertex value is used for
 //   the entire triangle, eliminating gradient artifacts on large greedy quads.
 // ---------------------------------------------------------------------------
 
-layout(location = 0) in vec3  fragColor;
+layout(location = 0) in vec4  fragColor;
 layout(location = 1) flat in vec3  fragNormal;   // flat: no interpolation
 layout(location = 2) flat in float fragAO;        // flat: no interpolation
 layout(location = 3) in vec3  fragWorldPos;
@@ -19,12 +20,11 @@ layout(location = 4) in float fragFade;
 
 layout(location = 0) out vec4 outColor;
 
-// Push constants (must match voxel.vert layout exactly)
+// Push constants (must match voxel.vert layout exactly — VoxelGlobalPush, 128 bytes;
+// the pipeline range is 128, a larger block here fails validation)
 layout(push_constant) uniform PushConstants {
     mat4  viewProj;
     mat4  lightSpaceMatrix;
-    vec3  chunkOffset;
-    float fadeProgress;
 } pc;
 
 const float bayer4[16] = float[](
@@ -66,10 +66,10 @@ void main() {
     else if (abs(norm.x) > 0.5)         faceShade = 0.80; // X sides
     else                                 faceShade = 0.70; // Z sides
 
-    vec3 finalColor = fragColor * lighting * faceShade;
+    vec3 finalColor = fragColor.rgb * lighting * faceShade;
 
     // Gamma correction (approximate sRGB)
     finalColor = pow(clamp(finalColor, 0.0, 1.0), vec3(1.0 / 2.2));
 
-    outColor = vec4(finalColor, 1.0);
+    outColor = vec4(finalColor, fragColor.a);
 }
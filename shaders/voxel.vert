@@ -1,13 +1,18 @@
-#version 450
+#version 460
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
 
 // ---------------------------------------------------------------------------
-// Voxel Vertex Shader
-// Accepts compressed VoxelVertex (8 bytes per vertex):
-//   location 0: uvec4(x, y, z, faceID)
-//   location 1: uvec4(ao, reserved, paletteIdx_lo, paletteIdx_hi)
+// Voxel Vertex Shader — vertex pulling
+// No vertex input. Each greedy quad is one 8-byte VoxelQuad record (see VoxelData.hpp),
+// read through the chunk's buffer device address (instance SSBO, quadAddress):
+//   quad   = gl_VertexIndex >> 2  (the shared quad index buffer emits q*4 + 0..3)
+//   slot   = gl_VertexIndex & 3   → corner of the quad (face winding + AO flip)
+//   geometry: x[5:0] y[11:6] z[17:12] w-1[22:18] h-1[27:23] faceID[30:28] flip[31]
+//   surface:  paletteIdx[11:0] ao c0..c3 [19:12]
 //
-// Chunk world position is passed via push constants (chunkOffset).
-// Block color is resolved from a hardcoded palette in the shader.
+// Chunk world position comes from the instance SSBO (gl_InstanceIndex).
+// Block color is resolved from the palette UBO.
 // AO is decoded and applied as a soft darkening factor.
 //
 // NOTE: fragNormal and fragAO use 'flat' qualifier — no interpolation.
@@ -16,17 +21,14 @@
 //   Without 'flat', large greedy quads show gradient artifacts (dark stripes).
 // ---------------------------------------------------------------------------
 
-layout(location = 0) in uvec4 inPosAndFace;   // x, y, z, faceID
-layout(location = 1) in uvec4 inAoAndPalette;  // ao, reserved, paletteIdx_lo, paletteIdx_hi
-
-layout(location = 0) out vec3  fragColor;
+layout(location = 0) out vec4  fragColor;   // palette rgba (alpha < 1: liquid)
 layout(location = 1) flat out vec3  fragNormal;
 layout(location = 2) flat out float fragAO;
 layout(location = 3) out vec3  fragWorldPos;
 layout(location = 4) out float fragFade;
 
 // ---------------------------------------------------------------------------
-// Push Constants (matches VoxelPushConstants in main.cpp — 144 bytes)
+// Push Constants (matches VoxelGlobalPush in main.cpp — 128 bytes)
 // ---------------------------------------------------------------------------
 layout(push_constant) uniform PushConstants {
     mat4 viewProj;
@@ -39,6 +41,12 @@ layout(push_constant) uniform PushConstants {
 struct ChunkInstanceData {
     float posX, posY, posZ;
     float fadeProgress;
+    uint64_t quadAddress; // first VoxelQuad of the chunk
+    uint64_t reserved;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 8) readonly buffer QuadBuffer {
+    uvec2 quads[];
 };
 
 layout(std140, set = 2, binding = 0) readonly buffer InstanceBuffer {
@@ -69,43 +77,50 @@ const vec3 k_normals[6] = vec3[6](
 const float k_aoFactors[4] = float[4](0.4, 0.6, 0.8, 1.0);
 
 void main() {
-    // Unpack position with negative wrap-around support for LOD skirts
-    int ix = int(inPosAndFace.x);
-    if (ix > 127) ix -= 256;
-    int iy = int(inPosAndFace.y);
-    if (iy > 127) iy -= 256;
-    int iz = int(inPosAndFace.z);
-    if (iz > 127) iz -= 256;
-
-    float lx     = float(ix);
-    float ly     = float(iy);
-    float lz     = float(iz);
-    uint  faceID = inPosAndFace.w;
-
     // Fetch chunk layout from SSBO via gl_InstanceIndex
     ChunkInstanceData chunkData = instances[gl_InstanceIndex];
     vec3 chunkOffset = vec3(chunkData.posX, chunkData.posY, chunkData.posZ);
 
+    uvec2 quad     = QuadBuffer(chunkData.quadAddress).quads[gl_VertexIndex >> 2];
+    uint  geometry = quad.x;
+    uint  surface  = quad.y;
+
+    uvec3 origin = uvec3(geometry, geometry >> 6, geometry >> 12) & 63u;
+    uint  w      = ((geometry >> 18) & 31u) + 1u;
+    uint  h      = ((geometry >> 23) & 31u) + 1u;
+    uint  faceID = (geometry >> 28) & 7u;
+    uint  flip   = geometry >> 31;
+
+    // Corners c0 = min, c1 = +w·u, c2 = +w·u +h·v, c3 = +h·v. +faces wind c0..c3, -faces
+    // c3..c0 (CCW front); a flipped quad starts one corner later (split along 1-3).
+    uint k = (uint(gl_VertexIndex) + flip) & 3u;
+    uint c = ((faceID & 1u) == 0u) ? k : 3u - k;
+
+    uint  d   = faceID >> 1;
+    uint  u   = (d + 1u) % 3u;
+    uint  v   = (d + 2u) % 3u;
+    uvec3 pos = origin;
+    if (c == 1u || c == 2u) pos[u] += w;
+    if (c >= 2u)            pos[v] += h;
+
     // World position = chunk offset + local position
-    vec3 worldPos = chunkOffset + vec3(lx, ly, lz);
+    vec3 worldPos = chunkOffset + vec3(pos);
 
     // Unpack AO and palette index
-    uint ao         = inAoAndPalette.x;
-    uint palLo      = inAoAndPalette.z;
-    uint palHi      = inAoAndPalette.w;
-    uint paletteIdx = (palLo | (palHi << 8u)) & 0xFu; // clamp to 0-15
+    uint ao         = (surface >> (12u + 2u * c)) & 3u;
+    uint paletteIdx = surface & 0xFu; // clamp to 0-15
 
     // Fetch block color from UBO palette
-    vec3 blockColor = palette.colors[paletteIdx].rgb;
+    vec4 blockColor = palette.colors[paletteIdx];
 
     // Apply AO darkening
-    float aoFactor = k_aoFactors[clamp(ao, 0u, 3u)];
+    float aoFactor = k_aoFactors[ao];
 
     // Outputs
     gl_Position  = pc.viewProj * vec4(worldPos, 1.0);
     fragColor    = blockColor;
-    fragNormal   = k_normals[clamp(faceID, 0u, 5u)];  // flat — provoking vertex value
-    fragAO       = aoFactor;                            // flat — no gradient across quad
+    fragNormal   = k_normals[min(faceID, 5u)];  // flat — provoking vertex value
+    fragAO       = aoFactor;                     // flat — no gradient across quad
     fragWorldPos = worldPos;
     fragFade     = chunkData.fadeProgress;
 }
@@ -2,6 +2,7 @@
 #define VMA_VULKAN_VERSION 1003000
 
 #include "VulkanContext.hpp"
+#include <atomic>
 #include <iostream>
 #include <vector>
 #include <set>
@@ -9,8 +10,29 @@
 
 namespace gfx {
 
-VulkanContext::VulkanContext(core::Window& window) : m_instance(VK_NULL_HANDLE), m_device(VK_NULL_HANDLE) {
+namespace {
+
+std::atomic<uint32_t> s_validationMessages{0};
+
+VKAPI_ATTR VkBool32 VKAPI_CALL validationCallback(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+                                                  VkDebugUtilsMessageTypeFlagsEXT,
+                                                  const VkDebugUtilsMessengerCallbackDataEXT* data, void*) {
+    s_validationMessages.fetch_add(1, std::memory_order_relaxed);
+    const bool error = severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    std::cerr << (error ? "[Validation] ERROR: " : "[Validation] WARNING: ") << data->pMessage << "\n";
+    return VK_FALSE;
+}
+
+} // namespace
+
+uint32_t VulkanContext::getValidationMessageCount() {
+    return s_validationMessages.load(std::memory_order_relaxed);
+}
+
+VulkanContext::VulkanContext(core::Window& window, bool validation) : m_instance(VK_NULL_HANDLE), m_device(VK_NULL_HANDLE) {
+    enableValidationLayers = enableValidationLayers || validation;
     createInstance();
+    createDebugMessenger();
     createSurface(window);
     pickPhysicalDevice();
     createLogicalDevice();
@@ -27,6 +49,11 @@ VulkanContext::~VulkanContext() {
         vkDestroyDevice(m_device, nullptr);
     }
     if (m_instance != VK_NULL_HANDLE) {
+        if (m_debugMessenger != VK_NULL_HANDLE) {
+            auto destroy = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+                vkGetInstanceProcAddr(m_instance, "vkDestroyDebugUtilsMessengerEXT"));
+            if (destroy) destroy(m_instance, m_debugMessenger, nullptr);
+        }
         vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
         vkDestroyInstance(m_instance, nullptr);
     }
@@ -42,26 +69,43 @@ void VulkanContext::createInstance() {
     appInfo.apiVersion = VK_API_VERSION_1_3;
 
     std::vector<const char*> extensions = { "VK_KHR_surface", "VK_KHR_win32_surface" };
-#ifndef NDEBUG
-    extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
-#endif
+    if (enableValidationLayers)
+        extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 
     VkInstanceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
     createInfo.pApplicationInfo = &appInfo;
     createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
     createInfo.ppEnabledExtensionNames = extensions.data();
-#ifndef NDEBUG
-    createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
-    createInfo.ppEnabledLayerNames = validationLayers.data();
-#else
-    createInfo.enabledLayerCount = 0;
-#endif
+    if (enableValidationLayers) {
+        createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
+        createInfo.ppEnabledLayerNames = validationLayers.data();
+    } else {
+        createInfo.enabledLayerCount = 0;
+    }
 
     if (vkCreateInstance(&createInfo, nullptr, &m_instance) != VK_SUCCESS)
         throw std::runtime_error("failed to create instance!");
 }
 
+void VulkanContext::createDebugMessenger() {
+    if (!enableValidationLayers) return;
+    // Warnings and errors go to stderr and are counted (getValidationMessageCount()).
+    VkDebugUtilsMessengerCreateInfoEXT createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT |
+                                 VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
+                             VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
+                             VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    createInfo.pfnUserCallback = validationCallback;
+
+    auto create = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+        vkGetInstanceProcAddr(m_instance, "vkCreateDebugUtilsMessengerEXT"));
+    if (!create || create(m_instance, &createInfo, nullptr, &m_debugMessenger) != VK_SUCCESS)
+        throw std::runtime_error("failed to set up the validation messenger!");
+}
+
 void VulkanContext::createSurface(core::Window& window) {
     VkWin32SurfaceCreateInfoKHR createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
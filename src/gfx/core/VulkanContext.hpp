@@ -29,7 +29,8 @@ struct SwapChainSupportDetails {
 
 class VulkanContext {
 public:
-    VulkanContext(core::Window& window);
+    // `validation` turns the Khronos validation layer on in release builds too (--smoke).
+    VulkanContext(core::Window& window, bool validation = false);
     ~VulkanContext();
 
     VkDevice getDevice() const { return m_device; }
@@ -40,6 +41,8 @@ public:
     VkCommandPool getCommandPool() const { return m_commandPool; }
     VkInstance getInstance() const { return m_instance; }
     VmaAllocator getAllocator() const { return m_allocator; }
+    // Validation warnings and errors reported so far (0 while validation is off).
+    static uint32_t getValidationMessageCount();
 
     QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device);
     SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
@@ -56,6 +59,7 @@ public:
 
 private:
     void createInstance();
+    void createDebugMessenger();
     void createSurface(core::Window& window);
     void pickPhysicalDevice();
     void createLogicalDevice();
@@ -63,6 +67,7 @@ private:
     void createCommandPool();
 
     VkInstance m_instance;
+    VkDebugUtilsMessengerEXT m_debugMessenger = VK_NULL_HANDLE;
     VkSurfaceKHR m_surface;
     VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
     VkDevice m_device;
@@ -72,9 +77,9 @@ private:
     VkCommandPool m_commandPool;
 
 #ifdef NDEBUG
-    const bool enableValidationLayers = false;
+    bool enableValidationLayers = false;
 #else
-    const bool enableValidationLayers = true;
+    bool enableValidationLayers = true;
 #endif
 
     const std::vector<const char*> validationLayers = {
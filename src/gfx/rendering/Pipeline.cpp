@@ -26,7 +26,9 @@ Pipeline::Pipeline(VulkanContext& context, const PipelineConfig& config)
     std::vector<VkVertexInputAttributeDescription> defaultAttribs;
     VkPipelineVertexInputStateCreateInfo vertexInput{VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
 
-    if (!config.bindingDescriptions.empty()) {
+    if (config.vertexPulling) {
+        // Empty vertex input: nothing bound, nothing fetched by the input assembler
+    } else if (!config.bindingDescriptions.empty()) {
         vertexInput.vertexBindingDescriptionCount   = static_cast<uint32_t>(config.bindingDescriptions.size());
         vertexInput.pVertexBindingDescriptions      = config.bindingDescriptions.data();
         vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(config.attributeDescriptions.size());
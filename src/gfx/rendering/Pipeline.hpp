@@ -24,6 +24,8 @@ struct PipelineConfig {
     float depthBiasConstant = 0.0f;
     float depthBiasSlope    = 0.0f;
     float depthBiasClamp    = 0.0f;
+    // No vertex input state: the vertex shader pulls its data (gl_VertexIndex + buffer refs)
+    bool  vertexPulling     = false;
 
     std::vector<VkDescriptorSetLayout>          descriptorSetLayouts;
     std::vector<VkPushConstantRange>             pushConstantRanges;
@@ -9,14 +9,17 @@ GeometryManager::~GeometryManager() = default;
 
 GeometryManager::GeometryManager(VulkanContext& context) : m_context(context) {
     allocateNewPool();
+    m_stagingRing = std::make_unique<StagingRing>(context, STAGING_RING_SIZE);
 }
 
 uint32_t GeometryManager::allocateNewPool() {
     auto pool = std::make_unique<BufferPool>();
     
     pool->vertexBuffer = std::make_unique<Buffer>(m_context, m_totalVertexCapacity,
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+        VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
         VMA_MEMORY_USAGE_GPU_ONLY);
+    pool->vertexAddress = pool->vertexBuffer->getDeviceAddress();
     pool->indexBuffer = std::make_unique<Buffer>(m_context, m_totalIndexCapacity,
         VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
         VMA_MEMORY_USAGE_GPU_ONLY);
@@ -34,27 +37,145 @@ uint32_t GeometryManager::allocateNewPool() {
 }
 
 // ---------------------------------------------------------------------------
-// executeBatchUpload — create one big staging buffer and issue 1 barrier for all
+// allocateRanges — best pool with room for both ranges (new pool if none)
+// ---------------------------------------------------------------------------
+Mesh* GeometryManager::allocateRanges(uint32_t vertexCount, uint32_t indexCount, size_t vertexStride, UploadRequest& outRequest,
+                                      bool quads) {
+    if (quads && vertexCount > m_quadIndexCapacity) {
+        throw std::runtime_error("GeometryManager: quad mesh exceeds the shared quad index buffer (reserveQuadIndices).");
+    }
+    VkDeviceSize vertexDataSize = vertexCount * vertexStride;
+    VkDeviceSize indexDataSize  = indexCount  * sizeof(uint32_t);
+    // Quad meshes have no index range; iOff stays 0 and is never freed (indexBytes == 0).
+    auto allocateIndices = [&](BlockAllocator& a) { return indexDataSize > 0 ? a.allocate(indexDataSize) : VkDeviceSize(0); };
+
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+
+    uint32_t targetPoolIndex = static_cast<uint32_t>(-1);
+    VkDeviceSize vOff = static_cast<VkDeviceSize>(-1);
+    VkDeviceSize iOff = static_cast<VkDeviceSize>(-1);
+
+    for (uint32_t i = 0; i < m_pools.size(); ++i) {
+        vOff = m_pools[i]->vertexAllocator.allocate(vertexDataSize);
+        if (vOff != static_cast<VkDeviceSize>(-1)) {
+            iOff = allocateIndices(m_pools[i]->indexAllocator);
+            if (iOff != static_cast<VkDeviceSize>(-1)) {
+                targetPoolIndex = i;
+                break;
+            } else {
+                m_pools[i]->vertexAllocator.free(vOff, vertexDataSize);
+                vOff = static_cast<VkDeviceSize>(-1);
+            }
+        }
+    }
+
+    if (targetPoolIndex == static_cast<uint32_t>(-1)) {
+        targetPoolIndex = allocateNewPool();
+        vOff = m_pools[targetPoolIndex]->vertexAllocator.allocate(vertexDataSize);
+        iOff = allocateIndices(m_pools[targetPoolIndex]->indexAllocator);
+        if (vOff == static_cast<VkDeviceSize>(-1) || iOff == static_cast<VkDeviceSize>(-1)) {
+            throw std::runtime_error("GeometryManager: Failed to allocate memory even in a fresh pool! Mesh is too large.");
+        }
+    }
+
+    outRequest = { targetPoolIndex, vOff, iOff, vertexDataSize, indexDataSize, nullptr, nullptr };
+
+    uint32_t firstIndex   = static_cast<uint32_t>(iOff / sizeof(uint32_t));
+    int32_t  vertexOffset = static_cast<int32_t>(vOff / vertexStride);
+    if (quads) indexCount = vertexCount * 6; // drawn from the shared quad index buffer
+
+    return new Mesh(indexCount, firstIndex, vertexOffset, targetPoolIndex);
+}
+
+Mesh* GeometryManager::allocateQuadMeshStaged(uint32_t quadCount, size_t quadStride,
+                                              uint64_t stagingHandle, UploadRequest& outRequest) {
+    Mesh* mesh = allocateRanges(quadCount, 0, quadStride, outRequest, true);
+    outRequest.staged        = true;
+    outRequest.stagingHandle = stagingHandle;
+    return mesh;
+}
+
+// ---------------------------------------------------------------------------
+// reserveQuadIndices — (re)builds the shared quad index buffer for `quadCount` quads
+// ---------------------------------------------------------------------------
+void GeometryManager::reserveQuadIndices(uint32_t quadCount) {
+    if (quadCount <= m_quadIndexCapacity) return;
+
+    const VkDeviceSize bytes = VkDeviceSize(quadCount) * 6 * sizeof(uint32_t);
+    Buffer staging(m_context, bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+    uint32_t* mapped = nullptr;
+    staging.map((void**)&mapped);
+    constexpr uint32_t pattern[6] = {0, 1, 2, 0, 2, 3};
+    for (uint32_t q = 0; q < quadCount; ++q)
+        for (int i = 0; i < 6; ++i) mapped[q * 6 + i] = q * 4 + pattern[i];
+    staging.unmap();
+
+    auto buffer = std::make_unique<Buffer>(m_context, bytes,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+
+    VkCommandBuffer cmd = m_context.beginSingleTimeCommands();
+    VkBufferCopy copy = {0, 0, bytes};
+    vkCmdCopyBuffer(cmd, staging.getBuffer(), buffer->getBuffer(), 1, &copy);
+
+    VkBufferMemoryBarrier2 ib = {};
+    ib.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    ib.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+    ib.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    ib.dstStageMask  = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+    ib.dstAccessMask = VK_ACCESS_2_INDEX_READ_BIT;
+    ib.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    ib.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    ib.buffer = buffer->getBuffer();
+    ib.offset = 0;
+    ib.size   = VK_WHOLE_SIZE;
+    VkDependencyInfo dep = {};
+    dep.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dep.bufferMemoryBarrierCount = 1;
+    dep.pBufferMemoryBarriers    = &ib;
+    vkCmdPipelineBarrier2(cmd, &dep);
+
+    m_context.endSingleTimeCommands(cmd);
+
+    m_quadIndexBuffer   = std::move(buffer);
+    m_quadIndexCapacity = quadCount;
+    std::cout << "[GeometryManager] Shared quad index buffer: " << quadCount << " quads ("
+              << bytes / 1024 << " KB).\n";
+}
+
+// ---------------------------------------------------------------------------
+// executeBatchUpload — one command buffer and 1 barrier for all requests.
+// Staged requests copy straight from the staging ring; the rest share one temporary
+// staging buffer (created only if there are any).
 // ---------------------------------------------------------------------------
 void GeometryManager::executeBatchUpload(const std::vector<UploadRequest>& requests) {
     if (requests.empty()) return;
 
     VkDeviceSize totalVertexBytes = 0;
     VkDeviceSize totalIndexBytes  = 0;
+    bool anyStaged = false;
     for (const auto& req : requests) {
+        if (req.staged) {
+            anyStaged = true;
+            continue;
+        }
         totalVertexBytes += req.vertexBytes;
         totalIndexBytes  += req.indexBytes;
     }
 
-    if (totalVertexBytes == 0 && totalIndexBytes == 0) return;
-
-    Buffer vertexStaging(m_context, std::max<VkDeviceSize>(1, totalVertexBytes), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-    Buffer indexStaging(m_context, std::max<VkDeviceSize>(1, totalIndexBytes), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+    if (totalVertexBytes == 0 && totalIndexBytes == 0 && !anyStaged) return;
 
+    std::unique_ptr<Buffer> vertexStaging;
+    std::unique_ptr<Buffer> indexStaging;
     uint8_t* vMapped = nullptr;
-    if (totalVertexBytes > 0) vertexStaging.map((void**)&vMapped);
     uint8_t* iMapped = nullptr;
-    if (totalIndexBytes > 0) indexStaging.map((void**)&iMapped);
+    if (totalVertexBytes > 0) {
+        vertexStaging = std::make_unique<Buffer>(m_context, totalVertexBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+        vertexStaging->map((void**)&vMapped);
+    }
+    if (totalIndexBytes > 0) {
+        indexStaging = std::make_unique<Buffer>(m_context, totalIndexBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+        indexStaging->map((void**)&iMapped);
+    }
 
     VkDeviceSize vStagingOffset = 0;
     VkDeviceSize iStagingOffset = 0;
@@ -65,22 +186,31 @@ void GeometryManager::executeBatchUpload(const std::vector<UploadRequest>& reque
 
     for (const auto& req : requests) {
         dirtyPools.insert(req.bufferIndex);
+        if (req.staged) {
+            // Quad records written by a mesh worker into its ring region (no index data).
+            m_stagingRing->flush(req.stagingHandle, req.vertexBytes);
+            if (req.vertexBytes > 0) {
+                VkBufferCopy copy = {m_stagingRing->offsetOf(req.stagingHandle), req.vertexOffset, req.vertexBytes};
+                vkCmdCopyBuffer(cmd, m_stagingRing->getBuffer(), m_pools[req.bufferIndex]->vertexBuffer->getBuffer(), 1, &copy);
+            }
+            continue;
+        }
         if (req.vertexBytes > 0) {
             std::memcpy(vMapped + vStagingOffset, req.vertexData, req.vertexBytes);
             VkBufferCopy copy = {vStagingOffset, req.vertexOffset, req.vertexBytes};
-            vkCmdCopyBuffer(cmd, vertexStaging.getBuffer(), m_pools[req.bufferIndex]->vertexBuffer->getBuffer(), 1, &copy);
+            vkCmdCopyBuffer(cmd, vertexStaging->getBuffer(), m_pools[req.bufferIndex]->vertexBuffer->getBuffer(), 1, &copy);
             vStagingOffset += req.vertexBytes;
         }
         if (req.indexBytes > 0) {
             std::memcpy(iMapped + iStagingOffset, req.indexData, req.indexBytes);
             VkBufferCopy copy = {iStagingOffset, req.indexOffset, req.indexBytes};
-            vkCmdCopyBuffer(cmd, indexStaging.getBuffer(), m_pools[req.bufferIndex]->indexBuffer->getBuffer(), 1, &copy);
+            vkCmdCopyBuffer(cmd, indexStaging->getBuffer(), m_pools[req.bufferIndex]->indexBuffer->getBuffer(), 1, &copy);
             iStagingOffset += req.indexBytes;
         }
     }
 
-    if (totalVertexBytes > 0) vertexStaging.unmap();
-    if (totalIndexBytes > 0) indexStaging.unmap();
+    if (vertexStaging) vertexStaging->unmap();
+    if (indexStaging)  indexStaging->unmap();
 
     std::vector<VkBufferMemoryBarrier2> barriers;
     for (uint32_t poolIdx : dirtyPools) {
@@ -88,8 +218,9 @@ void GeometryManager::executeBatchUpload(const std::vector<UploadRequest>& reque
         vb.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
         vb.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
         vb.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-        vb.dstStageMask  = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
-        vb.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+        // Vertex input (gfx::Vertex) or vertex pulling (quad meshes)
+        vb.dstStageMask  = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+        vb.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
         vb.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         vb.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         vb.buffer = m_pools[poolIdx]->vertexBuffer->getBuffer();
@@ -120,6 +251,12 @@ void GeometryManager::executeBatchUpload(const std::vector<UploadRequest>& reque
     }
 
     m_context.endSingleTimeCommands(cmd);
+
+    // The copies above are done, but ring regions are recycled on the frame schedule like
+    // delayed frees, so this stays correct if uploads stop waiting on their fence.
+    for (const auto& req : requests) {
+        if (req.staged) m_stagingRing->retire(req.stagingHandle, m_currentFrame);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -139,6 +276,8 @@ Mesh* GeometryManager::uploadMesh(const std::vector<Vertex>& vertices,
 // update — process delayed frees
 // ---------------------------------------------------------------------------
 void GeometryManager::update(uint64_t currentFrame) {
+    m_stagingRing->update(currentFrame);
+
     std::lock_guard<std::mutex> lock(m_poolMutex);
     m_currentFrame = currentFrame;
     constexpr uint64_t FRAMES_IN_FLIGHT = 3;
@@ -148,7 +287,9 @@ void GeometryManager::update(uint64_t currentFrame) {
         if (m_currentFrame >= it->frameIndex + FRAMES_IN_FLIGHT) {
             if (it->bufferIndex < m_pools.size()) {
                 m_pools[it->bufferIndex]->vertexAllocator.free(static_cast<VkDeviceSize>(it->vertexOffsetSteps) * it->vertexStride, it->vertexBytes);
-                m_pools[it->bufferIndex]->indexAllocator.free(static_cast<VkDeviceSize>(it->firstIndex) * sizeof(uint32_t), it->indexBytes);
+                if (it->indexBytes > 0) {
+                    m_pools[it->bufferIndex]->indexAllocator.free(static_cast<VkDeviceSize>(it->firstIndex) * sizeof(uint32_t), it->indexBytes);
+                }
             }
             it = m_delayedFrees.erase(it);
         } else {
@@ -180,6 +321,11 @@ void GeometryManager::bindPool(VkCommandBuffer commandBuffer, uint32_t poolIndex
     vkCmdBindIndexBuffer(commandBuffer, m_pools[poolIndex]->indexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
 }
 
+void GeometryManager::bindQuadIndices(VkCommandBuffer commandBuffer) {
+    if (!m_quadIndexBuffer) return;
+    vkCmdBindIndexBuffer(commandBuffer, m_quadIndexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+}
+
 VkDeviceSize GeometryManager::getVertexBytesUsed() const {
     VkDeviceSize total = 0;
     for (const auto& pool : m_pools) total += pool->vertexAllocator.m_allocated_bytes;
@@ -3,6 +3,7 @@
 #include "../core/VulkanContext.hpp"
 #include "Buffer.hpp"
 #include "Mesh.hpp"
+#include "StagingRing.hpp"
 #include <vector>
 #include <memory>
 #include <stdexcept>
@@ -69,9 +70,13 @@ public:
 
 class GeometryManager {
 public:
-    // Buffer sizes — large enough for voxel worlds (64 MB vertex, 32 MB index)
+    // Buffer sizes — 64 MB vertex per pool. Voxel meshes are 8-byte quad records pulled by the
+    // vertex shader (shared quad index buffer), so the per-pool index buffer only serves
+    // indexed gfx::Vertex meshes.
     static constexpr VkDeviceSize VERTEX_BUFFER_SIZE = 64 * 1024 * 1024;
-    static constexpr VkDeviceSize INDEX_BUFFER_SIZE  = 32 * 1024 * 1024;
+    static constexpr VkDeviceSize INDEX_BUFFER_SIZE  = 4 * 1024 * 1024;
+    // Persistent-mapped ring mesh workers write chunk meshes into (see StagingRing)
+    static constexpr VkDeviceSize STAGING_RING_SIZE  = 32 * 1024 * 1024;
 
     GeometryManager(VulkanContext& context);
     ~GeometryManager();
@@ -82,57 +87,48 @@ public:
     // Structure for batched uploads
     struct UploadRequest {
         uint32_t bufferIndex;
-        VkDeviceSize vertexOffset;
-        VkDeviceSize indexOffset;
-        VkDeviceSize vertexBytes;
-        VkDeviceSize indexBytes;
-        const void*  vertexData;
-        const void*  indexData;
+        VkDeviceSize vertexOffset; // pool vertex buffer: gfx::Vertex data or quad records
+        VkDeviceSize indexOffset;  // pool index buffer (indexed gfx::Vertex meshes only)
+        VkDeviceSize vertexBytes;  // bytes at vertexOffset (quad meshes: quadCount * stride)
+        VkDeviceSize indexBytes;   // 0 for quad meshes — they draw the shared quad index buffer
+        const void*  vertexData;   // CPU source of vertexBytes, unless staged
+        const void*  indexData;    // CPU source of indexBytes (uploadMesh() only)
+        // Quad records (vertexBytes) already in the staging ring at `stagingHandle`: the upload
+        // only records the copy. vertexData / indexData unused, indexBytes always 0.
+        bool         staged        = false;
+        uint64_t     stagingHandle = 0;
     };
 
+    // Quad range for a quad mesh whose bytes sit in the staging ring (see allocateQuadMesh)
+    Mesh* allocateQuadMeshStaged(uint32_t quadCount, size_t quadStride,
+                                 uint64_t stagingHandle, UploadRequest& outRequest);
+
+    StagingRing& getStagingRing() { return *m_stagingRing; }
+
     // Sub-allocate for arbitrary vertex type
     template<typename T>
     Mesh* allocateMeshRaw(uint32_t vertexCount, uint32_t indexCount, UploadRequest& outRequest, const std::vector<T>& vertices, const std::vector<uint32_t>& indices) {
-        VkDeviceSize vertexDataSize = vertexCount * sizeof(T);
-        VkDeviceSize indexDataSize  = indexCount  * sizeof(uint32_t);
-
-        std::lock_guard<std::mutex> lock(m_poolMutex);
-        
-        uint32_t targetPoolIndex = static_cast<uint32_t>(-1);
-        VkDeviceSize vOff = static_cast<VkDeviceSize>(-1);
-        VkDeviceSize iOff = static_cast<VkDeviceSize>(-1);
-
-        for (uint32_t i = 0; i < m_pools.size(); ++i) {
-            vOff = m_pools[i]->vertexAllocator.allocate(vertexDataSize);
-            if (vOff != static_cast<VkDeviceSize>(-1)) {
-                iOff = m_pools[i]->indexAllocator.allocate(indexDataSize);
-                if (iOff != static_cast<VkDeviceSize>(-1)) {
-                    targetPoolIndex = i;
-                    break;
-                } else {
-                    m_pools[i]->vertexAllocator.free(vOff, vertexDataSize);
-                    vOff = static_cast<VkDeviceSize>(-1);
-                }
-            }
-        }
-
-        if (targetPoolIndex == static_cast<uint32_t>(-1)) {
-            targetPoolIndex = allocateNewPool();
-            vOff = m_pools[targetPoolIndex]->vertexAllocator.allocate(vertexDataSize);
-            iOff = m_pools[targetPoolIndex]->indexAllocator.allocate(indexDataSize);
-            if (vOff == static_cast<VkDeviceSize>(-1) || iOff == static_cast<VkDeviceSize>(-1)) {
-                throw std::runtime_error("GeometryManager: Failed to allocate memory even in a fresh pool! Mesh is too large.");
-            }
-        }
-
-        outRequest = { targetPoolIndex, vOff, iOff, vertexDataSize, indexDataSize, vertices.data(), indices.data() };
-
-        uint32_t firstIndex   = static_cast<uint32_t>(iOff / sizeof(uint32_t));
-        int32_t  vertexOffset = static_cast<int32_t>(vOff / sizeof(T));
+        Mesh* mesh = allocateRanges(vertexCount, indexCount, sizeof(T), outRequest);
+        outRequest.vertexData = vertices.data();
+        outRequest.indexData  = indices.data();
+        return mesh;
+    }
 
-        return new Mesh(indexCount, firstIndex, vertexOffset, targetPoolIndex);
+    // Quad mesh: one T record per quad in the pool's vertex buffer, no index range. Nothing is
+    // bound as vertex input — the vertex shader pulls quad gl_VertexIndex / 4 from
+    // getPoolAddress() + getVertexOffset() * sizeof(T); the Mesh draws quadCount * 6 indices
+    // of the shared quad index buffer (bindQuadIndices()).
+    template<typename T>
+    Mesh* allocateQuadMesh(uint32_t quadCount, UploadRequest& outRequest, const std::vector<T>& quads) {
+        Mesh* mesh = allocateRanges(quadCount, 0, sizeof(T), outRequest, true);
+        outRequest.vertexData = quads.data();
+        return mesh;
     }
 
+    // Shared quad index buffer: q*4 + (0,1,2)(0,2,3) for `quadCount` quads. Grows only;
+    // GPU must be idle (init / world reset).
+    void reserveQuadIndices(uint32_t quadCount);
+
     void freeMesh(Mesh* mesh, VkDeviceSize vertexBytes, [[maybe_unused]] VkDeviceSize indexBytes) {
         if (!mesh) return;
         // In ChunkRenderer, we rely on freeMesh(int32_t, uint32_t, ...)
@@ -149,6 +145,14 @@ public:
 
     // Bind a specific buffer pool
     void bindPool(VkCommandBuffer commandBuffer, uint32_t poolIndex);
+    // Shared quad index buffer only: quad meshes of every pool draw with it bound
+    void bindQuadIndices(VkCommandBuffer commandBuffer);
+    // Buffer device address of a pool's vertex buffer (vertex pulling)
+    VkDeviceAddress getPoolAddress(uint32_t poolIndex) const { return m_pools[poolIndex]->vertexAddress; }
+    // Address of a quad mesh's first record — what the vertex shader pulls quads from
+    VkDeviceAddress getQuadAddress(const Mesh& mesh, size_t quadStride) const {
+        return getPoolAddress(mesh.getBufferIndex()) + VkDeviceAddress(mesh.getVertexOffset()) * quadStride;
+    }
 
     // Reset all sub-allocations and pools
     void reset();
@@ -159,11 +163,13 @@ public:
     // Query current usage
     VkDeviceSize getVertexBytesUsed() const;
     VkDeviceSize getIndexBytesUsed()  const;
+    VkDeviceSize getQuadIndexBytes()  const { return VkDeviceSize(m_quadIndexCapacity) * 6 * sizeof(uint32_t); }
 
 private:
     struct BufferPool {
         std::unique_ptr<Buffer> vertexBuffer;
         std::unique_ptr<Buffer> indexBuffer;
+        VkDeviceAddress         vertexAddress = 0;
         BlockAllocator vertexAllocator;
         BlockAllocator indexAllocator;
     };
@@ -178,6 +184,16 @@ private:
 
     uint32_t allocateNewPool();
 
+    // Pool sub-allocation shared by the allocateMesh* / allocateQuadMesh* calls (no source data
+    // set). `quads`: vertexCount quad records, no index range (shared quad index buffer).
+    Mesh* allocateRanges(uint32_t vertexCount, uint32_t indexCount, size_t vertexStride, UploadRequest& outRequest,
+                         bool quads = false);
+
+    std::unique_ptr<StagingRing> m_stagingRing;
+
+    std::unique_ptr<Buffer> m_quadIndexBuffer;
+    uint32_t                m_quadIndexCapacity = 0; // quads
+
     // Internal: stage and copy raw bytes to GPU buffers (no type knowledge)
     void uploadRawData(const void* vertexData, VkDeviceSize vertexBytes,
                        const void* indexData,  VkDeviceSize indexBytes);
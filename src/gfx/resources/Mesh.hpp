@@ -21,6 +21,7 @@ public:
 
     void draw(VkCommandBuffer commandBuffer);
 
+    uint32_t getIndexCount() const { return m_indexCount; }
     uint32_t getFirstIndex() const { return m_firstIndex; }
     int32_t  getVertexOffset() const { return m_vertexOffset; }
     uint32_t getBufferIndex() const { return m_bufferIndex; }
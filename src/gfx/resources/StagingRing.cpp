@@ -0,0 +1,86 @@
+#include "StagingRing.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace gfx {
+
+StagingRing::StagingRing(VulkanContext& context, VkDeviceSize capacity)
+    : m_capacity(capacity)
+{
+    m_buffer = std::make_unique<Buffer>(context, capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+    void* mapped = nullptr;
+    m_buffer->map(&mapped); // persistent: unmapped in the destructor only
+    m_mapped = static_cast<uint8_t*>(mapped);
+
+    std::cout << "[StagingRing] " << (capacity / 1024 / 1024) << " MB persistent-mapped upload ring.\n";
+}
+
+StagingRing::~StagingRing() {
+    if (m_mapped) m_buffer->unmap();
+}
+
+uint64_t StagingRing::reserve(VkDeviceSize bytes) {
+    bytes = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (bytes == 0 || bytes > m_capacity) return INVALID;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // A region never wraps: skip the rest of the buffer if it does not fit before the end.
+    uint64_t pos = m_tail;
+    const VkDeviceSize offset = pos % m_capacity;
+    if (offset + bytes > m_capacity) pos += m_capacity - offset;
+    if (pos + bytes - m_head > m_capacity) return INVALID;
+
+    if (pos != m_tail) m_regions.push_back({m_tail, pos - m_tail, 0, RegionState::FREE});
+    m_regions.push_back({pos, bytes, 0, RegionState::LIVE});
+    m_tail = pos + bytes;
+    return pos;
+}
+
+StagingRing::Region* StagingRing::find(uint64_t handle) {
+    auto it = std::lower_bound(m_regions.begin(), m_regions.end(), handle,
+                               [](const Region& r, uint64_t pos) { return r.pos < pos; });
+    return (it != m_regions.end() && it->pos == handle) ? &*it : nullptr;
+}
+
+void StagingRing::discard(uint64_t handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (Region* r = find(handle)) r->state = RegionState::FREE;
+    reclaim();
+}
+
+void StagingRing::retire(uint64_t handle, uint64_t frame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (Region* r = find(handle)) {
+        r->state = RegionState::RETIRED;
+        r->frame = frame;
+    }
+}
+
+void StagingRing::update(uint64_t currentFrame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lastFrame = currentFrame;
+    reclaim();
+}
+
+void StagingRing::reclaim() {
+    while (!m_regions.empty()) {
+        const Region& r = m_regions.front();
+        const bool done = r.state == RegionState::FREE ||
+                          (r.state == RegionState::RETIRED && m_lastFrame >= r.frame + FRAMES_IN_FLIGHT);
+        if (!done) break;
+        m_head = r.pos + r.size;
+        m_regions.pop_front();
+    }
+    if (m_regions.empty()) m_head = m_tail;
+}
+
+void StagingRing::flush(uint64_t handle, VkDeviceSize bytes) {
+    m_buffer->flush(offsetOf(handle), bytes);
+}
+
+VkDeviceSize StagingRing::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tail - m_head;
+}
+
+} // namespace gfx
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../core/VulkanContext.hpp"
+#include "Buffer.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace gfx {
+
+// ---------------------------------------------------------------------------
+// StagingRing — persistently mapped upload buffer, sub-allocated as a ring.
+//
+// Producers (mesh workers) reserve() a region and write into it directly; the main thread
+// records vkCmdCopyBuffer from it and retire()s the region with the frame of the copy.
+// Regions come back like GeometryManager's delayed frees: FRAMES_IN_FLIGHT frames later
+// (update()). Regions may be retired / discarded out of order; the ring head only advances
+// over the finished prefix. A full ring fails reserve() instead of blocking.
+//
+// Handles are monotonic byte positions (never reused), offset = handle % capacity.
+// reserve() is thread-safe; the rest is main-thread.
+// ---------------------------------------------------------------------------
+class StagingRing {
+public:
+    static constexpr uint64_t     INVALID          = ~0ull;
+    static constexpr uint64_t     FRAMES_IN_FLIGHT = 3;
+    static constexpr VkDeviceSize ALIGNMENT        = 16;
+
+    StagingRing(VulkanContext& context, VkDeviceSize capacity);
+    ~StagingRing();
+
+    StagingRing(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+
+    // Region of `bytes` that does not wrap; INVALID when the ring is full.
+    uint64_t reserve(VkDeviceSize bytes);
+    // Never copied from: reusable right away.
+    void discard(uint64_t handle);
+    // Copies from the region were submitted in `frame`.
+    void retire(uint64_t handle, uint64_t frame);
+    // Reclaims regions retired at least FRAMES_IN_FLIGHT frames before `currentFrame`.
+    void update(uint64_t currentFrame);
+
+    // Makes CPU writes to the region visible to the device (no-op on coherent memory).
+    void flush(uint64_t handle, VkDeviceSize bytes);
+
+    [[nodiscard]] VkDeviceSize offsetOf(uint64_t handle) const { return handle % m_capacity; }
+    [[nodiscard]] uint8_t*     data(uint64_t handle)     const { return m_mapped + offsetOf(handle); }
+    [[nodiscard]] VkBuffer     getBuffer()   const { return m_buffer->getBuffer(); }
+    [[nodiscard]] VkDeviceSize getCapacity() const { return m_capacity; }
+    // Reserved or not yet reclaimed (including wrap padding).
+    [[nodiscard]] VkDeviceSize getUsedBytes() const;
+
+private:
+    enum class RegionState : uint8_t { LIVE, RETIRED, FREE };
+    struct Region {
+        uint64_t     pos;
+        VkDeviceSize size;
+        uint64_t     frame;
+        RegionState  state;
+    };
+
+    Region* find(uint64_t handle);
+    void    reclaim(); // pops finished regions off the front (m_mutex held)
+
+    std::unique_ptr<Buffer> m_buffer;
+    uint8_t*                m_mapped   = nullptr;
+    VkDeviceSize            m_capacity = 0;
+
+    mutable std::mutex  m_mutex;
+    std::deque<Region>  m_regions; // ordered by pos
+    uint64_t            m_head      = 0; // first byte still in use
+    uint64_t            m_tail      = 0; // next byte to reserve
+    uint64_t            m_lastFrame = 0;
+};
+
+} // namespace gfx
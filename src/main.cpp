@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <filesystem>
 #include <cstdio>
+#include <cstdlib>
 #include <windows.h>
 #include <psapi.h>
 #include <timeapi.h>
@@ -27,8 +28,10 @@
 #include "world/BlockType.hpp"
 #include "world/World.hpp"
 #include "world/ChunkManager.hpp"
+#include "world/ChunkRenderer.hpp"
 #include "world/VoxelData.hpp"
 #include "world/Raycaster.hpp"
+#include "world/WorldBenchmarks.hpp"
 #include "scene/Frustum.hpp"
 
 // ---------------------------------------------------------------------------
@@ -105,13 +108,23 @@ static size_t getProcessRAMUsageMB() {
 
 static std::string resolveShaderBinaryPath(const char* shaderFileName) {
     const std::filesystem::path shaderPath = std::filesystem::path("bin") / "shaders" / shaderFileName;
-    if (std::filesystem::exists(shaderPath)) {
-        return shaderPath.generic_string();
+    if (!std::filesystem::exists(shaderPath)) {
+        throw std::runtime_error(
+            "Missing compiled shader binary: " + shaderPath.generic_string() +
+            ". Run 'mingw32-make shaders' before launching the engine.");
     }
 
-    throw std::runtime_error(
-        "Missing compiled shader binary: " + shaderPath.generic_string() +
-        ". Run 'mingw32-make shaders' before launching the engine.");
+    // .spv не трекаються в git — бінарник старший за GLSL означає, що шейдери не перезібрано
+    // (інакше пайплайн створюється зі старим інтерфейсом і ламається лише на GPU).
+    const std::filesystem::path sourcePath = std::filesystem::path("shaders") / shaderPath.stem();
+    std::error_code ec;
+    const auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+    if (!ec && sourceTime > std::filesystem::last_write_time(shaderPath)) {
+        throw std::runtime_error(
+            "Stale compiled shader binary: " + shaderPath.generic_string() + " is older than " +
+            sourcePath.generic_string() + ". Run 'mingw32-make shaders' before launching the engine.");
+    }
+    return shaderPath.generic_string();
 }
 
 static std::string prepareMetricsLogPath() {
@@ -126,7 +139,7 @@ static std::string prepareMetricsLogPath() {
     return metricsPath.generic_string();
 }
 
-int main() {
+int main(int argc, char** argv) {
     // Flush stdout after every write so log files are always up-to-date
     // even when output is redirected (full-buffering mode by default).
     std::cout << std::unitbuf;
@@ -145,6 +158,22 @@ int main() {
         }
     }
 
+    // CPU-only world benchmarks: engine.exe --bench [grid|all] — no window / Vulkan init.
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        const std::string name = (argc > 2) ? argv[2] : "all";
+        const bool ok = world::bench::runBenchmarks(name);
+        if (!ok) std::cerr << "Unknown benchmark: " << name << std::endl;
+        timeEndPeriod(1);
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Render smoke test: engine.exe --smoke [frames] — scripted camera flight with the
+    // validation layer on, then GPU-side checks; exit code 1 on failure (see README).
+    int smokeFrames = 0;
+    if (argc > 1 && std::string(argv[1]) == "--smoke")
+        smokeFrames = (argc > 2 && std::atoi(argv[2]) > 0) ? std::atoi(argv[2]) : 600;
+    uint32_t smokePeakLiquidTris = 0; // the flight keeps the sea in view: 0 = liquid pass drew nothing
+
     try {
         const std::string metricsLogPath = prepareMetricsLogPath();
 
@@ -154,7 +183,7 @@ int main() {
         core::Window window("ProtoEngine — Voxel World", WIDTH, HEIGHT);
         std::cout << "Window created.\n";
 
-        gfx::VulkanContext vulkanContext(window);
+        gfx::VulkanContext vulkanContext(window, smokeFrames > 0);
         std::cout << "VulkanContext created.\n";
 
         gfx::Swapchain swapchain(vulkanContext, window);
@@ -180,8 +209,10 @@ int main() {
         std::cout << "ImGuiManager created.\n";
 
         // ---- Voxel World (ChunkManager) ------------------------------------
+        // ChunkRenderer is the GPU sink for the meshes ChunkManager produces.
         // MeshWorker uses hardware_concurrency() threads by default
-        world::ChunkManager chunkManager(vulkanContext, geometryManager);
+        world::ChunkRenderer chunkRenderer(vulkanContext, geometryManager);
+        world::ChunkManager  chunkManager(chunkRenderer);
         int initialWorldRadius = 10;
         chunkManager.setRenderRadius(initialWorldRadius);
         int worldSeed = 42;
@@ -191,7 +222,7 @@ int main() {
         initCfg.worldRadiusBlks = initialWorldRadius * world::CHUNK_SIZE;
         chunkManager.generateWorld(initialWorldRadius, initialWorldRadius, initCfg);
         // Wait for all async meshing to complete before first frame
-        chunkManager.rebuildDirtyChunks(vulkanContext.getDevice(), 0.0f);
+        chunkManager.rebuildDirtyChunks(0.0f);
         std::cout << "ChunkManager created: " << chunkManager.getChunkCount()
                   << " chunks, " << chunkManager.getWorkerThreads() << " worker threads.\n";
 
@@ -256,13 +287,7 @@ int main() {
         shadowPipelineConfig.pushConstantRanges.push_back(stdPCRange);
         gfx::Pipeline shadowPipeline(vulkanContext, shadowPipelineConfig);
 
-        // ---- Voxel Pipeline (VoxelVertex — 8 bytes) ------------------------
-        {
-            // Verify VoxelVertex binding/attribute descriptions compile
-            [[maybe_unused]] auto vb = world::VoxelVertex::getBindingDescription();
-            [[maybe_unused]] auto va = world::VoxelVertex::getAttributeDescriptions();
-        }
-
+        // ---- Voxel Pipeline (VoxelQuad — 8 bytes per quad, vertex pulling) --
         gfx::PipelineConfig voxelPipelineConfig{};
         voxelPipelineConfig.colorAttachmentFormats = {swapchain.getImageFormat()};
         voxelPipelineConfig.depthAttachmentFormat  = swapchain.getDepthFormat();
@@ -271,14 +296,13 @@ int main() {
         voxelPipelineConfig.enableDepthTest        = true;
         voxelPipelineConfig.cullMode               = VK_CULL_MODE_BACK_BIT;
         voxelPipelineConfig.frontFace              = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-        // VoxelVertex binding + attributes
-        voxelPipelineConfig.bindingDescriptions   = {world::VoxelVertex::getBindingDescription()};
-        auto voxelAttrs = world::VoxelVertex::getAttributeDescriptions();
-        voxelPipelineConfig.attributeDescriptions = {voxelAttrs[0], voxelAttrs[1]};
+        // No vertex input: voxel.vert reads the chunk's VoxelQuad records through the
+        // instance SSBO's device address
+        voxelPipelineConfig.vertexPulling          = true;
         // Descriptor sets: set=0 (shadow/renderer), set=1 (bindless + palette), set=2 (SSBO chunk instances)
         voxelPipelineConfig.descriptorSetLayouts.push_back(renderer.getDescriptorSetLayout());
         voxelPipelineConfig.descriptorSetLayouts.push_back(bindlessSystem.getDescriptorSetLayout());
-        voxelPipelineConfig.descriptorSetLayouts.push_back(chunkManager.getRenderer().getDescriptorSetLayout());
+        voxelPipelineConfig.descriptorSetLayouts.push_back(chunkRenderer.getDescriptorSetLayout());
         voxelPipelineConfig.pushConstantRanges.push_back(voxelPCRange);
         // ---- Voxel Depth Pre-Pass Pipeline ---------------------------------
         gfx::PipelineConfig voxelDepthPrePassConfig = voxelPipelineConfig;
@@ -299,6 +323,14 @@ int main() {
         voxelWireConfig.cullMode    = VK_CULL_MODE_NONE; // show all edges
         gfx::Pipeline voxelWirePipeline(vulkanContext, voxelWireConfig);
 
+        // ---- Voxel Liquid Pipeline (translucent water, after the opaque pass) --
+        // Chunk liquid ranges arrive back to front; blended with the palette alpha and tested
+        // against the opaque depth without writing it. Both sides: the surface from below too.
+        gfx::PipelineConfig voxelLiquidConfig = voxelPipelineConfig;
+        voxelLiquidConfig.enableBlend = true;
+        voxelLiquidConfig.cullMode    = VK_CULL_MODE_NONE;
+        gfx::Pipeline voxelLiquidPipeline(vulkanContext, voxelLiquidConfig);
+
         // ---- Wireframe toggle state ----------------------------------------
         bool wireframe = false;
 
@@ -319,8 +351,8 @@ int main() {
         // ---- Debug Renderer (lines: frustum, camera marker) -----------------
         gfx::DebugRenderer debugRenderer(vulkanContext, nullptr,
             swapchain.getImageFormat(), swapchain.getDepthFormat(),
-            "bin/shaders/debug.vert.spv",
-            "bin/shaders/debug.frag.spv");
+            resolveShaderBinaryPath("debug.vert.spv"),
+            resolveShaderBinaryPath("debug.frag.spv"));
 
         // ---- Timer ---------------------------------------------------------
         core::Timer timer;
@@ -360,7 +392,7 @@ int main() {
         paletteData.colors[3]  = {0.52f, 0.33f, 0.16f, 1.f}; // 3  Dirt      (brown)
         paletteData.colors[4]  = {0.85f, 0.80f, 0.50f, 1.f}; // 4  Sand
         paletteData.colors[5]  = {0.90f, 0.93f, 0.97f, 1.f}; // 5  Snow
-        paletteData.colors[6]  = {0.18f, 0.40f, 0.82f, 1.f}; // 6  Water
+        paletteData.colors[6]  = {0.18f, 0.40f, 0.82f, 0.6f}; // 6  Water  (alpha: liquid pass blend)
         paletteData.colors[7]  = {0.40f, 0.25f, 0.10f, 1.f}; // 7  Wood
         paletteData.colors[8]  = {0.15f, 0.45f, 0.10f, 1.f}; // 8  Leaves
         paletteData.colors[9]  = {0.90f, 0.30f, 0.05f, 1.f}; // 9  Lava
@@ -376,7 +408,7 @@ int main() {
         chunkManager.waitAllWorkers();
         
         // Force one pass of GPU upload before the first frame
-        chunkManager.rebuildDirtyChunks(vulkanContext.getDevice(), 0.0f);
+        chunkManager.rebuildDirtyChunks(0.0f);
 
         // ---- Main Loop -----------------------------------------------------
         uint64_t absoluteFrame = 0;
@@ -398,6 +430,7 @@ int main() {
             }
 
             if (window.shouldClose()) break;
+            if (smokeFrames > 0 && absoluteFrame > static_cast<uint64_t>(smokeFrames)) break;
             auto t1 = std::chrono::high_resolution_clock::now();
 
             camera.setAspectRatio(renderer.getAspectRatio());
@@ -416,7 +449,11 @@ int main() {
                 }
             }
 
-            if (!ImGui::GetIO().WantCaptureMouse && !ImGui::GetIO().WantCaptureKeyboard) {
+            if (smokeFrames > 0) {
+                // Smoke flight: 2 blocks per frame away from the island, looking back at the
+                // coast — chunks stream in and out and the sea stays in view.
+                camera.setPosition({0.0f, 160.0f, 250.0f + 2.0f * static_cast<float>(absoluteFrame)});
+            } else if (!ImGui::GetIO().WantCaptureMouse && !ImGui::GetIO().WantCaptureKeyboard) {
                 // In debug mode: controlMainInDebug determines which camera moves
                 scene::Camera& moveTarget = (debugCameraMode && controlMainInDebug)
                     ? camera : activeCamera;
@@ -444,7 +481,7 @@ int main() {
             auto t2 = std::chrono::high_resolution_clock::now();
 
             // ---- Collect async mesh results (non-blocking) -----------------
-            chunkManager.rebuildDirtyChunks(vulkanContext.getDevice(), currentTime);
+            chunkManager.rebuildDirtyChunks(currentTime);
             geometryManager.update(absoluteFrame);
             auto t3 = std::chrono::high_resolution_clock::now();
 
@@ -561,8 +598,8 @@ int main() {
                     const auto lifecycleStats = chunkManager.getLifecycleStats();
                     const std::string metricsLine =
                         "[Metrics] FPS: " + std::to_string(displayFPS)
-                        + " | Visible chunks: " + std::to_string(chunkManager.getVisibleCount())
-                        + " | Visible polys: "  + std::to_string(chunkManager.getVisibleVertices())
+                        + " | Visible chunks: " + std::to_string(chunkRenderer.getVisibleCount())
+                        + " | Visible polys: "  + std::to_string(chunkRenderer.getVisibleVertices())
                         + " | GPU: " + std::to_string(renderer.getGpuFrameTimeMs()) + "ms"
                         + " | CPU: " + std::to_string(displayCPU) + "%"
                         + " | RAM: " + std::to_string(displayRAM) + "MB"
@@ -571,7 +608,46 @@ int main() {
                         + " | Placeholders: " + std::to_string(lifecycleStats.placeholders)
                         + " | MeshUnassigned: " + std::to_string(lifecycleStats.meshUnassigned)
                         + " | MeshEvicted: " + std::to_string(lifecycleStats.meshEvicted)
-                        + " | CachedModified: " + std::to_string(lifecycleStats.cachedModified);
+                        + " | CachedModified: " + std::to_string(lifecycleStats.cachedModified)
+                        + " | VoxelRAM: " + std::to_string(lifecycleStats.voxelBytes / (1024 * 1024)) + "MB"
+                        + " | BytesPerChunk: " + std::to_string(lifecycleStats.bytesPerChunk())
+                        + " | Uniform: " + std::to_string(lifecycleStats.paletteWidths[0])
+                        + " | PaletteBits(1/2/4/8/16): "
+                        + std::to_string(lifecycleStats.paletteWidths[1]) + "/"
+                        + std::to_string(lifecycleStats.paletteWidths[2]) + "/"
+                        + std::to_string(lifecycleStats.paletteWidths[3]) + "/"
+                        + std::to_string(lifecycleStats.paletteWidths[4]) + "/"
+                        + std::to_string(lifecycleStats.paletteWidths[5])
+                        + " | MeshSkipped: " + std::to_string(chunkManager.getSkippedMeshes())
+                        + " | Pool(cap/used/free/deferred): "
+                        + std::to_string(lifecycleStats.pool.capacity) + "/"
+                        + std::to_string(lifecycleStats.pool.inUse) + "/"
+                        + std::to_string(lifecycleStats.pool.freeCount) + "/"
+                        + std::to_string(lifecycleStats.pool.deferred)
+                        + " | PoolSlabAllocs: " + std::to_string(lifecycleStats.pool.slabAllocations)
+                        + " | PoolRecycled: " + std::to_string(lifecycleStats.pool.recycled)
+                        + " | ColdRatio(raw/palette): "
+                        + std::to_string(lifecycleStats.cold.rawRatio()) + "/"
+                        + std::to_string(lifecycleStats.cold.paletteRatio())
+                        + " | ColdDecompressUs(avg/max): "
+                        + std::to_string(lifecycleStats.cold.avgDecompressUs) + "/"
+                        + std::to_string(lifecycleStats.cold.maxDecompressUs)
+                        + " | RegionWrites: " + std::to_string(lifecycleStats.region.chunksWritten)
+                        + " | RegionReads: " + std::to_string(lifecycleStats.region.chunksRead)
+                        + " | RegionPending: " + std::to_string(lifecycleStats.region.pendingWrites)
+                        + " | DiskLoads(hit/miss/queued): "
+                        + std::to_string(lifecycleStats.loader.hits) + "/"
+                        + std::to_string(lifecycleStats.loader.misses) + "/"
+                        + std::to_string(lifecycleStats.loader.queued)
+                        + " | GenUs(noise/interp per column, surface/carve/decorate/encode per chunk): "
+                        + std::to_string(lifecycleStats.gen.usPerItem(world::GenStage::NOISE)) + "/"
+                        + std::to_string(lifecycleStats.gen.usPerItem(world::GenStage::INTERPOLATE)) + "/"
+                        + std::to_string(lifecycleStats.gen.usPerItem(world::GenStage::SURFACE)) + "/"
+                        + std::to_string(lifecycleStats.gen.usPerItem(world::GenStage::CARVE)) + "/"
+                        + std::to_string(lifecycleStats.gen.usPerItem(world::GenStage::DECORATE)) + "/"
+                        + std::to_string(lifecycleStats.gen.usPerItem(world::GenStage::ENCODE))
+                        + " | GenColumns/Chunks: " + std::to_string(lifecycleStats.gen.columns) + "/"
+                        + std::to_string(lifecycleStats.gen.chunks);
                     std::cout << metricsLine << std::endl;
                     if (FILE* f = std::fopen(metricsLogPath.c_str(), "a")) {
                         std::fprintf(f, "%s\n", metricsLine.c_str());
@@ -635,19 +711,23 @@ int main() {
 
                 ImGui::Separator();
                 if (ImGui::CollapsingHeader("Chunk Stats", ImGuiTreeNodeFlags_DefaultOpen)) {
-                    uint32_t visChunks = chunkManager.getVisibleCount();
-                    uint32_t visPolys  = chunkManager.getVisibleVertices(); // triangles
+                    uint32_t visChunks = chunkRenderer.getVisibleCount();
+                    uint32_t visPolys  = chunkRenderer.getVisibleVertices(); // triangles
                     auto lifecycleStats = chunkManager.getLifecycleStats();
                     ImGui::Text("Total chunks:   %u", chunkManager.getChunkCount());
                     ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f),
                         "Visible (GPU):  %u chunks", visChunks);
                     ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f),
                         "Visible polys:  %u tris", visPolys);
-                    ImGui::Text("Culled:         %u", chunkManager.getCulledCount());
-                    ImGui::Text("Total verts:    %u", chunkManager.getTotalVertices());
+                    ImGui::Text("Back faces:     %u tris skipped", chunkRenderer.getBackfaceCulledTriangles());
+                    ImGui::Text("Liquid:         %u tris", chunkRenderer.getVisibleLiquidTriangles());
+                    ImGui::Text("Culled:         %u", chunkRenderer.getCulledCount());
+                    ImGui::Text("Total quads:    %u (%.1f MB)", chunkManager.getTotalQuads(),
+                                chunkManager.getTotalQuads() * sizeof(world::VoxelQuad) / (1024.0 * 1024.0));
                     ImGui::Text("Rebuild:        %.2f ms", chunkManager.getLastRebuildMs());
                     ImGui::Text("Worker threads: %u", chunkManager.getWorkerThreads());
                     ImGui::Text("Pending meshes: %d", chunkManager.getPendingMeshes());
+                    ImGui::Text("Skipped meshes: %llu (uniform)", static_cast<unsigned long long>(chunkManager.getSkippedMeshes()));
                     ImGui::SeparatorText("Lifecycle");
                     ImGui::Text("Ready:          %u", lifecycleStats.ready);
                     ImGui::Text("Generating:     %u", lifecycleStats.generating);
@@ -659,6 +739,75 @@ int main() {
                     ImGui::Text("  LOD0 full:    %u", lodCounts[0]);
                     ImGui::Text("  LOD1 half:    %u", lodCounts[1]);
                     ImGui::Text("  LOD2 quarter: %u", lodCounts[2]);
+                    ImGui::SeparatorText("Generation Stages");
+                    ImGui::Text("Generated:      %llu chunks / %llu columns",
+                        static_cast<unsigned long long>(lifecycleStats.gen.chunks),
+                        static_cast<unsigned long long>(lifecycleStats.gen.columns));
+                    for (size_t i = 0; i < world::GEN_STAGE_COUNT; ++i) {
+                        const auto stage = static_cast<world::GenStage>(i);
+                        if (world::stageScope(stage) == world::StageScope::COLUMN) {
+                            ImGui::Text("  %-9s %7.1f us/chunk (%.1f us/column)", world::stageName(stage),
+                                lifecycleStats.gen.usPerChunk(stage), lifecycleStats.gen.usPerItem(stage));
+                        } else {
+                            ImGui::Text("  %-9s %7.1f us/chunk", world::stageName(stage),
+                                lifecycleStats.gen.usPerChunk(stage));
+                        }
+                    }
+                    ImGui::Text("  total     %7.1f us/chunk", lifecycleStats.gen.totalUsPerChunk());
+                    ImGui::Text("Decor queue:    %zu chunks / %zu writes / %.1f KB",
+                        lifecycleStats.decor.targets, lifecycleStats.decor.writes,
+                        lifecycleStats.decor.bytes / 1024.0);
+                    ImGui::Text("Decor late:     %llu of %llu posts, %llu pruned",
+                        static_cast<unsigned long long>(lifecycleStats.decor.late),
+                        static_cast<unsigned long long>(lifecycleStats.decor.posted),
+                        static_cast<unsigned long long>(lifecycleStats.decor.pruned));
+                    ImGui::SeparatorText("Voxel Storage");
+                    ImGui::Text("Voxel RAM:      %.1f MB", lifecycleStats.voxelBytes / (1024.0 * 1024.0));
+                    ImGui::Text("Bytes/chunk:    %u", lifecycleStats.bytesPerChunk());
+                    ImGui::Text("Mip RAM:        %.1f MB (%u chunks)", lifecycleStats.mipBytes / (1024.0 * 1024.0),
+                        lifecycleStats.mipChunks);
+                    ImGui::Text("Uniform chunks: %u", lifecycleStats.paletteWidths[0]);
+                    ImGui::Text("Payload LOD:    full %u / 16^3 %u / 8^3 %u", lifecycleStats.payloadLods[0],
+                        lifecycleStats.payloadLods[1], lifecycleStats.payloadLods[2]);
+                    ImGui::Text("Palette bits:   1:%u 2:%u 4:%u 8:%u 16:%u",
+                        lifecycleStats.paletteWidths[1], lifecycleStats.paletteWidths[2],
+                        lifecycleStats.paletteWidths[3], lifecycleStats.paletteWidths[4],
+                        lifecycleStats.paletteWidths[5]);
+                    ImGui::SeparatorText("Chunk Pool");
+                    ImGui::Text("Capacity:       %zu (%llu slabs)", lifecycleStats.pool.capacity,
+                        static_cast<unsigned long long>(lifecycleStats.pool.slabAllocations));
+                    ImGui::Text("In use / free:  %zu / %zu", lifecycleStats.pool.inUse, lifecycleStats.pool.freeCount);
+                    ImGui::Text("Deferred:       %zu", lifecycleStats.pool.deferred);
+                    ImGui::Text("Acquired:       %llu (recycled %llu)",
+                        static_cast<unsigned long long>(lifecycleStats.pool.acquired),
+                        static_cast<unsigned long long>(lifecycleStats.pool.recycled));
+                    ImGui::SeparatorText("Cold Tier");
+                    ImGui::Text("Entries:        %zu (%zu compressing)", lifecycleStats.cold.entries,
+                        lifecycleStats.cold.pending);
+                    ImGui::Text("Blob bytes:     %.1f KB", lifecycleStats.cold.compressedBytes / 1024.0);
+                    ImGui::Text("Ratio:          %.1fx raw / %.1fx palette",
+                        lifecycleStats.cold.rawRatio(), lifecycleStats.cold.paletteRatio());
+                    ImGui::Text("Decompress:     %.1f us avg / %.1f us max (%llu)",
+                        lifecycleStats.cold.avgDecompressUs, lifecycleStats.cold.maxDecompressUs,
+                        static_cast<unsigned long long>(lifecycleStats.cold.decompressed));
+                    ImGui::Text("Spilled:        %llu", static_cast<unsigned long long>(lifecycleStats.cold.spilled));
+                    ImGui::SeparatorText("Region Files");
+                    ImGui::Text("Written:        %llu (%.1f KB)",
+                        static_cast<unsigned long long>(lifecycleStats.region.chunksWritten),
+                        lifecycleStats.region.bytesWritten / 1024.0);
+                    ImGui::Text("Read:           %llu (%.1f KB)",
+                        static_cast<unsigned long long>(lifecycleStats.region.chunksRead),
+                        lifecycleStats.region.bytesRead / 1024.0);
+                    ImGui::Text("Pending writes: %zu (reclaimed %llu)", lifecycleStats.region.pendingWrites,
+                        static_cast<unsigned long long>(lifecycleStats.region.reclaimed));
+                    ImGui::Text("Open regions:   %zu", lifecycleStats.region.openRegions);
+                    ImGui::Text("Async loads:    %llu hit / %llu miss (%llu batches, %zu queued)",
+                        static_cast<unsigned long long>(lifecycleStats.loader.hits),
+                        static_cast<unsigned long long>(lifecycleStats.loader.misses),
+                        static_cast<unsigned long long>(lifecycleStats.loader.batches),
+                        lifecycleStats.loader.queued);
+                    ImGui::Text("Baked loads:    %llu",
+                        static_cast<unsigned long long>(lifecycleStats.loader.bakedHits));
                 }
 
                 ImGui::End(); // Performance & Metrics
@@ -682,6 +831,9 @@ int main() {
                     ImGui::SliderFloat("Hysteresis",    &chunkManager.getLodHysteresis(),   0.0f,   64.0f, "%.1f blk");
                     ImGui::SliderFloat("Unload Radius", &chunkManager.getUnloadRadius(),   64.0f, 4096.0f, "%.0f blk");
                     ImGui::SliderFloat("View Dist",     &chunkManager.getFrustumRadius(),  64.0f, 8192.0f, "%.0f blk");
+                    ImGui::Checkbox("Reduced far generation", &chunkManager.getReducedGeneration());
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("LOD1/2 chunks generate a 16^3 / 8^3 voxel grid; full detail on approach or edit");
                 }
 
                 if (ImGui::CollapsingHeader("World Generation", ImGuiTreeNodeFlags_DefaultOpen)) {
@@ -723,6 +875,26 @@ int main() {
                     if (ImGui::IsItemHovered())
                         ImGui::SetTooltip("Ridged threshold: lower = narrower rivers");
 
+                    ImGui::Spacing();
+                    ImGui::TextColored(ImVec4(0.7f,0.85f,1.0f,1.f), "Caves");
+                    ImGui::Checkbox("Caves", &terrainCfg.caves);
+                    ImGui::SliderFloat("Cave Freq",    &terrainCfg.caveFrequency, 0.005f,0.1f, "%.3f");
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("3D noise frequency: higher = smaller, more frequent caves");
+                    ImGui::SliderFloat("Cave Thresh",  &terrainCfg.caveThreshold, 0.1f, 0.9f,  "%.2f");
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("Density above this is carved to air.\nLower = more open cave space.");
+                    ImGui::SliderFloat("Cave Squash",  &terrainCfg.caveSquash,    0.5f, 4.0f,  "%.2f");
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("Vertical squash: higher = flatter, wider tunnels and overhangs");
+
+                    ImGui::Spacing();
+                    ImGui::TextColored(ImVec4(0.7f,0.85f,1.0f,1.f), "Trees");
+                    ImGui::Checkbox("Trees", &terrainCfg.trees);
+                    ImGui::SliderFloat("Tree Density", &terrainCfg.treeDensity,   0.0f, 1.0f,  "%.2f");
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("Chance of a tree per 8x8-block cell (on grass above sea level)");
+
                     ImGui::Spacing();
                     ImGui::TextColored(ImVec4(0.7f,0.85f,1.0f,1.f), "Island Shape");
                     ImGui::SliderFloat("Island Falloff",&terrainCfg.islandFalloff,0.2f,  0.9f, "%.2f");
@@ -852,9 +1024,11 @@ int main() {
                 float shadowDistanceLimit = 150.0f; // Limit shadow distance to 150 blocks
                 if (chunkManager.hasMesh()) {
                     auto cullStart = std::chrono::high_resolution_clock::now();
-                    chunkManager.cull(commandBuffer, frustum, frustum, activeCamera.getPosition(), shadowDistanceLimit, currentTime, currentFrame);
+                    chunkRenderer.cull(commandBuffer, frustum, frustum, activeCamera.getPosition(), shadowDistanceLimit, currentTime, currentFrame);
                     auto cullEnd = std::chrono::high_resolution_clock::now();
                     cullTime = std::chrono::duration<double, std::milli>(cullEnd - cullStart).count();
+                    if (chunkRenderer.getVisibleLiquidTriangles() > smokePeakLiquidTris)
+                        smokePeakLiquidTris = chunkRenderer.getVisibleLiquidTriangles();
                 }
                 if (displayCullMs == 0.0) displayCullMs = cullTime;
                 else displayCullMs = displayCullMs * 0.95 + cullTime * 0.05;
@@ -880,7 +1054,7 @@ int main() {
                         voxelDepthPrePass.getLayout(), 0, 1, &descriptorSet, 0, nullptr);
                     bindlessSystem.bind(commandBuffer, voxelDepthPrePass.getLayout(), currentFrame, 1);
 
-                    chunkManager.renderCamera(commandBuffer, voxelDepthPrePass.getLayout(), currentFrame);
+                    chunkRenderer.renderCamera(commandBuffer, voxelDepthPrePass.getLayout(), currentFrame);
                     
                     auto renderEnd = std::chrono::high_resolution_clock::now();
                     // renderTime += ... (not logged for prepass)
@@ -890,7 +1064,7 @@ int main() {
 
                 // Shadow pass (placeholder for voxel shadows)
                 renderer.beginShadowPass(commandBuffer);
-                // if (chunkManager.hasMesh()) chunkManager.renderShadow(commandBuffer, shadowPipelineLayout, currentFrame);
+                // if (chunkManager.hasMesh()) chunkRenderer.renderShadow(commandBuffer, shadowPipelineLayout, currentFrame);
                 renderer.endShadowPass(commandBuffer);
 
                 // Update Palette UBO
@@ -919,7 +1093,20 @@ int main() {
                         activePipeline.getLayout(), 0, 1, &descriptorSet, 0, nullptr);
                     bindlessSystem.bind(commandBuffer, activePipeline.getLayout(), currentFrame, 1);
 
-                    chunkManager.renderCamera(commandBuffer, activePipeline.getLayout(), currentFrame);
+                    chunkRenderer.renderCamera(commandBuffer, activePipeline.getLayout(), currentFrame);
+
+                    // ---- Liquid (blended, back to front) -------------------
+                    gfx::Pipeline& liquidPipeline = wireframe ? voxelWirePipeline : voxelLiquidPipeline;
+                    if (&liquidPipeline != &activePipeline) {
+                        liquidPipeline.bind(commandBuffer);
+                        vkCmdPushConstants(commandBuffer, liquidPipeline.getLayout(),
+                            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                            0, sizeof(VoxelGlobalPush), &vpc);
+                        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            liquidPipeline.getLayout(), 0, 1, &descriptorSet, 0, nullptr);
+                        bindlessSystem.bind(commandBuffer, liquidPipeline.getLayout(), currentFrame, 1);
+                    }
+                    chunkRenderer.renderLiquid(commandBuffer, liquidPipeline.getLayout(), currentFrame);
                     
                     auto renderEnd = std::chrono::high_resolution_clock::now();
                     renderTime += std::chrono::duration<double, std::milli>(renderEnd - renderStart).count();
@@ -955,9 +1142,36 @@ int main() {
 
         vkDeviceWaitIdle(vulkanContext.getDevice());
 
+        if (smokeFrames > 0) {
+            // Meshes still on the workers hold ring regions: land them, then step the frame
+            // counter past FRAMES_IN_FLIGHT — every region must have come back to the ring.
+            for (int i = 0; i < 256; ++i) {
+                chunkManager.waitAllWorkers();
+                chunkManager.rebuildDirtyChunks(static_cast<float>(timer.getTotalTime()));
+                chunkManager.flushDirty();
+                if (chunkManager.getPendingMeshes() == 0) break;
+            }
+            vkDeviceWaitIdle(vulkanContext.getDevice());
+            for (uint64_t i = 0; i <= gfx::StagingRing::FRAMES_IN_FLIGHT; ++i)
+                geometryManager.update(++absoluteFrame);
+
+            const VkDeviceSize ringUsed = geometryManager.getStagingRing().getUsedBytes();
+            const uint32_t     messages = gfx::VulkanContext::getValidationMessageCount();
+            const bool         passed   = ringUsed == 0 && messages == 0 && smokePeakLiquidTris > 0;
+            std::cout << "[Smoke] " << smokeFrames << " frames: staging ring " << ringUsed
+                      << " bytes in use, " << messages << " validation messages, peak "
+                      << smokePeakLiquidTris << " liquid tris — "
+                      << (passed ? "PASS" : "FAIL") << std::endl;
+            if (!passed) {
+                timeEndPeriod(1);
+                return EXIT_FAILURE;
+            }
+        }
+
     } catch (const std::exception& e) {
         std::cerr << "Fatal Error: " << e.what() << std::endl;
-        MessageBoxA(nullptr, e.what(), "ProtoEngine — Fatal Error", MB_OK | MB_ICONERROR);
+        if (smokeFrames == 0)
+            MessageBoxA(nullptr, e.what(), "ProtoEngine — Fatal Error", MB_OK | MB_ICONERROR);
         timeEndPeriod(1);
         return EXIT_FAILURE;
     }
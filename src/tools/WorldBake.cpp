@@ -0,0 +1,74 @@
+// worldbake — headless world pre-generation (no window, no Vulkan).
+//
+//   worldbake.exe [--radius N] [--seed S] [--threads T] [--out DIR] [--no-caves] [--no-trees]
+//
+// Generates the world the engine would build for the same settings (default: radius 10,
+// seed 42, default TerrainConfig — the engine's startup world) and writes it to
+// DIR/baked_<config hash>/ (see world/WorldBaker.hpp). The engine loads it on the next
+// generateWorld() with a matching config instead of generating.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <filesystem>
+#include "world/WorldBaker.hpp"
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: worldbake [--radius N] [--seed S] [--threads T] [--out DIR] [--no-caves] [--no-trees]\n"
+              << "  --radius N   chunk columns in [-N, N]^2 (default 10)\n"
+              << "  --seed S     terrain seed (default 42)\n"
+              << "  --threads T  worker threads (default: all cores)\n"
+              << "  --out DIR    save root the engine reads (default: saves)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    world::BakeOptions options;
+    world::TerrainConfig config;
+    config.seed = 42;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if      (arg == "--radius"  && hasValue) options.radius   = std::atoi(argv[++i]);
+        else if (arg == "--seed"    && hasValue) config.seed      = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) options.threads  = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (arg == "--out"     && hasValue) options.saveRoot = argv[++i];
+        else if (arg == "--no-caves") config.caves = false;
+        else if (arg == "--no-trees") config.trees = false;
+        else {
+            printUsage();
+            return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    // Same island extent the engine derives from its world radius (part of the config hash).
+    config.worldRadiusBlks = options.radius * world::CHUNK_SIZE;
+
+    // Same working directory as the engine (project root = parent of bin/), so saves/ match.
+    {
+        std::error_code ec;
+        const std::filesystem::path root = std::filesystem::absolute(argv[0], ec).parent_path().parent_path();
+        if (!ec && std::filesystem::exists(root / "bin")) std::filesystem::current_path(root, ec);
+    }
+
+    std::cout << "[worldbake] radius " << options.radius << ", seed " << config.seed
+              << " -> " << world::bakedWorldDirectory(options.saveRoot, config) << "\n" << std::flush;
+
+    const world::BakeResult r = world::bakeWorld(config, options);
+    if (!r.ok) {
+        std::cerr << "[worldbake] Failed.\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "[worldbake] " << r.chunks << " chunks, generate " << r.generateMs << " ms ("
+              << r.mvoxPerSec() << " Mvox/sec), write " << r.writeMs << " ms ("
+              << r.bytes / (1024.0 * 1024.0) << " MB, " << r.decorSpills << " tree spills)\n"
+              << "[worldbake] " << r.chunksPerSec() << " chunks/sec overall, peak RSS "
+              << r.peakRss / (1024.0 * 1024.0) << " MB\n" << std::flush;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,24 @@
+// worldbench — the world benchmarks without the engine (no window, no Vulkan, no GPU).
+//
+//   worldbench.exe [grid|noise|lodgen|caves|forest|stream|mesher|facecull|liquid|mip|all]
+//
+// Same runners as `engine.exe --bench` (see world/WorldBenchmarks.hpp), linked against the
+// world core only, so they run on headless build / CI machines.
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "world/WorldBenchmarks.hpp"
+
+int main(int argc, char** argv) {
+    const std::string name = argc > 1 ? argv[1] : "all";
+    if (name == "--help") {
+        std::cout << "Usage: worldbench [grid|noise|lodgen|caves|forest|stream|mesher|facecull|liquid|mip|all]\n";
+        return EXIT_SUCCESS;
+    }
+    if (!world::bench::runBenchmarks(name)) {
+        std::cerr << "Unknown benchmark: " << name << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,284 @@
+#include "world/BatchNoise.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "../vendor/FastNoiseLite.h"
+
+namespace world {
+
+namespace {
+
+std::atomic<bool> s_scalarFallback{false};
+
+FastNoiseLite makeReference(int seed, float frequency, int octaves) {
+    FastNoiseLite noise;
+    noise.SetSeed(seed);
+    noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    noise.SetFrequency(frequency);
+    if (octaves > 1) {
+        noise.SetFractalType(FastNoiseLite::FractalType_FBm);
+        noise.SetFractalOctaves(octaves);
+    }
+    return noise;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Vector kernel — a lane-by-lane transcription of FastNoiseLite::SingleSimplex / GenFractalFBm
+// ---------------------------------------------------------------------------
+#if defined(__GNUC__)
+
+// The helpers below return 32-byte vectors; they are internal to this file and always inlined
+// into sample(), so the "AVX vector return without AVX enabled changes the ABI" warning does not
+// apply. (GCC reports it at the end of the translation unit, so it stays off for the file.)
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace {
+
+constexpr int LANES = static_cast<int>(BatchNoise2D::LANES);
+
+typedef float    VecF __attribute__((vector_size(LANES * 4)));
+typedef int32_t  VecI __attribute__((vector_size(LANES * 4)));
+typedef uint32_t VecU __attribute__((vector_size(LANES * 4)));
+
+constexpr uint32_t PRIME_X = 501125321u;   // FastNoiseLite::PrimeX
+constexpr uint32_t PRIME_Y = 1136930381u;  // FastNoiseLite::PrimeY
+
+// FastNoiseLite's Lookup<float>::Gradients2D as (x, y) pairs. GradCoord masks the hash to
+// 127 << 1, so only the first 128 pairs are reachable: 5 × the 24-direction ring, then the
+// 8 directions below.
+struct Grad2 { float x, y; };
+constexpr Grad2 GRADIENT_RING[24] = {
+    { 0.130526192220052f,  0.99144486137381f }, { 0.38268343236509f,   0.923879532511287f},
+    { 0.608761429008721f,  0.793353340291235f}, { 0.793353340291235f,  0.608761429008721f},
+    { 0.923879532511287f,  0.38268343236509f }, { 0.99144486137381f,   0.130526192220051f},
+    { 0.99144486137381f,  -0.130526192220051f}, { 0.923879532511287f, -0.38268343236509f },
+    { 0.793353340291235f, -0.60876142900872f }, { 0.608761429008721f, -0.793353340291235f},
+    { 0.38268343236509f,  -0.923879532511287f}, { 0.130526192220052f, -0.99144486137381f },
+    {-0.130526192220052f, -0.99144486137381f }, {-0.38268343236509f,  -0.923879532511287f},
+    {-0.608761429008721f, -0.793353340291235f}, {-0.793353340291235f, -0.608761429008721f},
+    {-0.923879532511287f, -0.38268343236509f }, {-0.99144486137381f,  -0.130526192220052f},
+    {-0.99144486137381f,   0.130526192220051f}, {-0.923879532511287f,  0.38268343236509f },
+    {-0.793353340291235f,  0.608761429008721f}, {-0.608761429008721f,  0.793353340291235f},
+    {-0.38268343236509f,   0.923879532511287f}, {-0.130526192220052f,  0.99144486137381f },
+};
+constexpr Grad2 GRADIENT_TAIL[8] = {
+    { 0.38268343236509f,   0.923879532511287f}, { 0.923879532511287f,  0.38268343236509f },
+    { 0.923879532511287f, -0.38268343236509f }, { 0.38268343236509f,  -0.923879532511287f},
+    {-0.38268343236509f,  -0.923879532511287f}, {-0.923879532511287f, -0.38268343236509f },
+    {-0.923879532511287f,  0.38268343236509f }, {-0.38268343236509f,   0.923879532511287f},
+};
+
+struct GradientTable {
+    Grad2 pairs[128];
+    constexpr GradientTable() : pairs{} {
+        for (int i = 0; i < 120; ++i) pairs[i] = GRADIENT_RING[i % 24];
+        for (int i = 0; i < 8;   ++i) pairs[120 + i] = GRADIENT_TAIL[i];
+    }
+};
+constexpr GradientTable GRADIENTS;
+
+// FastNoiseLite::FastFloor: (int)f, minus one for negative f (also for negative integers).
+[[gnu::always_inline]] inline VecI fastFloor(const VecF& f) {
+    return __builtin_convertvector(f, VecI) + (f < 0.0f); // mask lanes are -1
+}
+
+// FastNoiseLite::GradCoord. The table lookup is a per-lane gather; everything else is vector.
+[[gnu::always_inline]] inline VecF gradCoord(const VecU& seed, const VecU& xPrimed, const VecU& yPrimed,
+                                             const VecF& xd, const VecF& yd) {
+    VecU hash = (seed ^ xPrimed ^ yPrimed) * 0x27d4eb2du;
+    // FastNoiseLite shifts a signed int; that only differs in the top 15 bits, which the mask drops.
+    hash ^= hash >> 15;
+    hash &= 127u << 1;
+
+    VecF xg, yg;
+    for (int l = 0; l < LANES; ++l) {
+        const Grad2& g = GRADIENTS.pairs[hash[l] >> 1];
+        xg[l] = g.x;
+        yg[l] = g.y;
+    }
+    return xd * xg + yd * yg;
+}
+
+// FastNoiseLite::SingleSimplex with its branches turned into lane selects.
+[[gnu::always_inline]] inline VecF singleSimplex(const VecU& seed, const VecF& x, const VecF& y) {
+    const float SQRT3 = 1.7320508075688772935274463415059f;
+    const float G2 = (3 - SQRT3) / 6;
+    const VecF  zero = {};
+
+    VecI i = fastFloor(x);
+    VecI j = fastFloor(y);
+    const VecF xi = x - __builtin_convertvector(i, VecF);
+    const VecF yi = y - __builtin_convertvector(j, VecF);
+
+    const VecF t  = (xi + yi) * G2;
+    const VecF x0 = xi - t;
+    const VecF y0 = yi - t;
+
+    const VecU iP = (VecU)i * PRIME_X;
+    const VecU jP = (VecU)j * PRIME_Y;
+
+    const VecF a  = 0.5f - x0 * x0 - y0 * y0;
+    const VecF n0 = (a > 0.0f) ? (a * a) * (a * a) * gradCoord(seed, iP, jP, x0, y0) : zero;
+
+    const VecF c  = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
+    const VecF x2 = x0 + (2 * (float)G2 - 1);
+    const VecF y2 = y0 + (2 * (float)G2 - 1);
+    const VecF n2 = (c > 0.0f) ? (c * c) * (c * c) * gradCoord(seed, iP + PRIME_X, jP + PRIME_Y, x2, y2) : zero;
+
+    // y0 > x0: middle corner (0, 1), else (1, 0).
+    const VecI upper  = (y0 > x0);
+    const VecU upperU = (VecU)upper;
+    const VecF x1 = upper ? x0 + (float)G2       : x0 + ((float)G2 - 1);
+    const VecF y1 = upper ? y0 + ((float)G2 - 1) : y0 + (float)G2;
+    const VecU cornerX = iP + (~upperU & PRIME_X);
+    const VecU cornerY = jP + ( upperU & PRIME_Y);
+    const VecF b  = 0.5f - x1 * x1 - y1 * y1;
+    const VecF n1 = (b > 0.0f) ? (b * b) * (b * b) * gradCoord(seed, cornerX, cornerY, x1, y1) : zero;
+
+    return (n0 + n1 + n2) * 99.83685446303647f;
+}
+
+// The whole batch loop, inlined into one function per instruction set below.
+[[gnu::always_inline]] inline void sampleVector(int seedIn, float frequency, int octaves, float fractalBounding,
+                                                const float* x, const float* y, float* out, size_t count) {
+    const float SQRT3 = (float)1.7320508075688772935274463415059;
+    const float F2 = 0.5f * (SQRT3 - 1);
+
+    for (size_t base = 0; base < count; base += LANES) {
+        const size_t n = (count - base < LANES) ? count - base : LANES;
+        VecF vx = {}, vy = {};
+        std::memcpy(&vx, x + base, n * sizeof(float));
+        std::memcpy(&vy, y + base, n * sizeof(float));
+
+        // TransformNoiseCoordinate: frequency, then the OpenSimplex2 skew.
+        vx *= frequency;
+        vy *= frequency;
+        const VecF t = (vx + vy) * F2;
+        vx += t;
+        vy += t;
+
+        VecU seed = {};
+        seed += static_cast<uint32_t>(seedIn);
+
+        VecF result;
+        if (octaves == 1) {
+            result = singleSimplex(seed, vx, vy);
+        } else {
+            // GenFractalFBm. Its weighted-strength factor is Lerp(1, .., 0) == 1 exactly, so
+            // that multiply is left out.
+            VecF  sum = {};
+            float amp = fractalBounding;
+            for (int o = 0; o < octaves; ++o) {
+                sum += singleSimplex(seed, vx, vy) * amp;
+                seed += 1u;
+                vx *= 2.0f;
+                vy *= 2.0f;
+                amp *= 0.5f;
+            }
+            result = sum;
+        }
+        std::memcpy(out + base, &result, n * sizeof(float));
+    }
+}
+
+// Baseline ISA of the build (SSE2 on x86-64: every 8-lane op is two 4-lane instructions).
+[[gnu::noinline]] void sampleBaseline(int seed, float frequency, int octaves, float fractalBounding,
+                                      const float* x, const float* y, float* out, size_t count) {
+    sampleVector(seed, frequency, octaves, fractalBounding, x, y, out, count);
+}
+
+// x86 builds that are not already AVX2 get a second copy compiled for AVX2, picked at run time.
+// "avx2" does not imply FMA in GCC, so the copy rounds exactly like the baseline one.
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__AVX2__)
+#define BATCH_NOISE_DISPATCH 1
+
+[[gnu::target("avx2"), gnu::noinline]]
+void sampleAvx2(int seed, float frequency, int octaves, float fractalBounding,
+                const float* x, const float* y, float* out, size_t count) {
+    sampleVector(seed, frequency, octaves, fractalBounding, x, y, out, count);
+}
+
+bool hasAvx2() {
+    static const bool s_avx2 = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return s_avx2;
+}
+#else
+#define BATCH_NOISE_DISPATCH 0
+#endif
+
+} // namespace
+
+#endif // __GNUC__
+
+// ---------------------------------------------------------------------------
+// BatchNoise2D
+// ---------------------------------------------------------------------------
+BatchNoise2D::BatchNoise2D(int seed, float frequency, int octaves)
+    : m_seed(seed), m_frequency(frequency), m_octaves(octaves > 1 ? octaves : 1)
+{
+    // FastNoiseLite::CalculateFractalBounding with gain 0.5.
+    const float gain = 0.5f;
+    float amp = gain;
+    float ampFractal = 1.0f;
+    for (int i = 1; i < m_octaves; ++i) {
+        ampFractal += amp;
+        amp *= gain;
+    }
+    m_fractalBounding = 1 / ampFractal;
+}
+
+float BatchNoise2D::sample(float x, float y) const {
+    return makeReference(m_seed, m_frequency, m_octaves).GetNoise(x, y);
+}
+
+void BatchNoise2D::sampleScalar(const float* x, const float* y, float* out, size_t count) const {
+    const FastNoiseLite noise = makeReference(m_seed, m_frequency, m_octaves);
+    for (size_t i = 0; i < count; ++i) out[i] = noise.GetNoise(x[i], y[i]);
+}
+
+void BatchNoise2D::sample(const float* x, const float* y, float* out, size_t count) const {
+#if defined(__GNUC__)
+    if (s_scalarFallback.load(std::memory_order_relaxed)) {
+        sampleScalar(x, y, out, count);
+        return;
+    }
+#if BATCH_NOISE_DISPATCH
+    if (hasAvx2()) {
+        sampleAvx2(m_seed, m_frequency, m_octaves, m_fractalBounding, x, y, out, count);
+        return;
+    }
+#endif
+    sampleBaseline(m_seed, m_frequency, m_octaves, m_fractalBounding, x, y, out, count);
+#else
+    sampleScalar(x, y, out, count);
+#endif
+}
+
+void BatchNoise2D::setScalarFallback(bool enabled) {
+    s_scalarFallback.store(enabled, std::memory_order_relaxed);
+}
+
+bool BatchNoise2D::isScalarFallback() {
+    return s_scalarFallback.load(std::memory_order_relaxed);
+}
+
+const char* BatchNoise2D::kernelName() {
+#if defined(__GNUC__) && BATCH_NOISE_DISPATCH
+    return hasAvx2() ? "avx2" : "sse2";
+#elif defined(__GNUC__) && defined(__AVX2__)
+    return "avx2";
+#elif defined(__GNUC__) && defined(__SSE2__)
+    return "sse2";
+#elif defined(__GNUC__)
+    return "vector";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace world
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// BatchNoise2D — one 2D OpenSimplex2 layer (single octave or FBm), evaluated LANES points
+// per kernel step.
+//
+// Bit-identical to FastNoiseLite::GetNoise(x, y) with NoiseType_OpenSimplex2, the same seed /
+// frequency / octaves and FastNoiseLite's default gain 0.5, lacunarity 2, weighted strength 0:
+// the kernel repeats FastNoiseLite's float operations in the same order, lane by lane, so
+// terrain generated through it does not change. It is written with GCC vector extensions and
+// compiled twice on x86: for the build's baseline (SSE2, two registers per step) and for AVX2
+// (one register per step), chosen once at run time by CPUID; a -mavx2 build has only the AVX2
+// copy. Other compilers fall back to FastNoiseLite point by point.
+//
+// The kernel does not use FMA, and FastNoiseLite must not either: build without -mfma
+// (or with -ffp-contract=off), otherwise the two paths round differently.
+// ---------------------------------------------------------------------------
+class BatchNoise2D {
+public:
+    static constexpr size_t LANES = 8;
+
+    // `octaves` <= 1 is plain noise (FractalType_None), more is FBm.
+    BatchNoise2D(int seed, float frequency, int octaves = 1);
+
+    // Reference path: FastNoiseLite, one point.
+    float sample(float x, float y) const;
+
+    // out[i] = sample(x[i], y[i]) for i < count. Arrays may have any length; a partial last
+    // step is padded internally.
+    void sample(const float* x, const float* y, float* out, size_t count) const;
+
+    // Routes every batch call through FastNoiseLite (benchmarks / A-B checks). Process-wide.
+    static void setScalarFallback(bool enabled);
+    static bool isScalarFallback();
+
+    // "avx2", "sse2", "vector" or "scalar": what sample(x, y, out, count) runs on here
+    // (build and CPU).
+    static const char* kernelName();
+
+private:
+    void sampleScalar(const float* x, const float* y, float* out, size_t count) const;
+
+    int   m_seed;
+    float m_frequency;
+    int   m_octaves;
+    float m_fractalBounding; // 1 / sum of octave amplitudes, as FastNoiseLite computes it
+};
+
+} // namespace world
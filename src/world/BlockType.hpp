@@ -47,6 +47,8 @@ public:
         registerBlock({4, "sand",  true,  {0.85f, 0.80f, 0.55f, 1.0f}});
         registerBlock({5, "snow",  true,  {0.92f, 0.95f, 1.00f, 1.0f}});
         registerBlock({6, "water", true,  {0.10f, 0.35f, 0.80f, 1.0f}});
+        registerBlock({7, "wood",  true,  {0.40f, 0.25f, 0.10f, 1.0f}});
+        registerBlock({8, "leaves",true,  {0.15f, 0.45f, 0.10f, 1.0f}});
     }
 
     static const std::unordered_map<BlockID, BlockInfo>& all() { return s_blocks; }
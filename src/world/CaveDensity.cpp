@@ -0,0 +1,97 @@
+#include "world/CaveDensity.hpp"
+#include <algorithm>
+// GetNoise(x, y, z) instantiates every 3D generator; GCC flags the (unused here) cellular
+// loops, whose primed coordinates are meant to wrap.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggressive-loop-optimizations"
+#endif
+#include "../vendor/FastNoiseLite.h"
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// CaveLattice
+// ---------------------------------------------------------------------------
+float CaveLattice::densityAt(int x, int y, int z) const {
+    const int   ix = x / STEP, iy = y / STEP, iz = z / STEP;
+    const float fx = (float)(x % STEP) / STEP;
+    const float fy = (float)(y % STEP) / STEP;
+    const float fz = (float)(z % STEP) / STEP;
+
+    auto lerpX = [&](int sy, int sz) {
+        const float a = density[sy][sz][ix];
+        return a + (density[sy][sz][ix + 1] - a) * fx;
+    };
+    const float y0 = lerpX(iy,     iz) + (lerpX(iy,     iz + 1) - lerpX(iy,     iz)) * fz;
+    const float y1 = lerpX(iy + 1, iz) + (lerpX(iy + 1, iz + 1) - lerpX(iy + 1, iz)) * fz;
+    return y0 + (y1 - y0) * fy;
+}
+
+// ---------------------------------------------------------------------------
+// CaveNoise
+// ---------------------------------------------------------------------------
+CaveNoise::CaveNoise(const TerrainConfig& config)
+    : m_noise(std::make_unique<FastNoiseLite>())
+    , m_threshold(config.caveThreshold)
+    , m_squash(config.caveSquash)
+    , m_worldScale(config.worldScale)
+{
+    m_noise->SetSeed(config.seed + 5);
+    m_noise->SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    m_noise->SetFrequency(config.caveFrequency);
+    m_noise->SetFractalType(FastNoiseLite::FractalType_FBm);
+    m_noise->SetFractalOctaves(2);
+}
+
+CaveNoise::~CaveNoise() = default;
+CaveNoise::CaveNoise(CaveNoise&&) noexcept = default;
+CaveNoise& CaveNoise::operator=(CaveNoise&&) noexcept = default;
+
+void CaveNoise::sampleLattice(int cx, int cy, int cz, CaveLattice& out) const {
+    constexpr int STEP    = CaveLattice::STEP;
+    constexpr int SAMPLES = CaveLattice::SAMPLES;
+    constexpr int CELLS   = CaveLattice::CELLS;
+
+    // caveSquash > 1 compresses Y: caverns come out wider than they are tall.
+    const float worldBaseX = (float)(cx * CHUNK_SIZE);
+    const float worldBaseY = (float)(cy * CHUNK_SIZE);
+    const float worldBaseZ = (float)(cz * CHUNK_SIZE);
+    out.threshold  = m_threshold;
+    out.minDensity = out.maxDensity = 0.0f;
+    for (int sy = 0; sy < SAMPLES; ++sy) {
+        const float qy = (worldBaseY + (float)(sy * STEP)) * m_squash / m_worldScale;
+        for (int sz = 0; sz < SAMPLES; ++sz) {
+            const float qz = (worldBaseZ + (float)(sz * STEP)) / m_worldScale;
+            for (int sx = 0; sx < SAMPLES; ++sx) {
+                const float qx = (worldBaseX + (float)(sx * STEP)) / m_worldScale;
+                const float d  = m_noise->GetNoise(qx, qy, qz);
+                out.density[sy][sz][sx] = d;
+                if (sx == 0 && sy == 0 && sz == 0) out.minDensity = out.maxDensity = d;
+                out.minDensity = std::min(out.minDensity, d);
+                out.maxDensity = std::max(out.maxDensity, d);
+            }
+        }
+    }
+
+    for (int y = 0; y < CELLS; ++y) {
+        for (int z = 0; z < CELLS; ++z) {
+            for (int x = 0; x < CELLS; ++x) {
+                float lo = out.density[y][z][x], hi = lo;
+                for (int c = 1; c < 8; ++c) {
+                    const float d = out.density[y + (c >> 2)][z + ((c >> 1) & 1)][x + (c & 1)];
+                    lo = std::min(lo, d);
+                    hi = std::max(hi, d);
+                }
+                out.cells[y][z][x] = hi <= m_threshold ? CaveLattice::Cell::SOLID
+                                   : lo >  m_threshold ? CaveLattice::Cell::CARVED
+                                                       : CaveLattice::Cell::MIXED;
+            }
+        }
+    }
+}
+
+} // namespace world
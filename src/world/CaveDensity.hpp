@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include "world/TerrainNoise.hpp"
+
+class FastNoiseLite;
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// CaveDensity — the 3D density field of the CARVE stage (GenerationStages.hpp): caves and overhangs.
+//
+// One 3D noise field, sampled per chunk on a STEP-spaced 9×9×9 lattice (the 2D ColumnSamples
+// scheme plus Y) and trilinearly upsampled. A solid voxel whose density exceeds
+// TerrainConfig::caveThreshold is carved to AIR. Carving only ever removes blocks, so the
+// heightmap stays an upper bound of the surface and the above-surface early-outs of
+// fillTerrain() hold as before; only the bottom of ColumnHeightmap spans moves down to
+// CAVE_FLOOR_Y, since a cave can open under any column.
+//
+// Trilinear interpolation never leaves the range of a cell's 8 corners, so the lattice also
+// classifies every 4³ cell as SOLID (nothing carved), CARVED (everything carved) or MIXED —
+// only MIXED cells interpolate per voxel, and a deep chunk whose lattice carves nothing is
+// still stored as uniform STONE.
+// ---------------------------------------------------------------------------
+
+// No carving below this world Y: the bottom of the world stays closed.
+constexpr int CAVE_FLOOR_Y = 4;
+// Columns whose surface lies under water keep this many solid blocks below it, so a cave
+// never opens an air pocket into the sea, a lake or a river bed.
+constexpr int CAVE_SEA_ROOF = 4;
+
+struct CaveLattice {
+    static constexpr int STEP    = ColumnSamples::STEP;
+    static constexpr int SAMPLES = ColumnSamples::SAMPLES; // 9 per axis
+    static constexpr int CELLS   = SAMPLES - 1;            // 8 per axis
+
+    enum class Cell : uint8_t { SOLID, CARVED, MIXED };
+
+    float density[SAMPLES][SAMPLES][SAMPLES]; // [y][z][x]
+    Cell  cells  [CELLS][CELLS][CELLS];       // [y][z][x], against `threshold`
+    float minDensity = 0.0f, maxDensity = 0.0f;
+    float threshold  = 0.0f;
+
+    bool carvesNothing() const { return maxDensity <= threshold; }
+    bool carvesAll()     const { return minDensity >  threshold; }
+
+    Cell cellAt(int x, int y, int z) const { return cells[y / STEP][z / STEP][x / STEP]; }
+    // Density at local voxel (x, y, z), trilinear between the corners of its cell.
+    float densityAt(int x, int y, int z) const;
+    // Whether local voxel (x, y, z) is carved: cell class first, interpolation for MIXED only.
+    bool isCarved(int x, int y, int z) const {
+        const Cell c = cellAt(x, y, z);
+        return c == Cell::CARVED || (c == Cell::MIXED && densityAt(x, y, z) > threshold);
+    }
+};
+
+// The 3D cave noise of one TerrainConfig. Owned by TerrainGenerator (one per thread).
+class CaveNoise {
+public:
+    explicit CaveNoise(const TerrainConfig& config);
+    ~CaveNoise();
+    CaveNoise(CaveNoise&&) noexcept;
+    CaveNoise& operator=(CaveNoise&&) noexcept;
+
+    // Samples the lattice of chunk (cx, cy, cz) and classifies its cells.
+    void sampleLattice(int cx, int cy, int cz, CaveLattice& out) const;
+
+private:
+    std::unique_ptr<FastNoiseLite> m_noise;
+    float m_threshold  = 0.0f;
+    float m_squash     = 1.0f;
+    float m_worldScale = 1.0f;
+};
+
+} // namespace world
@@ -3,317 +3,722 @@
 #include <cstring>
 #include <algorithm>
 #include <bit>
+#include <chrono>
 #include <cmath>
-#include <span>
-#include "../vendor/FastNoiseLite.h"
+#include <mutex>
+#include <unordered_map>
+#include "world/DecorationQueue.hpp"
+#include "world/TerrainColumnCache.hpp"
+#include "world/TerrainGenerator.hpp"
 
 namespace world {
 
+uint64_t hashTerrainConfig(const TerrainConfig& config) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&h](auto value) {
+        unsigned char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        for (unsigned char b : bytes) { h ^= b; h *= 0x100000001b3ull; }
+    };
+    mix(config.seed);        mix(config.baseHeight);      mix(config.amplitude);
+    mix(config.octaves);     mix(config.frequency);       mix(config.worldScale);
+    mix(static_cast<uint8_t>(config.islandMode));
+    mix(config.islandFalloff); mix(config.islandEdgeNoise); mix(config.worldRadiusBlks);
+    mix(config.seaLevel);    mix(config.sandMargin);      mix(config.snowHeight);
+    mix(config.mountainStrength); mix(config.stoneErosionThresh);
+    mix(config.desertMoistureThresh);
+    mix(config.riverDepth);  mix(config.riverWidth);
+    mix(static_cast<uint8_t>(config.caves));
+    mix(config.caveFrequency); mix(config.caveThreshold); mix(config.caveSquash);
+    mix(static_cast<uint8_t>(config.trees)); mix(config.treeDensity);
+    return h;
+}
+
 // ---------------------------------------------------------------------------
 // Chunk
 // ---------------------------------------------------------------------------
-Chunk::Chunk(int cx, int cy, int cz) : m_cx(cx), m_cy(cy), m_cz(cz) {}
+Chunk::Chunk(int cx, int cy, int cz)
+    : m_cx(cx), m_cy(cy), m_cz(cz) {}
+
+void Chunk::reset(int cx, int cy, int cz) {
+    {
+        std::lock_guard mipLock(m_mipMutex);
+        m_mip.reset();
+    }
+    {
+        std::unique_lock lock(m_paletteMutex);
+        m_palette.assign(1, VOXEL_AIR);
+        m_indices.clear(); // keep capacity: a recycled chunk usually re-encodes to a similar width
+        m_bits       = 0;
+        m_bitsLog2   = 0;
+        m_payloadLod = 0;
+        invalidateMip();
+    }
+    m_cx = cx; m_cy = cy; m_cz = cz;
+    m_isDirty = true;
+    m_isModified.store(false, std::memory_order_relaxed);
+    m_currentLOD.store(-1, std::memory_order_relaxed);
+    m_state.store(ChunkState::UNGENERATED, std::memory_order_release);
+}
 
 void Chunk::setVoxel(int x, int y, int z, VoxelData v) {
-    m_voxels[idx(x, y, z)] = v;
+    // Edits need every voxel. ChunkStorage refines a reduced chunk from terrain first; this
+    // only guards direct callers.
+    if (isReduced()) expandPayload();
+
+    // Only this (main) thread mutates the palette, so the lookup itself needs no lock.
+    uint32_t p = 0;
+    const uint32_t paletteSize = static_cast<uint32_t>(m_palette.size());
+    while (p < paletteSize && m_palette[p] != v) ++p;
+    if (p == paletteSize) p = addPaletteEntry(v);
+
+    writeIndex(idx(x, y, z), p);
+    invalidateMip(); // after the write: a mip built from the old voxel sees a newer version
     m_isDirty = true;
     m_isModified = true; // Mark as modified by player to save in RAM cache
 }
 
 VoxelData Chunk::getVoxel(int x, int y, int z) const {
-    return m_voxels[idx(x, y, z)];
+    std::shared_lock lock(m_paletteMutex);
+    return getVoxelUnlocked(x, y, z);
 }
 
 void Chunk::fill(VoxelData v) {
-    for (auto& vox : m_voxels) vox = v;
+    {
+        std::unique_lock lock(m_paletteMutex);
+        setUniformUnlocked(v);
+    }
     m_isDirty = true;
 }
 
 // ---------------------------------------------------------------------------
-// Island Generation Helpers
+// Palette storage
 // ---------------------------------------------------------------------------
+void Chunk::setUniformUnlocked(VoxelData v, int lod) {
+    m_palette.assign(1, v);
+    std::vector<uint64_t>().swap(m_indices); // drop the payload allocation entirely
+    m_bits       = 0;
+    m_bitsLog2   = 0;
+    m_payloadLod = static_cast<uint8_t>(lod);
+    invalidateMip();
+}
 
-// Smooth hermite blend (C1 continuity): 0 at t=0, 1 at t=1
-static inline float smoothstep01(float t) {
-    t = std::clamp(t, 0.0f, 1.0f);
-    return t * t * (3.0f - 2.0f * t);
+uint32_t Chunk::readIndex(int i) const {
+    if (m_bits == 0) return 0; // uniform
+    const int perWordLog2 = 6 - m_bitsLog2;
+    const uint64_t word   = m_indices[static_cast<size_t>(i >> perWordLog2)];
+    const int shift       = (i & ((1 << perWordLog2) - 1)) << m_bitsLog2;
+    return static_cast<uint32_t>((word >> shift) & ((uint64_t{1} << m_bits) - 1));
 }
 
-// Returns [0,1]: 1.0 = centre of island, 0.0 = ocean edge.
-// Uses a low-frequency noise offset so the coastline is organic/ragged.
-static float computeIslandMask(float wx, float wz,
-                                const TerrainConfig& cfg,
-                                FastNoiseLite& maskNoise)
-{
-    const float rBlks = static_cast<float>(cfg.worldRadiusBlks);
-    // Normalised distance from world centre: 0 at centre, 1 at edge
-    float nx   = wx / rBlks;
-    float nz   = wz / rBlks;
-    float dist = std::sqrt(nx * nx + nz * nz);
+void Chunk::writeIndex(int i, uint32_t paletteIdx) {
+    if (m_bits == 0) return; // uniform: index 0 is the only value, nothing to store
+    const int perWordLog2 = 6 - m_bitsLog2;
+    uint64_t& word        = m_indices[static_cast<size_t>(i >> perWordLog2)];
+    const int shift       = (i & ((1 << perWordLog2) - 1)) << m_bitsLog2;
+    const uint64_t mask   = ((uint64_t{1} << m_bits) - 1) << shift;
+    word = (word & ~mask) | ((static_cast<uint64_t>(paletteIdx) << shift) & mask);
+}
 
-    // Low-frequency warp makes the shoreline non-circular
-    float warp = maskNoise.GetNoise(wx, wz);  // maskNoise freq ≈ 0.003
-    float raggedDist = dist - warp * cfg.islandEdgeNoise;
+void Chunk::repack(uint8_t newBits) {
+    const int volume = payloadVolume();
+    std::vector<uint64_t> packed(static_cast<size_t>(volume) * newBits / 64, 0);
+    const int newLog2     = std::countr_zero(static_cast<unsigned>(newBits));
+    const int perWordLog2 = 6 - newLog2;
+    for (int i = 0; i < volume; ++i) {
+        const int shift = (i & ((1 << perWordLog2) - 1)) << newLog2;
+        packed[static_cast<size_t>(i >> perWordLog2)] |= static_cast<uint64_t>(readIndex(i)) << shift;
+    }
+    m_indices.swap(packed);
+    m_bits     = newBits;
+    m_bitsLog2 = static_cast<uint8_t>(newLog2);
+}
+
+uint32_t Chunk::addPaletteEntry(VoxelData v) {
+    std::unique_lock lock(m_paletteMutex);
+
+    // Edits never remove palette entries. At the 16-bit ceiling rebuild a tight palette
+    // from the live voxels first (at most CHUNK_VOLUME distinct values, so this always fits).
+    if (m_palette.size() >= (size_t{1} << 16)) {
+        static thread_local VoxelData tl_compact[CHUNK_VOLUME];
+        for (int i = 0; i < CHUNK_VOLUME; ++i) tl_compact[i] = m_palette[readIndex(i)];
+        lock.unlock();
+        encodeVoxels(tl_compact);
+        lock.lock();
+        for (uint32_t p = 0; p < m_palette.size(); ++p)
+            if (m_palette[p] == v) return p;
+    }
 
-    // Smooth falloff: full land inside falloff, ocean beyond 1.1
-    float t = (raggedDist - cfg.islandFalloff) / (1.1f - cfg.islandFalloff);
-    return 1.0f - smoothstep01(t);
+    const uint32_t p = static_cast<uint32_t>(m_palette.size());
+    if (p >= (uint32_t{1} << m_bits)) {
+        // Uniform chunks upgrade lazily to 1 bit on the first differing write.
+        repack(static_cast<uint8_t>(m_bits == 0 ? 1 : m_bits * 2));
+    }
+    m_palette.push_back(v);
+    return p;
 }
 
-// (getBaseHeight removed — height formula is now inlined in fillTerrain
-//  as a blend of plainH and mountH, controlled by erosion noise.)
+// Unpacks `count` indices at a fixed width. PER_WORD indices per 64-bit word, LSB first.
+template <int BITS>
+static void decodePacked(const uint64_t* words, const VoxelData* palette, VoxelData* out, int count) {
+    constexpr int      PER_WORD = 64 / BITS;
+    constexpr uint64_t MASK     = (uint64_t{1} << BITS) - 1;
+    for (int w = 0; w < count / PER_WORD; ++w) {
+        uint64_t word = words[w];
+        VoxelData* dst = out + w * PER_WORD;
+        for (int k = 0; k < PER_WORD; ++k) {
+            dst[k] = palette[word & MASK];
+            word >>= BITS;
+        }
+    }
+}
+
+// Inverse of decodePacked(): packs PER_WORD palette indices per 64-bit word, LSB first.
+template <int BITS>
+static void encodePacked(const uint16_t* indices, uint64_t* words, int count) {
+    constexpr int PER_WORD = 64 / BITS;
+    for (int w = 0; w < count / PER_WORD; ++w) {
+        const uint16_t* src = indices + w * PER_WORD;
+        uint64_t word = 0;
+        for (int k = PER_WORD - 1; k >= 0; --k) {
+            word = (word << BITS) | src[k];
+        }
+        words[w] = word;
+    }
+}
+
+void Chunk::decodeVoxels(VoxelData* out) const {
+    std::shared_lock lock(m_paletteMutex);
+    if (m_palette.size() == 1) {
+        std::fill_n(out, CHUNK_VOLUME, m_palette[0]);
+        return;
+    }
+    // A reduced payload is unpacked into scratch first, then replicated block by block.
+    static thread_local VoxelData tl_reduced[CHUNK_VOLUME / 8];
+    const int volume = payloadVolume();
+    VoxelData* dst   = m_payloadLod == 0 ? out : tl_reduced;
+
+    const uint64_t*  words   = m_indices.data();
+    const VoxelData* palette = m_palette.data();
+    switch (m_bits) {
+        case 1:  decodePacked<1> (words, palette, dst, volume); break;
+        case 2:  decodePacked<2> (words, palette, dst, volume); break;
+        case 4:  decodePacked<4> (words, palette, dst, volume); break;
+        case 8:  decodePacked<8> (words, palette, dst, volume); break;
+        default: decodePacked<16>(words, palette, dst, volume); break;
+    }
+    if (m_payloadLod == 0) return;
+
+    const int step = 1 << m_payloadLod;
+    const int size = CHUNK_SIZE >> m_payloadLod;
+    for (int z = 0; z < size; ++z) {
+        for (int y = 0; y < size; ++y) {
+            // Widen one reduced row, then copy it to the step × step full rows it covers.
+            VoxelData* row = &out[idx(0, y * step, z * step)];
+            const VoxelData* src = &tl_reduced[y * size + z * size * size];
+            for (int x = 0; x < CHUNK_SIZE; ++x) row[x] = src[x >> m_payloadLod];
+            for (int dz = 0; dz < step; ++dz)
+                for (int dy = 0; dy < step; ++dy)
+                    if (dz | dy) std::copy_n(row, CHUNK_SIZE, &out[idx(0, y * step + dy, z * step + dz)]);
+        }
+    }
+}
+
+void Chunk::encodeVoxels(const VoxelData* in, int lod) {
+    encodePayload(in, lod, false);
+}
+
+int Chunk::getPayloadLod() const {
+    std::shared_lock lock(m_paletteMutex);
+    return m_payloadLod;
+}
+
+void Chunk::expandPayload() {
+    static thread_local VoxelData tl_full[CHUNK_VOLUME];
+    decodeVoxels(tl_full);
+    encodePayload(tl_full, 0, true);
+}
+
+bool Chunk::applyDecoration(const std::vector<DecorationWrite>& writes) {
+    static thread_local VoxelData tl_full[CHUNK_VOLUME];
+    static thread_local VoxelData tl_reduced[CHUNK_VOLUME / 8];
+    const int lod  = getPayloadLod();
+    const int mask = (1 << lod) - 1;
+
+    // Most deliveries carry writes the chunk already collected: check them before decoding.
+    {
+        std::shared_lock lock(m_paletteMutex);
+        const bool any = std::any_of(writes.begin(), writes.end(), [&](const DecorationWrite& w) {
+            const int x = w.index % CHUNK_SIZE, y = (w.index / CHUNK_SIZE) % CHUNK_SIZE, z = w.index / (CHUNK_SIZE * CHUNK_SIZE);
+            return !((x | y | z) & mask) && decorationReplaces(getVoxelUnlocked(x, y, z), w.voxel);
+        });
+        if (!any) return false;
+    }
+
+    bool decoded = false, changed = false;
+    for (const DecorationWrite& w : writes) {
+        const int x = w.index % CHUNK_SIZE, y = (w.index / CHUNK_SIZE) % CHUNK_SIZE, z = w.index / (CHUNK_SIZE * CHUNK_SIZE);
+        if ((x | y | z) & mask) continue;
+        if (!decoded) { decodeVoxels(tl_full); decoded = true; }
+        if (!decorationReplaces(tl_full[w.index], w.voxel)) continue;
+        tl_full[w.index] = w.voxel;
+        changed = true;
+    }
+    if (!changed) return false;
+
+    if (lod == 0) {
+        encodePayload(tl_full, 0, false);
+    } else {
+        const int size = CHUNK_SIZE >> lod;
+        for (int z = 0; z < size; ++z)
+            for (int y = 0; y < size; ++y)
+                for (int x = 0; x < size; ++x)
+                    tl_reduced[x + y * size + z * size * size] = tl_full[idx(x << lod, y << lod, z << lod)];
+        encodePayload(tl_reduced, lod, false);
+    }
+    return true;
+}
+
+bool Chunk::encodePayload(const VoxelData* in, int lod, bool onlyIfCoarser) {
+    // Build a tight palette. Terrain runs along X are long, so a last-value cache resolves
+    // most voxels; the linear scan only sees the handful of distinct terrain materials.
+    static thread_local std::vector<VoxelData> tl_palette;
+    static thread_local std::vector<uint16_t>  tl_indices;
+    static thread_local std::unordered_map<uint32_t, uint16_t> tl_lookup;
+    constexpr size_t LINEAR_PALETTE_SCAN = 32;
+    const int volume = CHUNK_VOLUME >> (3 * lod);
+    tl_palette.clear();
+    tl_indices.resize(static_cast<size_t>(volume));
+
+    VoxelData lastValue = in[0];
+    uint16_t  lastIndex = 0;
+    tl_palette.push_back(lastValue);
+    for (int i = 0; i < volume; ++i) {
+        const VoxelData v = in[i];
+        if (v != lastValue) {
+            size_t p = 0;
+            if (tl_palette.size() <= LINEAR_PALETTE_SCAN) {
+                while (p < tl_palette.size() && tl_palette[p] != v) ++p;
+                if (p == tl_palette.size()) {
+                    tl_palette.push_back(v);
+                    if (tl_palette.size() > LINEAR_PALETTE_SCAN) {
+                        // Noisy payload: switch to a hashed lookup for the rest of the pass.
+                        tl_lookup.clear();
+                        for (size_t k = 0; k < tl_palette.size(); ++k)
+                            tl_lookup.emplace(tl_palette[k].raw, static_cast<uint16_t>(k));
+                    }
+                }
+            } else {
+                auto [it, inserted] = tl_lookup.emplace(v.raw, static_cast<uint16_t>(tl_palette.size()));
+                if (inserted) tl_palette.push_back(v);
+                p = it->second;
+            }
+            lastValue = v;
+            lastIndex = static_cast<uint16_t>(p);
+        }
+        tl_indices[static_cast<size_t>(i)] = lastIndex;
+    }
+
+    if (tl_palette.size() == 1) {
+        {
+            std::unique_lock lock(m_paletteMutex);
+            if (onlyIfCoarser && m_payloadLod <= lod) return false;
+            setUniformUnlocked(tl_palette[0], lod);
+        }
+        m_isDirty = true;
+        return true;
+    }
+
+    uint8_t bits = 1;
+    while ((size_t{1} << bits) < tl_palette.size()) bits = static_cast<uint8_t>(bits * 2);
+    const int bitsLog2 = std::countr_zero(static_cast<unsigned>(bits));
+
+    // Pack into per-thread scratch, then copy under the lock: assign() reuses the chunk's
+    // existing index capacity, so regenerating a recycled chunk does not hit the heap.
+    static thread_local std::vector<uint64_t> tl_packed;
+    const size_t wordCount = static_cast<size_t>(volume) * bits / 64;
+    tl_packed.resize(wordCount);
+    switch (bits) {
+        case 1:  encodePacked<1> (tl_indices.data(), tl_packed.data(), volume); break;
+        case 2:  encodePacked<2> (tl_indices.data(), tl_packed.data(), volume); break;
+        case 4:  encodePacked<4> (tl_indices.data(), tl_packed.data(), volume); break;
+        case 8:  encodePacked<8> (tl_indices.data(), tl_packed.data(), volume); break;
+        default: encodePacked<16>(tl_indices.data(), tl_packed.data(), volume); break;
+    }
+
+    {
+        std::unique_lock lock(m_paletteMutex);
+        if (onlyIfCoarser && m_payloadLod <= lod) return false;
+        m_palette.assign(tl_palette.begin(), tl_palette.end());
+        m_indices.assign(tl_packed.begin(), tl_packed.begin() + static_cast<std::ptrdiff_t>(wordCount));
+        m_bits       = bits;
+        m_bitsLog2   = static_cast<uint8_t>(bitsLog2);
+        m_payloadLod = static_cast<uint8_t>(lod);
+        invalidateMip();
+    }
+    m_isDirty = true;
+    return true;
+}
+
+int Chunk::getPaletteBits() const {
+    std::shared_lock lock(m_paletteMutex);
+    return m_bits;
+}
+
+size_t Chunk::getPaletteSize() const {
+    std::shared_lock lock(m_paletteMutex);
+    return m_palette.size();
+}
+
+size_t Chunk::getVoxelBytes() const {
+    std::shared_lock lock(m_paletteMutex);
+    return m_palette.capacity() * sizeof(VoxelData) + m_indices.capacity() * sizeof(uint64_t);
+}
+
+bool Chunk::isUniform() const {
+    std::shared_lock lock(m_paletteMutex);
+    return m_bits == 0;
+}
+
+VoxelData Chunk::getUniformVoxel() const {
+    std::shared_lock lock(m_paletteMutex);
+    return m_palette[0];
+}
 
 // ---------------------------------------------------------------------------
-// fillTerrain — island + biomes (erosion / rivers / moisture) + water
+// Voxel mip chain — reduced grids for LOD meshing
+//
+// levels[l] is the (CHUNK_SIZE >> l)³ grid of LOD l as 8-bit indices into a copy of the chunk
+// palette, for the requested LOD and every coarser one (the finer levels it was reduced
+// through are freed; the payload itself is the finest). Payloads with more than 256 palette
+// entries get no mip and are reduced cell by cell. Immutable once built: mesh workers hold
+// the shared_ptr while they read, a payload change makes the next acquireMip() build a new one.
 // ---------------------------------------------------------------------------
-void Chunk::fillTerrain(const TerrainConfig& config, FastNoiseLite* /*extNoise*/) {
-
-    // ---- Voxel constants ---------------------------------------------------
-    const VoxelData vStone = VoxelData::make(1, 255, 0, VOXEL_FLAG_SOLID);
-    const VoxelData vGrass = VoxelData::make(2, 255, 0, VOXEL_FLAG_SOLID);
-    const VoxelData vDirt  = VoxelData::make(3, 255, 0, VOXEL_FLAG_SOLID);
-    const VoxelData vSand  = VoxelData::make(4, 255, 0, VOXEL_FLAG_SOLID);
-    const VoxelData vSnow  = VoxelData::make(5, 255, 0, VOXEL_FLAG_SOLID);
-    const VoxelData vWater = VoxelData::make(6, 255, 0, VOXEL_FLAG_SOLID | VOXEL_FLAG_LIQUID);
-
-    // ---- Noise layer 1: Base terrain (FBm) ---------------------------------
-    FastNoiseLite terrainNoise;
-    terrainNoise.SetSeed(config.seed);
-    terrainNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    terrainNoise.SetFractalType(FastNoiseLite::FractalType_FBm);
-    terrainNoise.SetFractalOctaves(config.octaves);
-    terrainNoise.SetFrequency(config.frequency);
-
-    // ---- Noise layer 2: Island mask warp (very low frequency) ---------------
-    FastNoiseLite maskNoise;
-    maskNoise.SetSeed(config.seed + 1);
-    maskNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    maskNoise.SetFrequency(0.003f);
-
-    // ---- Noise layer 3: Erosion — flat plains vs sharp mountains (medium freq) --
-    FastNoiseLite erosionNoise;
-    erosionNoise.SetSeed(config.seed + 2);
-    erosionNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    erosionNoise.SetFractalType(FastNoiseLite::FractalType_FBm);
-    erosionNoise.SetFractalOctaves(4);
-    erosionNoise.SetFrequency(0.006f); // large-scale mountain/plain zones
-
-    // ---- Noise layer 4: River carving (ridged — trench where |n| < riverWidth) --
-    FastNoiseLite riverNoise;
-    riverNoise.SetSeed(config.seed + 3);
-    riverNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    riverNoise.SetFractalType(FastNoiseLite::FractalType_FBm);
-    riverNoise.SetFractalOctaves(3);
-    riverNoise.SetFrequency(0.004f);
-
-    // ---- Noise layer 5: Moisture — desert (dry) vs forest/plains (wet) ------
-    FastNoiseLite moistureNoise;
-    moistureNoise.SetSeed(config.seed + 4);
-    moistureNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    moistureNoise.SetFrequency(0.005f);
-
-    // ---- World-space origins of this chunk ---------------------------------
-    const int worldBaseX = m_cx * CHUNK_SIZE;
-    const int worldBaseY = m_cy * CHUNK_SIZE;
-    const int worldBaseZ = m_cz * CHUNK_SIZE;
-
-    // ---- Sample all noise layers at low-res grid (STEP=4, SAMPLES=9) -------
-    constexpr int STEP    = 4;
-    constexpr int SAMPLES = CHUNK_SIZE / STEP + 1; // 9×9 sample grid
-
-    float sH[SAMPLES][SAMPLES]; // final terrain height
-    float sE[SAMPLES][SAMPLES]; // erosion [0,1]:  0=plain, 1=mountain
-    float sR[SAMPLES][SAMPLES]; // river carve [0,1]: 1=deepest trench
-    float sM[SAMPLES][SAMPLES]; // moisture [-1,1]: -1=desert, +1=tropical
-
-    const float riverFloor = (float)(config.seaLevel - config.riverDepth);
-    const float rWidth     = std::max(config.riverWidth, 0.005f);
-    const float oceanFloor = (float)(config.seaLevel - 20);
-
-    for (int sz = 0; sz < SAMPLES; ++sz) {
-        for (int sx = 0; sx < SAMPLES; ++sx) {
-            const float wx = (float)(worldBaseX + sx * STEP);
-            const float wz = (float)(worldBaseZ + sz * STEP);
-            const float qx = wx / config.worldScale; // scaled coords for terrain
-            const float qz = wz / config.worldScale;
-
-            // Island mask [0,1] — 1=island interior, 0=open ocean
-            const float mask   = computeIslandMask(wx, wz, config, maskNoise);
-
-            // Base terrain noise in [-1, 1]
-            const float terrN  = terrainNoise.GetNoise(qx, qz);
-
-            // Erosion [0,1]: capped at island edges so coast is always flat
-            const float rawE   = (erosionNoise.GetNoise(qx, qz) + 1.0f) * 0.5f;
-            const float erode  = rawE * smoothstep01(mask * 1.6f);
-
-            // Moisture [-1, 1]
-            const float moist  = moistureNoise.GetNoise(wx, wz);
-
-            // --- Height formula ---
-            // Plains contribution: gentle hills (40% amplitude)
-            const float plainH = (float)config.baseHeight + terrN * config.amplitude * 0.40f;
-
-            // Mountain contribution: squared noise → sharp peaks
-            // absN²*2.2 reaches ~2.2 at |terrN|=1; subtract 0.25 to keep low
-            // areas from also rising
-            const float absN   = std::abs(terrN);
-            const float mountH = (float)config.baseHeight
-                                 + (absN * absN * 2.2f - 0.25f)
-                                 * config.amplitude * config.mountainStrength;
-
-            // Blend plains↔mountains by erosion
-            const float blendH = plainH + (mountH - plainH) * erode;
-
-            // Apply island mask → lerp toward ocean floor at edges
-            float finalH = oceanFloor + (blendH - oceanFloor) * mask;
-
-            // --- River carving ---
-            // Ridged: |riverNoise| is small near river centrelines
-            const float rn     = std::abs(riverNoise.GetNoise(qx, qz));
-            float rAmt         = std::max(0.0f, 1.0f - rn / rWidth); // 0→1
-            rAmt               = rAmt * rAmt; // sharpen profile
-            // Only carve rivers where island exists (not in city ocean zone)
-            const float coastBlend = std::clamp((mask - 0.25f) / 0.35f, 0.0f, 1.0f);
-            rAmt                  *= coastBlend;
-            // Pull height toward river floor
-            finalH = finalH + (riverFloor - finalH) * rAmt;
-
-            sH[sz][sx] = finalH;
-            sE[sz][sx] = erode;
-            sR[sz][sx] = rAmt;
-            sM[sz][sx] = moist;
+static constexpr int MAX_MIP_LOD = 2;
+
+struct VoxelMip {
+    uint32_t               version = 0; // Chunk::m_payloadVersion it was built from
+    std::vector<VoxelData> palette;
+    std::vector<uint8_t>   levels[MAX_MIP_LOD + 1];
+
+    bool has(int lod) const { return !levels[lod].empty(); }
+    VoxelData cell(int lod, int gx, int gy, int gz) const {
+        const int g = CHUNK_SIZE >> lod;
+        return palette[levels[lod][static_cast<size_t>(gx + gy * g + gz * g * g)]];
+    }
+    size_t bytes() const {
+        size_t b = palette.capacity() * sizeof(VoxelData);
+        for (const auto& level : levels) b += level.capacity() * sizeof(uint8_t);
+        return b;
+    }
+};
+
+// Surface priority of a mip child: opaque beats translucent beats anything else (AIR).
+static int mipRank(VoxelData v) { return v.isOpaque() ? 2 : v.isTranslucent() ? 1 : 0; }
+
+// One output row of a mip level: out[x] from the 2×2×2 children in `rows`, given in priority
+// order (upper before lower, then lower z). Surface priority by rank (mipRank() of each
+// palette entry); among equal ranks the earlier row wins (grass over dirt), then lower x. A
+// one-block wall, trunk or water layer survives the reduction wherever it sits in the block
+// instead of appearing only when it crosses the block origin.
+// Branchless: each child is keyed (rank, order, palette index) and the cell keeps the max key.
+static void reduceRow(const uint8_t* const (&rows)[4], int g, const uint8_t* rank, uint8_t* out)
+{
+    auto key = [rank](uint8_t p, uint32_t order) {
+        return static_cast<uint32_t>(rank[p]) << 11 | order << 8 | p;
+    };
+    for (int x = 0; x < g; ++x) {
+        uint32_t best = 0;
+        for (int r = 0; r < 4; ++r) {
+            const uint32_t order = 7u - 2u * static_cast<uint32_t>(r);
+            best = std::max(best, key(rows[r][2 * x], order));
+            best = std::max(best, key(rows[r][2 * x + 1], order - 1));
         }
+        out[x] = static_cast<uint8_t>(best & 0xFFu);
     }
+}
 
-    // ---- Bilinear interpolation into full-res chunk maps -------------------
-    float heightmap[CHUNK_SIZE][CHUNK_SIZE];
-    float erodemap [CHUNK_SIZE][CHUNK_SIZE];
-    float rivermap [CHUNK_SIZE][CHUNK_SIZE];
-    float moistmap [CHUNK_SIZE][CHUNK_SIZE];
-
-    for (int sz = 0; sz < SAMPLES - 1; ++sz) {
-        for (int sx = 0; sx < SAMPLES - 1; ++sx) {
-            // Cache the 4 corners for each field once
-            const float H00=sH[sz][sx], H10=sH[sz][sx+1], H01=sH[sz+1][sx], H11=sH[sz+1][sx+1];
-            const float E00=sE[sz][sx], E10=sE[sz][sx+1], E01=sE[sz+1][sx], E11=sE[sz+1][sx+1];
-            const float R00=sR[sz][sx], R10=sR[sz][sx+1], R01=sR[sz+1][sx], R11=sR[sz+1][sx+1];
-            const float M00=sM[sz][sx], M10=sM[sz][sx+1], M01=sM[sz+1][sx], M11=sM[sz+1][sx+1];
-
-            for (int dz = 0; dz < STEP; ++dz) {
-                const float tz = (float)dz / STEP;
-                // Lerp along Z for each field
-                const float hH0 = H00 + (H01-H00)*tz,  hH1 = H10 + (H11-H10)*tz;
-                const float hE0 = E00 + (E01-E00)*tz,  hE1 = E10 + (E11-E10)*tz;
-                const float hR0 = R00 + (R01-R00)*tz,  hR1 = R10 + (R11-R10)*tz;
-                const float hM0 = M00 + (M01-M00)*tz,  hM1 = M10 + (M11-M10)*tz;
-
-                for (int dx = 0; dx < STEP; ++dx) {
-                    const int gx = sx * STEP + dx;
-                    const int gz = sz * STEP + dz;
-                    if (gx >= CHUNK_SIZE || gz >= CHUNK_SIZE) continue;
-                    const float tx = (float)dx / STEP;
-                    heightmap[gz][gx] = hH0 + (hH1-hH0)*tx;
-                    erodemap [gz][gx] = hE0 + (hE1-hE0)*tx;
-                    rivermap [gz][gx] = hR0 + (hR1-hR0)*tx;
-                    moistmap [gz][gx] = hM0 + (hM1-hM0)*tx;
-                }
+// One mip level: every cell of the (srcSize / 2)³ grid from its 2×2×2 children in `src`.
+static void reduceSurfacePriority(const uint8_t* src, int srcSize, const uint8_t* rank,
+                                  std::vector<uint8_t>& dst)
+{
+    const int g = srcSize / 2;
+    dst.resize(static_cast<size_t>(g) * g * g);
+    for (int z = 0; z < g; ++z) {
+        for (int y = 0; y < g; ++y) {
+            const uint8_t* const rows[4] = {
+                &src[(2 * y + 1) * srcSize + (2 * z)     * srcSize * srcSize],
+                &src[(2 * y + 1) * srcSize + (2 * z + 1) * srcSize * srcSize],
+                &src[(2 * y)     * srcSize + (2 * z)     * srcSize * srcSize],
+                &src[(2 * y)     * srcSize + (2 * z + 1) * srcSize * srcSize],
+            };
+            reduceRow(rows, g, rank, &dst[static_cast<size_t>(y * g + z * g * g)]);
+        }
+    }
+}
+
+// The first mip level straight from the packed payload (BITS <= 8), without unpacking it
+// first. Each output row reads two runs of the payload: rows 2y and 2y + 1 at z = 2z' and at
+// z = 2z' + 1, each run contiguous. A run holding a single palette index (air above the
+// surface, stone below it) is recognised from its words; when both are, the row is one
+// index. Only mixed rows are unpacked and reduced with reduceRow().
+template <int BITS>
+static void reducePacked(const uint64_t* words, int srcSize, const uint8_t* rank, std::vector<uint8_t>& dst)
+{
+    static_assert(BITS <= 8 && 64 % BITS == 0);
+    constexpr int      PER_WORD = 64 / BITS;
+    constexpr uint64_t MASK     = (uint64_t{1} << BITS) - 1;
+    constexpr uint64_t REPEAT   = ~uint64_t{0} / MASK; // 1 in every BITS-wide field
+    const int g       = srcSize / 2;
+    const int runSize = 2 * srcSize; // voxels; a multiple of 32 bits that starts on a multiple of itself
+
+    // The palette index every voxel of the run at voxel `i` holds, or -1 if they differ.
+    auto uniform = [words, runSize](size_t i) -> int {
+        const size_t   bit   = i * BITS;
+        const uint64_t first = words[bit >> 6] >> (bit & 63);
+        const uint64_t value = first & MASK;
+        if (runSize < PER_WORD) {
+            const uint64_t runMask = (uint64_t{1} << (runSize * BITS)) - 1;
+            return ((first ^ value * REPEAT) & runMask) == 0 ? static_cast<int>(value) : -1;
+        }
+        for (int k = 0; k < runSize / PER_WORD; ++k)
+            if (words[(bit >> 6) + k] != value * REPEAT) return -1;
+        return static_cast<int>(value);
+    };
+    // The palette indices of one run, in order.
+    auto unpackRun = [words, runSize](size_t i, uint8_t* out) {
+        const size_t bit = i * BITS;
+        if (runSize < PER_WORD) {
+            uint64_t word = words[bit >> 6] >> (bit & 63);
+            for (int k = 0; k < runSize; ++k, word >>= BITS) out[k] = static_cast<uint8_t>(word & MASK);
+            return;
+        }
+        for (int w = 0; w < runSize / PER_WORD; ++w) {
+            uint64_t word = words[(bit >> 6) + w];
+            for (int k = 0; k < PER_WORD; ++k, word >>= BITS) out[w * PER_WORD + k] = static_cast<uint8_t>(word & MASK);
+        }
+    };
+
+    dst.resize(static_cast<size_t>(g) * g * g);
+    uint8_t nearRun[64], farRun[64];
+    const uint8_t* const rows[4] = { nearRun + srcSize, farRun + srcSize, nearRun, farRun };
+    for (int z = 0; z < g; ++z) {
+        for (int y = 0; y < g; ++y) {
+            uint8_t*     out  = &dst[static_cast<size_t>(y * g + z * g * g)];
+            const size_t near = static_cast<size_t>((2 * y) * srcSize + (2 * z)     * srcSize * srcSize);
+            const size_t far  = static_cast<size_t>((2 * y) * srcSize + (2 * z + 1) * srcSize * srcSize);
+            const int a = uniform(near);
+            const int b = a >= 0 ? uniform(far) : -1;
+            if (b >= 0) {
+                // The near run holds the top child of every cell: it wins unless outranked.
+                std::fill_n(out, g, static_cast<uint8_t>(rank[b] > rank[a] ? b : a));
+                continue;
             }
+            unpackRun(near, nearRun);
+            unpackRun(far, farRun);
+            reduceRow(rows, g, rank, out);
         }
     }
+}
 
-    // ---- Fill voxels -------------------------------------------------------
-    std::ranges::fill(m_voxels, VOXEL_AIR);
+std::shared_ptr<const VoxelMip> Chunk::acquireMip(int lod) const
+{
+    if (lod <= 0) return nullptr;
+    lod = std::min(lod, MAX_MIP_LOD);
+    // Read before the payload: a write that lands during the build leaves a newer version.
+    const uint32_t version = m_payloadVersion.load(std::memory_order_acquire);
+
+    std::lock_guard mipLock(m_mipMutex);
+    if (m_mip && m_mip->version == version && m_mip->has(lod)) return m_mip;
+    if (m_mip && m_mip->version != version) m_mip.reset(); // stale — drop it even if none is built
+
+    static thread_local std::vector<uint8_t> tl_rank;
+    std::shared_ptr<VoxelMip> mip;
+    int baseLod = 0;
+    {
+        std::shared_lock lock(m_paletteMutex);
+        if (m_bits == 0 || m_payloadLod >= lod) return nullptr; // the payload is the grid
+        if (m_bits > 8) return nullptr;                         // no 8-bit levels: reduced per cell
+        baseLod = m_payloadLod;
+        mip = std::make_shared<VoxelMip>();
+        mip->version = version;
+        mip->palette = m_palette;
+
+        tl_rank.resize(m_palette.size());
+        for (size_t p = 0; p < m_palette.size(); ++p) tl_rank[p] = static_cast<uint8_t>(mipRank(m_palette[p]));
+
+        // The level above the payload, read from the packed words in place.
+        const uint64_t* words   = m_indices.data();
+        const int       srcSize = CHUNK_SIZE >> baseLod;
+        std::vector<uint8_t>& first = mip->levels[baseLod + 1];
+        switch (m_bits) {
+            case 1:  reducePacked<1>(words, srcSize, tl_rank.data(), first); break;
+            case 2:  reducePacked<2>(words, srcSize, tl_rank.data(), first); break;
+            case 4:  reducePacked<4>(words, srcSize, tl_rank.data(), first); break;
+            default: reducePacked<8>(words, srcSize, tl_rank.data(), first); break;
+        }
+    }
 
-    for (int z = 0; z < CHUNK_SIZE; ++z) {
-        for (int x = 0; x < CHUNK_SIZE; ++x) {
-            const int   terrainH = (int)heightmap[z][x];
-            const float erode01  = erodemap[z][x];    // [0,1]: 0=flat plain, 1=sharp mountain
-            [[maybe_unused]]
-            const float rAmt     = rivermap[z][x];    // river carve strength
-            const float moist    = moistmap[z][x];    // [-1,1]: -1=dry, +1=wet
-
-            // ---------------------------------------------------------------
-            // Biome flags  (in priority order)
-            // ---------------------------------------------------------------
-
-            // Rocky cliff: very high erosion → bare stone face, grass cannot grip
-            const bool isRockyCliff = (erode01 > config.stoneErosionThresh);
-
-            // Desert: dry moisture AND not too high (low-elevation sandy zone)
-            const bool isDesert = (moist < config.desertMoistureThresh)
-                               && (terrainH < config.seaLevel + 50);
-
-            // Beach: within sandMargin blocks of sea level
-            const bool isBeach = (terrainH <= config.seaLevel + config.sandMargin);
-
-            // Snow cap: surface is above snowHeight
-            const bool isSnowCap = (terrainH > config.snowHeight);
-
-            // ---------------------------------------------------------------
-            // 4-level column layering:
-            //
-            //  Plain / grassy mountain          Rocky cliff      Desert / Beach
-            //  ─────────────────────────        ─────────────    ──────────────
-            //  depth 1 : GRASS (or SNOW cap)    STONE            SAND
-            //  depth 2-4: DIRT  (or STONE cap)  STONE            SAND
-            //  depth 5+: STONE                  STONE            STONE
-            //
-            //  Snow cap override (terrainH > snowHeight):
-            //    depth 1   → SNOW
-            //    depth 2-3 → STONE  (rock just below snowfield, no dirt)
-            //    depth 4+  → STONE
-            // ---------------------------------------------------------------
-
-            for (int y = 0; y < CHUNK_SIZE; ++y) {
-                const int wy    = worldBaseY + y;
-                VoxelData v     = VOXEL_AIR;
-
-                if (wy < terrainH) {
-                    const int depth = terrainH - wy;  // 1=surface, 2=one below, …
-
-                    if (isSnowCap) {
-                        // Snow cap: SNOW on top, immediate stone underneath
-                        if      (depth == 1) v = vSnow;
-                        else                 v = vStone;
-
-                    } else if (isRockyCliff) {
-                        // Bare cliff: all stone
-                        v = vStone;
-
-                    } else if (isDesert || isBeach) {
-                        // Sandy biome: sand surface + sand subsurface, then stone
-                        if   (depth <= 4) v = vSand;
-                        else              v = vStone;
-
-                    } else {
-                        // Normal grassy land (plains AND grassy mountain slopes):
-                        // GRASS → DIRT (4 blocks) → STONE
-                        if      (depth == 1) v = vGrass;
-                        else if (depth <= 5) v = vDirt;
-                        else                 v = vStone;
-                    }
+    // Every coarser level from the one below it (8× cheaper each); levels finer than `lod` were
+    // only the input and are not kept.
+    for (int l = baseLod + 2; l <= MAX_MIP_LOD; ++l) {
+        reduceSurfacePriority(mip->levels[l - 1].data(), CHUNK_SIZE >> (l - 1), tl_rank.data(), mip->levels[l]);
+    }
+    for (int l = baseLod + 1; l < lod; ++l) std::vector<uint8_t>().swap(mip->levels[l]);
+    m_mip = mip;
+    return mip;
+}
 
-                } else if (wy < config.seaLevel) {
-                    v = vWater;
-                }
+std::shared_ptr<const VoxelMip> Chunk::cachedMip(int lod) const
+{
+    if (lod <= 0) return nullptr;
+    const uint32_t version = m_payloadVersion.load(std::memory_order_acquire);
+    std::lock_guard mipLock(m_mipMutex);
+    if (m_mip && m_mip->version == version && m_mip->has(std::min(lod, MAX_MIP_LOD))) return m_mip;
+    return nullptr;
+}
 
-                m_voxels[idx(x, y, z)] = v;
+VoxelData Chunk::gridCellUnlocked(const VoxelMip* mip, int lod, int gx, int gy, int gz) const {
+    if (mip) return mip->cell(lod, gx, gy, gz);
+    if (lod <= m_payloadLod) return getVoxelUnlocked(gx << lod, gy << lod, gz << lod);
+
+    // No cached level: reduce this cell's children on the fly, like reduceSurfacePriority().
+    VoxelData best     = VOXEL_AIR;
+    int       bestRank = -1;
+    for (int dy = 1; dy >= 0; --dy) {
+        for (int dz = 0; dz < 2; ++dz) {
+            for (int dx = 0; dx < 2; ++dx) {
+                const VoxelData v = gridCellUnlocked(nullptr, lod - 1, 2 * gx + dx, 2 * gy + dy, 2 * gz + dz);
+                const int rank = mipRank(v);
+                if (rank > bestRank) { best = v; bestRank = rank; }
             }
         }
     }
-    m_isDirty = true;
+    return best;
+}
+
+void Chunk::decodeGrid(VoxelData* out, int lod, const VoxelMip* mip) const {
+    if (mip) {
+        const std::vector<uint8_t>& level = mip->levels[lod];
+        for (size_t i = 0; i < level.size(); ++i) out[i] = mip->palette[level[i]];
+        return;
+    }
+    if (lod == 0) {
+        decodeVoxels(out);
+        return;
+    }
+    const int g = CHUNK_SIZE >> lod;
+    std::shared_lock lock(m_paletteMutex);
+    if (m_bits == 0) {
+        std::fill_n(out, g * g * g, m_palette[0]);
+        return;
+    }
+    // Payload at this LOD or coarser (its cells at the block origins) — or a payload refined
+    // after acquireMip() or with more than 256 palette entries, reduced cell by cell.
+    for (int z = 0; z < g; ++z)
+        for (int y = 0; y < g; ++y)
+            for (int x = 0; x < g; ++x)
+                out[x + y * g + z * g * g] = gridCellUnlocked(nullptr, lod, x, y, z);
+}
+
+size_t Chunk::getMipBytes() const {
+    std::lock_guard mipLock(m_mipMutex);
+    return m_mip ? m_mip->bytes() : 0;
+}
+
+bool Chunk::isMeshTriviallyEmpty(const std::array<const Chunk*, 6>& neighbors,
+                                 const std::array<int, 6>& neighborLODs,
+                                 int lod) const
+{
+    if (lod < 0) lod = 0;
+    if (lod > 2) lod = 2;
+    bool liquid = false;
+    {
+        std::shared_lock lock(m_paletteMutex);
+        if (m_bits != 0) return false;
+        liquid = m_palette[0].isTranslucent();
+        if (!liquid && !m_palette[0].isOpaque()) return true; // uniform AIR never emits faces
+    }
+
+    // Uniform opaque / liquid: mirrors the boundary rules of generateMesh() — a missing
+    // neighbour or an LOD mismatch is a skirt (AIR), a chunk still generating counts as SOLID.
+    // Opaque faces show towards liquid, liquid surfaces only towards AIR.
+    for (int i = 0; i < 6; ++i) {
+        const Chunk* nb = neighbors[i];
+        if (!nb || neighborLODs[i] != lod) return false;
+        if (nb->m_state.load(std::memory_order_acquire) != ChunkState::READY) continue;
+        std::shared_lock lock(nb->m_paletteMutex);
+        if (nb->m_bits != 0) return false;
+        const VoxelData v = nb->m_palette[0];
+        if (liquid ? !v.isOccupied() : !v.isOpaque()) return false;
+    }
+    return true;
+}
+
+// (getBaseHeight removed — the height formula lives in sampleTerrainColumn()
+//  (TerrainNoise.cpp) as a blend of plainH and mountH, controlled by erosion noise.)
+
+// ---------------------------------------------------------------------------
+// fillTerrain — runs the generation pipeline (GenerationStages.hpp)
+// ---------------------------------------------------------------------------
+void Chunk::fillTerrain(const TerrainConfig& config, int lod) {
+    generateTerrain(config, lod, false);
+}
+
+bool Chunk::refineTerrain(const TerrainConfig& config, int lod) {
+    if (getPayloadLod() <= lod) return false;
+    return generateTerrain(config, lod, true);
+}
+
+bool Chunk::generateTerrain(const TerrainConfig& config, int lod, bool onlyIfCoarser) {
+    lod = std::clamp(lod, 0, 2);
+
+    // This thread's generator context: noise layers, chunk stages and scratch, configured
+    // once per config.
+    TerrainGenerator& generator = TerrainGenerator::forThread(config);
+
+    // ---- COLUMN stages: 2D terrain fields (shared by every Y-slice) ----------
+    // Noise, interpolation and biome classification run once per (cx,cz).
+    const TerrainColumnCache::ColumnPtr column =
+        TerrainColumnCache::shared().get(config, generator.getConfigHash(), m_cx, m_cz);
+
+    // ---- CHUNK stages: surface layering, carving, decoration -----------------
+    // Stages write into the generator's flat scratch volume; encodeVoxels() then builds the
+    // chunk palette in one pass instead of paying a palette lookup per setVoxel().
+    ChunkGenContext ctx{config, *column, m_cx, m_cy, m_cz,
+                        lod, 1 << lod, CHUNK_SIZE >> lod, m_cy * CHUNK_SIZE,
+                        generator.voxelScratch()};
+    generator.runChunkStages(ctx);
+
+    // ---- ENCODE --------------------------------------------------------------
+    // Uniform results are exact, so they are stored at full resolution whatever `lod` asked for.
+    const auto encodeStart = std::chrono::steady_clock::now();
+    bool replaced = true;
+    if (ctx.uniform) {
+        {
+            std::unique_lock lock(m_paletteMutex);
+            if (onlyIfCoarser && m_payloadLod <= lod) replaced = false;
+            else                                      setUniformUnlocked(ctx.uniformVoxel);
+        }
+        if (replaced) m_isDirty = true;
+    } else {
+        replaced = encodePayload(ctx.voxels, lod, onlyIfCoarser);
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - encodeStart);
+    TerrainGenerator::recordStage(TerrainGenerator::Stage::ENCODE, static_cast<uint64_t>(ns.count()));
+    return replaced;
 }
 
 
 void Chunk::fillRandom(int seed) {
     const VoxelData stone = VoxelData::make(1, 255, 0, VOXEL_FLAG_SOLID);
     uint32_t rng = static_cast<uint32_t>(seed ^ 0xDEADBEEF);
-    for (auto& v : m_voxels) {
+    static thread_local VoxelData tl_voxels[CHUNK_VOLUME];
+    for (auto& v : tl_voxels) {
         rng = rng * 1664525u + 1013904223u;
         v = ((rng >> 16) & 3) ? stone : VOXEL_AIR;
     }
-    m_isDirty = true;
+    encodeVoxels(tl_voxels);
 }
 
 // ---------------------------------------------------------------------------
@@ -325,7 +730,7 @@ bool Chunk::isAirAt(int x, int y, int z,
     if (x >= 0 && x < CHUNK_SIZE &&
         y >= 0 && y < CHUNK_SIZE &&
         z >= 0 && z < CHUNK_SIZE)
-        return !m_voxels[idx(x, y, z)].isSolid();
+        return !getVoxel(x, y, z).isSolid();
 
     const Chunk* nb = nullptr;
     int lx = x, ly = y, lz = z;
@@ -341,7 +746,7 @@ bool Chunk::isAirAt(int x, int y, int z,
     lx = (lx < 0) ? 0 : (lx >= CHUNK_SIZE ? CHUNK_SIZE-1 : lx);
     ly = (ly < 0) ? 0 : (ly >= CHUNK_SIZE ? CHUNK_SIZE-1 : ly);
     lz = (lz < 0) ? 0 : (lz >= CHUNK_SIZE ? CHUNK_SIZE-1 : lz);
-    return !nb->m_voxels[idx(lx, ly, lz)].isSolid();
+    return !nb->getVoxel(lx, ly, lz).isSolid();
 }
 
 // ---------------------------------------------------------------------------
@@ -381,80 +786,331 @@ static inline int cacheIdx(int x, int y, int z) {
     return (x + CACHE_PADDING) + (y + CACHE_PADDING) * CACHE_DIM + (z + CACHE_PADDING) * CACHE_DIM * CACHE_DIM;
 }
 
-static uint8_t sampleAO(const VoxelData* cache,
-                        const std::array<int, 3>& pos, int d, int du, int dv, int normalDir)
+// Occupancy views for the AO / border reads, in block coordinates (multiples of step, one
+// step outside the chunk at most). The reference mesher reads the padded VoxelData cache,
+// generateMesh() the bitmask MeshApron. AO occluders are opaque voxels.
+struct CacheOccupancy {
+    const VoxelData* cache;
+    bool solid(int x, int y, int z) const { return cache[cacheIdx(x, y, z)].isOpaque(); }
+};
+
+// Liquid surfaces are not AO-shaded: every corner samples as unoccluded (AO 3, no flip).
+struct NoOcclusion {
+    bool solid(int, int, int) const { return false; }
+};
+
+// Deep water. A liquid surface cell with at least DEEP_LIQUID_BLOCKS blocks of liquid below it
+// inside this chunk (at LOD l that many cells >> l, at least one) is a lid: its top face is
+// drawn in the opaque stream (palette rgb, no AO) instead of the blended one. Whatever lies
+// under a lid cannot be seen from above any more, so opaque faces towards the liquid run under
+// it, deeper than the threshold, are culled; the seabed stays visible in shallow water.
+static constexpr int DEEP_LIQUID_BLOCKS = 4;
+static int deepLiquidCells(int lod) { return std::max(1, DEEP_LIQUID_BLOCKS >> lod); }
+
+// ---------------------------------------------------------------------------
+// MeshApron — solid bits of the chunk's grid cells plus a one-cell apron of neighbour cells
+//
+// Grid units: cell g is the block origin g * step. Interior cells are the mesher's X
+// occupancy columns; the apron is six slabs, owned like the old padded cache (X slabs take
+// the edges and corners, then Y, then Z). ~1 KB instead of a 40³ VoxelData copy.
+// "Solid" is isOpaque() — or isOccupied() for the liquid pass (`occupied`), whose surfaces
+// are hidden by opaque and liquid cells alike.
+// ---------------------------------------------------------------------------
+struct MeshApron {
+    int  lod      = 0;
+    int  gridSize = CHUNK_SIZE;
+    bool occupied = false;
+    const uint32_t (*inner)[32] = nullptr; // [gz][gy] bit gx
+    uint64_t xSlab[2][34] = {};            // +X / -X: [gz + 1] bit (gy + 1)
+    uint32_t ySlab[2][34] = {};            // +Y / -Y: [gz + 1] bit gx
+    uint32_t zSlab[2][32] = {};            // +Z / -Z: [gy] bit gx
+
+    // Grid cell, each coordinate in [-1, gridSize].
+    bool solidCell(int gx, int gy, int gz) const {
+        if (gx < 0 || gx >= gridSize) return (xSlab[gx < 0][gz + 1] >> (gy + 1)) & 1u;
+        if (gy < 0 || gy >= gridSize) return (ySlab[gy < 0][gz + 1] >> gx) & 1u;
+        if (gz < 0 || gz >= gridSize) return (zSlab[gz < 0][gy] >> gx) & 1u;
+        return (inner[gz][gy] >> gx) & 1u;
+    }
+    bool solid(int x, int y, int z) const { return solidCell(x >> lod, y >> lod, z >> lod); }
+};
+
+// AO occluders are sampled at super-voxel granularity: `pos` is a block origin and the three
+// neighbours are the origins of the adjacent step³ blocks in front of the face. At LOD > 0
+// both views hold grid (mip) cells, so AO sees the same super-voxels as the faces.
+template <class Occupancy>
+static uint8_t sampleAO(const Occupancy& occ,
+                        const std::array<int, 3>& pos, int d, int du, int dv, int normalDir, int step)
 {
     const int u = (d + 1) % 3;
     const int v = (d + 2) % 3;
 
     std::array<int, 3> base = pos;
-    base[d] += (normalDir > 0) ? 1 : -1;
+    base[d] += (normalDir > 0) ? step : -step;
 
-    std::array<int, 3> s1 = base; s1[u] += du;
-    std::array<int, 3> s2 = base; s2[v] += dv;
-    std::array<int, 3> sc = base; sc[u] += du; sc[v] += dv;
+    std::array<int, 3> s1 = base; s1[u] += du * step;
+    std::array<int, 3> s2 = base; s2[v] += dv * step;
+    std::array<int, 3> sc = base; sc[u] += du * step; sc[v] += dv * step;
 
-    bool b1 = cache[cacheIdx(s1[0], s1[1], s1[2])].isSolid();
-    bool b2 = cache[cacheIdx(s2[0], s2[1], s2[2])].isSolid();
-    bool bc = cache[cacheIdx(sc[0], sc[1], sc[2])].isSolid();
+    bool b1 = occ.solid(s1[0], s1[1], s1[2]);
+    bool b2 = occ.solid(s2[0], s2[1], s2[2]);
+    bool bc = occ.solid(sc[0], sc[1], sc[2]);
 
     return Chunk::computeAO(b1, b2, bc);
 }
 
+// One VoxelQuad: min corner `origin`, extent w × h blocks along the face's u / v axes.
+// AO is per corner c0..c3 (see VoxelQuad); the emission order the shader derives from
+// faceID puts the first corner last for -faces, so the flip test runs in that order.
 static void emitQuad(VoxelMeshData& mesh,
-                     std::span<const std::array<int, 3>, 4> corners,
+                     const std::array<int, 3>& origin, int w, int h,
                      uint8_t faceID,
                      uint16_t paletteIdx,
                      uint8_t ao0, uint8_t ao1, uint8_t ao2, uint8_t ao3,
                      int normalDir)
 {
-    int    vOrder[4];
-    uint8_t vAO[4];
-    if (normalDir > 0) {
-        vOrder[0]=0; vOrder[1]=1; vOrder[2]=2; vOrder[3]=3;
-        vAO[0]=ao0; vAO[1]=ao1; vAO[2]=ao2; vAO[3]=ao3;
-    } else {
-        vOrder[0]=3; vOrder[1]=2; vOrder[2]=1; vOrder[3]=0;
-        vAO[0]=ao3; vAO[1]=ao2; vAO[2]=ao1; vAO[3]=ao0;
-    }
-
-    uint32_t baseIdx = static_cast<uint32_t>(mesh.vertices.size());
-    for (int c = 0; c < 4; ++c) {
-        const auto& co = corners[vOrder[c]];
-        VoxelVertex vert{};
-        vert.x          = static_cast<uint8_t>(co[0]);
-        vert.y          = static_cast<uint8_t>(co[1]);
-        vert.z          = static_cast<uint8_t>(co[2]);
-        vert.faceID     = faceID;
-        vert.ao         = vAO[c];
-        vert.reserved   = 0;
-        vert.paletteIdx = paletteIdx;
-        mesh.vertices.push_back(vert);
-    }
-
-    if (vAO[0] + vAO[2] < vAO[1] + vAO[3]) {
-        mesh.indices.push_back(baseIdx + 1);
-        mesh.indices.push_back(baseIdx + 2);
-        mesh.indices.push_back(baseIdx + 3);
-        mesh.indices.push_back(baseIdx + 1);
-        mesh.indices.push_back(baseIdx + 3);
-        mesh.indices.push_back(baseIdx + 0);
+    const uint8_t ao[4] = {ao0, ao1, ao2, ao3};
+    // Emitted corners 0..3: c0..c3 (+face) or c3..c0 (-face). Flip when 0+2 is darker than 1+3.
+    const bool flip = (normalDir > 0) ? (ao0 + ao2 < ao1 + ao3) : (ao3 + ao1 < ao2 + ao0);
+    mesh.quads.push_back(VoxelQuad::make(origin[0], origin[1], origin[2], w, h, faceID, flip, paletteIdx, ao));
+}
+
+// The direction loops of both meshers run faceID 0..5 in order, so each direction's quads are
+// already one contiguous range; only the counts are left to record. Runs between the opaque
+// and the liquid pass, so it sees the opaque quads only.
+static void countFaceQuads(VoxelMeshData& mesh)
+{
+    mesh.faceQuads = {};
+    for (const VoxelQuad& q : mesh.quads) mesh.faceQuads[q.getFaceID()]++;
+}
+
+// Per-thread mesher scratch: the decoded grid and the reference mesher's padded neighbourhood.
+static thread_local VoxelData tl_volumeCache[CACHE_DIM * CACHE_DIM * CACHE_DIM];
+static thread_local VoxelData tl_selfVoxels[CHUNK_VOLUME];
+static thread_local VoxelData tl_gridVoxels[CHUNK_VOLUME / 8];
+
+// ---------------------------------------------------------------------------
+// gatherApron — the neighbours' cells touching this chunk, as MeshApron slab bits
+//
+// Same values the padded cache holds at step multiples: the neighbour's grid cell at this LOD
+// (edge / corner cells clamp to its last cell), SOLID while it is still generating, AIR where
+// there is no neighbour. A same-LOD neighbour (sameLod[n]) will mesh from its mip chain anyway,
+// so it is built here; other neighbours reduce just the slab cells unless theirs is cached.
+// ---------------------------------------------------------------------------
+void Chunk::gatherApron(MeshApron& apron, const std::array<const Chunk*, 6>& neighbors,
+                        const std::array<bool, 6>& sameLod)
+{
+    const int g    = apron.gridSize;
+    const int lod  = apron.lod;
+    const int last = g - 1;
+    auto cell = [last](int c) { return std::clamp(c, 0, last); };
+    const bool occupied = apron.occupied;
+    auto blocks = [occupied](VoxelData v) { return occupied ? v.isOccupied() : v.isOpaque(); };
+
+    for (int n = 0; n < 6; ++n) {
+        const Chunk* nb = neighbors[n];
+        if (!nb) continue; // edge of the loaded world stays AIR
+
+        const int side  = n & 1;             // 0 = +axis, 1 = -axis
+        const int layer = side ? last : 0;   // the neighbour's cells facing this chunk
+
+        // -1: read cells; 0 / 1: the whole slab is AIR / SOLID (generating or uniform neighbour).
+        int uniform = 1;
+        std::shared_ptr<const VoxelMip> mip;
+        std::shared_lock lock(nb->m_paletteMutex, std::defer_lock);
+        if (nb->m_state.load(std::memory_order_acquire) == ChunkState::READY) {
+            mip = sameLod[n] ? nb->acquireMip(lod) : nb->cachedMip(lod); // before the palette lock (lock order)
+            lock.lock();
+            uniform = nb->m_bits == 0 ? static_cast<int>(blocks(nb->m_palette[0])) : -1;
+        }
+        auto solidAt = [&](int gx, int gy, int gz) -> bool {
+            return uniform >= 0 ? uniform != 0 : blocks(nb->gridCellUnlocked(mip.get(), lod, gx, gy, gz));
+        };
+
+        switch (n >> 1) {
+        case 0:
+            for (int gz = -1; gz <= g; ++gz) {
+                uint64_t row = 0;
+                for (int gy = -1; gy <= g; ++gy)
+                    row |= static_cast<uint64_t>(solidAt(layer, cell(gy), cell(gz))) << (gy + 1);
+                apron.xSlab[side][gz + 1] = row;
+            }
+            break;
+        case 1:
+            for (int gz = -1; gz <= g; ++gz) {
+                uint32_t row = 0;
+                for (int gx = 0; gx < g; ++gx)
+                    row |= static_cast<uint32_t>(solidAt(gx, layer, cell(gz))) << gx;
+                apron.ySlab[side][gz + 1] = row;
+            }
+            break;
+        default:
+            for (int gy = 0; gy < g; ++gy) {
+                uint32_t row = 0;
+                for (int gx = 0; gx < g; ++gx)
+                    row |= static_cast<uint32_t>(solidAt(gx, gy, layer)) << gx;
+                apron.zSlab[side][gy] = row;
+            }
+            break;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// buildMeshCache — reference mesher input: decoded grid + CACHE_PADDING border of the neighbours
+// ---------------------------------------------------------------------------
+void Chunk::buildMeshCache(VoxelData* volumeCache, VoxelData* selfVoxels,
+                           const std::array<const Chunk*, 6>& neighbors, int lod) const
+{
+    std::fill_n(volumeCache, CACHE_DIM * CACHE_DIM * CACHE_DIM, VOXEL_AIR);
+
+    // Decode the grid once, each cell replicated over its step³ block; the mask pass and the
+    // AO cache read this flat copy.
+    if (lod == 0) {
+        decodeVoxels(selfVoxels);
     } else {
-        mesh.indices.push_back(baseIdx + 0);
-        mesh.indices.push_back(baseIdx + 1);
-        mesh.indices.push_back(baseIdx + 2);
-        mesh.indices.push_back(baseIdx + 0);
-        mesh.indices.push_back(baseIdx + 2);
-        mesh.indices.push_back(baseIdx + 3);
+        const int g = CHUNK_SIZE >> lod;
+        decodeGrid(tl_gridVoxels, lod, acquireMip(lod).get());
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+            for (int y = 0; y < CHUNK_SIZE; ++y)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    selfVoxels[idx(x, y, z)] = tl_gridVoxels[(x >> lod) + (y >> lod) * g + (z >> lod) * g * g];
+    }
+
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            std::copy_n(&selfVoxels[idx(0, y, z)], CHUNK_SIZE, &volumeCache[cacheIdx(0, y, z)]);
+        }
+    }
+
+    // Neighbors boundaries. Each padding region belongs to exactly one neighbour (X slabs own
+    // the edges and corners, then Y, then Z — same priority as isAirAt()), so every neighbour
+    // is locked once while its slab is copied.
+    struct BorderRegion { int nb; int x0, x1, y0, y1, z0, z1; int ox, oy, oz; };
+    constexpr int LO = -CACHE_PADDING;
+    constexpr int HI = CHUNK_SIZE + CACHE_PADDING;
+    constexpr BorderRegion borderRegions[6] = {
+        {0, CHUNK_SIZE, HI,         LO, HI,         LO, HI,         -CHUNK_SIZE, 0, 0},
+        {1, LO, 0,                  LO, HI,         LO, HI,          CHUNK_SIZE, 0, 0},
+        {2, 0, CHUNK_SIZE,          CHUNK_SIZE, HI, LO, HI,          0, -CHUNK_SIZE, 0},
+        {3, 0, CHUNK_SIZE,          LO, 0,          LO, HI,          0,  CHUNK_SIZE, 0},
+        {4, 0, CHUNK_SIZE,          0, CHUNK_SIZE,  CHUNK_SIZE, HI,  0, 0, -CHUNK_SIZE},
+        {5, 0, CHUNK_SIZE,          0, CHUNK_SIZE,  LO, 0,           0, 0,  CHUNK_SIZE},
+    };
+
+    for (const auto& r : borderRegions) {
+        const Chunk* nb = neighbors[r.nb];
+        if (!nb) continue; // edge of the loaded world stays AIR
+
+        if (nb->m_state.load(std::memory_order_acquire) != ChunkState::READY) {
+            // If neighbor is UNGENERATED/GENERATING, assume it's SOLID.
+            // This prevents creating "walls" on the boundary before the
+            // terrain below is actually loaded by progressive generation.
+            const VoxelData solid = VoxelData::make(1, 255, 0, VOXEL_FLAG_SOLID);
+            for (int z = r.z0; z < r.z1; ++z)
+                for (int y = r.y0; y < r.y1; ++y)
+                    for (int x = r.x0; x < r.x1; ++x)
+                        volumeCache[cacheIdx(x, y, z)] = solid;
+            continue;
+        }
+
+        // Edge / corner cells past the neighbour clamp to its last block origin at this LOD.
+        const int last = CHUNK_SIZE - (1 << lod);
+        const std::shared_ptr<const VoxelMip> mip = nb->cachedMip(lod);
+        std::shared_lock lock(nb->m_paletteMutex);
+        for (int z = r.z0; z < r.z1; ++z) {
+            const int lz = std::clamp(z + r.oz, 0, last);
+            for (int y = r.y0; y < r.y1; ++y) {
+                const int ly = std::clamp(y + r.oy, 0, last);
+                for (int x = r.x0; x < r.x1; ++x) {
+                    const int lx = std::clamp(x + r.ox, 0, last);
+                    volumeCache[cacheIdx(x, y, z)] = nb->gridCellUnlocked(mip.get(), lod, lx >> lod, ly >> lod, lz >> lod);
+                }
+            }
+        }
     }
 }
 
 // ---------------------------------------------------------------------------
-// generateMesh — LOD-aware Bitwise Greedy Meshing
+// greedyMergeLayer — merges one layer's face bitmask into quads (shared by both meshers)
+//
+// layerMask[j] bit i = a visible face at (u = i, v = j) of `layer` along axis d, in grid
+// units; palettes[j][i] is its palette index. The mask is consumed.
 // ---------------------------------------------------------------------------
-VoxelMeshData Chunk::generateMesh(const std::array<const Chunk*, 6>& neighbors,
-                                  const std::array<int, 6>& neighborLODs,
-                                  int lod) const
+template <class Occupancy>
+static void greedyMergeLayer(VoxelMeshData& mesh, uint32_t (&layerMask)[32], const uint16_t (&palettes)[32][32],
+                             int gridSize, int d, int normalDir, int layer, int step,
+                             const Occupancy& occ)
+{
+    const int u = (d + 1) % 3;
+    const int v = (d + 2) % 3;
+    const uint8_t faceID = static_cast<uint8_t>(d * 2 + (normalDir > 0 ? 0 : 1));
+
+    for (int j = 0; j < gridSize; ++j) {
+        while (layerMask[j] != 0) {
+            int i = std::countr_zero(layerMask[j]);
+            uint16_t p = palettes[j][i];
+
+            int W = 1;
+            uint32_t rowMask = (1u << i);
+            while (i + W < gridSize && (layerMask[j] & (1u << (i + W))) && palettes[j][i + W] == p) {
+                rowMask |= (1u << (i + W));
+                W++;
+            }
+
+            int H = 1;
+            while (j + H < gridSize) {
+                if ((layerMask[j + H] & rowMask) != rowMask) break;
+
+                bool match = true;
+                for (int k = 0; k < W; ++k) {
+                    if (palettes[j + H][i + k] != p) {
+                        match = false;
+                        break;
+                    }
+                }
+                if (!match) break;
+                H++;
+            }
+
+            // Delayed AO Calculation (Compute ONLY for the 4 corners of the merged face!)
+            std::array<int, 3> aoPos0, aoPos1, aoPos2, aoPos3;
+            aoPos0[d] = aoPos1[d] = aoPos2[d] = aoPos3[d] = layer * step;
+
+            aoPos0[u] = i * step;             aoPos0[v] = j * step;
+            aoPos1[u] = (i + W - 1) * step;   aoPos1[v] = j * step;
+            aoPos2[u] = (i + W - 1) * step;   aoPos2[v] = (j + H - 1) * step;
+            aoPos3[u] = i * step;             aoPos3[v] = (j + H - 1) * step;
+
+            uint8_t ao0 = sampleAO(occ, aoPos0, d, -1, -1, normalDir, step);
+            uint8_t ao1 = sampleAO(occ, aoPos1, d, +1, -1, normalDir, step);
+            uint8_t ao2 = sampleAO(occ, aoPos2, d, +1, +1, normalDir, step);
+            uint8_t ao3 = sampleAO(occ, aoPos3, d, -1, +1, normalDir, step);
+
+            // Emit Quad Output
+            std::array<int, 3> origin;
+            origin[d] = layer * step + (normalDir > 0 ? step : 0);
+            origin[u] = i * step;
+            origin[v] = j * step;
+            emitQuad(mesh, origin, W * step, H * step, faceID, p, ao0, ao1, ao2, ao3, normalDir);
+
+            uint32_t clearMask = ~rowMask;
+            for (int h = 0; h < H; ++h) {
+                layerMask[j + h] &= clearMask;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// generateMeshReference — per-voxel mask build (the original mesher)
+//
+// Each face direction visits every grid cell and looks its neighbour up individually.
+// Kept as the correctness reference for generateMesh(): same cache, same greedy merge.
+// ---------------------------------------------------------------------------
+VoxelMeshData Chunk::generateMeshReference(const std::array<const Chunk*, 6>& neighbors,
+                                           const std::array<int, 6>& neighborLODs,
+                                           int lod) const
 {
     if (lod < 0) lod = 0;
     if (lod > 2) lod = 2;
@@ -463,203 +1119,439 @@ VoxelMeshData Chunk::generateMesh(const std::array<const Chunk*, 6>& neighbors,
     const int gridSize = CHUNK_SIZE / step;        
 
     VoxelMeshData mesh;
-    mesh.vertices.reserve(lod == 0 ? 2048 : 512);
-    mesh.indices.reserve(lod == 0 ? 3072 : 768);
+    mesh.quads.reserve(lod == 0 ? 512 : 128);
 
-    static thread_local VoxelData volumeCache[CACHE_DIM * CACHE_DIM * CACHE_DIM];
-    std::fill_n(volumeCache, CACHE_DIM * CACHE_DIM * CACHE_DIM, VOXEL_AIR);
+    VoxelData* volumeCache = tl_volumeCache;
+    VoxelData* selfVoxels  = tl_selfVoxels;
+    buildMeshCache(volumeCache, selfVoxels, neighbors, lod);
 
-    for (int z = 0; z < CHUNK_SIZE; ++z) {
-        for (int y = 0; y < CHUNK_SIZE; ++y) {
-            for (int x = 0; x < CHUNK_SIZE; ++x) {
-                volumeCache[cacheIdx(x, y, z)] = m_voxels[idx(x, y, z)];
-            }
+    // Per-layer Bitboard Data
+    static_assert(CHUNK_SIZE <= 32, "Greedy meshing bitmask overflow: CHUNK_SIZE > 32 requires 64-bit masks");
+    uint32_t layerMask[32];
+    uint32_t lidMask[32];
+    uint16_t palettes[32][32];
+
+    // Deep water (see DEEP_LIQUID_BLOCKS), one cell at a time. deepAt: the liquid run from `p`
+    // up reaches an unoccupied cell in this chunk, at least `depth` cells up. lidAt: `p` is a
+    // liquid surface cell (unoccupied cell above, in this chunk) over depth-1 more liquid cells.
+    const int depth = deepLiquidCells(lod);
+    auto voxelAt = [&](const std::array<int, 3>& p) { return selfVoxels[idx(p[0], p[1], p[2])]; };
+    auto deepAt = [&](std::array<int, 3> p) {
+        int run = 0;
+        for (; p[1] < CHUNK_SIZE && voxelAt(p).isLiquid(); p[1] += step) ++run;
+        return run >= depth && p[1] < CHUNK_SIZE && !voxelAt(p).isOccupied();
+    };
+    auto lidAt = [&](std::array<int, 3> p) {
+        if (!voxelAt(p).isLiquid() || p[1] + step >= CHUNK_SIZE) return false;
+        std::array<int, 3> above = p;
+        above[1] += step;
+        if (voxelAt(above).isOccupied()) return false;
+        for (int k = 1; k < depth; ++k) {
+            p[1] -= step;
+            if (p[1] < 0 || !voxelAt(p).isLiquid()) return false;
         }
-    }
+        return true;
+    };
+
+    // One mesh stream: faces of the cells `isCell` accepts whose neighbour `hides` rejects.
+    // The opaque stream (`opaquePass`) also treats deep liquid inside the chunk as hiding and
+    // adds the lid tops; the liquid stream drops them.
+    auto meshPass = [&](auto isCell, auto hides, const auto& occ, bool opaquePass) {
+        for (int d = 0; d < 3; ++d) {
+            const int u = (d + 1) % 3;
+            const int v = (d + 2) % 3;
+
+            for (int normalDir = 1; normalDir >= -1; normalDir -= 2) {
+                for (int layer = 0; layer < gridSize; ++layer) {
+                
+                    // Clear Bitboard
+                    const bool lidTops = d == 1 && normalDir > 0;
+                    uint32_t anyLid = 0;
+                    for (int m = 0; m < gridSize; ++m) {
+                        layerMask[m] = 0;
+                        lidMask[m]   = 0;
+                    }
+
+                    // 1. Generate Bitmask and extract palettes
+                    for (int j = 0; j < gridSize; ++j) {
+                        for (int i = 0; i < gridSize; ++i) {
+                            std::array<int, 3> pos;
+                            pos[d] = layer * step;
+                            pos[u] = i     * step;
+                            pos[v] = j     * step;
+
+                            const VoxelData& vox = selfVoxels[idx(pos[0], pos[1], pos[2])];
+                            if (lidTops && lidAt(pos)) {
+                                if (opaquePass) {
+                                    lidMask[j] |= (1u << i);
+                                    anyLid     |= lidMask[j];
+                                    palettes[j][i] = vox.getPaletteIndex();
+                                }
+                                continue;
+                            }
+                            if (!isCell(vox)) continue;
+
+                            std::array<int, 3> npos = pos;
+                            npos[d] += normalDir * step; // Base origin of the neighbor LOD block!
+
+                            // ------------------------------------------------------------------
+                            // SMART SKIRTS: Інтеграція в Bitwise Greedy Meshing
+                            // Якщо сусід відсутній (край світу) або має інший рівень деталізації (LOD):
+                            // Ми примусово вважаємо цю межу ПОВІТРЯМ (AIR -> isNeighborSolid = false).
+                            // Завдяки цьому, код нижче запише `1` у layerMask для КОЖНОГО вокселя обличчя (напр. 32x32), 
+                            // і Greedy Meshing автоматично об'єднає всю цю площину в ОДИН великий Quad!
+                            // ------------------------------------------------------------------
+                            bool isNeighborSolid = false;
+                            if (npos[d] >= 0 && npos[d] < CHUNK_SIZE) {
+                                // Internal voxel check
+                                isNeighborSolid = hides(selfVoxels[idx(npos[0], npos[1], npos[2])])
+                                               || (opaquePass && deepAt(npos));
+                            } else {
+                                // Boundary voxel check
+                                int neighborIdx = -1;
+                                if (d == 0)      neighborIdx = (normalDir > 0) ? 0 : 1;
+                                else if (d == 1) neighborIdx = (normalDir > 0) ? 2 : 3;
+                                else             neighborIdx = (normalDir > 0) ? 4 : 5;
+                            
+                                const Chunk* nb = neighbors[neighborIdx];
+                                if (!nb || neighborLODs[neighborIdx] != lod) {
+                                    // Спідниця: Edge of world OR LOD Boundary -> Повітря (щоб генерувався єдиний Quad)
+                                    isNeighborSolid = false; 
+                                } else {
+                                    // Same LOD: npos lands in the border slab copied above — the neighbour's
+                                    // voxel at the matching LOD origin, or SOLID for chunks still generating.
+                                    isNeighborSolid = hides(volumeCache[cacheIdx(npos[0], npos[1], npos[2])]);
+                                }
+                            }
+
+                            if (isNeighborSolid) continue;
+
+                            layerMask[j] |= (1u << i);
+                            palettes[j][i] = vox.getPaletteIndex();
+                        }
+                    }
 
-    // Neighbors boundaries
-    for (int z = -CACHE_PADDING; z < CHUNK_SIZE + CACHE_PADDING; ++z) {
-        for (int y = -CACHE_PADDING; y < CHUNK_SIZE + CACHE_PADDING; ++y) {
-            for (int x = -CACHE_PADDING; x < CHUNK_SIZE + CACHE_PADDING; ++x) {
-                if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_SIZE && z >= 0 && z < CHUNK_SIZE)
-                    continue; 
-
-                const Chunk* nb = nullptr;
-                int lx = x, ly = y, lz = z;
-
-                if      (x >= CHUNK_SIZE) { nb = neighbors[0]; lx = x - CHUNK_SIZE; }
-                else if (x < 0)           { nb = neighbors[1]; lx = x + CHUNK_SIZE; }
-                else if (y >= CHUNK_SIZE) { nb = neighbors[2]; ly = y - CHUNK_SIZE; }
-                else if (y < 0)           { nb = neighbors[3]; ly = y + CHUNK_SIZE; }
-                else if (z >= CHUNK_SIZE) { nb = neighbors[4]; lz = z - CHUNK_SIZE; }
-                else if (z < 0)           { nb = neighbors[5]; lz = z + CHUNK_SIZE; }
-
-                if (nb) {
-                    if (nb->m_state.load(std::memory_order_acquire) == ChunkState::READY) {
-                        lx = std::clamp(lx, 0, CHUNK_SIZE - 1);
-                        ly = std::clamp(ly, 0, CHUNK_SIZE - 1);
-                        lz = std::clamp(lz, 0, CHUNK_SIZE - 1);
-                        volumeCache[cacheIdx(x, y, z)] = nb->getVoxel(lx, ly, lz);
-                    } else {
-                        // If neighbor is UNGENERATED/GENERATING, assume it's SOLID.
-                        // This prevents creating "walls" on the boundary before the
-                        // terrain below is actually loaded by progressive generation.
-                        volumeCache[cacheIdx(x, y, z)] = VoxelData::make(1, 255, 0, VOXEL_FLAG_SOLID);
+                    greedyMergeLayer(mesh, layerMask, palettes, gridSize, d, normalDir, layer, step, occ);
+                    if (anyLid != 0) {
+                        greedyMergeLayer(mesh, lidMask, palettes, gridSize, d, normalDir, layer, step,
+                                         NoOcclusion{});
                     }
                 }
             }
         }
+    };
+
+    // Opaque: faces towards AIR and liquid. Liquid / transparent: the surface towards AIR only.
+    auto opaque   = [](VoxelData v) { return v.isOpaque(); };
+    auto occupied = [](VoxelData v) { return v.isOccupied(); };
+    meshPass(opaque, opaque, CacheOccupancy{volumeCache}, true);
+    countFaceQuads(mesh);
+    meshPass([](VoxelData v) { return v.isTranslucent(); }, occupied, NoOcclusion{}, false);
+    mesh.liquidQuads = mesh.quadCount() - mesh.opaqueQuads();
+    return mesh;
+}
+
+// ---------------------------------------------------------------------------
+// transpose32 — 32×32 bit matrix transpose in place (bit c of a[r] <-> bit r of a[c])
+// ---------------------------------------------------------------------------
+static void transpose32(uint32_t (&a)[32]) {
+    uint32_t m = 0x0000FFFFu;
+    for (int j = 16; j != 0; j >>= 1, m ^= (m << j)) {
+        for (int k = 0; k < 32; k = ((k | j) + 1) & ~j) {
+            const uint32_t t = ((a[k] >> j) ^ a[k | j]) & m;
+            a[k]     ^= t << j;
+            a[k | j] ^= t;
+        }
     }
+}
 
-    // Per-layer Bitboard Data
-    static_assert(CHUNK_SIZE <= 32, "Greedy meshing bitmask overflow: CHUNK_SIZE > 32 requires 64-bit masks");
-    uint32_t layerMask[32];
+// ---------------------------------------------------------------------------
+// generateMesh — Binary Greedy Meshing (column bitmasks)
+//
+//   1. Occupancy columns, once per axis: cols[d][j][i] bit L = grid cell at (u = i, v = j,
+//      d = L) is opaque. X columns are read from the grid (the payload at LOD 0, the mip level
+//      otherwise — a 16³ / 8³ chunk), Y and Z are bit transposes of them.
+//   2. Face bits for a whole column at once: c & ~(c >> 1) (+d) and c & ~(c << 1) (-d); the
+//      bit shifted in at the chunk edge is the neighbour's border cell (AIR for skirts).
+//   3. Transpose the face columns into per-layer bitplanes (layerMask[j] bit i) and run the
+//      same greedyMergeLayer() as generateMeshReference(), in the same order — the output is
+//      identical, only the mask build changed (no per-voxel neighbour lookups).
+//
+// Liquid / transparent cells get their own columns and a second pass after the opaque one:
+// same steps, but a face is hidden by opaque and liquid neighbours alike (surface only) and
+// is not AO-shaded. Chunks without liquid skip it.
+//
+// Neighbour cells (border faces, AO) come from a MeshApron: only the one-cell layer of each
+// neighbour that touches the chunk, as bits — no padded 40³ VoxelData cache.
+// ---------------------------------------------------------------------------
+
+// cols[0][gz][gy] bit gx (filled by the caller) -> Y columns cols[1][x][z], Z columns cols[2][y][x].
+static void transposeColumns(uint32_t (&cols)[3][32][32], int gridSize)
+{
+    uint32_t tmp[32];
+    for (int gz = 0; gz < gridSize; ++gz) {           // Y columns: cols[1][x][z]
+        std::copy_n(cols[0][gz], 32, tmp);
+        transpose32(tmp);
+        for (int gx = 0; gx < gridSize; ++gx) cols[1][gx][gz] = tmp[gx];
+    }
+    for (int gy = 0; gy < gridSize; ++gy) {           // Z columns: cols[2][y][x]
+        for (int gz = 0; gz < 32; ++gz) tmp[gz] = cols[0][gz][gy];
+        transpose32(tmp);
+        std::copy_n(tmp, 32, cols[2][gy]);
+    }
+}
+
+// One mesh stream (steps 2-3): faces of the `cells` columns towards cells that are neither in
+// `cells` nor in `blockers` (nullptr = no other blockers). `apron` classifies the border cells
+// the same way; nbSample[n] is false where neighbour n meshes as a skirt. `grid` holds the
+// gridSize³ cells (palette indices).
+// `lids` (Y columns, see DEEP_LIQUID_BLOCKS): liquid cells whose top face is opaque. A stream
+// whose `cells` hold them drops that face; one whose `cells` do not (the opaque stream) adds
+// it, merged after each layer's regular +Y faces, unshaded.
+template <class Occupancy>
+static void meshColumns(VoxelMeshData& mesh, const uint32_t (&cells)[3][32][32],
+                        const uint32_t (*blockers)[32][32], const MeshApron& apron,
+                        const std::array<bool, 6>& nbSample, const VoxelData* grid,
+                        const Occupancy& occ, const uint32_t (*lids)[32] = nullptr)
+{
+    const int gridSize = apron.gridSize;
+    const int step     = 1 << apron.lod;
+    const uint32_t topBit = 1u << (gridSize - 1);
+    uint32_t tmp[32];
+    uint32_t faces[32][32];      // [j][i] bit L: visible face in this direction
+    uint32_t planes[32][32];     // [L][j] bit i: the same faces, one bitplane per layer
+    uint32_t lidFaces[32][32];   // the same for the lid faces this stream adds
+    uint32_t lidPlanes[32][32];
     uint16_t palettes[32][32];
 
+    // 3. Bitplanes: out[L][j] bit i = in[j][i] bit L.
+    auto toPlanes = [&](const uint32_t (&in)[32][32], uint32_t (&out)[32][32]) {
+        for (int j = 0; j < gridSize; ++j) {
+            std::copy_n(in[j], 32, tmp);
+            uint32_t rowAny = 0;
+            for (int i = 0; i < gridSize; ++i) rowAny |= tmp[i];
+            if (rowAny == 0) {
+                for (int layer = 0; layer < gridSize; ++layer) out[layer][j] = 0;
+                continue;
+            }
+            for (int i = gridSize; i < 32; ++i) tmp[i] = 0;
+            transpose32(tmp);
+            for (int layer = 0; layer < gridSize; ++layer) out[layer][j] = tmp[layer];
+        }
+    };
+    // Fills palettes[j][i] for every bit of `plane` (cells of `layer`).
+    auto readPalettes = [&](const uint32_t (&plane)[32], int d, int layer) {
+        const int u = (d + 1) % 3;
+        const int v = (d + 2) % 3;
+        std::array<int, 3> cell{};
+        cell[d] = layer;
+        for (int j = 0; j < gridSize; ++j) {
+            cell[v] = j;
+            for (uint32_t bits = plane[j]; bits != 0; bits &= bits - 1) {
+                const int i = std::countr_zero(bits);
+                cell[u] = i;
+                palettes[j][i] = grid[cell[0] + cell[1] * gridSize + cell[2] * gridSize * gridSize]
+                                     .getPaletteIndex();
+            }
+        }
+    };
+
     for (int d = 0; d < 3; ++d) {
         const int u = (d + 1) % 3;
         const int v = (d + 2) % 3;
 
         for (int normalDir = 1; normalDir >= -1; normalDir -= 2) {
-            const uint8_t faceID = static_cast<uint8_t>(d * 2 + (normalDir > 0 ? 0 : 1));
+            // 2. Face columns. Neighbour border cell: only for a same-LOD neighbour, otherwise
+            //    AIR so the boundary meshes as a skirt (see generateMeshReference).
+            const int nbIdx = d * 2 + (normalDir > 0 ? 0 : 1);
+            std::array<int, 3> ncell{};
+            ncell[d] = (normalDir > 0) ? gridSize : -1;
+
+            const uint32_t (*lidTops)[32] = (d == 1 && normalDir > 0) ? lids : nullptr;
+            uint32_t anyFace = 0, anyLid = 0;
+            for (int j = 0; j < gridSize; ++j) {
+                ncell[v] = j;
+                for (int i = 0; i < gridSize; ++i) {
+                    const uint32_t c   = cells[d][j][i];
+                    const uint32_t lid = lidTops ? lidTops[j][i] : 0u;
+                    lidFaces[j][i] = lid & ~c;
+                    anyLid |= lidFaces[j][i];
+                    if (c == 0) { faces[j][i] = 0; continue; }
+                    const uint32_t b = blockers ? c | blockers[d][j][i] : c;
+
+                    ncell[u] = i;
+                    const bool nbSolid = nbSample[nbIdx] && apron.solidCell(ncell[0], ncell[1], ncell[2]);
+                    const uint32_t f = (normalDir > 0)
+                        ? c & ~((b >> 1) | (nbSolid ? topBit : 0u) | lid)
+                        : c & ~((b << 1) | (nbSolid ? 1u : 0u));
+                    faces[j][i] = f;
+                    anyFace |= f;
+                }
+            }
+            if ((anyFace | anyLid) == 0) continue;
+
+            if (anyFace != 0) toPlanes(faces, planes);
+            if (anyLid != 0)  toPlanes(lidFaces, lidPlanes);
 
             for (int layer = 0; layer < gridSize; ++layer) {
-                
-                // Clear Bitboard
-                for (int m = 0; m < gridSize; ++m) {
-                    layerMask[m] = 0;
+                if (anyFace & (1u << layer)) {
+                    readPalettes(planes[layer], d, layer);
+                    greedyMergeLayer(mesh, planes[layer], palettes, gridSize, d, normalDir, layer, step, occ);
                 }
+                if (anyLid & (1u << layer)) {
+                    readPalettes(lidPlanes[layer], d, layer);
+                    greedyMergeLayer(mesh, lidPlanes[layer], palettes, gridSize, d, normalDir, layer, step,
+                                     NoOcclusion{});
+                }
+            }
+        }
+    }
+}
 
-                // 1. Generate Bitmask and extract palettes
-                for (int j = 0; j < gridSize; ++j) {
-                    for (int i = 0; i < gridSize; ++i) {
-                        std::array<int, 3> pos;
-                        pos[d] = layer * step;
-                        pos[u] = i     * step;
-                        pos[v] = j     * step;
-
-                        const VoxelData& vox = m_voxels[idx(pos[0], pos[1], pos[2])];
-                        if (!vox.isSolid()) continue;
-
-                        std::array<int, 3> npos = pos;
-                        npos[d] += normalDir * step; // Base origin of the neighbor LOD block!
-
-                        // ------------------------------------------------------------------
-                        // SMART SKIRTS: Інтеграція в Bitwise Greedy Meshing
-                        // Якщо сусід відсутній (край світу) або має інший рівень деталізації (LOD):
-                        // Ми примусово вважаємо цю межу ПОВІТРЯМ (AIR -> isNeighborSolid = false).
-                        // Завдяки цьому, код нижче запише `1` у layerMask для КОЖНОГО вокселя обличчя (напр. 32x32), 
-                        // і Greedy Meshing автоматично об'єднає всю цю площину в ОДИН великий Quad!
-                        // ------------------------------------------------------------------
-                        bool isNeighborSolid = false;
-                        if (npos[d] >= 0 && npos[d] < CHUNK_SIZE) {
-                            // Internal voxel check
-                            isNeighborSolid = m_voxels[idx(npos[0], npos[1], npos[2])].isSolid();
-                        } else {
-                            // Boundary voxel check
-                            int neighborIdx = -1;
-                            int lx = npos[0], ly = npos[1], lz = npos[2];
-                            
-                            if (d == 0) {
-                                neighborIdx = (normalDir > 0) ? 0 : 1;
-                                lx = (normalDir > 0) ? 0 : (CHUNK_SIZE - step);
-                            } else if (d == 1) {
-                                neighborIdx = (normalDir > 0) ? 2 : 3;
-                                ly = (normalDir > 0) ? 0 : (CHUNK_SIZE - step);
-                            } else {
-                                neighborIdx = (normalDir > 0) ? 4 : 5;
-                                lz = (normalDir > 0) ? 0 : (CHUNK_SIZE - step);
-                            }
-                            
-                            const Chunk* nb = neighbors[neighborIdx];
-                            if (!nb || neighborLODs[neighborIdx] != lod) {
-                                // Спідниця: Edge of world OR LOD Boundary -> Повітря (щоб генерувався єдиний Quad)
-                                isNeighborSolid = false; 
-                            } else if (nb->m_state.load(std::memory_order_acquire) == ChunkState::READY) {
-                                // Same LOD: exact fast O(1) local voxel lookup
-                                isNeighborSolid = nb->m_voxels[idx(lx, ly, lz)].isSolid();
-                            } else {
-                                // Підземні чанки в процесі генерації (Sparse Storage)
-                                isNeighborSolid = true;
-                            }
-                        }
+VoxelMeshData Chunk::generateMesh(const std::array<const Chunk*, 6>& neighbors,
+                                  const std::array<int, 6>& neighborLODs,
+                                  int lod) const
+{
+    VoxelMeshData mesh;
+    generateMesh(neighbors, neighborLODs, lod, mesh);
+    return mesh;
+}
 
-                        if (isNeighborSolid) continue;
+void Chunk::generateMesh(const std::array<const Chunk*, 6>& neighbors,
+                         const std::array<int, 6>& neighborLODs,
+                         int lod, VoxelMeshData& mesh) const
+{
+    if (lod < 0) lod = 0;
+    if (lod > 2) lod = 2;
 
-                        layerMask[j] |= (1u << i);
-                        palettes[j][i] = vox.getPaletteIndex();
-                    }
-                }
+    const int step = 1 << lod;
+    const int gridSize = CHUNK_SIZE / step;
 
-                // 2. Bitwise Greedy Meshing
-                for (int j = 0; j < gridSize; ++j) {
-                    while (layerMask[j] != 0) {
-                        int i = std::countr_zero(layerMask[j]);
-                        uint16_t p = palettes[j][i];
-                        
-                        int W = 1;
-                        uint32_t rowMask = (1u << i);
-                        while (i + W < gridSize && (layerMask[j] & (1u << (i + W))) && palettes[j][i + W] == p) {
-                            rowMask |= (1u << (i + W));
-                            W++;
-                        }
-                        
-                        int H = 1;
-                        while (j + H < gridSize) {
-                            if ((layerMask[j + H] & rowMask) != rowMask) break;
-                            
-                            bool match = true;
-                            for (int k = 0; k < W; ++k) {
-                                if (palettes[j + H][i + k] != p) {
-                                    match = false;
-                                    break;
-                                }
-                            }
-                            if (!match) break;
-                            H++;
-                        }
-                        
-                        // Delayed AO Calculation (Compute ONLY for the 4 corners of the merged face!)
-                        std::array<int, 3> aoPos0, aoPos1, aoPos2, aoPos3;
-                        aoPos0[d] = aoPos1[d] = aoPos2[d] = aoPos3[d] = layer * step;
-                        
-                        aoPos0[u] = i * step;             aoPos0[v] = j * step;
-                        aoPos1[u] = (i + W - 1) * step;   aoPos1[v] = j * step;
-                        aoPos2[u] = (i + W - 1) * step;   aoPos2[v] = (j + H - 1) * step;
-                        aoPos3[u] = i * step;             aoPos3[v] = (j + H - 1) * step;
-                        
-                        uint8_t ao0 = sampleAO(volumeCache, aoPos0, d, -1, -1, normalDir);
-                        uint8_t ao1 = sampleAO(volumeCache, aoPos1, d, +1, -1, normalDir);
-                        uint8_t ao2 = sampleAO(volumeCache, aoPos2, d, +1, +1, normalDir);
-                        uint8_t ao3 = sampleAO(volumeCache, aoPos3, d, -1, +1, normalDir);
-                        
-                        // Emit Quad Output
-                        int vi  = i * step;
-                        int vj  = j * step;
-                        int vW  = W * step;
-                        int vH  = H * step;
-                        int faceLayer = layer * step + (normalDir > 0 ? step : 0);
-                        
-                        std::array<std::array<int, 3>, 4> corners;
-                        corners[0][d]=faceLayer; corners[0][u]=vi;    corners[0][v]=vj;
-                        corners[1][d]=faceLayer; corners[1][u]=vi+vW; corners[1][v]=vj;
-                        corners[2][d]=faceLayer; corners[2][u]=vi+vW; corners[2][v]=vj+vH;
-                        corners[3][d]=faceLayer; corners[3][u]=vi;    corners[3][v]=vj+vH;
-                        
-                        
-                        emitQuad(mesh, corners, faceID, p, ao0, ao1, ao2, ao3, normalDir);
-                        
-                        uint32_t clearMask = ~rowMask;
-                        for (int h = 0; h < H; ++h) {
-                            layerMask[j + h] &= clearMask;
-                        }
-                    }
+    mesh.quads.clear();
+    mesh.quads.reserve(lod == 0 ? 512 : 128);
+
+    if (lod == 0) {
+        // Near again: the levels would only hold RAM until the chunk is far (and rebuilt then).
+        std::lock_guard mipLock(m_mipMutex);
+        m_mip.reset();
+    }
+
+    // The gridSize³ cells: the payload at LOD 0, the cached mip level above it.
+    const std::shared_ptr<const VoxelMip> mip = acquireMip(lod);
+    VoxelData* grid = lod == 0 ? tl_selfVoxels : tl_gridVoxels;
+    decodeGrid(grid, lod, mip.get());
+
+    // Liquid columns only for chunks whose palette has a translucent entry (stale ones included).
+    auto translucent = [](VoxelData v) { return v.isTranslucent(); };
+    bool paletteLiquid = false;
+    if (mip) {
+        paletteLiquid = std::any_of(mip->palette.begin(), mip->palette.end(), translucent);
+    } else {
+        std::shared_lock lock(m_paletteMutex);
+        paletteLiquid = std::any_of(m_palette.begin(), m_palette.end(), translucent);
+    }
+
+    static_assert(CHUNK_SIZE <= 32, "Binary greedy meshing: CHUNK_SIZE > 32 requires 64-bit columns");
+
+    // 1. Occupancy columns, opaque and liquid (rows / bits past gridSize stay 0).
+    uint32_t cols[3][32][32] = {};
+    for (int gz = 0; gz < gridSize; ++gz) {
+        for (int gy = 0; gy < gridSize; ++gy) {
+            const VoxelData* row = &grid[gy * gridSize + gz * gridSize * gridSize];
+            uint32_t bits = 0;
+            for (int gx = 0; gx < gridSize; ++gx) {
+                bits |= static_cast<uint32_t>(row[gx].isOpaque()) << gx;
+            }
+            cols[0][gz][gy] = bits;
+        }
+    }
+    transposeColumns(cols, gridSize);
+
+    // Deep water (see DEEP_LIQUID_BLOCKS), in X columns first: deep = liquid cells whose run
+    // reaches a surface in this chunk at least `depth` cells up (opaque faces towards them are
+    // culled), lids = surface cells with at least `depth` liquid cells below.
+    uint32_t liquid[3][32][32];
+    uint32_t deep[3][32][32];
+    uint32_t lids[3][32][32];
+    uint32_t anyLiquid = 0, anyLid = 0;
+    if (paletteLiquid) {
+        std::fill_n(&liquid[0][0][0], 3 * 32 * 32, 0u);
+        std::fill_n(&deep[0][0][0], 32 * 32, 0u);
+        std::fill_n(&lids[0][0][0], 32 * 32, 0u);
+        const uint32_t rowMask = gridSize == 32 ? ~0u : (1u << gridSize) - 1;
+        const int      depth   = deepLiquidCells(lod);
+        for (int gz = 0; gz < gridSize; ++gz) {
+            uint32_t wet[32], open[32];
+            for (int gy = 0; gy < gridSize; ++gy) {
+                const VoxelData* row = &grid[gy * gridSize + gz * gridSize * gridSize];
+                uint32_t bits = 0, water = 0;
+                for (int gx = 0; gx < gridSize; ++gx) {
+                    bits  |= static_cast<uint32_t>(row[gx].isTranslucent()) << gx;
+                    water |= static_cast<uint32_t>(row[gx].isLiquid()) << gx;
                 }
+                liquid[0][gz][gy] = bits;
+                anyLiquid |= bits;
+                wet[gy]  = water;
+                open[gy] = ~(bits | cols[0][gz][gy]) & rowMask;
+            }
+            if (anyLiquid == 0) continue;
+
+            uint32_t reach[32];   // liquid runs that end at a surface inside the chunk
+            uint32_t below = 0;   // the same one row up
+            for (int gy = gridSize - 1; gy >= 0; --gy) {
+                const uint32_t surface = gy + 1 < gridSize ? wet[gy] & open[gy + 1] : 0u;
+                reach[gy] = wet[gy] & (surface | below);
+                below = reach[gy];
+
+                uint32_t lid = surface;
+                for (int k = 1; k < depth && lid != 0; ++k) lid &= gy - k >= 0 ? wet[gy - k] : 0u;
+                lids[0][gz][gy] = lid;
+                anyLid |= lid;
             }
+            for (int gy = 0; gy < gridSize; ++gy) {
+                uint32_t cell = reach[gy];
+                for (int k = 1; k < depth && cell != 0; ++k) cell &= gy + k < gridSize ? reach[gy + k] : 0u;
+                deep[0][gz][gy] = cell;
+            }
+        }
+        if (anyLid != 0) {
+            transposeColumns(deep, gridSize);
+            transposeColumns(lids, gridSize);
         }
     }
 
-    return mesh;
+    std::array<bool, 6> nbSample;
+    for (int n = 0; n < 6; ++n) nbSample[n] = neighbors[n] && neighborLODs[n] == lod;
+
+    // Neighbour cells for the border faces and AO.
+    MeshApron apron;
+    apron.lod      = lod;
+    apron.gridSize = gridSize;
+    apron.inner    = cols[0];
+    gatherApron(apron, neighbors, nbSample);
+
+    if (anyLid != 0) meshColumns(mesh, cols, deep, apron, nbSample, grid, apron, lids[1]);
+    else             meshColumns(mesh, cols, nullptr, apron, nbSample, grid, apron);
+    countFaceQuads(mesh);
+
+    if (anyLiquid != 0) {
+        transposeColumns(liquid, gridSize);
+
+        // Liquid surfaces: hidden by opaque and liquid cells, inside the chunk and across its border.
+        uint32_t occupiedX[32][32];
+        for (int gz = 0; gz < 32; ++gz)
+            for (int gy = 0; gy < 32; ++gy) occupiedX[gz][gy] = cols[0][gz][gy] | liquid[0][gz][gy];
+        MeshApron liquidApron;
+        liquidApron.lod      = lod;
+        liquidApron.gridSize = gridSize;
+        liquidApron.occupied = true;
+        liquidApron.inner    = occupiedX;
+        gatherApron(liquidApron, neighbors, nbSample);
+
+        meshColumns(mesh, liquid, cols, liquidApron, nbSample, grid, NoOcclusion{},
+                    anyLid != 0 ? lids[1] : nullptr);
+    }
+    mesh.liquidQuads = mesh.quadCount() - mesh.opaqueQuads();
 }
 
 } // namespace world
@@ -1,13 +1,13 @@
 #pragma once
 
 #include "VoxelData.hpp"
-#include "gfx/resources/Mesh.hpp"
 #include <vector>
 #include <array>
 #include <cstdint>
 #include <atomic>
-
-class FastNoiseLite;
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 namespace world {
 
@@ -20,13 +20,65 @@ enum class ChunkState : uint8_t {
     READY       = 2
 };
 
-constexpr int CHUNK_SIZE = 32;
+constexpr int CHUNK_SIZE   = 32;
+constexpr int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+
+// Palette index widths used by Chunk storage: 0 (uniform), 1, 2, 4, 8, 16 bits per voxel.
+// Bucket 0 of a width histogram counts uniform chunks; bucket i > 0 counts (1 << (i-1)) bits.
+constexpr int PALETTE_WIDTH_BUCKETS = 6;
+
+struct DecorationWrite; // DecorationQueue.hpp
+struct MeshApron;       // Chunk.cpp — generateMesh() neighbour bits
+struct VoxelMip;        // Chunk.cpp — reduced grids for LOD meshing
+
+// Upper bound of quads in one chunk mesh: every cell face of the CHUNK_SIZE³ grid.
+// Sizes the shared quad index buffer (GeometryManager::reserveQuadIndices()).
+constexpr uint32_t MAX_CHUNK_QUADS = 3u * CHUNK_SIZE * CHUNK_SIZE * (CHUNK_SIZE + 1);
 
-// CPU-side voxel mesh data (uses compressed VoxelVertex — 8 bytes each)
+// Indices `quadCount` quads draw from the shared quad index buffer (k_quadIndices per quad).
+constexpr uint32_t quadIndexCount(uint32_t quadCount) { return quadCount * 6; }
+
+// Quads per face direction of one mesh, indexed by faceID (0=+X, 1=-X, 2=+Y, 3=-Y, 4=+Z, 5=-Z).
+// A mesh's quads are grouped by faceID in that order: direction f starts at faceQuadFirst(f).
+using FaceQuadCounts = std::array<uint32_t, 6>;
+
+constexpr uint32_t faceQuadFirst(const FaceQuadCounts& counts, int face) {
+    uint32_t first = 0;
+    for (int f = 0; f < face; ++f) first += counts[f];
+    return first;
+}
+constexpr uint32_t faceQuadTotal(const FaceQuadCounts& counts) { return faceQuadFirst(counts, 6); }
+
+// Face directions (bit faceID) of chunk (cx, cy, cz)'s mesh that can face an eye at (ex, ey, ez),
+// world blocks. +d faces lie on planes above the chunk's min[d], -d faces below its max[d]; a
+// face only shows its front to an eye on its normal side, so the rest are back faces.
+constexpr uint32_t chunkFacingMask(int cx, int cy, int cz, float ex, float ey, float ez) {
+    const int   c[3] = {cx, cy, cz};
+    const float e[3] = {ex, ey, ez};
+    uint32_t mask = 0;
+    for (int d = 0; d < 3; ++d) {
+        const float lo = static_cast<float>(c[d] * CHUNK_SIZE);
+        if (e[d] > lo)              mask |= 1u << (d * 2);     // +d
+        if (e[d] < lo + CHUNK_SIZE) mask |= 1u << (d * 2 + 1); // -d
+    }
+    return mask;
+}
+
+// CPU-side voxel mesh data: one 8-byte VoxelQuad per greedy quad, expanded to its
+// corners by the vertex shader. No vertices, no indices. Two streams in one array:
+//   [0, opaqueQuads())            opaque quads, grouped by face direction (faceQuads), so the
+//                                 renderer can draw only the directions that can face the camera;
+//                                 includes the unshaded +Y lids of deep water;
+//   [opaqueQuads(), quadCount())  liquidQuads translucent surface quads (water), drawn blended
+//                                 after the opaque pass. Not AO-shaded.
 struct VoxelMeshData {
-    std::vector<VoxelVertex> vertices;
-    std::vector<uint32_t>    indices;
-    bool empty() const { return vertices.empty(); }
+    std::vector<VoxelQuad> quads;
+    FaceQuadCounts         faceQuads{};
+    uint32_t               liquidQuads = 0;
+    uint32_t opaqueQuads() const { return faceQuadTotal(faceQuads); }
+    bool     empty()      const { return quads.empty(); }
+    uint32_t quadCount()  const { return static_cast<uint32_t>(quads.size()); }
+    uint32_t indexCount() const { return quadIndexCount(quadCount()); }
 };
 
 struct TerrainConfig {
@@ -70,43 +122,127 @@ struct TerrainConfig {
     // --- Rivers ---
     int   riverDepth  = 18;   // blocks below seaLevel that river trenches carve
     float riverWidth  = 0.10f; // ridged-noise threshold: lower = narrower rivers
+
+    // --- Caves / overhangs (3D density, see CaveDensity.hpp) ---
+    bool  caves         = true;
+    float caveFrequency = 0.03f; // 3D noise frequency: higher = smaller, more frequent caves
+    float caveThreshold = 0.45f; // density above this is carved: lower = more hollow ground
+    float caveSquash    = 1.8f;  // vertical frequency multiplier: >1 = flatter, wider caverns
+
+    // --- Decoration (cross-chunk structures, see DecorationQueue.hpp) ---
+    bool  trees       = true;
+    float treeDensity = 0.30f; // chance of a tree per 8×8-block cell of grass
 };
 
+// Stable 64-bit hash of every TerrainConfig field (FNV-1a). Identical configs generate
+// identical terrain, so the hash names the save directory a world's edits belong to.
+uint64_t hashTerrainConfig(const TerrainConfig& config);
+
 class Chunk {
 public:
     // chunkCoord: grid position (multiply by CHUNK_SIZE to get world offset)
     explicit Chunk(int cx = 0, int cy = 0, int cz = 0);
     
-    void reset(int cx, int cy, int cz) {
-        m_cx = cx; m_cy = cy; m_cz = cz;
-        m_isDirty = true;
-        m_state.store(ChunkState::UNGENERATED, std::memory_order_release);
-    }
+    // Re-targets a pooled chunk to new coordinates: payload becomes uniform AIR (index buffer
+    // capacity is kept for the next encode), state UNGENERATED, edit / LOD markers cleared.
+    void reset(int cx, int cy, int cz);
 
     // ---- Voxel access -------------------------------------------------------
+    // Storage is palette-compressed: each chunk keeps a small table of distinct VoxelData
+    // values plus CHUNK_VOLUME bit-packed indices (1/2/4/8/16 bits, grown on demand).
+    // A uniform chunk (all air / all stone / all water) keeps one palette entry and no index
+    // payload at all; the first setVoxel() with a different value upgrades it to 1 bit.
     void      setVoxel(int x, int y, int z, VoxelData v);
     VoxelData getVoxel(int x, int y, int z) const;
 
+    // Fast bulk paths. decodeVoxels() expands the whole payload into `out` (CHUNK_VOLUME
+    // entries, idx() order) with one palette lookup per voxel and no per-voxel locking.
+    // encodeVoxels() replaces the payload from such an array and rebuilds a tight palette.
+    // With lod > 0, `in` is the reduced grid: (CHUNK_SIZE >> lod)³ voxels in idx() order of
+    // that grid, one per (1 << lod)³ block (see getPayloadLod()).
+    void decodeVoxels(VoxelData* out) const;
+    void encodeVoxels(const VoxelData* in, int lod = 0);
+
+    // ---- Reduced-resolution payload ----------------------------------------------
+    // Far chunks may be generated at their mesh LOD: only the origin voxel of every
+    // (1 << lod)³ block is stored and stands for the whole block; generateMesh() at that LOD
+    // meshes these cells directly. 0 = full resolution. Edits, fill() and a full
+    // encodeVoxels() always leave a full-resolution payload.
+    int  getPayloadLod() const;
+    bool isReduced()     const { return getPayloadLod() > 0; }
+
+    // ---- Voxel mip chain (LOD meshing) --------------------------------------------
+    // generateMesh() at lod > 0 meshes a (CHUNK_SIZE >> lod)³ grid. A payload finer than
+    // `lod` is reduced to it once, 2×2×2 -> 1 per level (surface priority: an opaque child
+    // wins, the topmost one, then a translucent one, so thin walls / trunks / water surfaces
+    // survive), read straight from the packed payload, and the levels at `lod` and coarser are
+    // kept (8-bit indices) until the payload changes. A reduced payload at `lod` or coarser is
+    // its own grid; uniform chunks need none.
+    size_t getMipBytes() const; // heap bytes of the cached levels (0 if none)
+
+    // ---- Palette stats --------------------------------------------------------
+    int    getPaletteBits() const; // bits per packed index: 0 (uniform), 1, 2, 4, 8 or 16
+    size_t getPaletteSize() const; // number of palette entries (may include stale ones after edits)
+    size_t getVoxelBytes()  const; // heap bytes held by palette + packed indices
+
+    // ---- Uniform mode -----------------------------------------------------------
+    bool      isUniform()       const; // single VoxelData value, no index payload
+    VoxelData getUniformVoxel() const; // valid only while isUniform()
+
+    // True when generateMesh() with these arguments is guaranteed to produce no geometry:
+    // the chunk is uniform AIR, or uniform opaque / liquid and every face borders a same-LOD
+    // neighbour that hides it (uniform opaque; for liquid also uniform liquid) or is still
+    // generating.
+    // Cheap — no payload is decoded.
+    bool isMeshTriviallyEmpty(const std::array<const Chunk*, 6>& neighbors,
+                              const std::array<int, 6>& neighborLODs,
+                              int lod) const;
+
     // ---- Fill helpers -------------------------------------------------------
     void fill(VoxelData v);
-    void fillTerrain(const TerrainConfig& config, FastNoiseLite* noise = nullptr);   // heightmap-based terrain
+    // Heightmap-based terrain (TerrainGenerator). lod > 0 generates the reduced payload only.
+    void fillTerrain(const TerrainConfig& config, int lod = 0);
+    // Regenerates a reduced payload at the finer `lod`. No-op (returns false) if the payload
+    // is already at `lod` or finer by the time it would be replaced — an edit in between wins.
+    bool refineTerrain(const TerrainConfig& config, int lod = 0);
+    // Main thread: structure voxels a neighbour's DECORATE stage spilled into this chunk after
+    // it had generated (DecorationQueue). Follows decorationReplaces(); a reduced payload
+    // keeps only the writes at its block origins. Returns true if any voxel changed.
+    bool applyDecoration(const std::vector<DecorationWrite>& writes);
     void fillRandom(int seed = 0);    // random solid/air for testing
 
     // ---- Mesh generation ----------------------------------------------------
-    // Hidden Face Culling — only emit faces adjacent to AIR.
+    // Hidden Face Culling — opaque voxels emit faces towards cells that are not opaque (AIR or
+    // liquid: the seabed stays visible through shallow water); liquid / transparent voxels emit
+    // their surface only, towards cells that are neither (VoxelMeshData::liquidQuads). Deep
+    // water (DEEP_LIQUID_BLOCKS in Chunk.cpp): its surface is an opaque lid and opaque faces
+    // towards the liquid under it are culled.
     // neighbors[6]: adjacent chunks in order +X,-X,+Y,-Y,+Z,-Z.
     // Pass nullptr for a neighbour to treat that boundary as AIR.
-    // Coordinates in VoxelVertex are LOCAL (0-31) — chunk offset is applied
-    // in the vertex shader via push constants (chunkOffset).
+    // Coordinates in VoxelQuad are LOCAL (0-32) — chunk offset is applied
+    // in the vertex shader from the instance SSBO.
     //
     // lod: Level of Detail (0=full, 1=half, 2=quarter resolution)
     //   step = 1 << lod  (1, 2, or 4 voxels per super-voxel)
     //   LOD 0: every voxel, full Greedy Meshing
-    //   LOD 1: 2×2×2 super-voxels, ~4× fewer vertices
-    //   LOD 2: 4×4×4 super-voxels, ~16× fewer vertices
+    //   LOD 1: 2×2×2 super-voxels, ~4× fewer quads
+    //   LOD 2: 4×4×4 super-voxels, ~16× fewer quads
+    //   A super-voxel is the chunk's mip cell at that LOD (see acquireMip()), neighbours
+    //   are sampled the same way.
+    //
+    // Face masks come from 32-bit occupancy columns (binary greedy meshing).
     VoxelMeshData generateMesh(const std::array<const Chunk*, 6>& neighbors = {},
                                const std::array<int, 6>& neighborLODs = {},
                                int lod = 0) const;
+    // Same, into `out` (cleared first, capacity kept) — lets mesh workers reuse one buffer.
+    void generateMesh(const std::array<const Chunk*, 6>& neighbors,
+                      const std::array<int, 6>& neighborLODs,
+                      int lod, VoxelMeshData& out) const;
+    // The previous per-voxel mask build; same arguments, identical output. Slow — kept as
+    // the correctness / speed reference for generateMesh() (`--bench mesher`).
+    VoxelMeshData generateMeshReference(const std::array<const Chunk*, 6>& neighbors = {},
+                                        const std::array<int, 6>& neighborLODs = {},
+                                        int lod = 0) const;
 
     // ---- State --------------------------------------------------------------
     bool isDirty()  const { return m_isDirty; }
@@ -118,16 +254,20 @@ public:
     int getCY() const { return m_cy; }
     int getCZ() const { return m_cz; }
 
-    // Storage lifecycle state. This tracks voxel readiness only; GPU mesh state lives in ChunkRenderer.
+    // Storage lifecycle state. This tracks voxel readiness only; mesh state lives in ChunkMesher (and the ChunkMeshSink).
     std::atomic<ChunkState> m_state{ChunkState::READY};
 
     // Tracks player edits to avoid destroying chunk data during Tier-4 stream unloads
     std::atomic<bool> m_isModified{false};
 
-    // Current render lifecycle marker assigned by ChunkManager / ChunkRenderer.
+    // Current render lifecycle marker assigned by ChunkManager / ChunkMesher.
     // Values: -1 (voxel data ready but no GPU mesh assigned yet), -2 (mesh evicted, voxels kept), or 0,1,2...
     std::atomic<int> m_currentLOD{-1};
 
+    // Number of queued / running MeshWorker tasks that reference this chunk (as target or
+    // neighbour). ChunkPool never recycles a chunk while this is non-zero.
+    mutable std::atomic<uint32_t> m_taskRefs{0};
+
     // World-space offset of this chunk's (0,0,0) corner (in block units)
     float getWorldOffsetX() const { return static_cast<float>(m_cx * CHUNK_SIZE); }
     float getWorldOffsetY() const { return static_cast<float>(m_cy * CHUNK_SIZE); }
@@ -145,13 +285,77 @@ public:
     static uint8_t computeAO(bool side1, bool side2, bool corner);
 
 private:
-    VoxelData m_voxels[CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE]{};
+    // Palette-compressed payload. m_indices packs payloadVolume() palette indices at m_bits per
+    // voxel into 64-bit words; widths are powers of two so an index never straddles a word.
+    // m_bits == 0 is the uniform mode: m_palette[0] is every voxel and m_indices is empty.
+    // m_payloadLod > 0: the indices cover the reduced (CHUNK_SIZE >> m_payloadLod)³ grid.
+    std::vector<VoxelData> m_palette{VOXEL_AIR};
+    std::vector<uint64_t>  m_indices;
+    uint8_t m_bits       = 0;
+    uint8_t m_bitsLog2   = 0;
+    uint8_t m_payloadLod = 0;
+
+    // Guards reallocation of m_palette / m_indices. Mesh workers read under a shared lock;
+    // writers only lock exclusively when the payload is replaced or re-packed to a wider width.
+    // In-place index writes from the main thread stay lock-free, like the old flat array.
+    mutable std::shared_mutex m_paletteMutex;
+
     int  m_cx, m_cy, m_cz;
     bool m_isDirty = true;
 
+    // Mip chain of the current payload, built lazily by acquireMip(). m_payloadVersion changes
+    // with every payload write (invalidateMip()); a cached VoxelMip of an older version is
+    // rebuilt on the next acquire. Lock order: m_mipMutex, then m_paletteMutex.
+    mutable std::shared_ptr<const VoxelMip> m_mip;
+    mutable std::mutex                      m_mipMutex;
+    std::atomic<uint32_t>                   m_payloadVersion{0};
+
     static int idx(int x, int y, int z) {
         return x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
     }
+
+    // Index of local (x, y, z) in the payload grid; idx() for a full-resolution payload.
+    int payloadIdx(int x, int y, int z) const {
+        const int l = m_payloadLod;
+        const int s = CHUNK_SIZE >> l;
+        return (x >> l) + (y >> l) * s + (z >> l) * s * s;
+    }
+    int payloadVolume() const { return CHUNK_VOLUME >> (3 * m_payloadLod); }
+
+    // Unlocked payload helpers — callers hold m_paletteMutex or own the chunk exclusively.
+    uint32_t  readIndex(int i) const;
+    void      writeIndex(int i, uint32_t paletteIdx);
+    VoxelData getVoxelUnlocked(int x, int y, int z) const { return m_palette[readIndex(payloadIdx(x, y, z))]; }
+    uint32_t  addPaletteEntry(VoxelData v); // takes m_paletteMutex exclusively
+    void      repack(uint8_t newBits);
+    void      setUniformUnlocked(VoxelData v, int lod = 0);
+    void      invalidateMip() { m_payloadVersion.fetch_add(1, std::memory_order_release); }
+
+    // Mesh grid at `lod`: the cached (or freshly built) mip levels, nullptr where the payload
+    // itself is the grid (lod 0, uniform, payload at `lod` or coarser). Takes m_mipMutex.
+    std::shared_ptr<const VoxelMip> acquireMip(int lod) const;
+    // The cached levels if they are current, without building any. Neighbours read only a
+    // slab of cells, which is cheaper to reduce on the fly than a whole chain.
+    std::shared_ptr<const VoxelMip> cachedMip(int lod) const;
+    // Grid cell (gx, gy, gz) at `lod` from a VoxelMip, or reduced from the payload when mip is
+    // nullptr (same value). Needs m_paletteMutex (shared) when mip is nullptr.
+    VoxelData gridCellUnlocked(const VoxelMip* mip, int lod, int gx, int gy, int gz) const;
+    // All (CHUNK_SIZE >> lod)³ grid cells into `out`, idx() order of that grid.
+    void      decodeGrid(VoxelData* out, int lod, const VoxelMip* mip) const;
+
+    // Reference mesher input: the grid at `lod` replicated into selfVoxels (CHUNK_VOLUME) and
+    // volumeCache (padded, see Chunk.cpp) filled with it plus the neighbours' border cells.
+    void buildMeshCache(VoxelData* volumeCache, VoxelData* selfVoxels,
+                        const std::array<const Chunk*, 6>& neighbors, int lod) const;
+    // generateMesh() input: the neighbours' cells touching this chunk, as MeshApron bit slabs.
+    static void gatherApron(MeshApron& apron, const std::array<const Chunk*, 6>& neighbors,
+                            const std::array<bool, 6>& sameLod);
+
+    // encodeVoxels() / fillTerrain() / refineTerrain() body. With onlyIfCoarser the payload is
+    // replaced only while the current one is coarser than `lod` (checked under the lock).
+    bool encodePayload(const VoxelData* in, int lod, bool onlyIfCoarser);
+    bool generateTerrain(const TerrainConfig& config, int lod, bool onlyIfCoarser);
+    void expandPayload(); // reduced -> full resolution by block replication (edit fallback)
 };
 
 } // namespace world
@@ -0,0 +1,219 @@
+#include "world/ChunkCodec.hpp"
+#include <cstring>
+#include <unordered_map>
+
+namespace world {
+
+namespace {
+
+// Per-thread scratch: encode/decode run on the region writer, loaders and the main thread.
+thread_local VoxelData tl_voxels[CHUNK_VOLUME];
+thread_local uint16_t  tl_paletteIdx[CHUNK_VOLUME];
+
+void putU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+}
+
+void putVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// Bounds-checked little-endian reader over an encoded payload.
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    bool u8(uint8_t& v)   { if (end - p < 1) return false; v = *p++; return true; }
+    bool u16(uint16_t& v) {
+        if (end - p < 2) return false;
+        v = static_cast<uint16_t>(p[0] | (p[1] << 8));
+        p += 2;
+        return true;
+    }
+    bool u32(uint32_t& v) {
+        if (end - p < 4) return false;
+        v = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+          | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        p += 4;
+        return true;
+    }
+    bool varint(uint32_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t b;
+            if (!u8(b)) return false;
+            v |= static_cast<uint32_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+};
+
+// Y-column walk order used by COLUMN_RLE: x, z outer, y inner (bottom-up).
+inline int columnOrderIndex(int x, int y, int z) {
+    return x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
+}
+
+} // namespace
+
+void encodeChunkPayload(const Chunk& chunk, std::vector<uint8_t>& out) {
+    chunk.decodeVoxels(tl_voxels);
+
+    // Tight palette of the values actually present (the chunk's own palette may hold stale entries).
+    std::vector<uint32_t> palette;
+    std::unordered_map<uint32_t, uint16_t> lookup;
+    uint32_t lastRaw = tl_voxels[0].raw;
+    uint16_t lastIdx = 0;
+    palette.push_back(lastRaw);
+    lookup.emplace(lastRaw, 0);
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        const uint32_t raw = tl_voxels[i].raw;
+        if (raw != lastRaw) {
+            auto [it, inserted] = lookup.emplace(raw, static_cast<uint16_t>(palette.size()));
+            if (inserted) palette.push_back(raw);
+            lastRaw = raw;
+            lastIdx = it->second;
+        }
+        tl_paletteIdx[i] = lastIdx;
+    }
+
+    if (palette.size() == 1) {
+        out.push_back(static_cast<uint8_t>(ChunkCodec::UNIFORM));
+        putU32(out, palette[0]);
+        return;
+    }
+
+    uint32_t bits = 1;
+    while ((size_t{1} << bits) < palette.size()) bits <<= 1;
+    const size_t packedBytes = static_cast<size_t>(CHUNK_VOLUME) * bits / 8;
+
+    // Build the RLE body first; it is kept only if it beats the packed form.
+    const bool wideIndex = palette.size() > 256;
+    thread_local std::vector<uint8_t> tl_rle;
+    tl_rle.clear();
+    uint32_t runLength = 0;
+    uint16_t runValue  = 0;
+    auto flushRun = [&]() {
+        putVarint(tl_rle, runLength);
+        if (wideIndex) putU16(tl_rle, runValue);
+        else           tl_rle.push_back(static_cast<uint8_t>(runValue));
+    };
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            for (int y = 0; y < CHUNK_SIZE; ++y) {
+                const uint16_t v = tl_paletteIdx[columnOrderIndex(x, y, z)];
+                if (runLength > 0 && v == runValue) { ++runLength; continue; }
+                if (runLength > 0) flushRun();
+                runValue  = v;
+                runLength = 1;
+            }
+        }
+    }
+    flushRun();
+
+    const bool useRle = tl_rle.size() < packedBytes;
+    out.reserve(out.size() + 3 + palette.size() * 4 + (useRle ? tl_rle.size() : packedBytes));
+    out.push_back(static_cast<uint8_t>(useRle ? ChunkCodec::COLUMN_RLE : ChunkCodec::PACKED));
+    putU16(out, static_cast<uint16_t>(palette.size()));
+    for (uint32_t raw : palette) putU32(out, raw);
+
+    if (useRle) {
+        out.insert(out.end(), tl_rle.begin(), tl_rle.end());
+        return;
+    }
+
+    // Same word layout as Chunk::m_indices: power-of-two widths never straddle a 64-bit word.
+    const uint32_t perWord = 64 / bits;
+    for (int base = 0; base < CHUNK_VOLUME; base += static_cast<int>(perWord)) {
+        uint64_t word = 0;
+        for (uint32_t j = 0; j < perWord; ++j) {
+            word |= static_cast<uint64_t>(tl_paletteIdx[base + static_cast<int>(j)]) << (j * bits);
+        }
+        for (int b = 0; b < 8; ++b) out.push_back(static_cast<uint8_t>(word >> (b * 8)));
+    }
+}
+
+bool decodeChunkPayload(const uint8_t* data, size_t size, Chunk& chunk) {
+    Reader r{data, data + size};
+    uint8_t codec;
+    if (!r.u8(codec)) return false;
+
+    if (codec == static_cast<uint8_t>(ChunkCodec::UNIFORM)) {
+        uint32_t raw;
+        if (!r.u32(raw)) return false;
+        chunk.fill(VoxelData{raw});
+        return true;
+    }
+    if (codec != static_cast<uint8_t>(ChunkCodec::PACKED) &&
+        codec != static_cast<uint8_t>(ChunkCodec::COLUMN_RLE)) {
+        return false;
+    }
+
+    uint16_t paletteSize;
+    if (!r.u16(paletteSize) || paletteSize < 2) return false;
+    thread_local std::vector<VoxelData> palette;
+    palette.resize(paletteSize);
+    for (uint16_t i = 0; i < paletteSize; ++i) {
+        uint32_t raw;
+        if (!r.u32(raw)) return false;
+        palette[i] = VoxelData{raw};
+    }
+
+    if (codec == static_cast<uint8_t>(ChunkCodec::PACKED)) {
+        uint32_t bits = 1;
+        while ((1u << bits) < paletteSize) bits <<= 1;
+        const uint32_t perWord = 64 / bits;
+        const uint64_t mask    = (uint64_t{1} << bits) - 1;
+        if (static_cast<size_t>(r.end - r.p) < static_cast<size_t>(CHUNK_VOLUME) * bits / 8) return false;
+        for (int base = 0; base < CHUNK_VOLUME; base += static_cast<int>(perWord)) {
+            uint64_t word;
+            std::memcpy(&word, r.p, sizeof(word)); // payload is little-endian like the host
+            r.p += sizeof(word);
+            for (uint32_t j = 0; j < perWord; ++j) {
+                const uint32_t idx = static_cast<uint32_t>((word >> (j * bits)) & mask);
+                if (idx >= paletteSize) return false;
+                tl_voxels[base + static_cast<int>(j)] = palette[idx];
+            }
+        }
+    } else {
+        const bool wideIndex = paletteSize > 256;
+        int x = 0, y = 0, z = 0;
+        int remaining = CHUNK_VOLUME;
+        while (remaining > 0) {
+            uint32_t runLength;
+            uint16_t value;
+            if (!r.varint(runLength) || runLength == 0 || runLength > static_cast<uint32_t>(remaining)) return false;
+            if (wideIndex) {
+                if (!r.u16(value)) return false;
+            } else {
+                uint8_t v8;
+                if (!r.u8(v8)) return false;
+                value = v8;
+            }
+            if (value >= paletteSize) return false;
+            const VoxelData v = palette[value];
+            remaining -= static_cast<int>(runLength);
+            for (uint32_t n = 0; n < runLength; ++n) {
+                tl_voxels[columnOrderIndex(x, y, z)] = v;
+                if (++y == CHUNK_SIZE) {
+                    y = 0;
+                    if (++x == CHUNK_SIZE) { x = 0; ++z; }
+                }
+            }
+        }
+    }
+
+    chunk.encodeVoxels(tl_voxels);
+    return true;
+}
+
+} // namespace world
@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "world/Chunk.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// ChunkCodec — compact, self-describing serialization of a chunk's voxel payload.
+//
+// Payload layout (little-endian):
+//   u8  codec
+//   UNIFORM     : u32 voxel
+//   PACKED      : u16 paletteSize, u32 palette[], indices bit-packed at the narrowest
+//                 power-of-two width (1/2/4/8/16) in 64-bit words, idx() order
+//   COLUMN_RLE  : u16 paletteSize, u32 palette[], runs of (varint length, u8/u16 index)
+//                 walking Y columns bottom-up (x, z outer) — terrain is mostly long
+//                 vertical runs of stone / air, so this is usually the smallest form
+//
+// encodeChunk() picks the smallest of PACKED / COLUMN_RLE (UNIFORM when it applies).
+// Thread-safe for concurrent readers of the source chunk (decodeVoxels() takes a shared lock).
+// ---------------------------------------------------------------------------
+enum class ChunkCodec : uint8_t {
+    UNIFORM    = 0,
+    PACKED     = 1,
+    COLUMN_RLE = 2,
+};
+
+// Appends the encoded payload of `chunk` to `out`.
+void encodeChunkPayload(const Chunk& chunk, std::vector<uint8_t>& out);
+
+// Replaces the payload of `chunk` from an encoded buffer. Returns false (chunk untouched)
+// if the buffer is truncated or malformed.
+bool decodeChunkPayload(const uint8_t* data, size_t size, Chunk& chunk);
+
+} // namespace world
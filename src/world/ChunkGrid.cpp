@@ -0,0 +1,157 @@
+#include "world/ChunkGrid.hpp"
+#include <bit>
+
+namespace world {
+
+ChunkGrid::Page* ChunkGrid::probePage(uint64_t key) const {
+    if (m_slots.empty()) return nullptr;
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = homeSlot(key);; i = (i + 1) & mask) {
+        const Slot& s = m_slots[i];
+        if (!s.page) return nullptr;
+        if (s.key == key) return s.page.get();
+    }
+}
+
+const ChunkGrid::CachedPage& ChunkGrid::cachePage(uint64_t key) const {
+    cacheEntry(key, probePage(key));
+    return m_pageCache[cacheIndex(key)];
+}
+
+void ChunkGrid::cacheEntry(uint64_t key, const Page* page) const {
+    CachedPage& entry = m_pageCache[cacheIndex(key)];
+    entry.key        = key;
+    entry.yBase      = page ? page->yBase : 0;
+    entry.layers     = page ? page->layers.data() : nullptr;
+    entry.layerCount = page ? static_cast<uint32_t>(page->layers.size()) : 0u;
+}
+
+void ChunkGrid::resetPageCache() {
+    for (size_t i = 0; i < m_pageCache.size(); ++i) {
+        // Page (px ^ 1, pz) of slot i maps to slot i ^ 1 — this entry can never hit.
+        const int px = static_cast<int>(i) & PAGE_CACHE_MASK;
+        const int pz = static_cast<int>(i) >> PAGE_CACHE_BITS;
+        m_pageCache[i] = {pageKey(px ^ 1, pz), 0, nullptr, 0u};
+    }
+}
+
+void ChunkGrid::insert(int cx, int cy, int cz, Chunk* chunk) {
+    if (!chunk) {
+        erase(cx, cy, cz);
+        return;
+    }
+
+    const uint64_t key = pageKey(cx >> PAGE_SHIFT, cz >> PAGE_SHIFT);
+    Page* page = findOrCreatePage(key);
+
+    // Grow the page's Y range to cover cy (new layers start empty).
+    if (page->layers.empty()) {
+        page->yBase = cy;
+        page->layers.resize(1, Layer{});
+    } else if (cy < page->yBase) {
+        const size_t extra = static_cast<size_t>(page->yBase - cy);
+        page->layers.insert(page->layers.begin(), extra, Layer{});
+        page->yBase = cy;
+    } else if (static_cast<size_t>(cy - page->yBase) >= page->layers.size()) {
+        page->layers.resize(static_cast<size_t>(cy - page->yBase) + 1, Layer{});
+    }
+    cacheEntry(key, page); // layers may have moved
+
+    Chunk*& cell = page->layers[static_cast<size_t>(cy - page->yBase)][columnIndex(cx, cz)];
+    if (!cell) {
+        ++page->count;
+        ++m_count;
+    }
+    cell = chunk;
+}
+
+void ChunkGrid::erase(int cx, int cy, int cz) {
+    const uint64_t key = pageKey(cx >> PAGE_SHIFT, cz >> PAGE_SHIFT);
+    Page* page = probePage(key);
+    if (!page) return;
+
+    const size_t ly = static_cast<size_t>(static_cast<int64_t>(cy) - page->yBase);
+    if (ly >= page->layers.size()) return;
+
+    Chunk*& cell = page->layers[ly][columnIndex(cx, cz)];
+    if (!cell) return;
+    cell = nullptr;
+    --m_count;
+    if (--page->count == 0) {
+        // Streamed-out regions give their memory back; an unbounded walk stays bounded in RAM.
+        erasePage(key);
+    }
+}
+
+void ChunkGrid::clear() {
+    m_slots.clear();
+    m_hashShift = 64;
+    m_pageCount = 0;
+    m_count     = 0;
+    resetPageCache();
+}
+
+size_t ChunkGrid::memoryBytes() const {
+    size_t bytes = m_slots.capacity() * sizeof(Slot);
+    for (const Slot& s : m_slots) {
+        if (s.page) bytes += sizeof(Page) + s.page->layers.capacity() * sizeof(Layer);
+    }
+    return bytes;
+}
+
+ChunkGrid::Page* ChunkGrid::findOrCreatePage(uint64_t key) {
+    if (Page* existing = probePage(key)) return existing;
+
+    // Keep the load factor at or below 1/2 so probes stay short.
+    if ((m_pageCount + 1) * 2 > m_slots.size()) {
+        rehash(m_slots.empty() ? 64 : m_slots.size() * 2);
+    }
+
+    const size_t mask = m_slots.size() - 1;
+    size_t i = homeSlot(key);
+    while (m_slots[i].page) i = (i + 1) & mask;
+
+    m_slots[i].key  = key;
+    m_slots[i].page = std::make_unique<Page>();
+    ++m_pageCount;
+
+    return m_slots[i].page.get(); // insert() refreshes the page cache entry
+}
+
+void ChunkGrid::erasePage(uint64_t key) {
+    const size_t mask = m_slots.size() - 1;
+    size_t hole = homeSlot(key);
+    while (m_slots[hole].key != key || !m_slots[hole].page) hole = (hole + 1) & mask;
+
+    cacheEntry(key, nullptr);
+    m_slots[hole].page.reset();
+    --m_pageCount;
+
+    // Backward-shift deletion: pull later entries of the probe run into the hole so lookups
+    // never need tombstones.
+    for (size_t j = (hole + 1) & mask; m_slots[j].page; j = (j + 1) & mask) {
+        const size_t home = homeSlot(m_slots[j].key);
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            m_slots[hole] = std::move(m_slots[j]);
+            hole = j;
+        }
+    }
+}
+
+void ChunkGrid::rehash(size_t newCapacity) {
+    std::vector<Slot> old = std::move(m_slots);
+    m_slots.clear();
+    m_slots.resize(newCapacity);
+    m_hashShift = 64 - std::countr_zero(newCapacity);
+
+    const size_t mask = newCapacity - 1;
+    for (Slot& s : old) {
+        if (!s.page) continue;
+        size_t i = homeSlot(s.key);
+        while (m_slots[i].page) i = (i + 1) & mask;
+        m_slots[i] = std::move(s);
+    }
+    // Page objects did not move (unique_ptr), so the page cache stays valid.
+}
+
+} // namespace world
@@ -0,0 +1,122 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace world {
+
+class Chunk;
+
+// ---------------------------------------------------------------------------
+// ChunkGrid — sparse paged Chunk* lookup for an unbounded world.
+//
+// Columns are grouped into 16×16 pages addressed by their 2D page coordinate.
+// Page keys are 64-bit (two full int32 halves), so every chunk coordinate is
+// valid — there is no world-size cap. Each page keeps a contiguous Y range of
+// 16×16 pointer layers that grows on demand, up or down.
+//
+// find() cost: one key compare in a direct-mapped page cache (16×16 pages, slot = low bits
+// of the page coordinate, no hash) that holds the page's Y range, then the layer load.
+// Absent pages are cached too, so lookups outside the world cost the same. Only when the
+// slot holds another page (pages 16 apart share a slot) does find() pay the multiplicative
+// hash and the short linear probe of the open-addressing table (load <= 1/2).
+// `--bench grid` (radius 64, median of 9 runs) vs the dense index math: neighbours 1.01×,
+// ray walk 0.87×, scattered lookups 1.00×. Worlds wider than 256 chunks per axis thrash
+// the cache on scattered access and fall back to the probe.
+//
+// Not thread-safe (the page cache is mutated by find()); like the rest of
+// ChunkStorage it is owned by the main thread.
+// ---------------------------------------------------------------------------
+class ChunkGrid {
+public:
+    static constexpr int PAGE_SHIFT = 4;
+    static constexpr int PAGE_SIZE  = 1 << PAGE_SHIFT; // 16 columns per side
+    static constexpr int PAGE_MASK  = PAGE_SIZE - 1;
+
+    ChunkGrid() { resetPageCache(); }
+    ChunkGrid(const ChunkGrid&) = delete;
+    ChunkGrid& operator=(const ChunkGrid&) = delete;
+
+    Chunk* find(int cx, int cy, int cz) const {
+        const int         px    = cx >> PAGE_SHIFT, pz = cz >> PAGE_SHIFT;
+        const uint64_t    key   = pageKey(px, pz);
+        const CachedPage* entry = &m_pageCache[cacheIndex(px, pz)];
+        if (entry->key != key) entry = &cachePage(key);
+        const size_t ly = static_cast<size_t>(static_cast<int64_t>(cy) - entry->yBase);
+        if (ly >= entry->layerCount) return nullptr; // also rejects cy < yBase (wraps)
+        return entry->layers[ly][columnIndex(cx, cz)];
+    }
+
+    // Stores `chunk` at (cx,cy,cz), replacing any previous pointer. nullptr erases.
+    void insert(int cx, int cy, int cz, Chunk* chunk);
+    void erase(int cx, int cy, int cz);
+    void clear();
+
+    size_t size()        const { return m_count; }
+    size_t pageCount()   const { return m_pageCount; }
+    size_t memoryBytes() const; // pages + slot table, for benchmarks / stats
+
+private:
+    using Layer = std::array<Chunk*, PAGE_SIZE * PAGE_SIZE>;
+
+    struct Page {
+        int64_t            yBase = 0;
+        std::vector<Layer> layers;   // layers[cy - yBase]
+        uint32_t           count = 0; // non-null entries; the page is freed at 0
+    };
+
+    struct Slot {
+        uint64_t              key = 0;
+        std::unique_ptr<Page> page; // nullptr = empty slot
+    };
+
+    // Direct-mapped page cache entry: a copy of the page's Y range, so a hit never touches
+    // the Page. An absent page is cached with layerCount 0. Refreshed whenever the page's
+    // layers change (insert) or the page goes away (erasePage). Empty entries hold a key of
+    // another cache slot (resetPageCache), so a hit is a single key compare.
+    struct CachedPage {
+        uint64_t     key        = 0;
+        int64_t      yBase      = 0;
+        const Layer* layers     = nullptr;
+        uint32_t     layerCount = 0;
+    };
+    static constexpr int PAGE_CACHE_BITS = 4; // 16×16 pages = 256×256 columns
+    static constexpr int PAGE_CACHE_MASK = (1 << PAGE_CACHE_BITS) - 1;
+
+    static uint64_t pageKey(int px, int pz) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(px)) << 32)
+             |  static_cast<uint64_t>(static_cast<uint32_t>(pz));
+    }
+    static size_t cacheIndex(int px, int pz) {
+        return static_cast<size_t>((px & PAGE_CACHE_MASK) | ((pz & PAGE_CACHE_MASK) << PAGE_CACHE_BITS));
+    }
+    static size_t cacheIndex(uint64_t key) { // inverse of pageKey()
+        return cacheIndex(static_cast<int>(static_cast<uint32_t>(key >> 32)),
+                          static_cast<int>(static_cast<uint32_t>(key)));
+    }
+    static int columnIndex(int cx, int cz) {
+        return (cx & PAGE_MASK) + ((cz & PAGE_MASK) << PAGE_SHIFT);
+    }
+    size_t homeSlot(uint64_t key) const {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_hashShift);
+    }
+
+    const CachedPage& cachePage(uint64_t key) const;                  // miss: probe, fill the entry
+    void              cacheEntry(uint64_t key, const Page* page) const; // page nullptr = absent
+    void              resetPageCache();
+    Page*             probePage(uint64_t key) const;                  // nullptr if absent
+    Page*             findOrCreatePage(uint64_t key);
+    void  erasePage(uint64_t key);
+    void  rehash(size_t newCapacity);
+
+    std::vector<Slot> m_slots;      // power-of-two capacity
+    int               m_hashShift = 64;
+    size_t            m_pageCount = 0;
+    size_t            m_count     = 0;
+
+    mutable std::array<CachedPage, 1u << (2 * PAGE_CACHE_BITS)> m_pageCache{};
+};
+
+} // namespace world
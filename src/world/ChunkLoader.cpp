@@ -0,0 +1,174 @@
+#include "world/ChunkLoader.hpp"
+#include "world/WorldBaker.hpp"
+#include <algorithm>
+
+namespace world {
+
+ChunkLoader::ChunkLoader(RegionStore& regions, RegionStore& baked, uint32_t threadCount)
+    : m_regions(regions)
+    , m_baked(baked)
+{
+    threadCount = std::max(1u, threadCount);
+    m_threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back([this](std::stop_token st) { workerLoop(st); });
+    }
+}
+
+ChunkLoader::~ChunkLoader() {
+    for (auto& t : m_threads) t.request_stop();
+    m_cv.notify_all();
+    m_threads.clear(); // join
+    cancelAll();
+}
+
+void ChunkLoader::request(Chunk* chunk) {
+    if (!chunk) return;
+    const int cx = chunk->getCX(), cy = chunk->getCY(), cz = chunk->getCZ();
+    chunk->m_taskRefs.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back({chunk, cx, cy, cz, RegionStore::regionOf(cx, cy, cz)});
+    }
+    m_requested.fetch_add(1, std::memory_order_relaxed);
+    m_cv.notify_one();
+}
+
+void ChunkLoader::setFocus(float x, float y, float z) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_focusX = x;
+    m_focusY = y;
+    m_focusZ = z;
+}
+
+std::vector<Chunk*> ChunkLoader::collectMisses() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Chunk*> out = std::move(m_misses);
+    m_misses.clear();
+    return out;
+}
+
+void ChunkLoader::cancelAll() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (const Request& r : m_queue) r.chunk->m_taskRefs.fetch_sub(1, std::memory_order_release);
+    m_queue.clear();
+    m_idleCv.wait(lock, [this]() { return m_inFlight == 0; });
+    for (Chunk* chunk : m_misses) chunk->m_taskRefs.fetch_sub(1, std::memory_order_release);
+    m_misses.clear();
+}
+
+ChunkLoader::Stats ChunkLoader::getStats() const {
+    Stats s;
+    s.requested = m_requested.load(std::memory_order_relaxed);
+    s.hits      = m_hits.load(std::memory_order_relaxed);
+    s.bakedHits = m_bakedHits.load(std::memory_order_relaxed);
+    s.misses    = m_missCount.load(std::memory_order_relaxed);
+    s.batches   = m_batches.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    s.queued = m_queue.size();
+    return s;
+}
+
+float ChunkLoader::distanceSq(const Request& r) const {
+    // Same metric as ChunkManager's placeholder rehydration: chunk centre to camera, 3D.
+    const float dx = m_focusX - (r.cx * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+    const float dy = m_focusY - (r.cy * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+    const float dz = m_focusZ - (r.cz * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+void ChunkLoader::workerLoop(std::stop_token st) {
+    std::vector<RegionStore::LoadItem> items;
+    std::vector<RegionStore::LoadItem> bakedItems;
+    std::vector<std::pair<float, size_t>> sameRegion;
+
+    while (!st.stop_requested()) {
+        items.clear();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_cv.wait(lock, st, [this]() { return !m_queue.empty(); })) break;
+
+            // Nearest request decides the region; its region-mates ride along, nearest first.
+            size_t best = 0;
+            float bestDist = distanceSq(m_queue[0]);
+            for (size_t i = 1; i < m_queue.size(); ++i) {
+                const float d = distanceSq(m_queue[i]);
+                if (d < bestDist) { bestDist = d; best = i; }
+            }
+            const RegionStore::Coord region = m_queue[best].region;
+
+            sameRegion.clear();
+            for (size_t i = 0; i < m_queue.size(); ++i) {
+                if (m_queue[i].region == region) sameRegion.push_back({distanceSq(m_queue[i]), i});
+            }
+            if (sameRegion.size() > MAX_BATCH) {
+                std::nth_element(sameRegion.begin(), sameRegion.begin() + MAX_BATCH, sameRegion.end());
+                sameRegion.resize(MAX_BATCH);
+            }
+
+            // Remove the picked requests (highest index first keeps swap-pop indices valid).
+            std::sort(sameRegion.begin(), sameRegion.end(),
+                      [](const auto& a, const auto& b) { return a.second > b.second; });
+            for (const auto& [dist, index] : sameRegion) {
+                const Request& r = m_queue[index];
+                items.push_back({r.cx, r.cy, r.cz, r.chunk, false});
+                m_queue[index] = m_queue.back();
+                m_queue.pop_back();
+            }
+            ++m_inFlight;
+        }
+
+        m_regions.loadBatch(items);
+        m_batches.fetch_add(1, std::memory_order_relaxed);
+
+        size_t hits = 0;
+        for (RegionStore::LoadItem& item : items) {
+            if (!item.loaded) continue;
+            // Edits restored from disk stay "modified" so the next eviction writes them back.
+            item.chunk->m_isModified.store(true, std::memory_order_release);
+            item.chunk->m_state.store(ChunkState::READY, std::memory_order_release);
+            item.chunk->m_taskRefs.fetch_sub(1, std::memory_order_release);
+            ++hits;
+        }
+
+        // Not edited: the baked world uses the same region layout, so the rest of the batch
+        // is one more loadBatch() there.
+        bakedItems.clear();
+        if (m_baked.isOpen()) {
+            for (const RegionStore::LoadItem& item : items) {
+                if (!item.loaded) bakedItems.push_back({item.cx, item.cy, item.cz, item.chunk, false});
+            }
+            if (!bakedItems.empty()) m_baked.loadBatch(bakedItems);
+        }
+        size_t bakedHits = 0;
+        const uint64_t bakedHash = m_bakedHash.load(std::memory_order_relaxed);
+        for (RegionStore::LoadItem& item : bakedItems) {
+            if (!item.loaded) continue;
+            adoptBakedChunk(*item.chunk, bakedHash);
+            item.chunk->m_state.store(ChunkState::READY, std::memory_order_release);
+            item.chunk->m_taskRefs.fetch_sub(1, std::memory_order_release);
+            ++bakedHits;
+        }
+
+        m_hits.fetch_add(hits + bakedHits, std::memory_order_relaxed);
+        m_bakedHits.fetch_add(bakedHits, std::memory_order_relaxed);
+        m_missCount.fetch_add(items.size() - hits - bakedHits, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (bakedItems.empty()) {
+                for (const RegionStore::LoadItem& item : items) {
+                    if (!item.loaded) m_misses.push_back(item.chunk);
+                }
+            } else {
+                for (const RegionStore::LoadItem& item : bakedItems) {
+                    if (!item.loaded) m_misses.push_back(item.chunk);
+                }
+            }
+            --m_inFlight;
+        }
+        m_idleCv.notify_all();
+    }
+}
+
+} // namespace world
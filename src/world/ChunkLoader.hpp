@@ -0,0 +1,99 @@
+#pragma once
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "world/Chunk.hpp"
+#include "world/RegionStore.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// ChunkLoader — asynchronous disk stage in front of MeshWorker GENERATE tasks.
+//
+// A placeholder that may have a saved record (RegionStore::mayContain()) is claimed as
+// GENERATING and handed to request() instead of being generated. Loader threads pick the
+// request nearest to the focus point (camera), take the other queued requests of the same
+// region file with it (the MAX_BATCH nearest) and read them with one RegionStore::loadBatch()
+// call — one file lock and one forward sweep over the sectors per batch.
+//
+//   hit  -> payload decoded, m_isModified set, state READY — exactly what a finished
+//           GENERATE task leaves behind, so ChunkManager picks it up the same way.
+//           Chunks not among the edits are then looked up in the baked world (WorldBaker):
+//           those hits stay unmodified and pick up pending tree writes (adoptBakedChunk()).
+//   miss -> returned by collectMisses() (still GENERATING); the main thread submits the
+//           usual GENERATE task, since MeshWorker rings only accept main-thread producers.
+//
+// Every queued chunk is pinned (Chunk::m_taskRefs) from request() until it is completed or
+// until the caller of collectMisses() unpins it, so ChunkPool never recycles it mid-load.
+// ---------------------------------------------------------------------------
+class ChunkLoader {
+public:
+    static constexpr size_t   MAX_BATCH       = 32;
+    static constexpr uint32_t DEFAULT_THREADS = 2;
+
+    struct Stats {
+        uint64_t requested = 0;
+        uint64_t hits      = 0;
+        uint64_t bakedHits = 0; // ... of which came from the baked world
+        uint64_t misses    = 0;
+        uint64_t batches   = 0;
+        size_t   queued    = 0;
+    };
+
+    ChunkLoader(RegionStore& regions, RegionStore& baked, uint32_t threadCount = DEFAULT_THREADS);
+    ~ChunkLoader();
+    ChunkLoader(const ChunkLoader&) = delete;
+    ChunkLoader& operator=(const ChunkLoader&) = delete;
+
+    // Main thread. `chunk` must already be claimed (GENERATING).
+    void request(Chunk* chunk);
+    // Priority origin in world space (the camera position).
+    void setFocus(float x, float y, float z);
+    // Config hash of the baked world (DecorationQueue key for adoptBakedChunk()).
+    void setBakedConfigHash(uint64_t hash) { m_bakedHash.store(hash, std::memory_order_relaxed); }
+
+    // Chunks that were not on disk. Each is still pinned: the caller unpins it after
+    // submitting (or dropping) the GENERATE task.
+    std::vector<Chunk*> collectMisses();
+
+    // Drops queued requests and outstanding misses and waits for batches in flight.
+    // Used before the world (and the region store) goes away.
+    void cancelAll();
+
+    Stats getStats() const;
+
+private:
+    struct Request {
+        Chunk*             chunk;
+        int                cx, cy, cz;
+        RegionStore::Coord region;
+    };
+
+    void workerLoop(std::stop_token st);
+    float distanceSq(const Request& r) const; // caller holds m_mutex
+
+    RegionStore& m_regions;
+    RegionStore& m_baked;
+    std::atomic<uint64_t> m_bakedHash{0};
+
+    mutable std::mutex          m_mutex;
+    std::condition_variable_any m_cv;      // work available
+    std::condition_variable_any m_idleCv;  // batch finished (cancelAll)
+    std::vector<Request>        m_queue;
+    std::vector<Chunk*>         m_misses;
+    uint32_t                    m_inFlight = 0;
+    float m_focusX = 0.0f, m_focusY = 0.0f, m_focusZ = 0.0f;
+
+    std::atomic<uint64_t> m_requested{0};
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_bakedHits{0};
+    std::atomic<uint64_t> m_missCount{0};
+    std::atomic<uint64_t> m_batches{0};
+
+    std::vector<std::jthread> m_threads; // last: joined before the members above go away
+};
+
+} // namespace world
@@ -1,19 +1,24 @@
 #include "ChunkManager.hpp"
+#include <algorithm>
 #include <iostream>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 
 namespace world {
 
-ChunkManager::ChunkManager(gfx::VulkanContext& context, gfx::GeometryManager& geometryManager, uint32_t meshWorkerThreads)
+ChunkManager::ChunkManager(ChunkMeshSink& meshSink, uint32_t meshWorkerThreads)
     : m_storage()
     , m_lodCtrl()
-    , m_renderer(context, geometryManager, m_storage, m_lodCtrl, meshWorkerThreads)
+    , m_mesher(m_storage, m_lodCtrl, meshSink, meshWorkerThreads)
 {
     // The components initialize themselves.
 }
 
 void ChunkManager::generateWorld(int radiusX, int radiusZ, const TerrainConfig& config) {
     m_terrainConfig = config;
-    m_renderer.clear();
+    m_mesher.clear();
     m_storage.generateWorld(radiusX, radiusZ, config);
 
     const auto& chunks = m_storage.getChunks();
@@ -38,37 +43,25 @@ void ChunkManager::generateWorld(int radiusX, int radiusZ, const TerrainConfig&
 
         int lod = m_lodCtrl.calculateLOD(key.x, key.y, key.z);
         chunk->m_currentLOD.store(lod, std::memory_order_relaxed);
-        m_renderer.markDirty(key.x, key.y, key.z);
+        m_mesher.markDirty(key.x, key.y, key.z);
     }
-    m_renderer.flushDirty();
+    m_mesher.flushDirty();
 }
 
-void ChunkManager::rebuildDirtyChunks(VkDevice device, float currentTime) {
-    m_renderer.rebuildDirtyChunks(device, currentTime);
-}
-
-void ChunkManager::cull(VkCommandBuffer cmd, const scene::Frustum& cameraFrustum, const scene::Frustum& shadowFrustum, const core::math::Vec3& cameraPos, float shadowDistanceLimit, float currentTime, uint32_t currentFrame) {
-    m_renderer.cull(cmd, cameraFrustum, shadowFrustum, cameraPos, shadowDistanceLimit, currentTime, currentFrame);
-}
-
-void ChunkManager::renderCamera(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame) {
-    m_renderer.renderCamera(cmd, layout, currentFrame);
-}
-
-void ChunkManager::renderShadow(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame) {
-    m_renderer.renderShadow(cmd, layout, currentFrame);
+void ChunkManager::rebuildDirtyChunks(float currentTime) {
+    m_mesher.rebuildDirtyChunks(currentTime);
 }
 
 void ChunkManager::markDirty(int cx, int cy, int cz) {
-    m_renderer.markDirty(cx, cy, cz);
+    m_mesher.markDirty(cx, cy, cz);
 }
 
 void ChunkManager::forceMarkDirty(int cx, int cy, int cz) {
-    m_renderer.forceMarkDirty(cx, cy, cz);
+    m_mesher.forceMarkDirty(cx, cy, cz);
 }
 
 void ChunkManager::flushDirty() {
-    m_renderer.flushDirty();
+    m_mesher.flushDirty();
 }
 
 VoxelData ChunkManager::getVoxel(int wx, int wy, int wz) const {
@@ -78,7 +71,7 @@ VoxelData ChunkManager::getVoxel(int wx, int wy, int wz) const {
 void ChunkManager::setVoxel(int wx, int wy, int wz, VoxelData v) {
     m_storage.setVoxel(wx, wy, wz, v);
 
-    // mark corresponding chunks dirty via renderer
+    // mark corresponding chunks dirty via mesher
     int cx = (wx >= 0) ? (wx / CHUNK_SIZE) : ((wx - CHUNK_SIZE + 1) / CHUNK_SIZE);
     int lx = wx - cx * CHUNK_SIZE;
 
@@ -89,21 +82,26 @@ void ChunkManager::setVoxel(int wx, int wy, int wz, VoxelData v) {
     int lz = wz - cz * CHUNK_SIZE;
 
     // The directly-edited chunk must be re-meshed even if it was previously empty.
-    m_renderer.forceMarkDirty(cx, cy, cz);
+    m_mesher.forceMarkDirty(cx, cy, cz);
 
     // Neighbours may need skirt updates; forceMarkDirty so that previously-empty
     // neighbours adjacent to the edit boundary are also re-evaluated.
-    if (lx == 0)              m_renderer.forceMarkDirty(cx - 1, cy, cz);
-    if (lx == CHUNK_SIZE - 1) m_renderer.forceMarkDirty(cx + 1, cy, cz);
-    if (ly == 0)              m_renderer.forceMarkDirty(cx, cy - 1, cz);
-    if (ly == CHUNK_SIZE - 1) m_renderer.forceMarkDirty(cx, cy + 1, cz);
-    if (lz == 0)              m_renderer.forceMarkDirty(cx, cy, cz - 1);
-    if (lz == CHUNK_SIZE - 1) m_renderer.forceMarkDirty(cx, cy, cz + 1);
+    if (lx == 0)              m_mesher.forceMarkDirty(cx - 1, cy, cz);
+    if (lx == CHUNK_SIZE - 1) m_mesher.forceMarkDirty(cx + 1, cy, cz);
+    if (ly == 0)              m_mesher.forceMarkDirty(cx, cy - 1, cz);
+    if (ly == CHUNK_SIZE - 1) m_mesher.forceMarkDirty(cx, cy + 1, cz);
+    if (lz == 0)              m_mesher.forceMarkDirty(cx, cy, cz - 1);
+    if (lz == CHUNK_SIZE - 1) m_mesher.forceMarkDirty(cx, cy, cz + 1);
 }
 
 void ChunkManager::updateCamera(const core::math::Vec3& cameraPos, const scene::Frustum& frustum) {
     m_lodCtrl.setCameraPosition(cameraPos);
 
+    // Async disk loads share the rehydration priority (distance to camera); chunks the loader
+    // did not find on disk are generated from here.
+    m_storage.setLoadFocus(cameraPos.x, cameraPos.y, cameraPos.z);
+    m_storage.pumpLoads(m_terrainConfig, m_mesher);
+
     // --- Placeholder Rehydration Near Camera ---
     // generateWorld() preallocates the initial world, but streamed-out chunks can later come back as
     // UNGENERATED placeholders. This pass prioritizes the nearest placeholders and restores voxel data.
@@ -158,17 +156,12 @@ void ChunkManager::updateCamera(const core::math::Vec3& cameraPos, const scene::
             Chunk* chunk = m_storage.getChunk(c.cx, c.cy, c.cz);
             if (!chunk) {
                 // Tier-4 may have removed the chunk object entirely; recreate a placeholder first.
-                m_storage.createChunkIfMissing(c.cx, c.cy, c.cz, m_terrainConfig, m_renderer, true);
+                m_storage.createChunkIfMissing(c.cx, c.cy, c.cz, m_terrainConfig, m_mesher, true);
                 chunk = m_storage.getChunk(c.cx, c.cy, c.cz);
             }
 
-            if (chunk) {
-                ChunkState expected = ChunkState::UNGENERATED;
-                if (chunk->m_state.compare_exchange_strong(expected, ChunkState::GENERATING,
-                                                              std::memory_order_acq_rel)) {
-                    m_renderer.submitGenerateTaskHigh(chunk, m_terrainConfig);
-                    ++submitted;
-                }
+            if (chunk && m_storage.requestPayload(chunk, m_terrainConfig, m_mesher, true)) {
+                ++submitted;
             }
         }
     }
@@ -198,11 +191,11 @@ void ChunkManager::updateCamera(const core::math::Vec3& cameraPos, const scene::
                 if (distSq <= sphereRadiusSq) {
                     auto [minCY, maxCY] = m_storage.getSurfaceBounds(cx, cz);
                     for (int cy = minCY; cy <= maxCY; ++cy)
-                        m_storage.createChunkIfMissing(cx, cy, cz, m_terrainConfig, m_renderer);
+                        m_storage.createChunkIfMissing(cx, cy, cz, m_terrainConfig, m_mesher);
                     
                     // Recreate any evicted slices below the current occupied span as placeholders.
                     for (int cy = m_storage.getMinY(); cy < minCY; ++cy)
-                        m_storage.createChunkIfMissing(cx, cy, cz, m_terrainConfig, m_renderer, true);
+                        m_storage.createChunkIfMissing(cx, cy, cz, m_terrainConfig, m_mesher, true);
                 }
             }
         }
@@ -210,18 +203,24 @@ void ChunkManager::updateCamera(const core::math::Vec3& cameraPos, const scene::
     auto endZ1 = std::chrono::high_resolution_clock::now();
 
     // Zone 2 (frustum): load chunks in camera view direction beyond sphere radius.
-    // IMPORTANT: iterate the world GRID BOUNDS (not getChunks()) so that chunks
+    // IMPORTANT: iterate the column SQUARE around the camera (not getChunks()) so that chunks
     // previously removed by Tier 4 (fully evicted) can be re-created when the
     // user increases Camera View Dist or looks at that direction again.
+    // Storage is unbounded, so the square follows the camera rather than fixed world extents.
     {
         const float sphereRadiusSq   = m_unloadRadius * m_unloadRadius;
         const float frustumMaxDistSq = m_frustumRadius * m_frustumRadius;
 
-        // Clamp iteration to world extents + frustum radius
-        int minCX = m_storage.getMinX();
-        int maxCX = m_storage.getMaxX();
-        int minCZ = m_storage.getMinZ();
-        int maxCZ = m_storage.getMaxZ();
+        int playerWX = static_cast<int>(std::floor(cameraPos.x));
+        int playerWZ = static_cast<int>(std::floor(cameraPos.z));
+        int px = (playerWX >= 0) ? (playerWX / CHUNK_SIZE) : ((playerWX - CHUNK_SIZE + 1) / CHUNK_SIZE);
+        int pz = (playerWZ >= 0) ? (playerWZ / CHUNK_SIZE) : ((playerWZ - CHUNK_SIZE + 1) / CHUNK_SIZE);
+        int radius = static_cast<int>(std::ceil(m_frustumRadius / CHUNK_SIZE)) + 1;
+
+        int minCX = px - radius;
+        int maxCX = px + radius;
+        int minCZ = pz - radius;
+        int maxCZ = pz + radius;
 
         for (int cz = minCZ; cz <= maxCZ; ++cz) {
             for (int cx = minCX; cx <= maxCX; ++cx) {
@@ -246,11 +245,11 @@ void ChunkManager::updateCamera(const core::math::Vec3& cameraPos, const scene::
                 // Camera is looking at this column — ensure the occupied span exists in storage.
                 auto [minCY, maxCY] = m_storage.getSurfaceBounds(cx, cz);
                 for (int cy = minCY; cy <= maxCY; ++cy)
-                    m_storage.createChunkIfMissing(cx, cy, cz, m_terrainConfig, m_renderer);
+                    m_storage.createChunkIfMissing(cx, cy, cz, m_terrainConfig, m_mesher);
                 
                 // Also recreate lower slices that may have been fully evicted before.
                 for (int cy = m_storage.getMinY(); cy < minCY; ++cy)
-                    m_storage.createChunkIfMissing(cx, cy, cz, m_terrainConfig, m_renderer, true);
+                    m_storage.createChunkIfMissing(cx, cy, cz, m_terrainConfig, m_mesher, true);
             }
         }
     }
@@ -321,51 +320,55 @@ void ChunkManager::updateCamera(const core::math::Vec3& cameraPos, const scene::
             // LOD_EVICTED = chunk was intentionally unloaded by Tier-3.
             // It's re-entering the visible zone now, so treat it as unassigned
             // and let the normal LOD calculation assign a fresh value.
-            if (oldLOD == ChunkRenderer::LOD_EVICTED) {
-                oldLOD = ChunkRenderer::LOD_UNASSIGNED;
+            if (oldLOD == ChunkMesher::LOD_EVICTED) {
+                oldLOD = ChunkMesher::LOD_UNASSIGNED;
             }
 
             int newLOD = m_lodCtrl.calculateLOD(key.x, key.y, key.z, oldLOD);
             if (newLOD != oldLOD) {
                 chunk->m_currentLOD.store(newLOD, std::memory_order_relaxed);
-                m_renderer.markDirty(key.x, key.y, key.z);
+                m_mesher.markDirty(key.x, key.y, key.z);
                 
                 // --- Smart Skirts: Neighbor Notification ---
                 // When a chunk's LOD changes, neighbours need skirt updates.
                 // markDirty() automatically skips chunks tagged as isEmpty,
                 // preventing cascade re-submissions to known air/solid chunks.
-                if (m_storage.getChunk(key.x + 1, key.y, key.z)) m_renderer.markDirty(key.x + 1, key.y, key.z);
-                if (m_storage.getChunk(key.x - 1, key.y, key.z)) m_renderer.markDirty(key.x - 1, key.y, key.z);
-                if (m_storage.getChunk(key.x, key.y + 1, key.z)) m_renderer.markDirty(key.x, key.y + 1, key.z);
-                if (m_storage.getChunk(key.x, key.y - 1, key.z)) m_renderer.markDirty(key.x, key.y - 1, key.z);
-                if (m_storage.getChunk(key.x, key.y, key.z + 1)) m_renderer.markDirty(key.x, key.y, key.z + 1);
-                if (m_storage.getChunk(key.x, key.y, key.z - 1)) m_renderer.markDirty(key.x, key.y, key.z - 1);
-
-            } else if (oldLOD == ChunkRenderer::LOD_UNASSIGNED) {
+                if (m_storage.getChunk(key.x + 1, key.y, key.z)) m_mesher.markDirty(key.x + 1, key.y, key.z);
+                if (m_storage.getChunk(key.x - 1, key.y, key.z)) m_mesher.markDirty(key.x - 1, key.y, key.z);
+                if (m_storage.getChunk(key.x, key.y + 1, key.z)) m_mesher.markDirty(key.x, key.y + 1, key.z);
+                if (m_storage.getChunk(key.x, key.y - 1, key.z)) m_mesher.markDirty(key.x, key.y - 1, key.z);
+                if (m_storage.getChunk(key.x, key.y, key.z + 1)) m_mesher.markDirty(key.x, key.y, key.z + 1);
+                if (m_storage.getChunk(key.x, key.y, key.z - 1)) m_mesher.markDirty(key.x, key.y, key.z - 1);
+
+            } else if (oldLOD == ChunkMesher::LOD_UNASSIGNED) {
                 // Voxels exist but no GPU mesh — assign LOD and mesh.
                 int lod = m_lodCtrl.calculateLOD(key.x, key.y, key.z);
                 chunk->m_currentLOD.store(lod, std::memory_order_relaxed);
-                m_renderer.markDirty(key.x, key.y, key.z);
+                m_mesher.markDirty(key.x, key.y, key.z);
                 
                 // --- Smart Skirts: Initial Gen Notification ---
                 // markDirty() skips isEmpty neighbours automatically, so we do
                 // NOT propagate the cascade into known air/solid underground chunks.
-                if (m_storage.getChunk(key.x + 1, key.y, key.z)) m_renderer.markDirty(key.x + 1, key.y, key.z);
-                if (m_storage.getChunk(key.x - 1, key.y, key.z)) m_renderer.markDirty(key.x - 1, key.y, key.z);
-                if (m_storage.getChunk(key.x, key.y + 1, key.z)) m_renderer.markDirty(key.x, key.y + 1, key.z);
-                if (m_storage.getChunk(key.x, key.y - 1, key.z)) m_renderer.markDirty(key.x, key.y - 1, key.z);
-                if (m_storage.getChunk(key.x, key.y, key.z + 1)) m_renderer.markDirty(key.x, key.y, key.z + 1);
-                if (m_storage.getChunk(key.x, key.y, key.z - 1)) m_renderer.markDirty(key.x, key.y, key.z - 1);
+                if (m_storage.getChunk(key.x + 1, key.y, key.z)) m_mesher.markDirty(key.x + 1, key.y, key.z);
+                if (m_storage.getChunk(key.x - 1, key.y, key.z)) m_mesher.markDirty(key.x - 1, key.y, key.z);
+                if (m_storage.getChunk(key.x, key.y + 1, key.z)) m_mesher.markDirty(key.x, key.y + 1, key.z);
+                if (m_storage.getChunk(key.x, key.y - 1, key.z)) m_mesher.markDirty(key.x, key.y - 1, key.z);
+                if (m_storage.getChunk(key.x, key.y, key.z + 1)) m_mesher.markDirty(key.x, key.y, key.z + 1);
+                if (m_storage.getChunk(key.x, key.y, key.z - 1)) m_mesher.markDirty(key.x, key.y, key.z - 1);
             }
         }
 
         for (const auto& key : chunksToFullyRemove) {
-            m_renderer.removeChunk(key);
+            m_mesher.removeChunk(key);
         }
         m_storage.removeChunks(chunksToFullyRemove);
+        // Tree spills between chunks that have both left the voxel radius: both regenerate (and
+        // post again) before either is back, so the queue stays bounded by the resident world.
+        if (!chunksToFullyRemove.empty())
+            DecorationQueue::shared().prune(cameraPos.x, cameraPos.z, m_frustumRadius);
         
         for (const auto& key : chunksMeshOnly) {
-            m_renderer.unloadMeshOnly(key);  // free GPU only, voxels stay, LOD = EVICTED
+            m_mesher.unloadMeshOnly(key);  // free GPU only, voxels stay, LOD = EVICTED
         }
 
 
@@ -384,14 +387,14 @@ void ChunkManager::updateCamera(const core::math::Vec3& cameraPos, const scene::
             if (underChunk && underChunk->m_state.load(std::memory_order_acquire) == ChunkState::UNGENERATED) {
                 ChunkState expected = ChunkState::UNGENERATED;
                 if (underChunk->m_state.compare_exchange_strong(expected, ChunkState::GENERATING, std::memory_order_acq_rel))
-                    m_renderer.submitGenerateTaskHigh(underChunk, m_terrainConfig);
+                    m_mesher.submitGenerateTaskHigh(underChunk, m_terrainConfig);
             } else if (!underChunk) {
-                m_storage.createChunkIfMissing(px, targetCY, pz, m_terrainConfig, m_renderer);
+                m_storage.createChunkIfMissing(px, targetCY, pz, m_terrainConfig, m_mesher);
             }
         }
     }
 
-    m_renderer.flushDirty();
+    m_mesher.flushDirty();
 
     auto endZ3 = std::chrono::high_resolution_clock::now();
     tZ1 += std::chrono::duration<float, std::milli>(endZ1 - startAll).count();
@@ -412,6 +415,12 @@ int ChunkManager::calculateLOD(int cx, int cy, int cz, int currentLOD) const {
 ChunkLifecycleStats ChunkManager::getLifecycleStats() const {
     ChunkLifecycleStats stats{};
     stats.cachedModified = static_cast<uint32_t>(m_storage.getDirtyCacheCount());
+    stats.pool           = m_storage.getPoolStats();
+    stats.cold           = m_storage.getColdStats();
+    stats.region         = m_storage.getRegionStats();
+    stats.loader         = m_storage.getLoaderStats();
+    stats.gen            = TerrainGenerator::getStats();
+    stats.decor          = DecorationQueue::shared().getStats();
 
     for (const auto& ac : m_storage.getChunks()) {
         const Chunk* chunk = m_storage.getChunk(ac.cx, ac.cy, ac.cz);
@@ -420,6 +429,15 @@ ChunkLifecycleStats ChunkManager::getLifecycleStats() const {
         }
 
         ++stats.active;
+        stats.voxelBytes += chunk->getVoxelBytes();
+        if (const size_t mipBytes = chunk->getMipBytes()) {
+            stats.mipBytes += mipBytes;
+            ++stats.mipChunks;
+        }
+        const int bits        = chunk->getPaletteBits();
+        const int widthBucket = bits == 0 ? 0 : std::countr_zero(static_cast<unsigned>(bits)) + 1;
+        if (widthBucket < PALETTE_WIDTH_BUCKETS) ++stats.paletteWidths[static_cast<size_t>(widthBucket)];
+        ++stats.payloadLods[static_cast<size_t>(std::clamp(chunk->getPayloadLod(), 0, 2))];
 
         switch (chunk->m_state.load(std::memory_order_acquire)) {
         case ChunkState::UNGENERATED:
@@ -434,9 +452,9 @@ ChunkLifecycleStats ChunkManager::getLifecycleStats() const {
         }
 
         const int lodState = chunk->m_currentLOD.load(std::memory_order_relaxed);
-        if (lodState == ChunkRenderer::LOD_UNASSIGNED) {
+        if (lodState == ChunkMesher::LOD_UNASSIGNED) {
             ++stats.meshUnassigned;
-        } else if (lodState == ChunkRenderer::LOD_EVICTED) {
+        } else if (lodState == ChunkMesher::LOD_EVICTED) {
             ++stats.meshEvicted;
         }
     }
@@ -2,10 +2,12 @@
 
 #include "world/ChunkStorage.hpp"
 #include "world/LODController.hpp"
-#include "world/ChunkRenderer.hpp"
+#include "world/ChunkMesher.hpp"
+#include "world/ChunkMeshSink.hpp"
+#include "world/TerrainGenerator.hpp"
+#include "world/DecorationQueue.hpp"
 #include "scene/Frustum.hpp"
 #include "core/Math.hpp"
-#include <vulkan/vulkan.h>
 
 namespace world {
 
@@ -17,24 +19,51 @@ struct ChunkLifecycleStats {
     uint32_t meshUnassigned = 0;
     uint32_t meshEvicted    = 0;
     uint32_t cachedModified = 0;
+
+    // Palette-compressed voxel payload across active chunks.
+    uint64_t voxelBytes     = 0; // palette + packed index bytes
+    // Cached voxel mip chains (LOD meshing of full-resolution payloads, Chunk::getMipBytes()).
+    uint64_t mipBytes       = 0;
+    uint32_t mipChunks      = 0;
+    // paletteWidths[0] = uniform chunks (no payload); paletteWidths[i] = chunks stored at
+    // (1 << (i-1)) bits per voxel (1, 2, 4, 8, 16).
+    std::array<uint32_t, PALETTE_WIDTH_BUCKETS> paletteWidths{};
+    // Chunks by payload resolution: [0] full, [1] 16³ and [2] 8³ reduced (far-LOD generation).
+    std::array<uint32_t, 3> payloadLods{};
+
+    // Chunk object pool. slabAllocations staying flat while flying = no Chunk heap churn.
+    ChunkPool::Stats pool{};
+
+    // Compressed cold tier of evicted modified chunks (ratio + rehydration decode latency).
+    ColdChunkCache::Stats cold{};
+    // Region-file persistence of modified chunks (writes on eviction, reads on stream-in).
+    RegionStore::Stats region{};
+    // Async load stage: hits restored from region files, misses forwarded to GENERATE.
+    ChunkLoader::Stats loader{};
+    // Terrain generation stage timings (process-wide, cumulative since start).
+    TerrainGenerator::Stats gen{};
+    // Pending cross-chunk tree writes (DECORATE stage).
+    DecorationQueue::Stats decor{};
+
+    uint32_t bytesPerChunk() const { return active ? static_cast<uint32_t>(voxelBytes / active) : 0; }
 };
 
 // ---------------------------------------------------------------------------
 // ChunkManager (Facade)
+//
+// Storage, LOD, streaming and meshing — no Vulkan. Finished meshes go to `meshSink`
+// (ChunkRenderer in the engine, CountingMeshSink in headless tools / benchmarks), which
+// must outlive the manager.
 // ---------------------------------------------------------------------------
 class ChunkManager {
 public:
-    explicit ChunkManager(gfx::VulkanContext& context, gfx::GeometryManager& geometryManager,
-                          uint32_t meshWorkerThreads = 0);
+    explicit ChunkManager(ChunkMeshSink& meshSink, uint32_t meshWorkerThreads = 0);
     ~ChunkManager() = default;
 
     void generateWorld(int radiusX, int radiusZ, const TerrainConfig& config = {});
 
-    void rebuildDirtyChunks(VkDevice device, float currentTime);
-
-    void cull(VkCommandBuffer cmd, const scene::Frustum& cameraFrustum, const scene::Frustum& shadowFrustum, const core::math::Vec3& cameraPos, float shadowDistanceLimit, float currentTime, uint32_t currentFrame);
-    void renderCamera(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame);
-    void renderShadow(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame);
+    // Collects finished worker tasks and hands the meshes to the sink.
+    void rebuildDirtyChunks(float currentTime);
 
     void markDirty(int cx, int cy, int cz);
     // forceMarkDirty bypasses the isEmpty guard — use when voxel data was actually changed.
@@ -51,6 +80,7 @@ public:
     float& getLodDist0() { return m_lodCtrl.m_lodDist0; }
     float& getLodDist1() { return m_lodCtrl.m_lodDist1; }
     float& getLodHysteresis() { return m_lodCtrl.m_lodHysteresis; }
+    bool&  getReducedGeneration() { return m_lodCtrl.m_reducedGeneration; }
 
     int  getRenderRadius()  const { return m_renderRadius; }
     void setRenderRadius(int r)   { m_renderRadius = r; }
@@ -60,30 +90,25 @@ public:
     TerrainConfig& getTerrainConfig() { return m_terrainConfig; }
 
     uint32_t getChunkCount()      const { return static_cast<uint32_t>(m_storage.getChunks().size()); }
-    uint32_t getTotalVertices()   const { return m_renderer.getTotalVertices(); }
-    uint32_t getTotalIndices()    const { return m_renderer.getTotalIndices(); }
-    float    getLastRebuildMs()   const { return m_renderer.getLastRebuildMs(); }
-    uint32_t getVisibleCount()    const { return m_renderer.getVisibleCount(); }
-    uint32_t getCulledCount()     const { return m_renderer.getCulledCount(); }
-    uint32_t getVisibleVertices() const { return m_renderer.getVisibleVertices(); }
-    
-    uint32_t getWorkerThreads() const { return m_renderer.getWorkerThreads(); }
-    int      getPendingMeshes() const { return m_renderer.getPendingMeshes(); }
-    ChunkLifecycleStats getLifecycleStats() const;
+    uint32_t getTotalQuads()      const { return m_mesher.getTotalQuads(); }
+    float    getLastRebuildMs()   const { return m_mesher.getLastRebuildMs(); }
 
-    const ChunkRenderer& getRenderer() const { return m_renderer; }
+    uint32_t getWorkerThreads() const { return m_mesher.getWorkerThreads(); }
+    int      getPendingMeshes() const { return m_mesher.getPendingMeshes(); }
+    uint64_t getSkippedMeshes() const { return m_mesher.getSkippedMeshes(); }
+    ChunkLifecycleStats getLifecycleStats() const;
 
-    std::array<uint32_t, 3> getLODCounts() const { return m_renderer.getLODCounts(); }
+    std::array<uint32_t, 3> getLODCounts() const { return m_mesher.getLODCounts(); }
 
-    bool hasMesh() const { return m_renderer.hasMesh(); }
+    bool hasMesh() const { return m_mesher.hasMesh(); }
 
     // Block until all background worker tasks complete (call before first frame to avoid blank screen)
-    void waitAllWorkers() { m_renderer.waitAllWorkers(); }
+    void waitAllWorkers() { m_mesher.waitAllWorkers(); }
 
 private:
     ChunkStorage  m_storage;
     LODController m_lodCtrl;
-    ChunkRenderer m_renderer;
+    ChunkMesher   m_mesher;
 
     int   m_renderRadius  = 16;
     float m_unloadRadius  = 512.0f;  // sphere: load+unload distance (blocks)
@@ -0,0 +1,171 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "world/Chunk.hpp"
+#include "world/ChunkStorage.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// MeshStaging — sink-owned memory one finished mesh is written into by a mesh worker:
+// quadCount VoxelQuad records, opaque by face direction then liquid, like VoxelMeshData.
+// See ChunkMeshSink::reserveStaging().
+// ---------------------------------------------------------------------------
+struct MeshStaging {
+    VoxelQuad*     quads     = nullptr;
+    uint32_t       quadCount = 0;
+    uint64_t       handle    = 0; // sink-defined (staging ring position)
+    FaceQuadCounts faceQuads{};   // set by the worker with the quads
+    uint32_t       liquidQuads = 0;
+
+    bool valid() const { return quads != nullptr; }
+};
+
+// ---------------------------------------------------------------------------
+// ChunkMeshSink — where finished chunk meshes go.
+//
+// ChunkMesher decides what to mesh and when; the sink only stores what it is given.
+// ChunkRenderer is the Vulkan sink (GeometryManager upload + MDI). CountingMeshSink keeps
+// sizes only, for tools and benchmarks that run without a window or GPU.
+//
+// Calls come from the main thread, inside ChunkMesher::rebuildDirtyChunks() (between
+// beginUploads / endUploads) or from ChunkMesher::removeChunk / unloadMeshOnly / clear.
+//
+// Optional staging path (hasStaging()): mesh workers reserve sink memory and write the mesh
+// there themselves; the main thread only hands the reservation over (uploadStaged()).
+// ---------------------------------------------------------------------------
+class ChunkMeshSink {
+public:
+    virtual ~ChunkMeshSink() = default;
+
+    // One rebuildDirtyChunks() pass. Uploads in between may be batched until endUploads().
+    virtual void beginUploads(float currentTime) { (void)currentTime; }
+    virtual void endUploads() {}
+
+    // Non-empty mesh of chunk `key` at `lod`, replacing the one held for it (if any).
+    // `mesh` is only valid during the call.
+    virtual void uploadMesh(const IVec3Key& key, int lod, const VoxelMeshData& mesh) = 0;
+    // Drops the mesh held for `key`. No-op if there is none.
+    virtual void releaseMesh(const IVec3Key& key) = 0;
+    // World rebuilt: drops every mesh.
+    virtual void clear() = 0;
+
+    // ---- Staging path -------------------------------------------------------
+    virtual bool hasStaging() const { return false; }
+    // Any thread. Space for a mesh of this size; invalid when full (the worker then keeps the
+    // mesh in VoxelMeshData and it goes through uploadMesh()).
+    virtual MeshStaging reserveStaging(uint32_t quadCount) {
+        (void)quadCount;
+        return {};
+    }
+    // Like uploadMesh() for a filled reservation; the sink takes it over.
+    virtual void uploadStaged(const IVec3Key& key, int lod, const MeshStaging& staged) {
+        (void)key; (void)lod; (void)staged;
+    }
+    // Returns a reservation that will not be uploaded (stale / superseded result).
+    virtual void releaseStaging(const MeshStaging& staged) { (void)staged; }
+};
+
+// ---------------------------------------------------------------------------
+// CountingMeshSink — headless sink: remembers mesh sizes, stores no geometry.
+// With `staging`, reservations are heap blocks — exercises ChunkMesher's staging path and
+// counts reservations that were never uploaded or released (Stats::stagingLive).
+// ---------------------------------------------------------------------------
+class CountingMeshSink final : public ChunkMeshSink {
+public:
+    struct Stats {
+        size_t   resident      = 0; // meshes currently held
+        uint64_t uploads       = 0; // uploadMesh() + uploadStaged() calls
+        uint64_t releases      = 0; // releaseMesh() calls that dropped a mesh
+        uint64_t quads         = 0; // resident quads (VoxelQuad, 8 bytes each)
+        uint64_t liquidQuads   = 0; // of which liquid surface quads
+        uint64_t uploadedBytes = 0; // quad bytes uploaded in total
+        uint64_t stagedUploads = 0; // uploads that came through uploadStaged()
+        size_t   stagingLive   = 0; // reservations neither uploaded nor released
+    };
+
+    explicit CountingMeshSink(bool staging = false) : m_staging(staging) {}
+
+    void uploadMesh(const IVec3Key& key, int /*lod*/, const VoxelMeshData& mesh) override {
+        add(key, {mesh.faceQuads, mesh.liquidQuads});
+    }
+
+    bool hasStaging() const override { return m_staging; }
+
+    MeshStaging reserveStaging(uint32_t quadCount) override {
+        auto block = std::make_unique<uint8_t[]>(quadCount * sizeof(VoxelQuad));
+        MeshStaging staged{reinterpret_cast<VoxelQuad*>(block.get()), quadCount, 0, {}};
+        std::lock_guard lock(m_stagingMutex);
+        staged.handle = ++m_stagingSerial;
+        m_stagingBlocks.emplace(staged.handle, std::move(block));
+        m_stats.stagingLive = m_stagingBlocks.size();
+        return staged;
+    }
+
+    void uploadStaged(const IVec3Key& key, int /*lod*/, const MeshStaging& staged) override {
+        releaseStaging(staged);
+        add(key, {staged.faceQuads, staged.liquidQuads});
+        m_stats.stagedUploads++;
+    }
+
+    void releaseStaging(const MeshStaging& staged) override {
+        std::lock_guard lock(m_stagingMutex);
+        m_stagingBlocks.erase(staged.handle);
+        m_stats.stagingLive = m_stagingBlocks.size();
+    }
+
+    void releaseMesh(const IVec3Key& key) override {
+        if (drop(key)) m_stats.releases++;
+        m_stats.resident = m_meshes.size();
+    }
+
+    void clear() override {
+        m_meshes.clear();
+        m_stats.resident = 0;
+        m_stats.quads    = 0;
+        m_stats.liquidQuads = 0;
+    }
+
+    // Resident mesh sizes: opaque quads per face direction, liquid quads
+    struct MeshSize {
+        FaceQuadCounts faceQuads{};
+        uint32_t       liquidQuads = 0;
+        uint32_t quadCount() const { return faceQuadTotal(faceQuads) + liquidQuads; }
+    };
+
+    const Stats& getStats() const { return m_stats; }
+    const std::unordered_map<IVec3Key, MeshSize, IVec3Hash>& getMeshes() const { return m_meshes; }
+
+private:
+    void add(const IVec3Key& key, const MeshSize& size) {
+        const uint32_t quadCount = size.quadCount();
+        drop(key);
+        m_meshes.emplace(key, size);
+        m_stats.uploads++;
+        m_stats.quads         += quadCount;
+        m_stats.liquidQuads   += size.liquidQuads;
+        m_stats.uploadedBytes += quadCount * sizeof(VoxelQuad);
+        m_stats.resident = m_meshes.size();
+    }
+
+    bool drop(const IVec3Key& key) {
+        auto it = m_meshes.find(key);
+        if (it == m_meshes.end()) return false;
+        m_stats.quads       -= it->second.quadCount();
+        m_stats.liquidQuads -= it->second.liquidQuads;
+        m_meshes.erase(it);
+        return true;
+    }
+
+    std::unordered_map<IVec3Key, MeshSize, IVec3Hash> m_meshes;
+    Stats m_stats;
+
+    bool                                                    m_staging = false;
+    std::mutex                                              m_stagingMutex;
+    uint64_t                                                m_stagingSerial = 0;
+    std::unordered_map<uint64_t, std::unique_ptr<uint8_t[]>> m_stagingBlocks;
+};
+
+} // namespace world
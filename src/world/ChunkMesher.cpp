@@ -0,0 +1,354 @@
+#include "ChunkMesher.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace world {
+
+ChunkMesher::ChunkMesher(ChunkStorage& storage, LODController& lodCtrl, ChunkMeshSink& sink, uint32_t meshWorkerThreads)
+    : m_storage(storage), m_lodCtrl(lodCtrl), m_sink(sink),
+      m_meshWorker(meshWorkerThreads, sink.hasStaging() ? &sink : nullptr)
+{
+    std::cout << "[ChunkMesher] MeshWorker threads: "
+              << m_meshWorker.getThreadCount() << (sink.hasStaging() ? " (meshing into sink staging)" : "")
+              << "\n" << std::flush;
+}
+
+void ChunkMesher::clear() {
+    m_meshWorker.waitAll();
+    for (auto& task : m_meshWorker.collect()) discardResult(task);
+    m_meshState.clear();
+    m_dirtyPending.clear();
+    m_refining.clear();
+    m_lateDecorations.clear();
+    m_sink.clear();
+    m_totalQuads = 0;
+}
+
+void ChunkMesher::markDirty(int cx, int cy, int cz) {
+    auto* chunk = m_storage.getChunk(cx, cy, cz);
+    if (!chunk) return;
+    // Guard: only mesh chunks whose voxel data is fully ready.
+    // Submitting UNGENERATED or GENERATING chunks yields empty meshes.
+    if (chunk->m_state.load(std::memory_order_acquire) != ChunkState::READY) return;
+    // Skip known-empty chunks (all-air / fully-occluded).
+    // These are re-enabled by forceMarkDirty() when voxel data actually changes, or pass
+    // while their reduced payload is coarser than the LOD they now need (flushDirty() refines).
+    auto stateIt = m_meshState.find({cx, cy, cz});
+    if (stateIt != m_meshState.end() && stateIt->second.isEmpty &&
+        chunk->getPayloadLod() <= std::max(chunk->m_currentLOD.load(std::memory_order_relaxed), 0)) return;
+    m_dirtyPending.insert({cx, cy, cz});
+}
+
+void ChunkMesher::forceMarkDirty(int cx, int cy, int cz) {
+    auto* chunk = m_storage.getChunk(cx, cy, cz);
+    if (!chunk) return;
+    if (chunk->m_state.load(std::memory_order_acquire) != ChunkState::READY) return;
+    // Clear the isEmpty flag so the chunk gets re-meshed after a voxel edit.
+    auto stateIt = m_meshState.find({cx, cy, cz});
+    if (stateIt != m_meshState.end()) stateIt->second.isEmpty = false;
+    m_dirtyPending.insert({cx, cy, cz});
+}
+
+void ChunkMesher::clearEmptyFlag(int cx, int cy, int cz) {
+    auto stateIt = m_meshState.find({cx, cy, cz});
+    if (stateIt != m_meshState.end()) stateIt->second.isEmpty = false;
+}
+
+void ChunkMesher::flushDirty() {
+    if (m_dirtyPending.empty()) return;
+
+    std::vector<MeshTask> batch;
+    batch.reserve(m_dirtyPending.size());
+    std::vector<MeshTask> refineBatch;
+
+    // 1) Evaluate Frustum, LODs, & push visible
+    for (const auto& key : m_dirtyPending) {
+        auto chunk = m_storage.getChunk(key.x, key.y, key.z);
+        if (!chunk) continue;
+        chunk->markDirty();
+
+        int lod = chunk->m_currentLOD.load(std::memory_order_relaxed);
+        if (lod < 0) lod = m_lodCtrl.calculateLOD(key.x, key.y, key.z); // fallback if unassigned
+
+        // Reduced payload coarser than this LOD: generate the finer one first. The current mesh
+        // stays on screen; the refine result re-queues the chunk (rebuildDirtyChunks()).
+        if (chunk->getPayloadLod() > lod) {
+            if (m_refining.insert(key).second) {
+                MeshTask task = makeGenerateTask(chunk, m_storage.getCachedConfig());
+                task.lod    = lod;
+                task.refine = true;
+                refineBatch.push_back(std::move(task));
+            }
+            continue;
+        }
+
+        std::array<const Chunk*, 6> neighbors = {
+            m_storage.getChunk(key.x + 1, key.y, key.z),
+            m_storage.getChunk(key.x - 1, key.y, key.z),
+            m_storage.getChunk(key.x, key.y + 1, key.z),
+            m_storage.getChunk(key.x, key.y - 1, key.z),
+            m_storage.getChunk(key.x, key.y, key.z + 1),
+            m_storage.getChunk(key.x, key.y, key.z - 1)
+        };
+        
+        std::array<int, 6> nLODs = {
+            m_lodCtrl.calculateLOD(key.x + 1, key.y, key.z),
+            m_lodCtrl.calculateLOD(key.x - 1, key.y, key.z),
+            m_lodCtrl.calculateLOD(key.x, key.y + 1, key.z),
+            m_lodCtrl.calculateLOD(key.x, key.y - 1, key.z),
+            m_lodCtrl.calculateLOD(key.x, key.y, key.z + 1),
+            m_lodCtrl.calculateLOD(key.x, key.y, key.z - 1)
+        };
+
+        MeshTask task;
+        task.chunk = chunk;
+        task.neighbors = neighbors;
+        task.neighborLODs = nLODs;
+        task.cx = key.x;
+        task.cy = key.y;
+        task.cz = key.z;
+        task.lod = lod;
+        batch.push_back(std::move(task));
+    }
+    m_dirtyPending.clear();
+
+    if (!refineBatch.empty()) {
+        m_meshWorker.submitBatchHigh(refineBatch);
+    }
+    if (!batch.empty()) {
+        m_meshWorker.submitBatchHigh(batch);
+    }
+}
+
+MeshTask ChunkMesher::makeGenerateTask(Chunk* chunk, const TerrainConfig& config) const {
+    MeshTask task;
+    task.type = MeshTask::Type::GENERATE;
+    task.chunk = chunk;
+    task.cx = chunk->getCX();
+    task.cy = chunk->getCY();
+    task.cz = chunk->getCZ();
+    task.config = config;
+    // Far chunks only get the voxels their mesh LOD reads; flushDirty() refines them later.
+    task.lod = m_lodCtrl.generationLOD(task.cx, task.cy, task.cz);
+    return task;
+}
+
+void ChunkMesher::submitGenerateTaskHigh(Chunk* chunk, const TerrainConfig& config) {
+    if (!chunk) return;
+    std::vector<MeshTask> batch;
+    batch.push_back(makeGenerateTask(chunk, config));
+    m_meshWorker.submitBatchHigh(batch);
+}
+
+void ChunkMesher::submitGenerateTaskLow(Chunk* chunk, const TerrainConfig& config) {
+    if (!chunk) return;
+    std::vector<MeshTask> batch;
+    batch.push_back(makeGenerateTask(chunk, config));
+    m_meshWorker.submitBatchLow(batch);  // LOW priority: won't starve mesh rebuilds
+}
+
+void ChunkMesher::waitAllWorkers() {
+    m_meshWorker.waitAll();
+}
+
+void ChunkMesher::applyLateDecorations() {
+    size_t kept = 0;
+    for (auto& d : m_lateDecorations) {
+        Chunk* chunk = m_storage.getChunk(d.cx, d.cy, d.cz);
+        // Unloaded: DecorationQueue still holds the writes for its next GENERATE.
+        if (!chunk) continue;
+        const ChunkState state = chunk->m_state.load(std::memory_order_acquire);
+        if (state == ChunkState::GENERATING) {
+            // Payload (generated or loaded) not published yet — next frame. A GENERATE that
+            // collected after the post already holds the writes; reapplying changes nothing.
+            m_lateDecorations[kept++] = std::move(d);
+            continue;
+        }
+        // UNGENERATED: its GENERATE has not collected yet and will find the writes in the
+        // queue. Edited chunks keep the player's voxels.
+        if (state != ChunkState::READY || chunk->m_isModified.load(std::memory_order_relaxed)) continue;
+        if (!chunk->applyDecoration(d.writes)) continue;
+
+        forceMarkDirty(d.cx, d.cy, d.cz);
+        markDirty(d.cx + 1, d.cy, d.cz);
+        markDirty(d.cx - 1, d.cy, d.cz);
+        markDirty(d.cx, d.cy + 1, d.cz);
+        markDirty(d.cx, d.cy - 1, d.cz);
+        markDirty(d.cx, d.cy, d.cz + 1);
+        markDirty(d.cx, d.cy, d.cz - 1);
+    }
+    m_lateDecorations.resize(kept);
+}
+
+void ChunkMesher::rebuildDirtyChunks(float currentTime) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    auto done = m_meshWorker.collect();
+    // Tree voxels the workers could not hand to an already-generated neighbour.
+    for (auto& task : done) {
+        for (auto& d : task.decorations) m_lateDecorations.push_back(std::move(d));
+        task.decorations.clear();
+    }
+    applyLateDecorations();
+    if (done.empty()) return;
+
+    // Deduplicate: keep only the most-recently-completed task per chunk.
+    // This prevents uploading an outdated LOD result when the worker queue
+    // delivered multiple results for the same chunk in one collect() batch.
+    std::unordered_map<IVec3Key, MeshTask, IVec3Hash> latestTasks;
+    latestTasks.reserve(done.size());
+    auto keepLatest = [&latestTasks, this](const IVec3Key& key, MeshTask& task) {
+        auto [it, inserted] = latestTasks.try_emplace(key);
+        if (!inserted) discardResult(it->second);
+        it->second = std::move(task);
+    };
+    for (auto& task : done) {
+        IVec3Key key{task.cx, task.cy, task.cz};
+
+        if (task.refine) {
+            // Finer payload is in (or an edit got there first): re-mesh at the current LOD.
+            // The old mesh is kept until that result replaces it.
+            m_refining.erase(key);
+            forceMarkDirty(key.x, key.y, key.z);
+            // Same-LOD neighbours meshed their shared faces against the coarse payload.
+            markDirty(key.x + 1, key.y, key.z);
+            markDirty(key.x - 1, key.y, key.z);
+            markDirty(key.x, key.y + 1, key.z);
+            markDirty(key.x, key.y - 1, key.z);
+            markDirty(key.x, key.y, key.z + 1);
+            markDirty(key.x, key.y, key.z - 1);
+            continue;
+        }
+
+        if (task.type == MeshTask::Type::GENERATE) {
+            keepLatest(key, task);
+            continue;
+        }
+
+        auto chunk = m_storage.getChunk(key.x, key.y, key.z);
+        int desiredLOD = chunk ? chunk->m_currentLOD.load(std::memory_order_relaxed) : 0;
+        if (task.lod == desiredLOD) {
+            keepLatest(key, task);
+        } else {
+            discardResult(task); // stale LOD result
+        }
+    }
+
+    m_sink.beginUploads(currentTime);
+
+    for (auto& [key, task] : latestTasks) {
+        if (task.type != MeshTask::Type::GENERATE) {
+            auto chunk = m_storage.getChunk(key.x, key.y, key.z);
+            int desiredLOD = chunk ? chunk->m_currentLOD.load(std::memory_order_relaxed) : 0;
+            if (task.lod != desiredLOD) {
+                discardResult(task);
+                continue;
+            }
+        }
+
+        auto& state = m_meshState[key];
+
+        if (task.type == MeshTask::Type::GENERATE) {
+            // New voxels: the old mesh (if any) no longer matches them.
+            releaseMesh(key, state);
+            // Voxels are ready — queue this chunk for meshing on the next flushDirty().
+            // Do NOT submit here: we need neighbour data which may also be freshly generated.
+            m_dirtyPending.insert(IVec3Key{key.x, key.y, key.z});
+            continue;
+        }
+
+        if (task.result.empty() && !task.staged.valid()) {
+            releaseMesh(key, state);
+            // Chunk is all-air or fully occluded — no geometry needed.
+            // Tag it so markDirty() silently ignores future LOD-cascade notifications.
+            state.isEmpty = true;
+            // Always clear the dirty flag regardless of LOD level (Bug fix: previously
+            // markClean was only called for lod==0, leaving LOD1/2 chunks permanently dirty).
+            auto chunk = m_storage.getChunk(key.x, key.y, key.z);
+            if (chunk) chunk->markClean();
+            continue;
+        }
+
+        // Non-empty result: clear any stale isEmpty flag (chunk gained geometry).
+        state.isEmpty = false;
+
+        // Voxel quads are already generated in local chunk space [0, CHUNK_SIZE]!
+        // No worldBias shifting needed. The sink places the mesh per chunk.
+        if (state.hasMesh) {
+            m_totalQuads -= state.quadCount;
+        }
+        // Both replace the previous mesh.
+        if (task.staged.valid()) {
+            m_sink.uploadStaged(key, task.lod, task.staged);
+            state.quadCount = task.staged.quadCount;
+        } else {
+            m_sink.uploadMesh(key, task.lod, task.result);
+            state.quadCount = task.result.quadCount();
+        }
+        state.lod         = task.lod;
+        state.hasMesh     = true;
+        m_totalQuads += state.quadCount;
+
+        auto chunk = m_storage.getChunk(key.x, key.y, key.z);
+        if (chunk) chunk->markClean();
+    }
+
+    m_sink.endUploads();
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    m_lastRebuildMs = std::chrono::duration<float, std::milli>(t1 - t0).count();
+}
+
+void ChunkMesher::discardResult(MeshTask& task) {
+    if (task.staged.valid()) m_sink.releaseStaging(task.staged);
+    task.staged = {};
+}
+
+void ChunkMesher::releaseMesh(const IVec3Key& key, MeshState& state) {
+    if (!state.hasMesh) return;
+    m_sink.releaseMesh(key);
+    m_totalQuads -= state.quadCount;
+    state.quadCount = 0;
+    state.hasMesh     = false;
+}
+
+void ChunkMesher::removeChunk(const IVec3Key& key) {
+    auto it = m_meshState.find(key);
+    if (it != m_meshState.end()) {
+        releaseMesh(key, it->second);
+        m_meshState.erase(it);
+    }
+    m_dirtyPending.erase(key);
+}
+
+void ChunkMesher::unloadMeshOnly(const IVec3Key& key) {
+    // Tier-3: звільняємо mesh, але залишаємо LOD_EVICTED у чанку.
+    auto it = m_meshState.find(key);
+    if (it != m_meshState.end()) {
+        releaseMesh(key, it->second);
+        m_meshState.erase(it);
+    }
+    // Ключова відмінність від removeChunk: ставимо sentinel LOD_EVICTED,
+    // а не erase — щоб updateCamera знала "цей чанк вивантажено свідомо".
+    Chunk* chunk = m_storage.getChunk(key.x, key.y, key.z);
+    if (chunk) chunk->m_currentLOD.store(LOD_EVICTED, std::memory_order_relaxed);
+    m_dirtyPending.erase(key);
+}
+
+std::array<uint32_t, 3> ChunkMesher::getLODCounts() const {
+    std::array<uint32_t, 3> out{0, 0, 0};
+    for (const auto& [key, state] : m_meshState) {
+        if (state.hasMesh && state.lod >= 0 && state.lod <= 2) out[static_cast<size_t>(state.lod)]++;
+    }
+    return out;
+}
+
+bool ChunkMesher::hasMesh() const {
+    for (const auto& [key, state] : m_meshState) {
+        if (state.hasMesh) return true;
+    }
+    return false;
+}
+
+} // namespace world
@@ -0,0 +1,117 @@
+#pragma once
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "world/Chunk.hpp"
+#include "world/ChunkStorage.hpp"
+#include "world/ChunkMeshSink.hpp"
+#include "world/LODController.hpp"
+#include "world/MeshWorker.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// ChunkMesher — CPU side of chunk rendering: what gets meshed, at which LOD, and when.
+//
+// Owns the MeshWorker pool and the dirty / refine / late-decoration bookkeeping. Finished
+// meshes are handed to a ChunkMeshSink (ChunkRenderer on the GPU, CountingMeshSink headless),
+// so generation, streaming and meshing build and run without Vulkan.
+// ---------------------------------------------------------------------------
+class ChunkMesher {
+public:
+    // Sentinel LOD values:
+    //   -1 = chunk exists in storage but LOD not yet assigned
+    //   -2 = chunk intentionally evicted (Tier-3), do NOT re-schedule mesh
+    static constexpr int LOD_UNASSIGNED = -1;
+    static constexpr int LOD_EVICTED    = -2;
+
+    ChunkMesher(ChunkStorage& storage, LODController& lodCtrl, ChunkMeshSink& sink, uint32_t meshWorkerThreads = 0);
+
+    // Queue updates
+    void markDirty(int cx, int cy, int cz);
+    // Same as markDirty but bypasses the isEmpty guard —
+    // must be called when voxel data actually changes (setVoxel).
+    void forceMarkDirty(int cx, int cy, int cz);
+    void flushDirty();
+    void submitGenerateTaskHigh(Chunk* chunk, const TerrainConfig& config);
+    void submitGenerateTaskLow (Chunk* chunk, const TerrainConfig& config); // async streaming
+
+    // Returns true if the last completed mesh task for this chunk produced
+    // zero geometry (all-air / fully-occluded). Neighbour-notification code
+    // in ChunkManager uses this to skip useless cascade dirty-marks.
+    bool isChunkEmpty(const IVec3Key& key) const {
+        auto it = m_meshState.find(key);
+        return it != m_meshState.end() && it->second.isEmpty;
+    }
+
+    // Block until all queued worker tasks are finished (use before first frame)
+    void waitAllWorkers();
+
+    // Collects finished worker tasks and hands the meshes to the sink.
+    void rebuildDirtyChunks(float currentTime);
+
+    // LOD Counters (chunks holding a mesh, by mesh LOD)
+    std::array<uint32_t, 3> getLODCounts() const;
+
+    // Stats
+    uint32_t getTotalQuads()    const { return m_totalQuads; }
+    float    getLastRebuildMs() const { return m_lastRebuildMs; }
+    bool     hasMesh() const;
+    uint32_t getWorkerThreads() const { return m_meshWorker.getThreadCount(); }
+    int      getPendingMeshes() const { return m_meshWorker.getActiveTasks(); }
+    uint64_t getSkippedMeshes() const { return m_meshWorker.getSkippedMeshes(); }
+
+    void clear();
+    // Full removal: mesh + per-chunk mesh state
+    void removeChunk(const IVec3Key& key);
+    // Tier-3: frees the mesh only, sets LOD_EVICTED on the chunk
+    // so LOD logic won't re-schedule meshing until chunk re-enters view.
+    void unloadMeshOnly(const IVec3Key& key);
+    // Clears the isEmpty flag for a chunk so it will be re-meshed
+    // (used internally by forceMarkDirty).
+    void clearEmptyFlag(int cx, int cy, int cz);
+
+private:
+    // Per-chunk mesh bookkeeping (the geometry itself lives in the sink).
+    struct MeshState {
+        uint32_t quadCount   = 0;
+        int      lod         = -1;
+        bool     hasMesh     = false; // the sink holds a mesh for this chunk
+        // isEmpty = true:  mesh task returned empty result (all-air or all-solid chunk).
+        // markDirty() silently skips these chunks to prevent cascade re-submissions.
+        // Cleared automatically by forceMarkDirty() on voxel edits.
+        bool     isEmpty     = false;
+    };
+
+    // GENERATE task at the chunk's generation LOD (LODController::generationLOD()).
+    MeshTask makeGenerateTask(Chunk* chunk, const TerrainConfig& config) const;
+    // Applies DecorationQueue writes that may have arrived after their target chunk generated;
+    // targets that are not resident or not generated yet collect them on their own GENERATE.
+    void applyLateDecorations();
+    // Drops the chunk's mesh from the sink and the quad total.
+    void releaseMesh(const IVec3Key& key, MeshState& state);
+    // Returns a finished MESH result's staging reservation (if any) to the sink unused.
+    void discardResult(MeshTask& task);
+
+    // -------------------------------------------------------------
+    // Core references
+    ChunkStorage&  m_storage;
+    LODController& m_lodCtrl;
+    ChunkMeshSink& m_sink;
+    MeshWorker     m_meshWorker;
+
+    // -------------------------------------------------------------
+    std::unordered_map<IVec3Key, MeshState, IVec3Hash> m_meshState;
+    std::unordered_set<IVec3Key, IVec3Hash>            m_dirtyPending;
+    // Reduced chunks with a refine (finer payload) GENERATE task in flight.
+    std::unordered_set<IVec3Key, IVec3Hash>            m_refining;
+    // Late tree writes waiting for their chunk (GENERATING → retried next frame).
+    std::vector<DecorationDelivery>                    m_lateDecorations;
+
+    // Statistics
+    uint32_t m_totalQuads    = 0;
+    float    m_lastRebuildMs = 0.0f;
+};
+
+} // namespace world
@@ -0,0 +1,73 @@
+#include "world/ChunkPool.hpp"
+
+namespace world {
+
+ChunkPool::Handle ChunkPool::acquire(int cx, int cy, int cz) {
+    Chunk* chunk = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_free.empty() && !m_deferred.empty()) collectDeferred();
+
+        if (!m_free.empty()) {
+            chunk = m_free.back();
+            m_free.pop_back();
+            ++m_stats.recycled;
+        } else {
+            if (m_fresh.empty()) growSlab();
+            chunk = m_fresh.back();
+            m_fresh.pop_back();
+        }
+        ++m_stats.acquired;
+        ++m_stats.inUse;
+    }
+    chunk->reset(cx, cy, cz);
+    return Handle(chunk, Deleter{this});
+}
+
+void ChunkPool::release(Chunk* chunk) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.released;
+    --m_stats.inUse;
+    if (chunk->m_taskRefs.load(std::memory_order_acquire) != 0) {
+        m_deferred.push_back(chunk);
+    } else {
+        m_free.push_back(chunk);
+    }
+}
+
+void ChunkPool::prewarm(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (m_stats.capacity < capacity) growSlab();
+}
+
+ChunkPool::Stats ChunkPool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats s = m_stats;
+    s.freeCount = m_free.size() + m_fresh.size();
+    s.deferred  = m_deferred.size();
+    return s;
+}
+
+void ChunkPool::growSlab() {
+    m_slabs.push_back(std::make_unique<Chunk[]>(SLAB_SIZE));
+    Chunk* slab = m_slabs.back().get();
+    m_fresh.reserve(m_fresh.size() + SLAB_SIZE);
+    // Size the free / deferred lists for the whole pool so release() never reallocates.
+    m_free.reserve(m_stats.capacity + SLAB_SIZE);
+    m_deferred.reserve(m_stats.capacity + SLAB_SIZE);
+    // Push in reverse so chunks are handed out in address order.
+    for (size_t i = SLAB_SIZE; i-- > 0;) m_fresh.push_back(&slab[i]);
+    m_stats.capacity += SLAB_SIZE;
+    ++m_stats.slabAllocations;
+}
+
+void ChunkPool::collectDeferred() {
+    size_t keep = 0;
+    for (Chunk* chunk : m_deferred) {
+        if (chunk->m_taskRefs.load(std::memory_order_acquire) == 0) m_free.push_back(chunk);
+        else m_deferred[keep++] = chunk;
+    }
+    m_deferred.resize(keep);
+}
+
+} // namespace world
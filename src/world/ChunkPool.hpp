@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include "world/Chunk.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// ChunkPool — slab allocator + free list for Chunk objects.
+//
+// Chunks are allocated in slabs of SLAB_SIZE and never returned to the heap
+// while the pool lives. acquire() pops a free chunk and re-targets it with
+// Chunk::reset(); the Handle's deleter pushes it back on release. Streaming a
+// column out and back in therefore costs no heap allocation once the pool has
+// grown (or been pre-warmed) to the working-set size.
+//
+// A released chunk that is still referenced by queued / running MeshWorker
+// tasks (Chunk::m_taskRefs != 0) is parked on a deferred list and only becomes
+// reusable after those tasks finish, so a worker never sees it re-targeted.
+//
+// The pool must outlive every Handle it issued.
+// ---------------------------------------------------------------------------
+class ChunkPool {
+public:
+    static constexpr size_t SLAB_SIZE = 256;
+
+    struct Deleter {
+        ChunkPool* pool = nullptr;
+        void operator()(Chunk* chunk) const { if (pool && chunk) pool->release(chunk); }
+    };
+    using Handle = std::unique_ptr<Chunk, Deleter>;
+
+    struct Stats {
+        uint64_t slabAllocations = 0; // heap allocations made by the pool (one per slab)
+        uint64_t acquired        = 0; // acquire() calls
+        uint64_t recycled        = 0; // acquire() calls served by a previously released chunk
+        uint64_t released        = 0; // handles returned to the pool
+        size_t   capacity        = 0; // chunks owned by the pool (in use + free + deferred)
+        size_t   inUse           = 0;
+        size_t   freeCount       = 0;
+        size_t   deferred        = 0; // released but still referenced by worker tasks
+    };
+
+    ChunkPool() = default;
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    // Returns a chunk at (cx,cy,cz) in UNGENERATED state with an all-AIR payload.
+    Handle acquire(int cx, int cy, int cz);
+
+    // Grows the pool until it owns at least `capacity` chunks. Never shrinks.
+    void prewarm(size_t capacity);
+
+    Stats getStats() const;
+
+private:
+    void release(Chunk* chunk);
+    void growSlab();             // caller holds m_mutex
+    void collectDeferred();      // caller holds m_mutex
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<Chunk[]>> m_slabs;
+    std::vector<Chunk*> m_free;     // released chunks, reused first (warm in cache)
+    std::vector<Chunk*> m_fresh;    // slab chunks never handed out yet
+    std::vector<Chunk*> m_deferred; // released, waiting for m_taskRefs to drop to zero
+
+    Stats m_stats;
+};
+
+} // namespace world
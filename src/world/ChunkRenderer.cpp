@@ -1,20 +1,19 @@
 #include "ChunkRenderer.hpp"
 #include "gfx/rendering/Pipeline.hpp"
-#include <chrono>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
 
 namespace world {
 
-ChunkRenderer::ChunkRenderer(gfx::VulkanContext& context, gfx::GeometryManager& geom, ChunkStorage& storage, LODController& lodCtrl, uint32_t meshWorkerThreads)
-    : m_context(context), m_geometryManager(geom), m_storage(storage), m_lodCtrl(lodCtrl), m_meshWorker(meshWorkerThreads)
+ChunkRenderer::ChunkRenderer(gfx::VulkanContext& context, gfx::GeometryManager& geom)
+    : m_context(context), m_geometryManager(geom)
 {
-    std::cout << "[ChunkRenderer] MeshWorker threads: "
-              << m_meshWorker.getThreadCount() << "\n" << std::flush;
-              
     createDescriptorSetLayout();
     createBuffers();
+    // Chunk meshes carry no indices: every draw reads the shared quad pattern.
+    m_geometryManager.reserveQuadIndices(MAX_CHUNK_QUADS);
 }
 
 ChunkRenderer::~ChunkRenderer() {
@@ -27,6 +26,7 @@ ChunkRenderer::~ChunkRenderer() {
         if (m_instanceBuffers[i]) m_instanceBuffers[i]->unmap();
         if (m_cameraIndirectBuffers[i]) m_cameraIndirectBuffers[i]->unmap();
         if (m_shadowIndirectBuffers[i]) m_shadowIndirectBuffers[i]->unmap();
+        if (m_liquidIndirectBuffers[i]) m_liquidIndirectBuffers[i]->unmap();
     }
 }
 
@@ -79,7 +79,8 @@ void ChunkRenderer::createDescriptorSetLayout() {
 
 void ChunkRenderer::createBuffers() {
     VkDeviceSize instanceBufferSize = MAX_VISIBLE_CHUNKS * sizeof(ChunkInstanceData);
-    VkDeviceSize indirectBufferSize = MAX_VISIBLE_CHUNKS * sizeof(VkDrawIndexedIndirectCommand);
+    VkDeviceSize cameraIndirectSize = MAX_CAMERA_DRAWS * sizeof(VkDrawIndexedIndirectCommand);
+    VkDeviceSize shadowIndirectSize = MAX_VISIBLE_CHUNKS * sizeof(VkDrawIndexedIndirectCommand);
 
     for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
         m_instanceBuffers[i] = std::make_unique<gfx::Buffer>(
@@ -92,7 +93,7 @@ void ChunkRenderer::createBuffers() {
 
         m_cameraIndirectBuffers[i] = std::make_unique<gfx::Buffer>(
             m_context,
-            indirectBufferSize,
+            cameraIndirectSize,
             VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
             VMA_MEMORY_USAGE_CPU_TO_GPU
         );
@@ -100,12 +101,20 @@ void ChunkRenderer::createBuffers() {
 
         m_shadowIndirectBuffers[i] = std::make_unique<gfx::Buffer>(
             m_context,
-            indirectBufferSize,
+            shadowIndirectSize,
             VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
             VMA_MEMORY_USAGE_CPU_TO_GPU
         );
         m_shadowIndirectBuffers[i]->map(&m_shadowIndirectMapped[i]);
 
+        m_liquidIndirectBuffers[i] = std::make_unique<gfx::Buffer>(
+            m_context,
+            shadowIndirectSize, // one per chunk as well
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VMA_MEMORY_USAGE_CPU_TO_GPU
+        );
+        m_liquidIndirectBuffers[i]->map(&m_liquidIndirectMapped[i]);
+
         VkDescriptorBufferInfo instanceInfo{};
         instanceInfo.buffer = m_instanceBuffers[i]->getBuffer();
         instanceInfo.offset = 0;
@@ -137,14 +146,12 @@ void ChunkRenderer::createBuffers() {
     // Persistent SSBO: Reserve CPU-side buffers
     m_cpuInstanceData.reserve(MAX_VISIBLE_CHUNKS);
     m_fadeStartTimes.reserve(MAX_VISIBLE_CHUNKS);
-    m_activeBatches.reserve(128); // avoid heap allocation during hot rendering loop
 }
 
 void ChunkRenderer::clear() {
-    m_meshWorker.waitAll();
-    m_meshWorker.collect();
+    for (auto& [key, rd] : m_renderData) freeMesh(rd);
     m_renderData.clear();
-    m_dirtyPending.clear();
+    m_pendingUploads.clear();
     m_cpuInstanceData.clear();
     m_fadeStartTimes.clear();
     m_renderSnapshot.clear();
@@ -152,11 +159,11 @@ void ChunkRenderer::clear() {
     m_sortedChunks.clear();
     m_listDirty = true;
     m_framesDirty = {true, true, true};
-    m_totalVertices = 0;
-    m_totalIndices = 0;
     m_visibleCount = 0;
     m_culledCount = 0;
     m_visibleVertices = 0;
+    m_backfaceTriangles = 0;
+    m_liquidTriangles = 0;
 }
 
 void ChunkRenderer::upsertRenderSnapshot(const IVec3Key& key, const ChunkRenderData& rd, int lod) {
@@ -167,10 +174,10 @@ void ChunkRenderer::upsertRenderSnapshot(const IVec3Key& key, const ChunkRenderD
 
     RenderChunkSnapshot snapshot{};
     snapshot.key = key;
-    snapshot.poolIndex = rd.mesh->getBufferIndex();
+    snapshot.quadAddress = m_geometryManager.getQuadAddress(*rd.mesh, sizeof(VoxelQuad));
     snapshot.indexCount = rd.indexCount;
-    snapshot.firstIndex = rd.mesh->getFirstIndex();
-    snapshot.vertexOffset = rd.mesh->getVertexOffset();
+    snapshot.faceQuads = rd.faceQuads;
+    snapshot.liquidQuads = rd.liquidQuads;
     snapshot.lod = lod;
     snapshot.fadeStartTime = rd.fadeStartTime;
     snapshot.fadeProgress = rd.fadeProgress;
@@ -218,134 +225,6 @@ scene::AABB ChunkRenderer::buildAABB(int cx, int cy, int cz) const {
     return {{wx, wy, wz}, {wx + sz, wy + sz, wz + sz}};
 }
 
-void ChunkRenderer::markDirty(int cx, int cy, int cz) {
-    auto* chunk = m_storage.getChunk(cx, cy, cz);
-    if (!chunk) return;
-    // Guard: only mesh chunks whose voxel data is fully ready.
-    // Submitting UNGENERATED or GENERATING chunks yields empty meshes.
-    if (chunk->m_state.load(std::memory_order_acquire) != ChunkState::READY) return;
-    // Skip known-empty chunks (all-air / fully-occluded).
-    // These are re-enabled by forceMarkDirty() when voxel data actually changes.
-    auto rdIt = m_renderData.find({cx, cy, cz});
-    if (rdIt != m_renderData.end() && rdIt->second.isEmpty) return;
-    m_dirtyPending.insert({cx, cy, cz});
-}
-
-void ChunkRenderer::forceMarkDirty(int cx, int cy, int cz) {
-    auto* chunk = m_storage.getChunk(cx, cy, cz);
-    if (!chunk) return;
-    if (chunk->m_state.load(std::memory_order_acquire) != ChunkState::READY) return;
-    // Clear the isEmpty flag so the chunk gets re-meshed after a voxel edit.
-    auto rdIt = m_renderData.find({cx, cy, cz});
-    if (rdIt != m_renderData.end()) rdIt->second.isEmpty = false;
-    m_dirtyPending.insert({cx, cy, cz});
-}
-
-void ChunkRenderer::clearEmptyFlag(int cx, int cy, int cz) {
-    auto rdIt = m_renderData.find({cx, cy, cz});
-    if (rdIt != m_renderData.end()) rdIt->second.isEmpty = false;
-}
-
-void ChunkRenderer::flushDirty() {
-    if (m_dirtyPending.empty()) return;
-
-    std::vector<MeshTask> batch;
-    batch.reserve(m_dirtyPending.size());
-
-    // 1) Evaluate Frustum, LODs, & push visible
-    for (const auto& key : m_dirtyPending) {
-        auto chunk = m_storage.getChunk(key.x, key.y, key.z);
-        if (!chunk) continue;
-        chunk->markDirty();
-
-        int lod = chunk->m_currentLOD.load(std::memory_order_relaxed);
-        if (lod < 0) lod = m_lodCtrl.calculateLOD(key.x, key.y, key.z); // fallback if unassigned
-
-        std::array<const Chunk*, 6> neighbors = {
-            m_storage.getChunk(key.x + 1, key.y, key.z),
-            m_storage.getChunk(key.x - 1, key.y, key.z),
-            m_storage.getChunk(key.x, key.y + 1, key.z),
-            m_storage.getChunk(key.x, key.y - 1, key.z),
-            m_storage.getChunk(key.x, key.y, key.z + 1),
-            m_storage.getChunk(key.x, key.y, key.z - 1)
-        };
-        
-        std::array<int, 6> nLODs = {
-            m_lodCtrl.calculateLOD(key.x + 1, key.y, key.z),
-            m_lodCtrl.calculateLOD(key.x - 1, key.y, key.z),
-            m_lodCtrl.calculateLOD(key.x, key.y + 1, key.z),
-            m_lodCtrl.calculateLOD(key.x, key.y - 1, key.z),
-            m_lodCtrl.calculateLOD(key.x, key.y, key.z + 1),
-            m_lodCtrl.calculateLOD(key.x, key.y, key.z - 1)
-        };
-
-        MeshTask task;
-        task.chunk = chunk;
-        task.neighbors = neighbors;
-        task.neighborLODs = nLODs;
-        task.cx = key.x;
-        task.cy = key.y;
-        task.cz = key.z;
-        task.lod = lod;
-        batch.push_back(std::move(task));
-    }
-    m_dirtyPending.clear();
-
-    if (!batch.empty()) {
-        m_meshWorker.submitBatchHigh(batch);
-    }
-}
-
-void ChunkRenderer::submitGenerateTaskHigh(Chunk* chunk, const TerrainConfig& config) {
-    if (!chunk) return;
-    MeshTask task;
-    task.type = MeshTask::Type::GENERATE;
-    task.chunk = chunk;
-    task.cx = chunk->getCX();
-    task.cy = chunk->getCY();
-    task.cz = chunk->getCZ();
-    task.config = config;
-    
-    std::vector<MeshTask> batch;
-    batch.push_back(std::move(task));
-    m_meshWorker.submitBatchHigh(batch);
-}
-
-void ChunkRenderer::submitGenerateTaskLow(Chunk* chunk, const TerrainConfig& config) {
-    if (!chunk) return;
-    MeshTask task;
-    task.type = MeshTask::Type::GENERATE;
-    task.chunk = chunk;
-    task.cx = chunk->getCX();
-    task.cy = chunk->getCY();
-    task.cz = chunk->getCZ();
-    task.config = config;
-
-    std::vector<MeshTask> batch;
-    batch.push_back(std::move(task));
-    m_meshWorker.submitBatchLow(batch);  // LOW priority: won't starve mesh rebuilds
-}
-
-void ChunkRenderer::waitAllWorkers() {
-    m_meshWorker.waitAll();
-}
-
-std::array<uint32_t, 3> ChunkRenderer::getLODCounts() const {
-    std::array<uint32_t, 3> out{0, 0, 0};
-    for (const auto& snapshot : m_renderSnapshot) {
-        int lod = snapshot.lod;
-        if (lod >= 0 && lod <= 2) out[static_cast<size_t>(lod)]++;
-    }
-    return out;
-}
-
-bool ChunkRenderer::hasMesh() const {
-    for (const auto& [key, rd] : m_renderData) {
-        if (rd.valid && rd.mesh) return true;
-    }
-    return false;
-}
-
 // ---------------------------------------------------------------------------
 // Persistent SSBO helpers
 // ---------------------------------------------------------------------------
@@ -355,10 +234,10 @@ void ChunkRenderer::rebuildSortedList() {
     m_sortedChunks.reserve(m_renderSnapshot.size());
     for (uint32_t i = 0; i < static_cast<uint32_t>(m_renderSnapshot.size()); ++i) {
         const auto& snapshot = m_renderSnapshot[i];
-        m_sortedChunks.push_back({i, snapshot.poolIndex, snapshot.lod});
+        m_sortedChunks.push_back({i, snapshot.lod});
     }
+    // Pools no longer split the draw (vertex pulling), so only the LOD order is kept.
     std::sort(m_sortedChunks.begin(), m_sortedChunks.end(), [](const ChunkDrawCmd& a, const ChunkDrawCmd& b) {
-        if (a.poolIndex != b.poolIndex) return a.poolIndex < b.poolIndex;
         return a.lod < b.lod;
     });
 }
@@ -376,6 +255,8 @@ void ChunkRenderer::rebuildCpuInstanceData() {
         inst.posY         = static_cast<float>(snapshot.key.y * CHUNK_SIZE);
         inst.posZ         = static_cast<float>(snapshot.key.z * CHUNK_SIZE);
         inst.fadeProgress = snapshot.fadeProgress;
+        inst.quadAddress  = snapshot.quadAddress;
+        inst.reserved     = 0;
         m_cpuInstanceData.push_back(inst);
         m_fadeStartTimes.push_back(snapshot.fadeStartTime);
     }
@@ -384,49 +265,11 @@ void ChunkRenderer::rebuildCpuInstanceData() {
     m_framesDirty = {true, true, true};
 }
 
-void ChunkRenderer::rebuildIndirectBuffers(uint32_t frame) {
-    auto* cameraIndirects = static_cast<VkDrawIndexedIndirectCommand*>(m_cameraIndirectMapped[frame]);
-    auto* shadowIndirects = static_cast<VkDrawIndexedIndirectCommand*>(m_shadowIndirectMapped[frame]);
-
-    m_activeBatches.clear();
-    if (m_sortedChunks.empty()) return;
-
-    // Pre-reserve to avoid heap allocation during the hot loop
-    m_activeBatches.reserve(m_sortedChunks.size());
-
-    uint32_t currentPool = m_sortedChunks[0].poolIndex;
-    uint32_t startIdx = 0;
-
-    for (uint32_t idx = 0; idx < static_cast<uint32_t>(m_sortedChunks.size()); ++idx) {
-        const auto& cmd = m_sortedChunks[idx];
-        const auto& snapshot = m_renderSnapshot[cmd.snapshotIndex];
-        if (cmd.poolIndex != currentPool) {
-            m_activeBatches.push_back({currentPool, startIdx, idx - startIdx});
-            currentPool = cmd.poolIndex;
-            startIdx = idx;
-        }
-
-        cameraIndirects[idx].indexCount    = snapshot.indexCount;
-        cameraIndirects[idx].instanceCount = 0; // GPU Compute will set to 1 if visible
-        cameraIndirects[idx].firstIndex    = snapshot.firstIndex;
-        cameraIndirects[idx].vertexOffset  = snapshot.vertexOffset;
-        cameraIndirects[idx].firstInstance = idx;
-
-        shadowIndirects[idx].indexCount    = snapshot.indexCount;
-        shadowIndirects[idx].instanceCount = 0;
-        shadowIndirects[idx].firstIndex    = snapshot.firstIndex;
-        shadowIndirects[idx].vertexOffset  = snapshot.vertexOffset;
-        shadowIndirects[idx].firstInstance = idx;
-    }
-    m_activeBatches.push_back({currentPool, startIdx,
-        static_cast<uint32_t>(m_sortedChunks.size()) - startIdx});
-}
-
 void ChunkRenderer::cull(VkCommandBuffer cmd, const scene::Frustum& cameraFrustum, const scene::Frustum& shadowFrustum, const core::math::Vec3& cameraPos, float shadowDistanceLimit, float currentTime, uint32_t currentFrame) {
     (void)cmd;
 
     // 1. Якщо список чанків змінився (load/unload) — перебудуємо sorted list і CPU-буфер.
-    // m_listDirty встановлюється ТІЛЬКИ у rebuildDirtyChunks / removeChunk / unloadMeshOnly.
+    // m_listDirty встановлюється ТІЛЬКИ у uploadMesh / releaseMesh / clear.
     // Після rebuild знімаємо m_listDirty, щоб наступний кадр НЕ перебудовував даремно.
     if (m_listDirty) {
         rebuildSortedList();
@@ -445,43 +288,69 @@ void ChunkRenderer::cull(VkCommandBuffer cmd, const scene::Frustum& cameraFrustu
     }
     if (fadeUpdated) m_framesDirty[currentFrame] = true;
 
-    // 2.5 Renderer-side visibility stats come from the compact render snapshot,
-    // not from indirect-buffer readback.
-    uint32_t visibleCount = 0;
-    uint32_t visibleIndexCount = 0;
-    for (const auto& snapshot : m_renderSnapshot) {
-        if (!isSnapshotVisibleInFrustum(snapshot, cameraFrustum)) {
-            continue;
-        }
-        ++visibleCount;
-        visibleIndexCount += snapshot.indexCount;
-    }
-    m_visibleCount = visibleCount;
-    m_visibleVertices = visibleIndexCount / 3;
-
     // 3. Один memcpy якщо GPU-буфер поточного кадру застарів
     if (m_framesDirty[currentFrame] && !m_cpuInstanceData.empty()) {
         size_t sz = m_cpuInstanceData.size() * sizeof(ChunkInstanceData);
         memcpy(m_instanceMapped[currentFrame], m_cpuInstanceData.data(), sz);
-        rebuildIndirectBuffers(currentFrame);
         m_framesDirty[currentFrame] = false;
     }
 
     m_activeInstances = static_cast<uint32_t>(m_cpuInstanceData.size());
-    m_culledCount = m_activeInstances > visibleCount ? (m_activeInstances - visibleCount) : 0;
-
-    if (m_activeInstances == 0) return;
-
-    // 4. CPU-side frustum filtering writes instanceCount directly into the mapped indirect buffers.
+    m_cameraDrawCount[currentFrame] = 0;
+    m_shadowDrawCount[currentFrame] = 0;
+    m_liquidDrawCount[currentFrame] = 0;
+
+    // 4. CPU-side frustum filtering writes only the visible draws into the mapped indirect
+    //    buffers (firstInstance = the chunk's instance SSBO entry). Camera draws are split by
+    //    face direction and skip the directions that face away from the eye; every draw
+    //    starts at the shared quad index buffer's quad `first`, so gl_VertexIndex / 4 indexes
+    //    the chunk's quads from the instance's quadAddress. Visibility stats come from the
+    //    same pass, not from indirect-buffer readback.
     auto* cameraIndirects = static_cast<VkDrawIndexedIndirectCommand*>(m_cameraIndirectMapped[currentFrame]);
     auto* shadowIndirects = static_cast<VkDrawIndexedIndirectCommand*>(m_shadowIndirectMapped[currentFrame]);
+    uint32_t cameraDraws = 0, shadowDraws = 0;
+    uint32_t visibleCount = 0, visibleIndexCount = 0, backfaceIndexCount = 0;
+    m_liquidOrder.clear();
 
     for (uint32_t idx = 0; idx < static_cast<uint32_t>(m_sortedChunks.size()); ++idx) {
         const auto& drawCmd = m_sortedChunks[idx];
         const auto& snapshot = m_renderSnapshot[drawCmd.snapshotIndex];
 
-        const bool cameraVisible = isSnapshotVisibleInFrustum(snapshot, cameraFrustum);
-        cameraIndirects[idx].instanceCount = cameraVisible ? 1u : 0u;
+        if (isSnapshotVisibleInFrustum(snapshot, cameraFrustum)) {
+            ++visibleCount;
+            const uint32_t facing = chunkFacingMask(snapshot.key.x, snapshot.key.y, snapshot.key.z,
+                                                    cameraPos.x, cameraPos.y, cameraPos.z);
+            // Adjacent drawn directions share one command (+d / -d when the eye is inside
+            // the chunk's slab, or every direction of a chunk around the eye).
+            VkDrawIndexedIndirectCommand* run = nullptr;
+            uint32_t first = 0;
+            for (int face = 0; face < 6; ++face) {
+                const uint32_t quads = snapshot.faceQuads[face];
+                if (quads == 0) continue;
+                if (!(facing & (1u << face))) {
+                    backfaceIndexCount += quadIndexCount(quads);
+                    run = nullptr;
+                } else if (run) {
+                    run->indexCount += quadIndexCount(quads);
+                } else {
+                    run = &cameraIndirects[cameraDraws++];
+                    run->indexCount    = quadIndexCount(quads);
+                    run->instanceCount = 1;
+                    run->firstIndex    = quadIndexCount(first);
+                    run->vertexOffset  = 0;
+                    run->firstInstance = idx;
+                }
+                if (facing & (1u << face)) visibleIndexCount += quadIndexCount(quads);
+                first += quads;
+            }
+
+            if (snapshot.liquidQuads > 0) {
+                const float dx = snapshot.key.x * CHUNK_SIZE + CHUNK_SIZE / 2.0f - cameraPos.x;
+                const float dy = snapshot.key.y * CHUNK_SIZE + CHUNK_SIZE / 2.0f - cameraPos.y;
+                const float dz = snapshot.key.z * CHUNK_SIZE + CHUNK_SIZE / 2.0f - cameraPos.z;
+                m_liquidOrder.push_back({dx * dx + dy * dy + dz * dz, idx});
+            }
+        }
 
         bool shadowVisible = isSnapshotVisibleInFrustum(snapshot, shadowFrustum);
         if (shadowVisible && shadowDistanceLimit > 0.0f) {
@@ -494,15 +363,51 @@ void ChunkRenderer::cull(VkCommandBuffer cmd, const scene::Frustum& cameraFrustu
             const float distSq = dx * dx + dy * dy + dz * dz;
             shadowVisible = distSq <= shadowDistanceLimit * shadowDistanceLimit;
         }
-        shadowIndirects[idx].instanceCount = shadowVisible ? 1u : 0u;
+        if (shadowVisible && snapshot.indexCount > 0) { // liquid-only chunks cast no shadow
+            auto& ic = shadowIndirects[shadowDraws++];
+            ic.indexCount    = snapshot.indexCount;
+            ic.instanceCount = 1;
+            ic.firstIndex    = 0;
+            ic.vertexOffset  = 0;
+            ic.firstInstance = idx;
+        }
     }
 
+    // 5. Liquid: blended without depth writes, so whole chunks go back to front (coarse — quads
+    //    inside one chunk are not sorted). A chunk's liquid quads follow its opaque ones.
+    std::sort(m_liquidOrder.begin(), m_liquidOrder.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+    auto* liquidIndirects = static_cast<VkDrawIndexedIndirectCommand*>(m_liquidIndirectMapped[currentFrame]);
+    uint32_t liquidIndexCount = 0;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_liquidOrder.size()); ++i) {
+        const uint32_t idx = m_liquidOrder[i].second;
+        const auto& snapshot = m_renderSnapshot[m_sortedChunks[idx].snapshotIndex];
+        auto& ic = liquidIndirects[i];
+        ic.indexCount    = quadIndexCount(snapshot.liquidQuads);
+        ic.instanceCount = 1;
+        ic.firstIndex    = quadIndexCount(faceQuadTotal(snapshot.faceQuads));
+        ic.vertexOffset  = 0;
+        ic.firstInstance = idx;
+        liquidIndexCount += ic.indexCount;
+    }
+
+    m_cameraDrawCount[currentFrame] = cameraDraws;
+    m_shadowDrawCount[currentFrame] = shadowDraws;
+    m_liquidDrawCount[currentFrame] = static_cast<uint32_t>(m_liquidOrder.size());
+    m_visibleCount      = visibleCount;
+    m_visibleVertices   = visibleIndexCount / 3;
+    m_backfaceTriangles = backfaceIndexCount / 3;
+    m_liquidTriangles   = liquidIndexCount / 3;
+    m_culledCount = m_activeInstances > visibleCount ? (m_activeInstances - visibleCount) : 0;
+
     m_cameraIndirectBuffers[currentFrame]->flush();
     m_shadowIndirectBuffers[currentFrame]->flush();
+    m_liquidIndirectBuffers[currentFrame]->flush();
 }
 
 void ChunkRenderer::renderCamera(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame) {
-    if (m_activeInstances == 0) return;
+    if (m_cameraDrawCount[currentFrame] == 0) return;
 
     // Both camera and shadow passes need only Set 2 which contains the SSBO buffers
     // Camera Pass uses cameraDescriptorSets, which links to cameraIndirectBuffers (if needed) and instanceBuffers
@@ -512,15 +417,14 @@ void ChunkRenderer::renderCamera(VkCommandBuffer cmd, VkPipelineLayout layout, u
     VkBuffer indirectBuffer = m_cameraIndirectBuffers[currentFrame]->getBuffer();
     uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
 
-    for (const auto& batch : m_activeBatches) {
-        m_geometryManager.bindPool(cmd, batch.poolIndex);
-        vkCmdDrawIndexedIndirect(cmd, indirectBuffer, batch.startIdx * stride, batch.count, stride);
-    }
+    // No vertex buffers: one MDI call covers every pool
+    m_geometryManager.bindQuadIndices(cmd);
+    vkCmdDrawIndexedIndirect(cmd, indirectBuffer, 0, m_cameraDrawCount[currentFrame], stride);
     // m_visibleCount is populated from the renderer-owned CPU snapshot visibility pass in cull().
 }
 
 void ChunkRenderer::renderShadow(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame) {
-    if (m_activeInstances == 0) return;
+    if (m_shadowDrawCount[currentFrame] == 0) return;
 
     // Shadow pass uses shadowDescriptorSets and shadowIndirectBuffers
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -529,174 +433,113 @@ void ChunkRenderer::renderShadow(VkCommandBuffer cmd, VkPipelineLayout layout, u
     VkBuffer indirectBuffer = m_shadowIndirectBuffers[currentFrame]->getBuffer();
     uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
 
-    for (const auto& batch : m_activeBatches) {
-        m_geometryManager.bindPool(cmd, batch.poolIndex);
-        vkCmdDrawIndexedIndirect(cmd, indirectBuffer, batch.startIdx * stride, batch.count, stride);
-    }
+    // No vertex buffers: one MDI call covers every pool
+    m_geometryManager.bindQuadIndices(cmd);
+    vkCmdDrawIndexedIndirect(cmd, indirectBuffer, 0, m_shadowDrawCount[currentFrame], stride);
     // We don't update m_visibleCount here, since camera pass represents the main frame stats
 }
 
-void ChunkRenderer::rebuildDirtyChunks(VkDevice device, float currentTime) {
-    auto t0 = std::chrono::high_resolution_clock::now();
+void ChunkRenderer::renderLiquid(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame) {
+    if (m_liquidDrawCount[currentFrame] == 0) return;
 
-    auto done = m_meshWorker.collect();
-    if (done.empty()) return;
-
-    // Deduplicate: keep only the most-recently-completed task per chunk.
-    // This prevents uploading an outdated LOD result when the worker queue
-    // delivered multiple results for the same chunk in one collect() batch.
-    std::unordered_map<IVec3Key, MeshTask, IVec3Hash> latestTasks;
-    latestTasks.reserve(done.size());
-    for (auto& task : done) {
-        IVec3Key key{task.cx, task.cy, task.cz};
-
-        if (task.type == MeshTask::Type::GENERATE) {
-            latestTasks[key] = std::move(task);
-            continue;
-        }
-
-        auto chunk = m_storage.getChunk(key.x, key.y, key.z);
-        int desiredLOD = chunk ? chunk->m_currentLOD.load(std::memory_order_relaxed) : 0;
-        if (task.lod == desiredLOD) {
-            latestTasks[key] = std::move(task);
-        }
-        // else: stale LOD result — silently discard
-    }
-
-    if (!latestTasks.empty() && device != VK_NULL_HANDLE) {
-        // vkDeviceWaitIdle(device); // ВИДАЛЕНО: Pipeline Stall виправлено через Delayed Free у GeometryManager!
-    }
-
-    std::vector<gfx::GeometryManager::UploadRequest> requests;
-    requests.reserve(latestTasks.size());
-
-    for (auto& [key, task] : latestTasks) {
-        if (task.type != MeshTask::Type::GENERATE) {
-            auto chunk = m_storage.getChunk(key.x, key.y, key.z);
-            int desiredLOD = chunk ? chunk->m_currentLOD.load(std::memory_order_relaxed) : 0;
-            if (task.lod != desiredLOD) {
-                continue;
-            }
-        }
-
-        auto& rd = m_renderData[key];
+    // Same instance SSBO as the camera pass; the commands are already back to front.
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+        layout, 2, 1, &m_cameraDescriptorSets[currentFrame], 0, nullptr);
 
-        if (rd.valid) {
-            m_totalVertices -= rd.vertexCount;
-            m_totalIndices  -= rd.indexCount;
-            if (rd.mesh) {
-                int32_t vOff = rd.mesh->getVertexOffset();
-                uint32_t iOff = rd.mesh->getFirstIndex();
-                m_geometryManager.freeMesh(vOff, iOff, 
-                    rd.vertexCount * sizeof(VoxelVertex), rd.indexCount * sizeof(uint32_t), sizeof(VoxelVertex), rd.mesh->getBufferIndex());
-            }
-            rd.mesh.reset();
-            rd.valid = false;
-            eraseRenderSnapshot(key);
-            m_listDirty = true;
-            m_framesDirty = {true, true, true};
-        }
+    VkBuffer indirectBuffer = m_liquidIndirectBuffers[currentFrame]->getBuffer();
+    uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
 
-        if (task.type == MeshTask::Type::GENERATE) {
-            // Voxels are ready — queue this chunk for meshing on the next flushDirty().
-            // Do NOT submit here: we need neighbour data which may also be freshly generated.
-            m_dirtyPending.insert(IVec3Key{key.x, key.y, key.z});
-            continue;
-        }
+    m_geometryManager.bindQuadIndices(cmd);
+    vkCmdDrawIndexedIndirect(cmd, indirectBuffer, 0, m_liquidDrawCount[currentFrame], stride);
+}
 
-        if (task.result.empty()) {
-            // Chunk is all-air or fully occluded — no geometry needed.
-            // Tag it so markDirty() silently ignores future LOD-cascade notifications.
-            rd.isEmpty = true;
-            // Always clear the dirty flag regardless of LOD level (Bug fix: previously
-            // markClean was only called for lod==0, leaving LOD1/2 chunks permanently dirty).
-            auto chunk = m_storage.getChunk(key.x, key.y, key.z);
-            if (chunk) chunk->markClean();
-            // No SSBO change needed — empty chunks don't occupy a slot.
-            continue;
-        }
+// ---------------------------------------------------------------------------
+// ChunkMeshSink
+// ---------------------------------------------------------------------------
 
-        // Non-empty result: clear any stale isEmpty flag (chunk gained geometry).
-        rd.isEmpty = false;
+void ChunkRenderer::beginUploads(float currentTime) {
+    m_uploadTime = currentTime;
+    m_pendingUploads.clear();
+}
 
-        // Voxel vertices are already generated in local chunk space [0, CHUNK_SIZE]!
-        // No worldBias shifting needed. The position is sent per-chunk via PushConstants.
+void ChunkRenderer::uploadMesh(const IVec3Key& key, int lod, const VoxelMeshData& mesh) {
+    gfx::GeometryManager::UploadRequest req;
+    gfx::Mesh* gpuMesh = m_geometryManager.allocateQuadMesh(mesh.quadCount(), req, mesh.quads);
+    placeMesh(key, lod, gpuMesh, mesh.faceQuads, mesh.liquidQuads, req);
+}
 
-        gfx::GeometryManager::UploadRequest req;
-        rd.mesh.reset(m_geometryManager.allocateMeshRaw(static_cast<uint32_t>(task.result.vertices.size()), static_cast<uint32_t>(task.result.indices.size()), req, task.result.vertices, task.result.indices));
-        rd.aabb = buildAABB(key.x, key.y, key.z);
-        rd.vertexCount = static_cast<uint32_t>(task.result.vertices.size());
-        rd.indexCount  = static_cast<uint32_t>(task.result.indices.size());
-        rd.valid = true;
-        rd.fadeStartTime = currentTime;
-        rd.fadeProgress  = 0.0f; // новий mesh — fade з 0
-        upsertRenderSnapshot(key, rd, task.lod);
-        m_listDirty = true;             // список змінився — потрібен rebuild
-        m_framesDirty = {true, true, true};
+MeshStaging ChunkRenderer::reserveStaging(uint32_t quadCount) {
+    // Worker thread. StagingRing::reserve() is the only ring call that is thread-safe.
+    gfx::StagingRing& ring = m_geometryManager.getStagingRing();
+    const uint64_t handle = ring.reserve(quadCount * sizeof(VoxelQuad));
+    if (handle == gfx::StagingRing::INVALID) return {};
+    return MeshStaging{reinterpret_cast<VoxelQuad*>(ring.data(handle)), quadCount, handle};
+}
 
-        m_totalVertices += rd.vertexCount;
-        m_totalIndices  += rd.indexCount;
+void ChunkRenderer::uploadStaged(const IVec3Key& key, int lod, const MeshStaging& staged) {
+    gfx::GeometryManager::UploadRequest req;
+    gfx::Mesh* gpuMesh = m_geometryManager.allocateQuadMeshStaged(staged.quadCount, sizeof(VoxelQuad),
+                                                                  staged.handle, req);
+    placeMesh(key, lod, gpuMesh, staged.faceQuads, staged.liquidQuads, req);
+}
 
-        requests.push_back(req);
+void ChunkRenderer::releaseStaging(const MeshStaging& staged) {
+    m_geometryManager.getStagingRing().discard(staged.handle);
+}
 
-        auto chunk = m_storage.getChunk(key.x, key.y, key.z);
-        if (chunk) chunk->markClean();
+void ChunkRenderer::placeMesh(const IVec3Key& key, int lod, gfx::Mesh* mesh, const FaceQuadCounts& faceQuads,
+                              uint32_t liquidQuads, const gfx::GeometryManager::UploadRequest& req) {
+    auto& rd = m_renderData[key];
+    if (rd.valid) {
+        freeMesh(rd);
+        eraseRenderSnapshot(key);
     }
 
-    if (!requests.empty()) {
-        m_geometryManager.executeBatchUpload(requests);
-    }
+    // Voxel quads are already generated in local chunk space [0, CHUNK_SIZE]!
+    // The position (and the quads' device address) is sent per-chunk via the instance SSBO.
+    rd.mesh.reset(mesh);
+    rd.aabb = buildAABB(key.x, key.y, key.z);
+    rd.quadCount   = faceQuadTotal(faceQuads) + liquidQuads;
+    rd.indexCount  = quadIndexCount(faceQuadTotal(faceQuads));
+    rd.faceQuads   = faceQuads;
+    rd.liquidQuads = liquidQuads;
+    rd.valid = true;
+    rd.fadeStartTime = m_uploadTime;
+    rd.fadeProgress  = 0.0f; // новий mesh — fade з 0
+    upsertRenderSnapshot(key, rd, lod);
+    m_listDirty = true;             // список змінився — потрібен rebuild
+    m_framesDirty = {true, true, true};
 
-    auto t1 = std::chrono::high_resolution_clock::now();
-    m_lastRebuildMs = std::chrono::duration<float, std::milli>(t1 - t0).count();
+    m_pendingUploads.push_back(req);
 }
 
-
-void ChunkRenderer::removeChunk(const IVec3Key& key) {
-    auto it = m_renderData.find(key);
-    if (it != m_renderData.end()) {
-        ChunkRenderData& rd = it->second;
-        if (rd.mesh) {
-            int32_t  vOff = rd.mesh->getVertexOffset();
-            uint32_t iOff = rd.mesh->getFirstIndex();
-            m_geometryManager.freeMesh(vOff, iOff, 
-                rd.vertexCount * sizeof(VoxelVertex), rd.indexCount * sizeof(uint32_t), sizeof(VoxelVertex), rd.mesh->getBufferIndex());
-            m_totalVertices -= rd.vertexCount;
-            m_totalIndices  -= rd.indexCount;
-        }
-        eraseRenderSnapshot(key);
-        m_renderData.erase(it);
-        m_listDirty = true;
-        m_framesDirty = {true, true, true};
+void ChunkRenderer::endUploads() {
+    if (!m_pendingUploads.empty()) {
+        m_geometryManager.executeBatchUpload(m_pendingUploads);
+        m_pendingUploads.clear();
     }
-    m_dirtyPending.erase(key);
 }
 
-void ChunkRenderer::unloadMeshOnly(const IVec3Key& key) {
-    // Tier-3: звільняємо GPU пам'ять, але залишаємо LOD_EVICTED у m_chunkLOD.
+void ChunkRenderer::releaseMesh(const IVec3Key& key) {
     auto it = m_renderData.find(key);
-    if (it != m_renderData.end()) {
-        ChunkRenderData& rd = it->second;
-        if (rd.mesh) {
-            int32_t  vOff = rd.mesh->getVertexOffset();
-            uint32_t iOff = rd.mesh->getFirstIndex();
-            m_geometryManager.freeMesh(vOff, iOff,
-                rd.vertexCount * sizeof(VoxelVertex), rd.indexCount * sizeof(uint32_t), sizeof(VoxelVertex), rd.mesh->getBufferIndex());
-            m_totalVertices -= rd.vertexCount;
-            m_totalIndices  -= rd.indexCount;
-        }
-        eraseRenderSnapshot(key);
-        m_renderData.erase(it);
-        m_listDirty = true;
-        m_framesDirty = {true, true, true};
-    }
-    // Ключова відмінність від removeChunk: ставимо sentinel LOD_EVICTED,
-    // а не erase — щоб updateCamera знала "цей чанк вивантажено свідомо".
-    Chunk* chunk = m_storage.getChunk(key.x, key.y, key.z);
-    if (chunk) chunk->m_currentLOD.store(LOD_EVICTED, std::memory_order_relaxed);
-    m_dirtyPending.erase(key);
+    if (it == m_renderData.end()) return;
+    freeMesh(it->second);
+    eraseRenderSnapshot(key);
+    m_renderData.erase(it);
+    m_listDirty = true;
+    m_framesDirty = {true, true, true};
 }
 
-
+void ChunkRenderer::freeMesh(ChunkRenderData& rd) {
+    // Delayed free у GeometryManager: кадри в польоті ще можуть читати цей діапазон.
+    // Лише quad-записи — індекси спільні (quad index buffer).
+    if (rd.mesh) {
+        int32_t vOff = rd.mesh->getVertexOffset();
+        m_geometryManager.freeMesh(vOff, 0,
+            rd.quadCount * sizeof(VoxelQuad), 0, sizeof(VoxelQuad), rd.mesh->getBufferIndex());
+    }
+    rd.mesh.reset();
+    rd.valid = false;
+}
 
 } // namespace world
@@ -1,13 +1,11 @@
 #pragma once
+#include <array>
 #include <unordered_map>
-#include <unordered_set>
 #include <memory>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include "world/Chunk.hpp"
-#include "world/ChunkStorage.hpp"
-#include "world/LODController.hpp"
-#include "world/MeshWorker.hpp"
+#include "world/ChunkMeshSink.hpp"
 #include "gfx/resources/GeometryManager.hpp"
 #include "gfx/resources/Buffer.hpp"
 #include "gfx/core/VulkanContext.hpp"
@@ -18,104 +16,91 @@ namespace world {
 // Holds the GPU mesh representation for a specific chunk coordinate
 struct ChunkRenderData {
     std::unique_ptr<gfx::Mesh> mesh;
-    uint32_t vertexCount = 0;
-    uint32_t indexCount  = 0;
+    uint32_t quadCount   = 0; // VoxelQuad records in the pool (opaque + liquid)
+    uint32_t indexCount  = 0; // opaque, drawn from the shared quad index buffer, no pool range
+    FaceQuadCounts faceQuads{}; // opaque quads per face direction (contiguous, faceID order)
+    uint32_t liquidQuads = 0;   // liquid quads, after the opaque ones
     scene::AABB aabb;
     bool valid     = false;
-    // isEmpty = true:  mesh task returned empty result (all-air or all-solid chunk).
-    // markDirty() silently skips these chunks to prevent cascade re-submissions.
-    // Cleared automatically by forceMarkDirty() on voxel edits.
-    bool isEmpty   = false;
     float fadeStartTime  = 0.0f;
     float fadeProgress   = 0.0f; // cached fade value (зберігається при rebuildCpuInstanceData)
 };
 
 struct RenderChunkSnapshot {
     IVec3Key key;
-    uint32_t poolIndex    = 0;
+    VkDeviceAddress quadAddress = 0; // first VoxelQuad of the chunk (vertex pulling)
     uint32_t indexCount   = 0;
-    uint32_t firstIndex   = 0;
-    int32_t  vertexOffset = 0;
+    FaceQuadCounts faceQuads{};
+    uint32_t liquidQuads  = 0;
     int      lod          = -1;
     float    fadeStartTime = 0.0f;
     float    fadeProgress  = 0.0f;
 };
 
-// SSBO layout for chunk instance data
+// SSBO layout for chunk instance data (std140, matches voxel.vert)
 struct alignas(16) ChunkInstanceData {
     float posX, posY, posZ;
     float fadeProgress;
+    uint64_t quadAddress; // VkDeviceAddress of the chunk's VoxelQuad records (uvec2 in GLSL)
+    uint64_t reserved;
 };
-
-class ChunkRenderer {
+static_assert(sizeof(ChunkInstanceData) == 32, "ChunkInstanceData must match the std140 layout");
+
+// ---------------------------------------------------------------------------
+// ChunkRenderer — Vulkan ChunkMeshSink: GeometryManager pools + MDI with the instance SSBO.
+// What to mesh and when is decided by ChunkMesher (world core, no Vulkan).
+// Chunks own VoxelQuad ranges only. Nothing is bound as vertex input: voxel.vert pulls the
+// quads through the instance's buffer device address, and every chunk of every pool is
+// drawn by the single MDI call, indexed by GeometryManager's shared quad index buffer.
+// Chunk-level backface culling: a mesh's quads are grouped by face direction and the camera
+// pass gets one indirect command per direction that can face the eye (chunkFacingMask),
+// up to 6 per chunk. The shadow pass draws whole chunks (opaque quads).
+// Liquid quads (VoxelMeshData::liquidQuads) have their own indirect list, one command per
+// visible chunk, sorted far to near by chunk centre — renderLiquid() draws them blended after
+// the opaque pass.
+// ---------------------------------------------------------------------------
+class ChunkRenderer final : public ChunkMeshSink {
 public:
     static constexpr int MAX_FRAMES_IN_FLIGHT = 3;
     static constexpr uint32_t MAX_VISIBLE_CHUNKS = 8192;
+    static constexpr uint32_t MAX_CAMERA_DRAWS   = MAX_VISIBLE_CHUNKS * 6; // one per face direction
+
+    ChunkRenderer(gfx::VulkanContext& context, gfx::GeometryManager& geom);
+    ~ChunkRenderer() override;
+
+    // ChunkMeshSink: uploads are batched into one GeometryManager::executeBatchUpload()
+    void beginUploads(float currentTime) override;
+    void uploadMesh(const IVec3Key& key, int lod, const VoxelMeshData& mesh) override;
+    void releaseMesh(const IVec3Key& key) override;
+    void endUploads() override;
+    void clear() override;
+
+    // Staging path: mesh workers write into GeometryManager's StagingRing, the upload only
+    // records the copies out of it.
+    bool        hasStaging() const override { return true; }
+    MeshStaging reserveStaging(uint32_t quadCount) override;
+    void        uploadStaged(const IVec3Key& key, int lod, const MeshStaging& staged) override;
+    void        releaseStaging(const MeshStaging& staged) override;
 
-    // Sentinel LOD values:
-    //   -1 = chunk exists in storage but LOD not yet assigned
-    //   -2 = chunk intentionally evicted (Tier-3), do NOT re-schedule mesh
-    static constexpr int LOD_UNASSIGNED = -1;
-    static constexpr int LOD_EVICTED    = -2;
-
-    ChunkRenderer(gfx::VulkanContext& context, gfx::GeometryManager& geom, ChunkStorage& storage, LODController& lodCtrl, uint32_t meshWorkerThreads = 0);
-    ~ChunkRenderer();
-
-    // Queue updates
-    void markDirty(int cx, int cy, int cz);
-    // Same as markDirty but bypasses the isEmpty guard —
-    // must be called when voxel data actually changes (setVoxel).
-    void forceMarkDirty(int cx, int cy, int cz);
-    void flushDirty();
-    void submitGenerateTaskHigh(Chunk* chunk, const TerrainConfig& config);
-    void submitGenerateTaskLow (Chunk* chunk, const TerrainConfig& config); // async streaming
-
-    // Returns true if the last completed mesh task for this chunk produced
-    // zero geometry (all-air / fully-occluded). Neighbour-notification code
-    // in ChunkManager uses this to skip useless cascade dirty-marks.
-    bool isChunkEmpty(const IVec3Key& key) const {
-        auto it = m_renderData.find(key);
-        return it != m_renderData.end() && it->second.isEmpty;
-    }
-    
-    // Block until all queued worker tasks are finished (use before first frame)
-    void waitAllWorkers();
-    
-    // Process async tasks and upload to GPU
-    void rebuildDirtyChunks(VkDevice device, float currentTime);
     // GPU Compute Frustum Culling and MDI generation
     void cull(VkCommandBuffer cmd, const scene::Frustum& cameraFrustum, const scene::Frustum& shadowFrustum, const core::math::Vec3& cameraPos, float shadowDistanceLimit, float currentTime, uint32_t currentFrame);
 
     // Call inside main render passes
     void renderCamera(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame);
     void renderShadow(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame);
-
-    // LOD Counters
-    std::array<uint32_t, 3> getLODCounts() const;
+    // Translucent liquid surfaces, after renderCamera() (blending pipeline, no depth writes)
+    void renderLiquid(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t currentFrame);
 
     // Stats
-    uint32_t getTotalVertices() const { return m_totalVertices; }
-    uint32_t getTotalIndices()  const { return m_totalIndices; }
     uint32_t getVisibleCount()  const { return m_visibleCount; }
     uint32_t getCulledCount()   const { return m_culledCount; }
-    uint32_t getVisibleVertices() const { return m_visibleVertices; }
-    float    getLastRebuildMs() const { return m_lastRebuildMs; }
-    bool     hasMesh() const;
-    uint32_t getWorkerThreads() const { return m_meshWorker.getThreadCount(); }
-    int      getPendingMeshes() const { return m_meshWorker.getActiveTasks(); }
+    uint32_t getVisibleVertices() const { return m_visibleVertices; } // triangles
+    // Triangles of frustum-visible chunks skipped as back faces (direction culling)
+    uint32_t getBackfaceCulledTriangles() const { return m_backfaceTriangles; }
+    uint32_t getVisibleLiquidTriangles()  const { return m_liquidTriangles; }
 
     VkDescriptorSetLayout getDescriptorSetLayout() const { return m_descriptorSetLayout; }
 
-    void clear();
-    // Full removal: GPU mesh + removes from m_chunkLOD entirely
-    void removeChunk(const IVec3Key& key);
-    // Tier-3: frees GPU mesh only, sets LOD_EVICTED in m_chunkLOD
-    // so LOD logic won't re-schedule meshing until chunk re-enters view.
-    void unloadMeshOnly(const IVec3Key& key);
-    // Clears the isEmpty flag for a chunk so it will be re-meshed
-    // (used internally by forceMarkDirty).
-    void clearEmptyFlag(int cx, int cy, int cz);
-
 private:
 
     scene::AABB buildAABB(int cx, int cy, int cz) const;
@@ -124,23 +109,27 @@ private:
     void upsertRenderSnapshot(const IVec3Key& key, const ChunkRenderData& rd, int lod);
     void eraseRenderSnapshot(const IVec3Key& key);
     bool isSnapshotVisibleInFrustum(const RenderChunkSnapshot& snapshot, const scene::Frustum& frustum) const;
+    // Returns the chunk's pool ranges to GeometryManager (delayed free).
+    void freeMesh(ChunkRenderData& rd);
+    // uploadMesh / uploadStaged body: replaces the chunk's mesh with `mesh` (quad range
+    // allocated, copy queued as `req`).
+    void placeMesh(const IVec3Key& key, int lod, gfx::Mesh* mesh, const FaceQuadCounts& faceQuads,
+                   uint32_t liquidQuads, const gfx::GeometryManager::UploadRequest& req);
 
     // Persistent SSBO helpers (викликаються рідко — лише при load/unload)
     void rebuildSortedList();                    // сортує m_sortedChunks
     void rebuildCpuInstanceData();               // перебудовує m_cpuInstanceData + встановлює m_framesDirty
-    void rebuildIndirectBuffers(uint32_t frame); // записує indirect cmds для одного frame
 
     // -------------------------------------------------------------
     // Core references
     gfx::VulkanContext&   m_context;
     gfx::GeometryManager& m_geometryManager;
-    ChunkStorage&         m_storage;
-    LODController&        m_lodCtrl;
-    MeshWorker            m_meshWorker;
 
     // -------------------------------------------------------------
     std::unordered_map<IVec3Key, ChunkRenderData, IVec3Hash> m_renderData;
-    std::unordered_set<IVec3Key, IVec3Hash>                  m_dirtyPending;
+    // Uploads of the current beginUploads() / endUploads() pass.
+    std::vector<gfx::GeometryManager::UploadRequest>         m_pendingUploads;
+    float                                                    m_uploadTime = 0.0f;
     // Compact renderer-owned mesh residency snapshot used by culling, indirect generation, and LOD stats.
     std::vector<RenderChunkSnapshot>                         m_renderSnapshot;
     std::unordered_map<IVec3Key, size_t, IVec3Hash>         m_renderSnapshotIndices;
@@ -148,10 +137,11 @@ private:
     // Renderer-owned culling/draw-prep state (Front-to-Back sorting + persistent MDI generation)
     struct ChunkDrawCmd {
         uint32_t snapshotIndex;
-        uint32_t poolIndex;
         int lod;
     };
     std::vector<ChunkDrawCmd> m_sortedChunks;
+    // cull() scratch: visible chunks with liquid, {squared eye distance, instance index}
+    std::vector<std::pair<float, uint32_t>> m_liquidOrder;
 
     // --- Persistent SSBO: CPU-side dense buffer ---
     // Щільний масив даних чанків на боці CPU. При зміні списку (load/unload)
@@ -160,7 +150,7 @@ private:
     std::vector<float>             m_fadeStartTimes;    // [i] -> fadeStartTime
 
     // Structural dirty: true = список чанків змінився (load/unload), потрібен rebuildSortedList + rebuildCpuInstanceData.
-    // Встановлюється в rebuildDirtyChunks / removeChunk / unloadMeshOnly. Знімається в cull() після rebuild.
+    // Встановлюється в uploadMesh / releaseMesh. Знімається в cull() після rebuild.
     bool m_listDirty = true;
 
     // Per-frame dirty flags.
@@ -170,12 +160,11 @@ private:
     std::array<bool, MAX_FRAMES_IN_FLIGHT> m_framesDirty = {true, true, true};
 
     // Statistics
-    uint32_t m_totalVertices = 0;
-    uint32_t m_totalIndices  = 0;
     uint32_t m_visibleCount  = 0;
     uint32_t m_culledCount   = 0;
     uint32_t m_visibleVertices = 0;
-    float    m_lastRebuildMs = 0.0f;
+    uint32_t m_backfaceTriangles = 0;
+    uint32_t m_liquidTriangles   = 0;
 
     // -------------------------------------------------------------
     // Hardware resources (MDI + instance SSBO)
@@ -187,18 +176,17 @@ private:
     std::unique_ptr<gfx::Buffer> m_instanceBuffers[MAX_FRAMES_IN_FLIGHT];
     std::unique_ptr<gfx::Buffer> m_cameraIndirectBuffers[MAX_FRAMES_IN_FLIGHT];
     std::unique_ptr<gfx::Buffer> m_shadowIndirectBuffers[MAX_FRAMES_IN_FLIGHT];
+    std::unique_ptr<gfx::Buffer> m_liquidIndirectBuffers[MAX_FRAMES_IN_FLIGHT];
     void* m_instanceMapped[MAX_FRAMES_IN_FLIGHT]{};
     void* m_cameraIndirectMapped[MAX_FRAMES_IN_FLIGHT]{};
     void* m_shadowIndirectMapped[MAX_FRAMES_IN_FLIGHT]{};
+    void* m_liquidIndirectMapped[MAX_FRAMES_IN_FLIGHT]{};
 
-    // Tracks how many commands were dispatched per pool
-    struct PoolBatch {
-        uint32_t poolIndex;
-        uint32_t startIdx;
-        uint32_t count;
-    };
-    std::vector<PoolBatch> m_activeBatches;
-    uint32_t m_activeInstances = 0;
+    uint32_t m_activeInstances = 0; // resident chunks (instance SSBO entries)
+    // Commands cull() wrote into this frame's indirect buffers (compacted, visible only)
+    uint32_t m_cameraDrawCount[MAX_FRAMES_IN_FLIGHT]{};
+    uint32_t m_shadowDrawCount[MAX_FRAMES_IN_FLIGHT]{};
+    uint32_t m_liquidDrawCount[MAX_FRAMES_IN_FLIGHT]{};
 };
 
 } // namespace world
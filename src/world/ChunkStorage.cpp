@@ -1,14 +1,18 @@
 #include "ChunkStorage.hpp"
-#include "ChunkRenderer.hpp"
+#include "ChunkMesher.hpp"
+#include "ChunkCodec.hpp"
+#include "DecorationQueue.hpp"
+#include "TerrainGenerator.hpp"
+#include "WorldBaker.hpp"
 #include <iostream>
 #include <chrono>
 #include <cmath>
 #include <atomic>
-#include <limits>
 #include <thread>
 #include <vector>
 #include <unordered_set>
-#include "../vendor/FastNoiseLite.h"
+#include <filesystem>
+#include <cstdio>
 
 namespace world {
 
@@ -47,22 +51,79 @@ void ChunkStorage::eraseActiveChunk(const IVec3Key& key) {
     m_activeChunkIndices.erase(indexIt);
 }
 
+ChunkStorage::~ChunkStorage() {
+    // Edits made this session reach the disk on a normal exit.
+    m_loader.cancelAll();
+    persistResidentChunks();
+}
+
+void ChunkStorage::persistResidentChunks() {
+    if (!m_regions.isOpen()) return;
+
+    // Let cold-tier blobs and queued evictions land first so the synchronous writes below
+    // are the newest version.
+    m_dirtyCache.spillAll();
+    m_regions.flush();
+    size_t saved = 0;
+    for (const auto& [key, chunk] : m_chunkRegistry) {
+        if (chunk && chunk->m_isModified.load(std::memory_order_relaxed) && m_regions.writeNow(*chunk)) {
+            ++saved;
+        }
+    }
+    const RegionStore::Stats stats = m_regions.getStats();
+    m_regions.close();
+
+    if (stats.chunksWritten > 0) {
+        std::cout << "[ChunkStorage] Region files: " << stats.chunksWritten << " chunk writes ("
+                  << stats.bytesWritten / 1024 << " KB) this session, " << saved
+                  << " resident modified chunks saved to " << m_regions.getDirectory() << "\n" << std::flush;
+    }
+}
+
 void ChunkStorage::clear() {
-    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_loader.cancelAll(); // queued loads target chunks that are about to be released
+    persistResidentChunks();
+
     m_activeChunks.clear();
     m_activeChunkIndices.clear();
     m_chunkRegistry.clear();
     m_chunkGrid.clear();
     m_dirtyCache.clear();
-    m_boundsCache.clear(); // Invalidate lazy bounds cache on world reset
+    m_baked.close();
 }
 
 void ChunkStorage::generateWorld(int radiusX, int radiusZ, const TerrainConfig& config) {
     clear();
+    // Spills posted for the previous world (a config that generates again gets the same hash).
+    DecorationQueue::shared().clear();
 
     // Capture the exact terrain config for later column-bound queries and chunk rehydration.
     m_cachedConfig = config;
 
+    // Edits persisted for this exact config (any earlier session) are restored below and on
+    // stream-in instead of being regenerated.
+    if (!m_saveRoot.empty()) {
+        char worldDir[32];
+        std::snprintf(worldDir, sizeof(worldDir), "world_%016llx",
+                      static_cast<unsigned long long>(hashTerrainConfig(config)));
+        m_regions.open((std::filesystem::path(m_saveRoot) / worldDir).string());
+    }
+
+    // A world pre-generated by the worldbake tool for this exact config replaces generation.
+    // Its saved tree spills go into DecorationQueue first, so chunks generated next to baked
+    // ones (and baked ones adopted later) see the same voxels a full generation would.
+    const uint64_t configHash = hashTerrainConfig(config);
+    m_loader.setBakedConfigHash(configHash);
+    if (!m_saveRoot.empty()) {
+        const std::string bakedDir = bakedWorldDirectory(m_saveRoot, config);
+        std::error_code ec;
+        if (std::filesystem::is_directory(bakedDir, ec) && m_baked.open(bakedDir)) {
+            const size_t spills = loadBakedDecorations(bakedDir, configHash);
+            std::cout << "[ChunkStorage] Loading baked world from " << bakedDir
+                      << " (" << spills << " tree spills)\n" << std::flush;
+        }
+    }
+
     m_minX = -radiusX;
     m_maxX =  radiusX;
     // Dynamic Y bounds derived from terrain config.
@@ -83,84 +144,28 @@ void ChunkStorage::generateWorld(int radiusX, int radiusZ, const TerrainConfig&
     m_height = m_maxY - m_minY + 1;
     m_depth = m_maxZ - m_minZ + 1;
 
-    size_t totalGridSize = static_cast<size_t>(m_width) * m_height * m_depth;
-    m_chunkGrid.assign(totalGridSize, nullptr);
-
     auto t0 = std::chrono::high_resolution_clock::now();
     
-    // Estimate occupied Y extents per (cx,cz) column before allocating chunks.
+    // Exact occupied Y extents per (cx,cz) column before allocating chunks. The heightmap
+    // also covers the one-column ring around the area (getChunkSpan() looks at neighbours)
+    // and is reused by streaming / LOD lookups through getSurfaceBounds().
+    uint32_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    m_heightmap.reset(config);
+    m_heightmap.fill(-radiusX - 1, radiusX + 1, -radiusZ - 1, radiusZ + 1, numThreads);
+
     struct ColumnData { int minCY, maxCY; };
     std::vector<ColumnData> columns(m_width * m_depth);
-
-    FastNoiseLite noise;
-    noise.SetSeed(config.seed);
-    noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    noise.SetFractalType(FastNoiseLite::FractalType_FBm);
-    noise.SetFractalOctaves(config.octaves);
-    noise.SetFrequency(config.frequency);
-
-    // Simplified radial island mask (no warp noise here; this is a conservative bounds pass).
-    const float rBlks    = (config.islandMode && config.worldRadiusBlks > 0)
-                           ? static_cast<float>(config.worldRadiusBlks) : 1e9f;
-    const float falloff  = config.islandFalloff;
-    const float oceanFlH = static_cast<float>(config.seaLevel - 20);
-    auto islandMaskSimple = [&](float wx, float wz) -> float {
-        if (!config.islandMode) return 1.0f;
-        float dx = wx / rBlks, dz = wz / rBlks;
-        float dist = std::sqrt(dx*dx + dz*dz);
-        float t = (dist - falloff) / (1.1f - falloff);
-        t = std::clamp(t, 0.0f, 1.0f);
-        return 1.0f - t * t * (3.0f - 2.0f * t);
-    };
-
     for (int cz = -radiusZ; cz <= radiusZ; ++cz) {
         for (int cx = -radiusX; cx <= radiusX; ++cx) {
-            const int worldBaseX = cx * CHUNK_SIZE;
-            const int worldBaseZ = cz * CHUNK_SIZE;
-            int minH = 999999, maxH = -999999;
-
-            float sampleX[5] = {
-                (float)worldBaseX,               (float)(worldBaseX + CHUNK_SIZE - 1),
-                (float)worldBaseX,               (float)(worldBaseX + CHUNK_SIZE - 1),
-                (float)(worldBaseX + CHUNK_SIZE / 2)
-            };
-            float sampleZ[5] = {
-                (float)worldBaseZ,               (float)worldBaseZ,
-                (float)(worldBaseZ + CHUNK_SIZE - 1), (float)(worldBaseZ + CHUNK_SIZE - 1),
-                (float)(worldBaseZ + CHUNK_SIZE / 2)
-            };
-
-            for (int i = 0; i < 5; ++i) {
-                // Apply worldScale: divide coords so GetNoise sees effective lower frequency
-                float n     = noise.GetNoise(sampleX[i] / config.worldScale,
-                                             sampleZ[i] / config.worldScale);
-                float landH = static_cast<float>(config.baseHeight) + n * config.amplitude;
-                float mask  = islandMaskSimple(sampleX[i], sampleZ[i]);
-                float h     = oceanFlH + (landH - oceanFlH) * mask;
-
-                // Mountain noise (erosion) can push peaks significantly higher:
-                // peak ≈ h + amplitude * mountainStrength * 0.95  (conservative estimate)
-                float hMountMax = h + config.amplitude * config.mountainStrength * 0.95f;
-
-                // Include the water surface in the occupied bounds so sea-level slices exist.
-                float lo = std::min(h, (float)config.seaLevel) - 2.0f;
-                float hi = std::max(hMountMax, (float)config.seaLevel) + 4.0f;
-                if ((int)lo < minH) minH = (int)lo;
-                if ((int)hi > maxH) maxH = (int)hi;
-            }
-
-            int colIdx = (cz + radiusZ) * m_width + (cx + radiusX);
-            columns[colIdx] = {
-                std::max(static_cast<int>(std::floor(static_cast<float>(minH) / CHUNK_SIZE)), m_minY),
-                std::min(static_cast<int>(std::floor(static_cast<float>(maxH) / CHUNK_SIZE)), m_maxY)
-            };
+            const auto [minCY, maxCY] = getSurfaceBounds(cx, cz);
+            columns[(cz + radiusZ) * m_width + (cx + radiusX)] = {minCY, maxCY};
         }
     }
 
     // Allocate every occupied Y-slice in each column up front.
-    // The current world model is full-column preallocation within conservative bounds,
+    // The current world model is full-column preallocation within the exact heightmap span,
     // not surface-only sparse generation.
-    struct ChunkTask { int cx, cy, cz; size_t idx; };
+    struct ChunkTask { int cx, cy, cz; };
     std::vector<ChunkTask> allTasks;
     allTasks.reserve(static_cast<size_t>(m_width) * m_depth * 4); // ~4 Y slices on avg
 
@@ -171,41 +176,59 @@ void ChunkStorage::generateWorld(int radiusX, int radiusZ, const TerrainConfig&
             int maxCY  = columns[colIdx].maxCY;
 
             // Allocate every occupied slice so streaming later only rehydrates evicted chunks.
-            for (int cy = minCY; cy <= maxCY; ++cy) {
-                size_t idx = getGridIndex(cx, cy, cz);
-                if (idx != static_cast<size_t>(-1))
-                    allTasks.push_back({cx, cy, cz, idx});
-            }
+            for (int cy = minCY; cy <= maxCY; ++cy)
+                allTasks.push_back({cx, cy, cz});
         }
     }
 
     struct GeneratedChunkRecord {
         int cx, cy, cz;
-        size_t idx;
-        std::unique_ptr<Chunk> chunk;
+        ChunkPool::Handle chunk;
     };
 
     int totalCount = static_cast<int>(allTasks.size());
     std::vector<GeneratedChunkRecord> generated(static_cast<size_t>(totalCount));
 
-    // Parallel allocation + fillTerrain across the full occupied chunk set.
+    // Chunks come from the pool (clear() above returned the previous world to it). Acquire
+    // serially here; the worker threads below only fill terrain.
+    m_pool.prewarm(std::max(m_poolCapacity,
+        static_cast<size_t>(static_cast<float>(totalCount) * (1.0f + STREAMING_HEADROOM))));
+    for (size_t i = 0; i < allTasks.size(); ++i) {
+        const auto& task = allTasks[i];
+        generated[i] = {task.cx, task.cy, task.cz, m_pool.acquire(task.cx, task.cy, task.cz)};
+    }
+
+    // Parallel fillTerrain across the full occupied chunk set; chunks with a saved record are
+    // loaded from their region file instead.
     std::atomic<size_t> taskIdx{0};
-    uint32_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<size_t> restoredCount{0};
+    std::atomic<size_t> bakedCount{0};
+    // Tree spills into chunks another thread had already generated (applied after the join).
+    std::vector<std::vector<DecorationDelivery>> lateDecorations(numThreads);
 
     {
         std::vector<std::thread> threads;
         threads.reserve(numThreads);
         for (uint32_t t = 0; t < numThreads; ++t) {
-            threads.emplace_back([this, &allTasks, &generated, &taskIdx, config, totalCount]() {
+            threads.emplace_back([this, &generated, &taskIdx, &restoredCount, &bakedCount,
+                                  &late = lateDecorations[t], config, configHash, totalCount]() {
                 while (true) {
                     size_t i = taskIdx.fetch_add(1, std::memory_order_relaxed);
                     if (i >= static_cast<size_t>(totalCount)) break;
 
-                    const auto& task = allTasks[i];
-                    auto chunk = std::make_unique<Chunk>(task.cx, task.cy, task.cz);
-                    chunk->fillTerrain(config, nullptr);
+                    Chunk* chunk = generated[i].chunk.get();
+                    const auto& g = generated[i];
+                    if (m_regions.mayContain(g.cx, g.cy, g.cz) && m_regions.load(g.cx, g.cy, g.cz, *chunk)) {
+                        chunk->m_isModified.store(true, std::memory_order_relaxed);
+                        restoredCount.fetch_add(1, std::memory_order_relaxed);
+                    } else if (m_baked.mayContain(g.cx, g.cy, g.cz) && m_baked.load(g.cx, g.cy, g.cz, *chunk)) {
+                        adoptBakedChunk(*chunk, configHash);
+                        bakedCount.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        chunk->fillTerrain(config);
+                        for (auto& d : TerrainGenerator::takeLateDecorations()) late.push_back(std::move(d));
+                    }
                     chunk->m_state.store(ChunkState::READY, std::memory_order_release);
-                    generated[i] = {task.cx, task.cy, task.cz, task.idx, std::move(chunk)};
                 }
             });
         }
@@ -222,11 +245,19 @@ void ChunkStorage::generateWorld(int radiusX, int radiusZ, const TerrainConfig&
     for (auto& record : generated) {
         IVec3Key key{record.cx, record.cy, record.cz};
         Chunk* rawPtr = record.chunk.get();
-        m_chunkGrid[record.idx] = rawPtr;
+        m_chunkGrid.insert(record.cx, record.cy, record.cz, rawPtr);
         addActiveChunk(record.cx, record.cy, record.cz);
         m_chunkRegistry.emplace(key, std::move(record.chunk));
     }
 
+    for (const auto& perThread : lateDecorations) {
+        for (const auto& d : perThread) {
+            Chunk* chunk = m_chunkGrid.find(d.cx, d.cy, d.cz);
+            if (chunk && !chunk->m_isModified.load(std::memory_order_relaxed))
+                chunk->applyDecoration(d.writes);
+        }
+    }
+
     auto t1 = std::chrono::high_resolution_clock::now();
     float timeMs = std::chrono::duration<float, std::milli>(t1 - t0).count();
 
@@ -239,12 +270,20 @@ void ChunkStorage::generateWorld(int radiusX, int radiusZ, const TerrainConfig&
               << m_width << "x" << m_depth << " columns, up to "
               << (m_maxY - m_minY + 1) << " Y-slices each) in "
               << timeMs << " ms (" << (voxelsPerSec / 1000000.0f) << " Mvox/sec).\n" << std::flush;
+    if (bakedCount > 0) {
+        std::cout << "[ChunkStorage] " << bakedCount.load() << " of them loaded from the baked world, "
+                  << (totalCount - static_cast<int>(bakedCount.load()) - static_cast<int>(restoredCount.load()))
+                  << " generated.\n" << std::flush;
+    }
+    if (restoredCount > 0) {
+        std::cout << "[ChunkStorage] Restored " << restoredCount.load() << " modified chunks from "
+                  << m_regions.getDirectory() << "\n" << std::flush;
+    }
 }
 
 void ChunkStorage::removeChunk(int cx, int cy, int cz) {
-    size_t idx = getGridIndex(cx, cy, cz);
-    if (idx != static_cast<size_t>(-1) && m_chunkGrid[idx]) {
-        m_chunkGrid[idx] = nullptr;
+    if (m_chunkGrid.find(cx, cy, cz)) {
+        m_chunkGrid.erase(cx, cy, cz);
         const IVec3Key key{cx, cy, cz};
         m_chunkRegistry.erase(key);
         eraseActiveChunk(key);
@@ -255,10 +294,7 @@ void ChunkStorage::removeChunks(const std::vector<IVec3Key>& keys) {
     if (keys.empty()) return;
 
     for (const auto& key : keys) {
-        size_t idx = getGridIndex(key.x, key.y, key.z);
-        if (idx != static_cast<size_t>(-1)) {
-            m_chunkGrid[idx] = nullptr;
-        }
+        m_chunkGrid.erase(key.x, key.y, key.z);
     }
 
     for (const auto& key : keys) {
@@ -269,9 +305,10 @@ void ChunkStorage::removeChunks(const std::vector<IVec3Key>& keys) {
         }
 
         Chunk* chunk = registryIt->second.get();
-        if (chunk && chunk->m_isModified.load(std::memory_order_relaxed)) {
-            std::lock_guard<std::mutex> lock(m_cacheMutex);
-            m_dirtyCache[key] = std::move(registryIt->second);
+        // acquire: pairs with ChunkLoader publishing a restored payload before setting the flag.
+        if (chunk && chunk->m_isModified.load(std::memory_order_acquire)) {
+            // Compressed off the main thread and recycled; spills on to m_regions over budget.
+            m_dirtyCache.insert(std::move(registryIt->second));
             m_chunkRegistry.erase(registryIt);
         } else {
             m_chunkRegistry.erase(registryIt);
@@ -300,43 +337,38 @@ void ChunkStorage::setVoxel(int wx, int wy, int wz, VoxelData v) {
 
     Chunk* chunk = getChunk(cx, cy, cz);
     if (!chunk) return;
-    
-    chunk->setVoxel(lx, ly, lz, v);
-}
 
-const Chunk* ChunkStorage::getChunk(int cx, int cy, int cz) const {
-    size_t idx = getGridIndex(cx, cy, cz);
-    if (idx == static_cast<size_t>(-1)) return nullptr;
-    return m_chunkGrid[idx];
-}
+    // A far chunk may hold only its reduced LOD payload: generate the real voxels before the
+    // edit (synchronously — a queued refine task then finds the work done and backs off).
+    if (chunk->isReduced()) chunk->refineTerrain(m_cachedConfig, 0);
 
-Chunk* ChunkStorage::getChunk(int cx, int cy, int cz) {
-    size_t idx = getGridIndex(cx, cy, cz);
-    if (idx == static_cast<size_t>(-1)) return nullptr;
-    return m_chunkGrid[idx];
+    chunk->setVoxel(lx, ly, lz, v);
 }
 
-void ChunkStorage::createChunkIfMissing(int cx, int cy, int cz, const TerrainConfig& config, ChunkRenderer& renderer, bool /*async*/) {
-    size_t idx = getGridIndex(cx, cy, cz);
-    if (idx == static_cast<size_t>(-1)) return; // Out of bounds
-
-    if (!m_chunkGrid[idx]) {
-        IVec3Key k{cx, cy, cz};
-        std::unique_ptr<Chunk> cachedChunk;
-        
-        // Modified chunks survive Tier-4 eviction here and must be restored verbatim.
-        {
-            std::lock_guard<std::mutex> lock(m_cacheMutex);
-            auto it = m_dirtyCache.find(k);
-            if (it != m_dirtyCache.end()) {
-                cachedChunk = std::move(it->second);
-                m_dirtyCache.erase(it);
+void ChunkStorage::createChunkIfMissing(int cx, int cy, int cz, const TerrainConfig& config, ChunkMesher& mesher, bool /*async*/) {
+    // Storage is unbounded in X/Z: streaming may create columns outside the pre-generated area.
+    Chunk* existing = m_chunkGrid.find(cx, cy, cz);
+    if (!existing) {
+        // Modified chunks survive Tier-4 eviction in the cold tier and must be restored verbatim
+        // (decoded from their compressed blob if the worker already got to them).
+        ChunkPool::Handle cachedChunk = m_dirtyCache.take(cx, cy, cz, m_pool);
+
+        // Blobs spilled to the region writer but not written yet come back without any I/O.
+        // Records already on disk are read asynchronously by requestPayload() below.
+        std::vector<uint8_t> payload;
+        if (!cachedChunk && m_regions.isOpen() && m_regions.reclaim(cx, cy, cz, payload)) {
+            cachedChunk = m_pool.acquire(cx, cy, cz);
+            if (decodeChunkPayload(payload.data(), payload.size(), *cachedChunk)) {
+                cachedChunk->m_isModified.store(true, std::memory_order_relaxed);
+                cachedChunk->m_state.store(ChunkState::READY, std::memory_order_release);
+            } else {
+                cachedChunk.reset();
             }
         }
 
         if (cachedChunk) {
             Chunk* rawPtr = cachedChunk.get();
-            m_chunkGrid[idx] = rawPtr;
+            m_chunkGrid.insert(cx, cy, cz, rawPtr);
             addActiveChunk(cx, cy, cz);
             m_chunkRegistry[IVec3Key{cx, cy, cz}] = std::move(cachedChunk);
             
@@ -346,105 +378,59 @@ void ChunkStorage::createChunkIfMissing(int cx, int cy, int cz, const TerrainCon
             return;
         }
 
-        auto chunk = std::make_unique<Chunk>(cx, cy, cz);
-        chunk->m_state.store(ChunkState::UNGENERATED, std::memory_order_release);
+        // Pooled: recycled from an earlier stream-out when available (reset() -> UNGENERATED).
+        auto chunk = m_pool.acquire(cx, cy, cz);
 
         Chunk* rawPtr = chunk.get();
-        m_chunkGrid[idx] = rawPtr;
+        m_chunkGrid.insert(cx, cy, cz, rawPtr);
         addActiveChunk(cx, cy, cz);
         m_chunkRegistry[IVec3Key{cx, cy, cz}] = std::move(chunk);
 
-        // Re-created chunks re-enter as placeholders first and are then generated asynchronously.
-        ChunkState expected = ChunkState::UNGENERATED;
-        if (rawPtr->m_state.compare_exchange_strong(expected, ChunkState::GENERATING,
-                                                    std::memory_order_acq_rel)) {
-            renderer.submitGenerateTaskLow(rawPtr, config);
-        }
+        // Re-created chunks re-enter as placeholders first and are then loaded / generated asynchronously.
+        requestPayload(rawPtr, config, mesher, false);
     } else {
         // Chunk exists in storage but may still be a placeholder after stream re-entry.
         // Try to claim generation if no worker has started it yet.
-        Chunk* chunkPtr = m_chunkGrid[idx];
-        ChunkState expected = ChunkState::UNGENERATED;
-        if (chunkPtr->m_state.compare_exchange_strong(expected, ChunkState::GENERATING,
-                                                      std::memory_order_acq_rel)) {
-            renderer.submitGenerateTaskLow(chunkPtr, config);
-        }
+        requestPayload(existing, config, mesher, false);
     }
 }
 
-
-std::pair<int, int> ChunkStorage::getSurfaceBounds(int cx, int cz) const {
-    // Fast path: O(1) cache hit — bounds are immutable for a fixed TerrainConfig.
-    const uint64_t cacheKey = (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32)
-                             |  static_cast<uint64_t>(static_cast<uint32_t>(cz));
-    {
-        auto it = m_boundsCache.find(cacheKey);
-        if (it != m_boundsCache.end()) return it->second;
+bool ChunkStorage::requestPayload(Chunk* chunk, const TerrainConfig& config, ChunkMesher& mesher, bool highPriority) {
+    ChunkState expected = ChunkState::UNGENERATED;
+    if (!chunk->m_state.compare_exchange_strong(expected, ChunkState::GENERATING,
+                                                std::memory_order_acq_rel)) {
+        return false;
     }
 
-    // Slow path: recompute the occupied Y-range for this column exactly once per world instance.
-    // thread_local: re-init when seed OR worldScale changes.
-    static thread_local FastNoiseLite tl_noise;
-    static thread_local int           tl_seed  = std::numeric_limits<int>::min();
-    static thread_local float         tl_scale = -1.0f;
-
-    if (tl_seed != m_cachedConfig.seed || tl_scale != m_cachedConfig.worldScale) {
-        tl_noise.SetSeed(m_cachedConfig.seed);
-        tl_noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-        tl_noise.SetFractalType(FastNoiseLite::FractalType_FBm);
-        tl_noise.SetFractalOctaves(m_cachedConfig.octaves);
-        tl_noise.SetFrequency(m_cachedConfig.frequency);
-        tl_seed  = m_cachedConfig.seed;
-        tl_scale = m_cachedConfig.worldScale;
+    // mayContain() is an in-memory index lookup; the read itself happens on loader threads.
+    if (m_regions.mayContain(chunk->getCX(), chunk->getCY(), chunk->getCZ()) ||
+        m_baked.mayContain(chunk->getCX(), chunk->getCY(), chunk->getCZ())) {
+        m_loader.request(chunk);
+    } else if (highPriority) {
+        mesher.submitGenerateTaskHigh(chunk, config);
+    } else {
+        mesher.submitGenerateTaskLow(chunk, config);
     }
+    return true;
+}
 
-    const float rBlks   = (m_cachedConfig.islandMode && m_cachedConfig.worldRadiusBlks > 0)
-                          ? static_cast<float>(m_cachedConfig.worldRadiusBlks) : 1e9f;
-    const float falloff = m_cachedConfig.islandFalloff;
-    const float oceanFl = static_cast<float>(m_cachedConfig.seaLevel - 20);
-    const float wScale  = (m_cachedConfig.worldScale > 0.0f) ? m_cachedConfig.worldScale : 1.0f;
-
-    auto islandMaskSimple = [&](float wx, float wz) -> float {
-        if (!m_cachedConfig.islandMode) return 1.0f;
-        float dx = wx / rBlks, dz = wz / rBlks;
-        float dist = std::sqrt(dx*dx + dz*dz);
-        float t = (dist - falloff) / (1.1f - falloff);
-        t = std::clamp(t, 0.0f, 1.0f);
-        return 1.0f - t * t * (3.0f - 2.0f * t);
-    };
-
-    const int worldBaseX = cx * CHUNK_SIZE;
-    const int worldBaseZ = cz * CHUNK_SIZE;
-    int minH = 999999, maxH = -999999;
-
-    std::array<float, 5> sampleX = { (float)worldBaseX, (float)(worldBaseX + CHUNK_SIZE - 1),
-                                     (float)worldBaseX, (float)(worldBaseX + CHUNK_SIZE - 1),
-                                     (float)(worldBaseX + CHUNK_SIZE / 2) };
-    std::array<float, 5> sampleZ = { (float)worldBaseZ, (float)worldBaseZ,
-                                     (float)(worldBaseZ + CHUNK_SIZE - 1), (float)(worldBaseZ + CHUNK_SIZE - 1),
-                                     (float)(worldBaseZ + CHUNK_SIZE / 2) };
-
-    for (int i = 0; i < 5; ++i) {
-        float n     = tl_noise.GetNoise(sampleX[i] / wScale, sampleZ[i] / wScale);
-        float landH = static_cast<float>(m_cachedConfig.baseHeight) + n * m_cachedConfig.amplitude;
-        float mask  = islandMaskSimple(sampleX[i], sampleZ[i]);
-        float h     = oceanFl + (landH - oceanFl) * mask;
-
-        // Conservative mountain peak estimate
-        float hMountMax = h + m_cachedConfig.amplitude * m_cachedConfig.mountainStrength * 0.95f;
-
-        float lo = std::min(h, (float)m_cachedConfig.seaLevel) - 2.0f;
-        float hi = std::max(hMountMax, (float)m_cachedConfig.seaLevel) + 4.0f;
-        if ((int)lo < minH) minH = (int)lo;
-        if ((int)hi > maxH) maxH = (int)hi;
+void ChunkStorage::pumpLoads(const TerrainConfig& config, ChunkMesher& mesher) {
+    for (Chunk* chunk : m_loader.collectMisses()) {
+        // The chunk may have been streamed out while its read was queued; it is still pinned,
+        // so the pointer is valid, but only a chunk that is still registered gets generated.
+        if (m_chunkGrid.find(chunk->getCX(), chunk->getCY(), chunk->getCZ()) == chunk &&
+            chunk->m_state.load(std::memory_order_acquire) == ChunkState::GENERATING) {
+            mesher.submitGenerateTaskHigh(chunk, config);
+        }
+        chunk->m_taskRefs.fetch_sub(1, std::memory_order_release);
     }
+}
 
-    int minCY = static_cast<int>(std::floor(static_cast<float>(minH) / CHUNK_SIZE));
-    int maxCY = static_cast<int>(std::floor(static_cast<float>(maxH) / CHUNK_SIZE));
 
-    auto result = std::make_pair(std::max(minCY, m_minY), std::min(maxCY, m_maxY));
-    m_boundsCache[cacheKey] = result;
-    return result;
+std::pair<int, int> ChunkStorage::getSurfaceBounds(int cx, int cz) const {
+    // Lock-free: exact heights come from the shared column heightmap (computed on first use).
+    const auto [minCY, maxCY] = m_heightmap.getChunkSpan(cx, cz);
+    return {std::max(minCY, m_minY), std::min(maxCY, m_maxY)};
 }
 
 int ChunkStorage::getSurfaceMidY(int cx, int cz) const {
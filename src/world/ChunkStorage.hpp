@@ -4,8 +4,14 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <cstdint>
-#include <mutex>
+#include <string>
 #include "world/Chunk.hpp"
+#include "world/ChunkGrid.hpp"
+#include "world/ChunkPool.hpp"
+#include "world/RegionStore.hpp"
+#include "world/ChunkLoader.hpp"
+#include "world/ColdChunkCache.hpp"
+#include "world/ColumnHeightmap.hpp"
 
 namespace world {
 
@@ -26,25 +32,41 @@ struct IVec3Hash {
     }
 };
 
-class ChunkRenderer; // Forward declaration
+class ChunkMesher; // Forward declaration
 
 class ChunkStorage {
 public:
+    ChunkStorage() = default;
+    ~ChunkStorage();
+    ChunkStorage(const ChunkStorage&) = delete;
+    ChunkStorage& operator=(const ChunkStorage&) = delete;
+
     void generateWorld(int radiusX, int radiusZ, const TerrainConfig& config = {});
     void clear();
     void removeChunk(int cx, int cy, int cz);
     void removeChunks(const std::vector<IVec3Key>& keys);
     
-    void createChunkIfMissing(int cx, int cy, int cz, const TerrainConfig& config, ChunkRenderer& renderer, bool async = false);
+    void createChunkIfMissing(int cx, int cy, int cz, const TerrainConfig& config, ChunkMesher& mesher, bool async = false);
+
+    // Claims an UNGENERATED chunk (-> GENERATING) and schedules its payload: an async disk
+    // read through ChunkLoader when a saved edit or a baked record may exist, else a GENERATE task.
+    // Returns false if another path already claimed it.
+    bool requestPayload(Chunk* chunk, const TerrainConfig& config, ChunkMesher& mesher, bool highPriority);
+    // Main thread, once per frame: turns ChunkLoader misses into GENERATE tasks.
+    void pumpLoads(const TerrainConfig& config, ChunkMesher& mesher);
+    // Load priority origin (camera position in world space).
+    void setLoadFocus(float x, float y, float z) { m_loader.setFocus(x, y, z); }
+    ChunkLoader::Stats getLoaderStats() const { return m_loader.getStats(); }
 
     VoxelData getVoxel(int wx, int wy, int wz) const;
     void      setVoxel(int wx, int wy, int wz, VoxelData v);
 
-    const Chunk* getChunk(int cx, int cy, int cz) const;
-    Chunk*       getChunk(int cx, int cy, int cz);
+    // Hot path (every neighbour lookup in flushDirty() / raycast()): inline paged lookup.
+    const Chunk* getChunk(int cx, int cy, int cz) const { return m_chunkGrid.find(cx, cy, cz); }
+    Chunk*       getChunk(int cx, int cy, int cz)       { return m_chunkGrid.find(cx, cy, cz); }
 
     // Legacy name: returns the occupied Y-range for a chunk column, not only the visible surface slice.
-    // Uses cached terrain config captured by generateWorld().
+    // Exact (ColumnHeightmap, same noise stack as fillTerrain()) and lock-free; safe off the main thread.
     std::pair<int, int> getSurfaceBounds(int cx, int cz) const;
     int                 getSurfaceMidY  (int cx, int cz) const;
 
@@ -57,12 +79,26 @@ public:
 
     const std::vector<ActiveChunk>& getChunks() const { return m_activeChunks; }
     std::vector<ActiveChunk>&       getChunks()       { return m_activeChunks; }
+    // Chunk object pool. generateWorld() pre-warms to max(configured capacity, initial world
+    // + STREAMING_HEADROOM); setPoolCapacity() pre-warms immediately and raises that floor.
+    void setPoolCapacity(size_t capacity) { m_poolCapacity = capacity; m_pool.prewarm(capacity); }
+    ChunkPool::Stats getPoolStats() const { return m_pool.getStats(); }
+
+    // Modified chunks that left the active set but are still in RAM: the compressed cold tier
+    // plus spilled payloads still queued for the region writer.
     size_t getDirtyCacheCount() const {
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
-        return m_dirtyCache.size();
+        return m_dirtyCache.getStats().entries + m_regions.getPendingWrites();
     }
+    ColdChunkCache::Stats getColdStats() const { return m_dirtyCache.getStats(); }
 
-    // World grid bounds (in chunk coords)
+    // Root directory for region files; each TerrainConfig gets its own sub-directory
+    // (world_<config hash>). Takes effect on the next generateWorld(). Empty string disables
+    // persistence: evicted edits then stay in the cold tier for the session only.
+    void setSaveRoot(const std::string& root) { m_saveRoot = root; }
+    RegionStore::Stats getRegionStats() const { return m_regions.getStats(); }
+
+    // Bounds of the area pre-generated by generateWorld() (in chunk coords). Storage itself is
+    // unbounded in X/Z; the Y range still clamps column spans returned by getSurfaceBounds().
     int getMinX() const { return m_minX; }
     int getMaxX() const { return m_maxX; }
     int getMinY() const { return m_minY; }
@@ -71,10 +107,34 @@ public:
     int getMaxZ() const { return m_maxZ; }
 
 private:
-    using ChunkRegistry = std::unordered_map<IVec3Key, std::unique_ptr<Chunk>, IVec3Hash>;
+    using ChunkRegistry = std::unordered_map<IVec3Key, ChunkPool::Handle, IVec3Hash>;
+
+    // Extra pool capacity over the initial world, as a fraction: columns streamed in ahead
+    // of the ones streamed out need chunks before Tier-4 hands the old ones back.
+    static constexpr float STREAMING_HEADROOM = 0.5f;
 
     void addActiveChunk(int cx, int cy, int cz);
     void eraseActiveChunk(const IVec3Key& key);
+    // Writes every resident modified chunk to the region store and closes it (world reset / exit).
+    void persistResidentChunks();
+
+    // Owns the memory of every Chunk below. Declared first so it is destroyed last,
+    // after the registries have returned their handles.
+    ChunkPool m_pool;
+    size_t    m_poolCapacity = 0;
+
+    // On-disk home of evicted modified chunks (encoded payloads only, no Chunk objects).
+    RegionStore m_regions;
+    std::string m_saveRoot = "saves";
+    // Pre-generated world for m_cachedConfig (<saveRoot>/baked_<hash>, see WorldBaker), read-only.
+    // Open only when such a bake exists; its chunks are loaded instead of generated.
+    RegionStore m_baked;
+    // Async disk stage in front of GENERATE; reads through m_regions / m_baked, so declared after them.
+    ChunkLoader m_loader{m_regions, m_baked};
+    // Tier-4 eviction target: modified chunks are compressed here so stream-out does not lose
+    // player edits; over its byte budget the oldest blobs spill to m_regions. Declared after
+    // the pool: chunks still waiting for compression go back to it on shutdown.
+    ColdChunkCache m_dirtyCache{m_regions};
 
     // Lightweight iteration list for streaming / LOD passes.
     std::vector<ActiveChunk> m_activeChunks;
@@ -82,30 +142,20 @@ private:
     std::unordered_map<IVec3Key, size_t, IVec3Hash> m_activeChunkIndices;
     // Authoritative ownership of active chunk objects.
     ChunkRegistry m_chunkRegistry;
-    std::vector<Chunk*> m_chunkGrid;
-    
-    // Tier-4 eviction cache: modified chunks are parked here so stream-out does not lose player edits.
-    ChunkRegistry m_dirtyCache;
-    mutable std::mutex m_cacheMutex;
+    // Sparse coordinate -> Chunk* lookup (non-owning; m_chunkRegistry owns the objects).
+    ChunkGrid m_chunkGrid;
     
     int m_minX = 0, m_maxX = 0;
     int m_minY = 0, m_maxY = 0;
     int m_minZ = 0, m_maxZ = 0;
     int m_width = 0, m_height = 0, m_depth = 0;
 
-    // Cached config from the current world instance. Used by lazy column-bound queries and rehydration.
+    // Cached config from the current world instance. Used by rehydration.
     TerrainConfig m_cachedConfig;
 
-    // Lazy column-bounds cache: each (cx,cz) column is computed at most once per world instance.
-    // Terrain is deterministic for a fixed TerrainConfig, so these bounds stay immutable until generateWorld().
-    // Key = (uint32(cx) << 32) | uint32(cz).
-    mutable std::unordered_map<uint64_t, std::pair<int, int>> m_boundsCache;
-
-    inline size_t getGridIndex(int cx, int cy, int cz) const {
-        if (cx < m_minX || cx > m_maxX || cy < m_minY || cy > m_maxY || cz < m_minZ || cz > m_maxZ)
-            return static_cast<size_t>(-1);
-        return static_cast<size_t>((cx - m_minX) + (cy - m_minY) * m_width + (cz - m_minZ) * m_width * m_height);
-    }
+    // Exact per-column terrain heights for m_cachedConfig. Filled in parallel by generateWorld(),
+    // extended lazily (and lock-free) by streaming / LOD queries; reset on the next generateWorld().
+    ColumnHeightmap m_heightmap;
 };
 
 }
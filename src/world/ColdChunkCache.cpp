@@ -0,0 +1,197 @@
+#include "world/ColdChunkCache.hpp"
+#include "world/ChunkCodec.hpp"
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+namespace world {
+
+ColdChunkCache::ColdChunkCache(RegionStore& spillTarget, size_t budgetBytes)
+    : m_spillTarget(spillTarget)
+    , m_budget(budgetBytes)
+    , m_worker([this](std::stop_token st) { workerLoop(st); })
+{
+}
+
+ColdChunkCache::~ColdChunkCache() {
+    m_worker.request_stop();
+    m_cv.notify_all();
+    if (m_worker.joinable()) m_worker.join();
+}
+
+void ColdChunkCache::setBudget(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = budgetBytes;
+    spillOverBudget();
+}
+
+void ColdChunkCache::insert(ChunkPool::Handle chunk) {
+    if (!chunk) return;
+    const Coord key{chunk->getCX(), chunk->getCY(), chunk->getCZ()};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            // Superseded (cannot normally happen: take() runs before a chunk is re-created).
+            if (it->second.chunk) --m_pending;
+            else                  removeBlob(it);
+        }
+        Entry& entry = m_entries[key];
+        entry.chunk = std::move(chunk);
+        entry.seq   = m_nextSeq++;
+        m_compressQueue.emplace_back(key, entry.seq);
+        ++m_pending;
+    }
+    m_cv.notify_one();
+}
+
+ChunkPool::Handle ColdChunkCache::take(int cx, int cy, int cz, ChunkPool& pool) {
+    std::vector<uint8_t> blob;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(Coord{cx, cy, cz});
+        if (it == m_entries.end()) return nullptr;
+
+        if (it->second.chunk) {
+            // Not compressed yet: hand the original object back. If the worker is encoding it
+            // right now, its result no longer matches an entry and is discarded.
+            ChunkPool::Handle chunk = std::move(it->second.chunk);
+            m_entries.erase(it);
+            --m_pending;
+            return chunk;
+        }
+        blob = removeBlob(it);
+    }
+
+    ChunkPool::Handle chunk = pool.acquire(cx, cy, cz);
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    const bool ok = decodeChunkPayload(blob.data(), blob.size(), *chunk);
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    if (!ok) {
+        std::cerr << "[ColdChunkCache] Corrupt blob for chunk (" << cx << ", " << cy << ", " << cz << ")\n";
+        return nullptr;
+    }
+
+    const double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    ++m_decompressed;
+    m_decompressUsSum += us;
+    m_decompressUsMax = std::max(m_decompressUsMax, us);
+
+    chunk->m_isModified.store(true, std::memory_order_relaxed);
+    chunk->m_state.store(ChunkState::READY, std::memory_order_release);
+    return chunk;
+}
+
+void ColdChunkCache::spillAll() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCv.wait(lock, [this]() { return m_compressQueue.empty() && !m_inFlight; });
+    if (!m_spillTarget.isOpen()) return;
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.chunk) { ++it; continue; }
+        const Coord key = it->first;
+        auto next = std::next(it);
+        m_spillTarget.enqueueWrite(key.x, key.y, key.z, removeBlob(it));
+        ++m_spilled;
+        it = next;
+    }
+    m_blobOrder.clear();
+}
+
+void ColdChunkCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear(); // queued chunks go back to the pool (deferred if the worker holds one)
+    m_compressQueue.clear();
+    m_blobOrder.clear();
+    m_pending      = 0;
+    m_blobBytes    = 0;
+    m_paletteBytes = 0;
+}
+
+ColdChunkCache::Stats ColdChunkCache::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats s;
+    s.entries         = m_entries.size();
+    s.pending         = m_pending;
+    s.compressedBytes = m_blobBytes;
+    s.paletteBytes    = m_paletteBytes;
+    s.compressed      = m_compressed;
+    s.decompressed    = m_decompressed;
+    s.spilled         = m_spilled;
+    s.avgDecompressUs = m_decompressed ? m_decompressUsSum / static_cast<double>(m_decompressed) : 0.0;
+    s.maxDecompressUs = m_decompressUsMax;
+    return s;
+}
+
+std::vector<uint8_t> ColdChunkCache::removeBlob(std::unordered_map<Coord, Entry, CoordHash>::iterator it) {
+    std::vector<uint8_t> blob = std::move(it->second.blob);
+    m_blobBytes    -= blob.size();
+    m_paletteBytes -= it->second.paletteBytes;
+    m_entries.erase(it);
+    return blob;
+}
+
+void ColdChunkCache::spillOverBudget() {
+    if (!m_spillTarget.isOpen()) return;
+    while (m_blobBytes > m_budget && !m_blobOrder.empty()) {
+        const auto [key, seq] = m_blobOrder.front();
+        m_blobOrder.pop_front();
+        auto it = m_entries.find(key);
+        if (it == m_entries.end() || it->second.seq != seq || it->second.chunk) continue; // taken since
+        // Enqueued under m_mutex: take() and RegionStore::reclaim() are tried in that order on
+        // the main thread, so the blob is always reachable in one of the two.
+        m_spillTarget.enqueueWrite(key.x, key.y, key.z, removeBlob(it));
+        ++m_spilled;
+    }
+}
+
+void ColdChunkCache::workerLoop(std::stop_token st) {
+    while (true) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_compressQueue.empty()) m_idleCv.notify_all();
+        if (!m_cv.wait(lock, st, [this]() { return !m_compressQueue.empty(); })) break;
+
+        const auto [key, seq] = m_compressQueue.front();
+        m_compressQueue.pop_front();
+        auto it = m_entries.find(key);
+        if (it == m_entries.end() || it->second.seq != seq || !it->second.chunk) continue;
+
+        // Pinned while encoding, so a take() + release meanwhile cannot recycle it under us.
+        Chunk* chunk = it->second.chunk.get();
+        chunk->m_taskRefs.fetch_add(1, std::memory_order_acq_rel);
+        m_inFlight = true;
+        lock.unlock();
+
+        std::vector<uint8_t> blob;
+        encodeChunkPayload(*chunk, blob);
+        blob.shrink_to_fit();
+        const size_t paletteBytes = chunk->getVoxelBytes();
+        chunk->m_taskRefs.fetch_sub(1, std::memory_order_acq_rel);
+
+        lock.lock();
+        m_inFlight = false;
+        it = m_entries.find(key);
+        if (it == m_entries.end() || it->second.seq != seq || !it->second.chunk) continue;
+
+        it->second.chunk.reset(); // back to the pool: the cold tier keeps only the blob
+        it->second.paletteBytes = paletteBytes;
+        m_blobBytes    += blob.size();
+        m_paletteBytes += paletteBytes;
+        it->second.blob = std::move(blob);
+        ++m_compressed;
+        --m_pending;
+        m_blobOrder.emplace_back(key, seq);
+
+        // take() leaves stale spill-order records behind; compact once they dominate.
+        const size_t blobs = m_entries.size() - m_pending;
+        if (m_blobOrder.size() > 2 * blobs + 1024) {
+            std::erase_if(m_blobOrder, [this](const std::pair<Coord, uint64_t>& rec) {
+                auto e = m_entries.find(rec.first);
+                return e == m_entries.end() || e->second.seq != rec.second || e->second.chunk;
+            });
+        }
+        spillOverBudget();
+    }
+}
+
+} // namespace world
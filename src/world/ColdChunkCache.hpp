@@ -0,0 +1,118 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "world/Chunk.hpp"
+#include "world/ChunkPool.hpp"
+#include "world/RegionStore.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// ColdChunkCache — compressed in-RAM tier for modified chunks evicted by Tier 4.
+//
+// insert() takes the evicted chunk; a worker thread encodes it with ChunkCodec (usually
+// COLUMN_RLE — long vertical runs compress to a few KB instead of 128 KB of raw VoxelData)
+// and returns the Chunk object to the pool. take() hands back either the still-unencoded
+// chunk or a pool chunk decoded from the blob; decode time is recorded for the stats.
+//
+// When the blobs exceed the byte budget and the region store is open, the oldest blobs are
+// spilled to RegionStore's write queue (already encoded, so the writer only does I/O). With
+// persistence disabled nothing can be spilled and the budget is not enforced — edits are
+// never dropped.
+// ---------------------------------------------------------------------------
+class ColdChunkCache {
+public:
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 64ull * 1024 * 1024;
+
+    struct Stats {
+        size_t   entries         = 0; // blobs + chunks waiting for compression
+        size_t   pending         = 0; // chunks waiting for compression
+        uint64_t compressedBytes = 0; // resident blob bytes
+        uint64_t paletteBytes    = 0; // palette payload the resident blobs had in the hot tier
+        uint64_t compressed      = 0; // chunks encoded so far
+        uint64_t decompressed    = 0; // blobs decoded by take()
+        uint64_t spilled         = 0; // blobs handed to the region store
+        double   avgDecompressUs = 0.0;
+        double   maxDecompressUs = 0.0;
+
+        // Resident blobs vs the same chunks stored verbatim (CHUNK_VOLUME × VoxelData).
+        double rawRatio() const {
+            const size_t blobs = entries - pending;
+            return compressedBytes ? static_cast<double>(blobs) * CHUNK_VOLUME * sizeof(VoxelData) / compressedBytes : 0.0;
+        }
+        // Resident blobs vs the palette-compressed hot-tier payload.
+        double paletteRatio() const {
+            return compressedBytes ? static_cast<double>(paletteBytes) / compressedBytes : 0.0;
+        }
+    };
+
+    explicit ColdChunkCache(RegionStore& spillTarget, size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+    ~ColdChunkCache();
+    ColdChunkCache(const ColdChunkCache&) = delete;
+    ColdChunkCache& operator=(const ColdChunkCache&) = delete;
+
+    void setBudget(size_t budgetBytes);
+
+    // Main thread. Takes ownership of an evicted modified chunk.
+    void insert(ChunkPool::Handle chunk);
+    // Main thread. Returns the chunk for (cx,cy,cz) in READY state with m_isModified set,
+    // decoding into a chunk from `pool` if it was already compressed; nullptr if not cached.
+    ChunkPool::Handle take(int cx, int cy, int cz, ChunkPool& pool);
+
+    // Waits for queued compressions, then moves every blob to the region store's write queue.
+    // No-op (blobs stay) if the region store is closed.
+    void spillAll();
+    // Drops everything (world reset). Queued chunks go back to the pool.
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    using Coord     = RegionStore::Coord;
+    using CoordHash = RegionStore::CoordHash;
+
+    struct Entry {
+        ChunkPool::Handle    chunk;  // set until the worker has encoded it
+        std::vector<uint8_t> blob;
+        uint64_t             seq          = 0;
+        size_t               paletteBytes = 0;
+    };
+
+    void workerLoop(std::stop_token st);
+    void spillOverBudget(); // caller holds m_mutex
+    // Erases a compressed entry and returns its blob — caller holds m_mutex.
+    std::vector<uint8_t> removeBlob(std::unordered_map<Coord, Entry, CoordHash>::iterator it);
+
+    RegionStore& m_spillTarget;
+    size_t       m_budget;
+
+    mutable std::mutex          m_mutex;
+    std::condition_variable_any m_cv;     // compression work available
+    std::condition_variable_any m_idleCv; // compression queue drained
+    std::unordered_map<Coord, Entry, CoordHash> m_entries;
+    std::deque<std::pair<Coord, uint64_t>>      m_compressQueue;
+    std::deque<std::pair<Coord, uint64_t>>      m_blobOrder; // oldest blob first (spill order)
+    uint64_t m_nextSeq  = 1;
+    bool     m_inFlight = false;
+    size_t   m_pending  = 0;
+
+    uint64_t m_blobBytes    = 0;
+    uint64_t m_paletteBytes = 0;
+    uint64_t m_compressed   = 0;
+    uint64_t m_spilled      = 0;
+
+    // take() runs on the main thread only.
+    uint64_t m_decompressed    = 0;
+    double   m_decompressUsSum = 0.0;
+    double   m_decompressUsMax = 0.0;
+
+    std::jthread m_worker; // last: joined before the members above go away
+};
+
+} // namespace world
@@ -0,0 +1,164 @@
+#include "world/ColumnHeightmap.hpp"
+#include "world/TerrainColumnCache.hpp"
+#include "world/CaveDensity.hpp"
+#include "world/DecorationQueue.hpp"
+#include <algorithm>
+#include <bit>
+#include <thread>
+#include <vector>
+
+namespace world {
+
+namespace {
+
+constexpr int TILE_MASK = ColumnHeightmap::TILE_SIZE - 1;
+
+uint64_t pack(const ColumnHeightmap::Column& c) {
+    return  static_cast<uint64_t>(static_cast<uint16_t>(c.minHeight))
+         | (static_cast<uint64_t>(static_cast<uint16_t>(c.maxHeight))   << 16)
+         | (static_cast<uint64_t>(static_cast<uint16_t>(c.waterHeight)) << 32);
+}
+
+ColumnHeightmap::Column unpack(uint64_t v) {
+    ColumnHeightmap::Column c;
+    c.minHeight   = static_cast<int16_t>(static_cast<uint16_t>(v));
+    c.maxHeight   = static_cast<int16_t>(static_cast<uint16_t>(v >> 16));
+    c.waterHeight = static_cast<int16_t>(static_cast<uint16_t>(v >> 32));
+    return c;
+}
+
+// Block Y -> chunk Y (floors negative values).
+int chunkOf(int blockY) {
+    return (blockY >= 0) ? (blockY / CHUNK_SIZE) : ((blockY - CHUNK_SIZE + 1) / CHUNK_SIZE);
+}
+
+} // namespace
+
+ColumnHeightmap::ColumnHeightmap()
+    : m_slots(std::make_unique<std::atomic<Tile*>[]>(MAX_TILES))
+{
+}
+
+ColumnHeightmap::~ColumnHeightmap() {
+    for (size_t i = 0; i < MAX_TILES; ++i) delete m_slots[i].load(std::memory_order_relaxed);
+}
+
+void ColumnHeightmap::reset(const TerrainConfig& config) {
+    for (size_t i = 0; i < MAX_TILES; ++i) {
+        delete m_slots[i].exchange(nullptr, std::memory_order_relaxed);
+    }
+    m_tileCount.store(0, std::memory_order_relaxed);
+    m_computed.store(0, std::memory_order_relaxed);
+    m_config     = config;
+    m_configHash = hashTerrainConfig(config);
+}
+
+void ColumnHeightmap::fill(int minCX, int maxCX, int minCZ, int maxCZ, uint32_t threadCount) {
+    if (maxCX < minCX || maxCZ < minCZ) return;
+    const int    width = maxCX - minCX + 1;
+    const size_t total = static_cast<size_t>(width) * static_cast<size_t>(maxCZ - minCZ + 1);
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < total;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            get(minCX + static_cast<int>(i % width), minCZ + static_cast<int>(i / width));
+        }
+    };
+
+    threadCount = std::clamp<uint32_t>(threadCount, 1u, static_cast<uint32_t>(std::min<size_t>(total, 64)));
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (uint32_t t = 1; t < threadCount; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& t : threads) t.join();
+}
+
+ColumnHeightmap::Column ColumnHeightmap::get(int cx, int cz) const {
+    Tile* tile = findTile(cx >> TILE_SHIFT, cz >> TILE_SHIFT);
+    if (!tile) return compute(cx, cz); // directory full: still exact, just not cached
+
+    std::atomic<uint64_t>& slot = tile->columns[((cz & TILE_MASK) << TILE_SHIFT) | (cx & TILE_MASK)];
+    const uint64_t cached = slot.load(std::memory_order_acquire);
+    if (cached & VALID_BIT) return unpack(cached);
+
+    const Column column = compute(cx, cz);
+    slot.store(VALID_BIT | pack(column), std::memory_order_release);
+    return column;
+}
+
+std::pair<int, int> ColumnHeightmap::getChunkSpan(int cx, int cz) const {
+    const Column self = get(cx, cz);
+    const Column around[4] = {get(cx + 1, cz), get(cx - 1, cz), get(cx, cz + 1), get(cx, cz - 1)};
+    int lowest = self.minHeight;
+    int highest = self.maxHeight;
+    for (const Column& c : around) {
+        lowest  = std::min<int>(lowest,  c.minHeight);
+        highest = std::max<int>(highest, c.maxHeight);
+    }
+
+    // Trees rise up to STRUCTURE_MAX_HEIGHT above the terrain, and crowns reach over from the
+    // neighbouring columns.
+    int top = std::max<int>(self.maxHeight, self.waterHeight) - 1;
+    if (m_config.trees) top = std::max(top, highest + STRUCTURE_MAX_HEIGHT - 1);
+
+    // Below `lowest - SURFACE_LAYER_DEPTH` every biome is plain stone: chunks there would be
+    // uniform STONE that nothing can see. Caves can open anywhere above CAVE_FLOOR_Y, so with
+    // caves on the column reaches down to the floor (sealed stone chunks stay uniform and meshless).
+    const int bottom = m_config.caves ? std::min(CAVE_FLOOR_Y, lowest - SURFACE_LAYER_DEPTH)
+                                      : lowest - SURFACE_LAYER_DEPTH;
+    return {chunkOf(bottom), chunkOf(top)};
+}
+
+ColumnHeightmap::Stats ColumnHeightmap::getStats() const {
+    Stats s;
+    s.tiles           = m_tileCount.load(std::memory_order_relaxed);
+    s.columnsComputed = m_computed.load(std::memory_order_relaxed);
+    return s;
+}
+
+ColumnHeightmap::Tile* ColumnHeightmap::findTile(int tx, int tz) const {
+    const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(tx)) << 32)
+                       |  static_cast<uint64_t>(static_cast<uint32_t>(tz));
+    constexpr int hashShift = 64 - std::countr_zero(MAX_TILES);
+    size_t i = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> hashShift);
+
+    Tile* fresh = nullptr;
+    for (size_t probe = 0; probe < MAX_TILES; ++probe, i = (i + 1) & (MAX_TILES - 1)) {
+        Tile* tile = m_slots[i].load(std::memory_order_acquire);
+        if (!tile) {
+            if (!fresh) {
+                fresh = new Tile;
+                fresh->tx = tx;
+                fresh->tz = tz;
+            }
+            if (m_slots[i].compare_exchange_strong(tile, fresh, std::memory_order_acq_rel)) {
+                m_tileCount.fetch_add(1, std::memory_order_relaxed);
+                return fresh;
+            }
+            // Lost the slot: `tile` now holds the winner, which may be our tile.
+        }
+        if (tile->tx == tx && tile->tz == tz) {
+            delete fresh;
+            return tile;
+        }
+    }
+    delete fresh;
+    return nullptr;
+}
+
+ColumnHeightmap::Column ColumnHeightmap::compute(int cx, int cz) const {
+    // Built through the shared column cache: the chunks of this column generated next (or
+    // generated just now) reuse the same noise evaluation.
+    const TerrainColumnCache::ColumnPtr terrain =
+        TerrainColumnCache::shared().get(m_config, m_configHash, cx, cz);
+    m_computed.fetch_add(1, std::memory_order_relaxed);
+
+    Column column;
+    column.minHeight   = static_cast<int16_t>(std::clamp(terrain->minHeight, INT16_MIN + 1, INT16_MAX));
+    column.maxHeight   = static_cast<int16_t>(std::clamp(terrain->maxHeight, INT16_MIN + 1, INT16_MAX));
+    column.waterHeight = (terrain->minHeight < m_config.seaLevel) ? static_cast<int16_t>(m_config.seaLevel) : INT16_MIN;
+    return column;
+}
+
+} // namespace world
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "world/Chunk.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// ColumnHeightmap — exact per-column terrain heights for one TerrainConfig.
+//
+// For every chunk column (cx, cz) it stores the lowest and highest terrain height
+// (`terrainH` as fillTerrain() computes it: blocks below it are solid) over the 32×32 block
+// columns, taken from the same TerrainColumn fillTerrain() layers (TerrainColumnCache), so the
+// values are exact rather than an estimate.
+//
+// Storage is paged: 32×32-column tiles found through a fixed open-addressing directory of
+// atomic tile pointers. Tiles are only added (CAS into an empty slot) and each column is one
+// atomic word, so get() is lock-free from any thread; a column that is not there yet is
+// computed by the caller and published (two threads racing on it store the same value).
+// fill() computes a rectangle in parallel up front. reset() must not race with lookups.
+// ---------------------------------------------------------------------------
+class ColumnHeightmap {
+public:
+    static constexpr int    TILE_SHIFT   = 5;
+    static constexpr int    TILE_SIZE    = 1 << TILE_SHIFT; // columns per tile side
+    static constexpr int    TILE_COLUMNS = TILE_SIZE * TILE_SIZE;
+    static constexpr size_t MAX_TILES    = 4096;            // directory slots (power of two)
+    // Deepest non-stone block under a column is terrainH - SURFACE_LAYER_DEPTH (grass/dirt/sand).
+    static constexpr int    SURFACE_LAYER_DEPTH = 5;
+
+    struct Column {
+        int16_t minHeight   = 0;
+        int16_t maxHeight   = 0;
+        int16_t waterHeight = INT16_MIN; // seaLevel if any block column is under water, else INT16_MIN
+    };
+
+    struct Stats {
+        size_t   tiles           = 0;
+        uint64_t columnsComputed = 0;
+    };
+
+    ColumnHeightmap();
+    ~ColumnHeightmap();
+    ColumnHeightmap(const ColumnHeightmap&) = delete;
+    ColumnHeightmap& operator=(const ColumnHeightmap&) = delete;
+
+    // Drops every tile and switches to `config`. Not thread-safe against get().
+    void reset(const TerrainConfig& config);
+
+    // Computes every column of the inclusive rectangle on `threadCount` threads.
+    void fill(int minCX, int maxCX, int minCZ, int maxCZ, uint32_t threadCount);
+
+    // Lock-free lookup; computes the column on first use.
+    Column get(int cx, int cz) const;
+
+    // Chunk Y-span (inclusive, unclamped) holding every non-stone voxel of the column: from the
+    // surface layers of the lowest column around it (faces toward lower neighbours are exposed
+    // down to that height; with caves on, down to CAVE_FLOOR_Y) up to the highest solid or water
+    // block — with trees on, up to the tallest structure the column or its neighbours can root.
+    std::pair<int, int> getChunkSpan(int cx, int cz) const;
+
+    Stats getStats() const;
+
+private:
+    struct Tile {
+        int tx = 0, tz = 0;
+        // 0 = not computed yet; otherwise VALID_BIT | packed Column.
+        std::atomic<uint64_t> columns[TILE_COLUMNS]{};
+    };
+
+    static constexpr uint64_t VALID_BIT = 1ull << 63;
+
+    Tile*  findTile(int tx, int tz) const; // creates the tile if absent; nullptr if full
+    Column compute(int cx, int cz) const;
+
+    TerrainConfig m_config;
+    uint64_t      m_configHash = 0;
+
+    std::unique_ptr<std::atomic<Tile*>[]> m_slots;
+    mutable std::atomic<size_t>   m_tileCount{0};
+    mutable std::atomic<uint64_t> m_computed{0};
+};
+
+} // namespace world
@@ -0,0 +1,126 @@
+#include "world/DecorationQueue.hpp"
+#include <algorithm>
+
+namespace world {
+
+DecorationQueue& DecorationQueue::shared() {
+    static DecorationQueue s_queue;
+    return s_queue;
+}
+
+bool DecorationQueue::post(uint64_t configHash, int tx, int ty, int tz, int sx, int sy, int sz,
+                           const std::vector<DecorationWrite>& writes, bool persistent) {
+    const Key key{configHash, tx, ty, tz};
+    Shard& shard = shardOf(key);
+    std::lock_guard lock(shard.mutex);
+    Entry& entry = shard.map[key];
+
+    auto it = std::find_if(entry.spills.begin(), entry.spills.end(), [&](const Spill& s) {
+        return s.sx == sx && s.sy == sy && s.sz == sz;
+    });
+    if (it == entry.spills.end()) {
+        entry.spills.push_back({sx, sy, sz, writes, persistent});
+        ++shard.spills;
+    } else {
+        // The source regenerated (stream-in again, refine): same seed, same voxels.
+        it->persistent = it->persistent || persistent;
+        if (it->writes == writes) return false;
+        shard.writes -= it->writes.size();
+        it->writes = writes;
+    }
+    shard.writes += writes.size();
+
+    // Whether the target has collected is unknown here (it may have before this entry existed):
+    // new writes always go to the caller's residency check.
+    m_posted.fetch_add(1, std::memory_order_relaxed);
+    m_late.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void DecorationQueue::collect(uint64_t configHash, int cx, int cy, int cz, std::vector<DecorationWrite>& out) {
+    const Key key{configHash, cx, cy, cz};
+    Shard& shard = shardOf(key);
+    std::lock_guard lock(shard.mutex);
+    auto slot = shard.map.find(key);
+    if (slot == shard.map.end()) return;
+
+    size_t n = 0;
+    for (const Spill& spill : slot->second.spills) {
+        out.insert(out.end(), spill.writes.begin(), spill.writes.end());
+        n += spill.writes.size();
+    }
+    m_collected.fetch_add(n, std::memory_order_relaxed);
+}
+
+size_t DecorationQueue::prune(float x, float z, float radius) {
+    const float radiusSq = radius * radius;
+    auto outside = [&](int cx, int cz) {
+        const float dx = x - (cx * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+        const float dz = z - (cz * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+        return dx * dx + dz * dz > radiusSq;
+    };
+
+    size_t dropped = 0;
+    for (Shard& shard : m_shards) {
+        std::lock_guard lock(shard.mutex);
+        for (auto slot = shard.map.begin(); slot != shard.map.end();) {
+            if (!outside(slot->first.cx, slot->first.cz)) { ++slot; continue; }
+            std::vector<Spill>& spills = slot->second.spills;
+            auto keep = std::remove_if(spills.begin(), spills.end(), [&](const Spill& s) {
+                if (s.persistent || !outside(s.sx, s.sz)) return false;
+                shard.writes -= s.writes.size();
+                return true;
+            });
+            const size_t n = static_cast<size_t>(spills.end() - keep);
+            spills.erase(keep, spills.end());
+            shard.spills -= n;
+            dropped      += n;
+            slot = spills.empty() ? shard.map.erase(slot) : std::next(slot);
+        }
+    }
+    m_pruned.fetch_add(dropped, std::memory_order_relaxed);
+    return dropped;
+}
+
+std::vector<DecorationQueue::Posted> DecorationQueue::snapshot(uint64_t configHash) const {
+    std::vector<Posted> out;
+    for (const Shard& shard : m_shards) {
+        std::lock_guard lock(shard.mutex);
+        for (const auto& [key, entry] : shard.map) {
+            if (key.configHash != configHash) continue;
+            for (const Spill& spill : entry.spills)
+                out.push_back({key.cx, key.cy, key.cz, spill.sx, spill.sy, spill.sz, spill.writes});
+        }
+    }
+    return out;
+}
+
+void DecorationQueue::clear() {
+    for (Shard& shard : m_shards) {
+        std::lock_guard lock(shard.mutex);
+        shard.map.clear();
+        shard.spills = 0;
+        shard.writes = 0;
+    }
+}
+
+DecorationQueue::Stats DecorationQueue::getStats() const {
+    Stats s;
+    for (const Shard& shard : m_shards) {
+        std::lock_guard lock(shard.mutex);
+        s.targets += shard.map.size();
+        s.spills  += shard.spills;
+        s.writes  += shard.writes;
+    }
+    // Hash node (key + entry + next/hash words) per target, plus the spill vectors.
+    s.bytes = s.targets * (sizeof(Key) + sizeof(Entry) + 2 * sizeof(void*))
+            + s.spills  * sizeof(Spill)
+            + s.writes  * sizeof(DecorationWrite);
+    s.posted    = m_posted.load(std::memory_order_relaxed);
+    s.late      = m_late.load(std::memory_order_relaxed);
+    s.collected = m_collected.load(std::memory_order_relaxed);
+    s.pruned    = m_pruned.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace world
@@ -0,0 +1,158 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "world/Chunk.hpp"
+
+namespace world {
+
+// Structure materials (palette 7 / 8, see the block palette in main.cpp).
+inline constexpr VoxelData VOXEL_WOOD   = VoxelData::make(7, 255, 0, VOXEL_FLAG_SOLID);
+inline constexpr VoxelData VOXEL_LEAVES = VoxelData::make(8, 255, 0, VOXEL_FLAG_SOLID);
+
+// Structures span their root block and at most this many blocks above it (ColumnHeightmap
+// keeps that headroom above the terrain when decoration is on).
+constexpr int STRUCTURE_MAX_HEIGHT = 8;
+
+// One voxel a structure writes into a chunk: local idx() (x + y*32 + z*1024) and the value.
+struct DecorationWrite {
+    uint16_t  index = 0;
+    VoxelData voxel = VOXEL_AIR;
+    bool operator==(const DecorationWrite&) const = default;
+};
+
+// Whether a structure voxel may overwrite `current`. Structures only grow into AIR and wood
+// wins over leaves, so the result is the same whichever chunk's writes land first.
+inline bool decorationReplaces(VoxelData current, VoxelData placed) {
+    if (current.isAir()) return !placed.isAir();
+    return current == VOXEL_LEAVES && placed == VOXEL_WOOD;
+}
+
+// Spill writes for a chunk that had already generated when they were posted. The main thread
+// applies them to the live chunk (Chunk::applyDecoration()).
+struct DecorationDelivery {
+    int cx = 0, cy = 0, cz = 0;
+    std::vector<DecorationWrite> writes;
+};
+
+// ---------------------------------------------------------------------------
+// DecorationQueue — pending cross-chunk structure writes, keyed by target chunk.
+//
+// The DECORATE stage places every structure rooted in the chunk being generated; the voxels
+// that fall into a neighbour are posted here under that neighbour's key instead of touching
+// the neighbour. When the neighbour's own GENERATE task reaches DECORATE it collects them
+// into its scratch, before the payload is encoded.
+//
+// Only chunks with posted writes have an entry; a chunk that collects nothing leaves no trace.
+// So the queue cannot tell whether a target has generated yet: post() reports every new write
+// to the caller, which hands it to the main thread as a DecorationDelivery. The main thread checks residency —
+// an unloaded or still-ungenerated target collects the writes from here on its own GENERATE,
+// and applying writes a chunk already holds changes nothing (decorationReplaces()).
+//
+// Posts are kept after collection (and replaced, not duplicated, when the source regenerates),
+// so a streamed-out target that regenerates later gets the same voxels back. prune() drops
+// spills whose source and target columns have both left the streaming radius: both
+// regenerate (and re-post) before they can show up again — except an edited source, which is
+// restored from disk and does not post again. Spills loaded with a baked world
+// are persistent — their sources are loaded, not regenerated — and stay until clear().
+//
+// Split into SHARDS independently locked maps: a post or collect locks one shard for a few
+// vector copies, so decorating workers never wait on each other for long.
+// ---------------------------------------------------------------------------
+class DecorationQueue {
+public:
+    static constexpr size_t SHARDS = 16;
+
+    struct Stats {
+        size_t   targets   = 0; // chunks with posted writes
+        size_t   spills    = 0; // (source, target) pairs
+        size_t   writes    = 0; // voxels held
+        size_t   bytes     = 0; // approximate heap held by the queue
+        uint64_t posted    = 0; // post() calls that stored new writes
+        uint64_t late      = 0; // ... handed to the caller for the residency check
+        uint64_t collected = 0; // writes handed to a generating chunk
+        uint64_t pruned    = 0; // spills dropped by prune()
+    };
+
+    // A stored spill as snapshot() returns it.
+    struct Posted {
+        int tx, ty, tz; // target chunk
+        int sx, sy, sz; // source chunk
+        std::vector<DecorationWrite> writes;
+    };
+
+    DecorationQueue() = default;
+    DecorationQueue(const DecorationQueue&) = delete;
+    DecorationQueue& operator=(const DecorationQueue&) = delete;
+
+    // Process-wide instance used by the DECORATE stage.
+    static DecorationQueue& shared();
+
+    // Records the writes chunk (sx, sy, sz) spills into chunk (tx, ty, tz), replacing its
+    // earlier post. Returns true when the writes are new: the target may already have
+    // generated, so the caller delivers them to the main thread, which applies them if the
+    // target is resident.
+    // `persistent` spills survive prune().
+    bool post(uint64_t configHash, int tx, int ty, int tz, int sx, int sy, int sz,
+              const std::vector<DecorationWrite>& writes, bool persistent = false);
+
+    // Appends every write posted for chunk (cx, cy, cz) to `out`. Adds no entry for a chunk
+    // nothing was posted to.
+    void collect(uint64_t configHash, int cx, int cy, int cz, std::vector<DecorationWrite>& out);
+
+    // Drops the non-persistent spills whose source and target chunk columns both lie farther
+    // than `radius` blocks (XZ) from (x, z). Returns the number of spills dropped.
+    size_t prune(float x, float z, float radius);
+
+    // Every spill stored under `configHash` (WorldBaker saves them with a baked world).
+    std::vector<Posted> snapshot(uint64_t configHash) const;
+
+    void  clear();
+    Stats getStats() const;
+
+private:
+    struct Key {
+        uint64_t configHash;
+        int      cx, cy, cz;
+        bool operator==(const Key& o) const {
+            return configHash == o.configHash && cx == o.cx && cy == o.cy && cz == o.cz;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const noexcept {
+            uint64_t h = k.configHash;
+            h ^= static_cast<uint32_t>(k.cx) * 0x9E3779B97F4A7C15ull;
+            h ^= static_cast<uint32_t>(k.cy) * 0xD6E8FEB86659FD93ull;
+            h ^= static_cast<uint32_t>(k.cz) * 0xC2B2AE3D27D4EB4Full;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+    struct Spill {
+        int sx, sy, sz;
+        std::vector<DecorationWrite> writes;
+        bool persistent = false;
+    };
+    struct Entry {
+        std::vector<Spill> spills;
+    };
+    struct Shard {
+        mutable std::mutex                      mutex;
+        std::unordered_map<Key, Entry, KeyHash> map;
+        size_t spills = 0;
+        size_t writes = 0;
+    };
+
+    Shard& shardOf(const Key& key) { return m_shards[KeyHash{}(key) % SHARDS]; }
+
+    std::array<Shard, SHARDS> m_shards;
+
+    std::atomic<uint64_t> m_posted{0};
+    std::atomic<uint64_t> m_late{0};
+    std::atomic<uint64_t> m_collected{0};
+    std::atomic<uint64_t> m_pruned{0};
+};
+
+} // namespace world
@@ -0,0 +1,262 @@
+#include "world/GenerationStages.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace world {
+
+namespace {
+
+const VoxelData vStone = VoxelData::make(1, 255, 0, VOXEL_FLAG_SOLID);
+const VoxelData vGrass = VoxelData::make(2, 255, 0, VOXEL_FLAG_SOLID);
+const VoxelData vDirt  = VoxelData::make(3, 255, 0, VOXEL_FLAG_SOLID);
+const VoxelData vSand  = VoxelData::make(4, 255, 0, VOXEL_FLAG_SOLID);
+const VoxelData vSnow  = VoxelData::make(5, 255, 0, VOXEL_FLAG_SOLID);
+const VoxelData vWater = VoxelData::make(6, 255, 0, VOXEL_FLAG_SOLID | VOXEL_FLAG_LIQUID);
+
+// Rounds towards +inf for any sign of `a` (b > 0).
+int ceilDiv(int a, int b) {
+    return a >= 0 ? (a + b - 1) / b : -((-a) / b);
+}
+
+} // namespace
+
+const char* stageName(GenStage stage) {
+    switch (stage) {
+        case GenStage::NOISE:       return "noise";
+        case GenStage::INTERPOLATE: return "interp";
+        case GenStage::SURFACE:     return "surface";
+        case GenStage::CARVE:       return "carve";
+        case GenStage::DECORATE:    return "decorate";
+        case GenStage::ENCODE:      return "encode";
+        default:                    return "?";
+    }
+}
+
+void ChunkGenContext::expand() {
+    std::fill_n(voxels, size * size * size, uniformVoxel);
+    uniform = false;
+}
+
+// ---------------------------------------------------------------------------
+// SurfaceStage — island + biomes (erosion / rivers / moisture) + water
+// ---------------------------------------------------------------------------
+void SurfaceStage::run(ChunkGenContext& ctx) {
+    const TerrainConfig& config = ctx.config;
+    const TerrainColumn& column = ctx.column;
+
+    // ---- Uniform early-out ---------------------------------------------------
+    // Bilinear interpolation never leaves the [min, max] range of the 9×9 samples, so the
+    // sample extremes bound every column height. Chunks wholly above the surface are AIR or
+    // WATER, chunks deeper than the thickest surface layer (5 blocks) are STONE in every
+    // biome. One block of margin absorbs float rounding in the lerp and the (int) truncation
+    // below.
+    const int chunkTop = ctx.worldBaseY + CHUNK_SIZE - 1;
+    if (ctx.worldBaseY > (int)column.maxSample + 1) {
+        if (ctx.worldBaseY >= config.seaLevel) return ctx.setUniform(VOXEL_AIR);
+        if (chunkTop       <  config.seaLevel) return ctx.setUniform(vWater);
+    } else if (chunkTop < (int)column.minSample - 6 - 1) {
+        return ctx.setUniform(vStone);
+    }
+
+    // ---- Fill voxels -------------------------------------------------------
+    // A reduced payload evaluates only the origin voxel of each step³ block, i.e. exactly the
+    // voxels generateMesh() samples at that LOD.
+    const int step = ctx.step;
+    const int size = ctx.size;
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            const int         terrainH = column.height[z * step][x * step];
+            const SurfaceKind surface  = column.surface[z * step][x * step]; // biome flags, see TerrainGenerator::buildColumn()
+
+            // ---------------------------------------------------------------
+            // 4-level column layering:
+            //
+            //  Plain / grassy mountain          Rocky cliff      Desert / Beach
+            //  ─────────────────────────        ─────────────    ──────────────
+            //  depth 1 : GRASS (or SNOW cap)    STONE            SAND
+            //  depth 2-4: DIRT  (or STONE cap)  STONE            SAND
+            //  depth 5+: STONE                  STONE            STONE
+            //
+            //  Snow cap override (terrainH > snowHeight):
+            //    depth 1   → SNOW
+            //    depth 2-3 → STONE  (rock just below snowfield, no dirt)
+            //    depth 4+  → STONE
+            // ---------------------------------------------------------------
+
+            for (int y = 0; y < size; ++y) {
+                const int wy    = ctx.worldBaseY + y * step;
+                VoxelData v     = VOXEL_AIR;
+
+                if (wy < terrainH) {
+                    const int depth = terrainH - wy;  // 1=surface, 2=one below, …
+
+                    if (surface == SurfaceKind::SNOW) {
+                        // Snow cap: SNOW on top, immediate stone underneath
+                        if      (depth == 1) v = vSnow;
+                        else                 v = vStone;
+
+                    } else if (surface == SurfaceKind::ROCK) {
+                        // Bare cliff: all stone
+                        v = vStone;
+
+                    } else if (surface == SurfaceKind::SAND) {
+                        // Sandy biome: sand surface + sand subsurface, then stone
+                        if   (depth <= 4) v = vSand;
+                        else              v = vStone;
+
+                    } else {
+                        // Normal grassy land (plains AND grassy mountain slopes):
+                        // GRASS → DIRT (4 blocks) → STONE
+                        if      (depth == 1) v = vGrass;
+                        else if (depth <= 5) v = vDirt;
+                        else                 v = vStone;
+                    }
+
+                } else if (wy < config.seaLevel) {
+                    v = vWater;
+                }
+
+                ctx.at(x, y, z) = v;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// CarveStage — 3D cave density (9×9×9 lattice)
+// ---------------------------------------------------------------------------
+void CarveStage::run(ChunkGenContext& ctx) {
+    // Carving only removes blocks below the terrain surface: chunks wholly above it and
+    // chunks wholly under the cave floor never sample the lattice.
+    if (ctx.worldBaseY > (int)ctx.column.maxSample + 1) return;
+    if (ctx.worldBaseY + CHUNK_SIZE <= CAVE_FLOOR_Y) return;
+
+    m_noise.sampleLattice(ctx.cx, ctx.cy, ctx.cz, m_lattice);
+    if (m_lattice.carvesNothing()) return;
+
+    if (ctx.uniform) {
+        // SURFACE only leaves a below-surface chunk uniform when it is deep STONE: every voxel
+        // lies deeper than CAVE_SEA_ROOF, so a lattice that carves everything empties it.
+        if (m_lattice.carvesAll() && ctx.worldBaseY >= CAVE_FLOOR_Y) return ctx.setUniform(VOXEL_AIR);
+        ctx.expand();
+    }
+
+    // Per column, the carvable range is [CAVE_FLOOR_Y, surface) — capped CAVE_SEA_ROOF blocks
+    // under the surface when it lies under water; SOLID cells skip the interpolation.
+    const int step = ctx.step;
+    const int size = ctx.size;
+    const int yBegin = std::max(0, ceilDiv(CAVE_FLOOR_Y - ctx.worldBaseY, step));
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            const int terrainH = ctx.column.height[z * step][x * step];
+            const int top      = (terrainH >= ctx.config.seaLevel) ? terrainH : terrainH - CAVE_SEA_ROOF;
+            const int yEnd     = std::min(size, ceilDiv(top - ctx.worldBaseY, step));
+            for (int y = yBegin; y < yEnd; ++y) {
+                if (m_lattice.isCarved(x * step, y * step, z * step)) ctx.at(x, y, z) = VOXEL_AIR;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// DecorateStage — trees, cross-chunk through DecorationQueue
+// ---------------------------------------------------------------------------
+void DecorateStage::write(ChunkGenContext& ctx, int x, int y, int z, VoxelData v) {
+    if (ctx.uniform) {
+        if (!decorationReplaces(ctx.uniformVoxel, v)) return;
+        // Expanded even for a write the reduced grid drops: a uniform ctx is stored as exact at
+        // full resolution, and this chunk must stay reduced so it is refined later.
+        ctx.expand();
+    }
+    // A reduced payload stores the origin voxel of each step³ block only.
+    const int mask = ctx.step - 1;
+    if ((x | y | z) & mask) return;
+    VoxelData& cur = ctx.at(x >> ctx.lod, y >> ctx.lod, z >> ctx.lod);
+    if (decorationReplaces(cur, v)) cur = v;
+}
+
+void DecorateStage::place(ChunkGenContext& ctx, int wx, int wy, int wz, VoxelData v) {
+    const int x = wx - ctx.cx * CHUNK_SIZE;
+    const int y = wy - ctx.worldBaseY;
+    const int z = wz - ctx.cz * CHUNK_SIZE;
+    const int dx = (x < 0) ? -1 : (x >= CHUNK_SIZE ? 1 : 0);
+    const int dy = (y >= CHUNK_SIZE) ? 1 : 0;
+    const int dz = (z < 0) ? -1 : (z >= CHUNK_SIZE ? 1 : 0);
+    if ((dx | dy | dz) == 0) return write(ctx, x, y, z, v);
+
+    const int lx = x - dx * CHUNK_SIZE, ly = y - dy * CHUNK_SIZE, lz = z - dz * CHUNK_SIZE;
+    m_spills[(dx + 1) + (dz + 1) * 3 + dy * 9].push_back(
+        {static_cast<uint16_t>(lx + ly * CHUNK_SIZE + lz * CHUNK_SIZE * CHUNK_SIZE), v});
+}
+
+void DecorateStage::placeTree(ChunkGenContext& ctx, int wx, int wy, int wz, uint64_t seed) {
+    //  Trunk of 4-6 WOOD from the first air block up; a LEAVES crown around its top:
+    //  two 5×5 layers (corners trimmed) and two 3×3 layers above them.
+    const int trunk = 4 + static_cast<int>((seed >> 40) % 3);
+    for (int dy = 0; dy < trunk; ++dy) place(ctx, wx, wy + dy, wz, VOXEL_WOOD);
+    for (int dy = trunk - 2; dy <= trunk + 1; ++dy) {
+        const int r = (dy < trunk) ? 2 : 1;
+        for (int dz = -r; dz <= r; ++dz) {
+            for (int dx = -r; dx <= r; ++dx) {
+                if (std::abs(dx) == r && std::abs(dz) == r && (r == 2 || dy == trunk + 1)) continue;
+                place(ctx, wx + dx, wy + dy, wz + dz, VOXEL_LEAVES);
+            }
+        }
+    }
+}
+
+void DecorateStage::run(ChunkGenContext& ctx) {
+    const TerrainConfig& config = ctx.config;
+    DecorationQueue& queue = DecorationQueue::shared();
+    for (auto& spill : m_spills) spill.clear();
+
+    // ---- Structures rooted in this chunk -------------------------------------
+    // Root = first air block above a grass surface; only the chunk holding it places the tree.
+    const int chunkTop = ctx.worldBaseY + CHUNK_SIZE;
+    if (config.trees && ctx.column.maxHeight >= ctx.worldBaseY && ctx.column.minHeight < chunkTop) {
+        const uint32_t threshold = static_cast<uint32_t>(std::clamp(config.treeDensity, 0.0f, 1.0f) * 65536.0f);
+        constexpr int CELLS = CHUNK_SIZE / TREE_CELL;
+        for (int cz = 0; cz < CELLS; ++cz) {
+            for (int cx = 0; cx < CELLS; ++cx) {
+                const int gx = ctx.cx * CELLS + cx, gz = ctx.cz * CELLS + cz;
+                uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(config.seed)) * 0x9E3779B97F4A7C15ull;
+                h ^= static_cast<uint64_t>(static_cast<uint32_t>(gx)) * 0xD6E8FEB86659FD93ull;
+                h ^= static_cast<uint64_t>(static_cast<uint32_t>(gz)) * 0xC2B2AE3D27D4EB4Full;
+                h ^= h >> 31; h *= 0xBF58476D1CE4E5B9ull; h ^= h >> 29;
+                if ((h & 0xFFFF) >= threshold) continue;
+
+                // Candidate 1..6 blocks into its cell, so neighbouring crowns rarely merge.
+                const int x = cx * TREE_CELL + 1 + static_cast<int>((h >> 16) % (TREE_CELL - 2));
+                const int z = cz * TREE_CELL + 1 + static_cast<int>((h >> 24) % (TREE_CELL - 2));
+                const int root = ctx.column.height[z][x];
+                if (root < ctx.worldBaseY || root >= chunkTop) continue;
+                if (root <= config.seaLevel || ctx.column.surface[z][x] != SurfaceKind::GRASS) continue;
+                placeTree(ctx, ctx.cx * CHUNK_SIZE + x, root, ctx.cz * CHUNK_SIZE + z, h);
+            }
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(m_spills.size()); ++i) {
+        if (m_spills[i].empty()) continue;
+        const int tx = ctx.cx + i % 3 - 1, tz = ctx.cz + (i / 3) % 3 - 1, ty = ctx.cy + i / 9;
+        if (queue.post(ctx.configHash, tx, ty, tz, ctx.cx, ctx.cy, ctx.cz, m_spills[i]) && ctx.late)
+            ctx.late->push_back({tx, ty, tz, m_spills[i]});
+    }
+
+    // ---- Structures of neighbouring chunks reaching into this one -------------
+    m_incoming.clear();
+    queue.collect(ctx.configHash, ctx.cx, ctx.cy, ctx.cz, m_incoming);
+    for (const DecorationWrite& w : m_incoming) {
+        write(ctx, w.index % CHUNK_SIZE, (w.index / CHUNK_SIZE) % CHUNK_SIZE, w.index / (CHUNK_SIZE * CHUNK_SIZE), w.voxel);
+    }
+}
+
+std::vector<std::unique_ptr<ChunkStage>> buildChunkStages(const TerrainConfig& config) {
+    std::vector<std::unique_ptr<ChunkStage>> stages;
+    stages.push_back(std::make_unique<SurfaceStage>());
+    if (config.caves) stages.push_back(std::make_unique<CarveStage>(config));
+    if (config.trees) stages.push_back(std::make_unique<DecorateStage>());
+    return stages;
+}
+
+} // namespace world
@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "world/TerrainNoise.hpp"
+#include "world/CaveDensity.hpp"
+#include "world/DecorationQueue.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// GenerationStages — the staged terrain pipeline behind Chunk::fillTerrain().
+//
+//   COLUMN scope (once per (cx, cz), cached in TerrainColumnCache, shared by every Y-slice):
+//     NOISE        2D noise on the STEP grid (height, erosion, moisture, rivers)
+//     INTERPOLATE  full-resolution fields + biome classes → TerrainColumn
+//   CHUNK scope (once per chunk, in the MeshWorker GENERATE task):
+//     SURFACE      biome layering + water; exact uniform chunks skip the voxel pass
+//     CARVE        3D cave density (CaveDensity), carves solid voxels to AIR
+//     DECORATE     structures (trees) rooted in the chunk; voxels that spill into
+//                  neighbours go through DecorationQueue
+//   ENCODE         palette encoding of the result (Chunk, timed only)
+//
+// Chunk stages are ChunkStage objects owned by the thread's TerrainGenerator and run in
+// order on a ChunkGenContext. A stage the config does not need is simply not in the list, so
+// an expensive stage costs nothing while it is switched off. Every stage is timed separately
+// (TerrainGenerator::Stats).
+// ---------------------------------------------------------------------------
+
+enum class GenStage : uint8_t { NOISE, INTERPOLATE, SURFACE, CARVE, DECORATE, ENCODE, COUNT };
+enum class StageScope : uint8_t { COLUMN, CHUNK };
+
+constexpr size_t GEN_STAGE_COUNT = static_cast<size_t>(GenStage::COUNT);
+
+constexpr StageScope stageScope(GenStage stage) {
+    return (stage == GenStage::NOISE || stage == GenStage::INTERPOLATE) ? StageScope::COLUMN
+                                                                        : StageScope::CHUNK;
+}
+
+const char* stageName(GenStage stage);
+
+// What the chunk stages see and edit. The chunk is either uniform (one voxel value, no
+// scratch written yet) or a size³ grid in the generator's scratch volume; a reduced payload
+// (lod > 0) stores only the origin voxel of each step³ block, so stages address voxels by
+// grid index and convert to chunk-local blocks with `step`.
+struct ChunkGenContext {
+    const TerrainConfig& config;
+    const TerrainColumn& column;
+    int cx, cy, cz;
+    int lod, step, size;
+    int worldBaseY;
+    VoxelData* voxels; // size³ scratch, x + y*size + z*size*size
+
+    bool      uniform      = false;
+    VoxelData uniformVoxel = VOXEL_AIR;
+
+    // Set by TerrainGenerator::runChunkStages().
+    uint64_t configHash = 0;
+    std::vector<DecorationDelivery>* late = nullptr; // DECORATE: spills the target may have missed
+
+    VoxelData& at(int x, int y, int z) { return voxels[x + y * size + z * size * size]; }
+
+    void setUniform(VoxelData v) { uniform = true; uniformVoxel = v; }
+    // Writes the uniform value into the scratch so a stage can edit single voxels.
+    void expand();
+};
+
+class ChunkStage {
+public:
+    virtual ~ChunkStage() = default;
+    virtual GenStage stage() const = 0;
+    virtual void run(ChunkGenContext& ctx) = 0;
+};
+
+// Biome layering (GRASS/DIRT, SAND, ROCK, SNOW over STONE) and sea water. Chunks wholly above
+// the surface or deeper than every surface layer come out uniform.
+class SurfaceStage final : public ChunkStage {
+public:
+    GenStage stage() const override { return GenStage::SURFACE; }
+    void run(ChunkGenContext& ctx) override;
+};
+
+// Caves and overhangs from the 9×9×9 density lattice (see CaveDensity.hpp).
+class CarveStage final : public ChunkStage {
+public:
+    explicit CarveStage(const TerrainConfig& config) : m_noise(config) {}
+    GenStage stage() const override { return GenStage::CARVE; }
+    void run(ChunkGenContext& ctx) override;
+
+private:
+    CaveNoise   m_noise;
+    CaveLattice m_lattice;
+};
+
+// Trees on grass, one candidate per 8×8-block cell, placed by the chunk that holds the root
+// block. Voxels inside the chunk go into the scratch; the rest is posted to DecorationQueue
+// for the neighbour, and whatever the neighbours posted for this chunk is collected here.
+// Deterministic per (seed, cell), so a regenerated chunk posts the same voxels again.
+class DecorateStage final : public ChunkStage {
+public:
+    GenStage stage() const override { return GenStage::DECORATE; }
+    void run(ChunkGenContext& ctx) override;
+
+    static constexpr int TREE_CELL = 8;
+
+private:
+    void placeTree(ChunkGenContext& ctx, int wx, int wy, int wz, uint64_t seed);
+    void place(ChunkGenContext& ctx, int wx, int wy, int wz, VoxelData v);
+    void write(ChunkGenContext& ctx, int x, int y, int z, VoxelData v);
+
+    // Spills per neighbour: dx, dz ∈ [-1, 1], dy ∈ [0, 1] (structures grow up from their root).
+    std::array<std::vector<DecorationWrite>, 18> m_spills;
+    std::vector<DecorationWrite> m_incoming;
+};
+
+// The chunk stages `config` needs, in pipeline order.
+std::vector<std::unique_ptr<ChunkStage>> buildChunkStages(const TerrainConfig& config);
+
+} // namespace world
@@ -11,11 +11,18 @@ public:
     float m_lodDist0      = 64.0f;   // LOD 0 → LOD 1 boundary
     float m_lodDist1      = 128.0f;  // LOD 1 → LOD 2 boundary
     float m_lodHysteresis = 4.0f;    // Hysteresis to prevent flickering
+    // Far chunks generate only the voxels their mesh LOD reads; full resolution follows
+    // lazily when they come closer or get edited (Chunk::getPayloadLod()).
+    bool  m_reducedGeneration = true;
 
     void setCameraPosition(const core::math::Vec3& pos) { m_cameraPos = pos; }
     const core::math::Vec3& getCameraPosition() const { return m_cameraPos; }
 
     int calculateLOD(int cx, int cy, int cz, int currentLOD = -1) const;
+    // Payload resolution for a chunk generated now: its LOD, or 0 with reduced generation off.
+    int generationLOD(int cx, int cy, int cz) const {
+        return m_reducedGeneration ? calculateLOD(cx, cy, cz) : 0;
+    }
 
 private:
     core::math::Vec3 m_cameraPos{0.0f, 0.0f, 0.0f};
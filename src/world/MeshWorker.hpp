@@ -1,8 +1,9 @@
 #pragma once
 
 #include "Chunk.hpp"
+#include "ChunkMeshSink.hpp"
 #include "VoxelData.hpp"
-#include "../vendor/FastNoiseLite.h"
+#include "TerrainGenerator.hpp"
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -10,6 +11,7 @@
 #include <vector>
 #include <functional>
 #include <atomic>
+#include <cstring>
 
 namespace world {
 
@@ -25,11 +27,32 @@ struct MeshTask {
     int cx = 0, cy = 0, cz = 0;
     TerrainConfig config{}; // Replace explicit seed
     int lod = 0;  // Level of Detail: 0=full, 1=half, 2=quarter resolution
+                  // (GENERATE: resolution of the voxel payload, see Chunk::getPayloadLod())
+    bool refine = false; // GENERATE on a READY reduced chunk: re-generate it at the finer `lod`
     std::array<const Chunk*, 6> neighbors{};
     std::array<int, 6> neighborLODs{};
 
     // Output (filled by worker)
     VoxelMeshData result;
+    // MESH with a staging sink: the mesh already sits in sink memory and `result` stays empty.
+    // Must reach the sink once — ChunkMeshSink::uploadStaged() or releaseStaging().
+    MeshStaging staged;
+    // GENERATE: structure voxels spilled into neighbours that may already have generated — the
+    // main thread applies them to resident ones (ChunkMesher::applyLateDecorations()).
+    std::vector<DecorationDelivery> decorations;
+
+    // Pins every chunk the task reads or writes (Chunk::m_taskRefs) so ChunkPool defers
+    // recycling them until the worker is done. pin() on submit, unpin() after execution.
+    void pin() const   { forEachChunk([](const Chunk* c) { c->m_taskRefs.fetch_add(1, std::memory_order_relaxed); }); }
+    void unpin() const { forEachChunk([](const Chunk* c) { c->m_taskRefs.fetch_sub(1, std::memory_order_release); }); }
+
+private:
+    template <typename Fn>
+    void forEachChunk(Fn&& fn) const {
+        if (chunk) fn(chunk);
+        if (type == Type::MESH)
+            for (const Chunk* nb : neighbors) if (nb) fn(nb);
+    }
 };
 
 // ---------------------------------------------------------------------------
@@ -43,7 +66,8 @@ struct MeshTask {
 //
 // Thread safety:
 //   - submit() and collect() are called from the main thread only.
-//   - Chunk data is READ-ONLY during meshing (no writes from workers).
+//   - Chunk data is READ-ONLY during meshing (no writes from workers). GENERATE tasks write
+//     their chunk; refine tasks swap a READY chunk's payload under its palette lock.
 //   - Results are collected after waitAll() — no concurrent access.
 // ---------------------------------------------------------------------------
 class MeshWorker {
@@ -51,7 +75,9 @@ public:
     static constexpr size_t RING_SIZE = 65536;
     static constexpr size_t RING_MASK = RING_SIZE - 1;
 
-    explicit MeshWorker(uint32_t threadCount = 0) : m_ringHigh(RING_SIZE), m_ringLow(RING_SIZE) {
+    // staging: sink whose staging memory MESH results are written into (ChunkMeshSink::hasStaging()).
+    explicit MeshWorker(uint32_t threadCount = 0, ChunkMeshSink* staging = nullptr)
+        : m_staging(staging), m_ringHigh(RING_SIZE), m_ringLow(RING_SIZE) {
         if (threadCount == 0)
             threadCount = std::max(1u, std::thread::hardware_concurrency());
         m_threadCount = threadCount;
@@ -80,6 +106,7 @@ public:
             while (t - m_headHigh.load(std::memory_order_acquire) >= RING_SIZE) {
                 std::this_thread::yield();
             }
+            task.pin();
             m_ringHigh[t & RING_MASK] = std::move(task);
             t++;
             m_tailHigh.store(t, std::memory_order_release);
@@ -98,6 +125,7 @@ public:
             while (t - m_headLow.load(std::memory_order_acquire) >= RING_SIZE) {
                 std::this_thread::yield();
             }
+            task.pin();
             m_ringLow[t & RING_MASK] = std::move(task);
             t++;
             m_tailLow.store(t, std::memory_order_release);
@@ -121,13 +149,30 @@ public:
 
     uint32_t getThreadCount() const { return m_threadCount; }
     int getActiveTasks() const { return m_activeTasks.load(std::memory_order_relaxed); }
+    // MESH tasks answered without running generateMesh() (uniform chunks, see Chunk::isMeshTriviallyEmpty).
+    uint64_t getSkippedMeshes() const { return m_skippedMeshes.load(std::memory_order_relaxed); }
 
 private:
-    void workerLoop(std::stop_token st) {
-        // FastNoiseLite noise; // Moved inside the loop for each generation task
-        // bool noiseInit = false; // No longer needed
-        // int currentSeed = 0; // No longer needed
+    // Meshes into this thread's reused buffer and copies it once into a staging reservation,
+    // so the result needs no allocation and the main thread no copy. A full staging ring
+    // falls back to an owned VoxelMeshData.
+    void meshIntoStaging(MeshTask& task) {
+        static thread_local VoxelMeshData scratch;
+        task.chunk->generateMesh(task.neighbors, task.neighborLODs, task.lod, scratch);
+        if (scratch.empty()) return;
+
+        const uint32_t quadCount = scratch.quadCount();
+        task.staged = m_staging->reserveStaging(quadCount);
+        if (!task.staged.valid()) {
+            task.result = scratch;
+            return;
+        }
+        std::memcpy(task.staged.quads, scratch.quads.data(), quadCount * sizeof(VoxelQuad));
+        task.staged.faceQuads   = scratch.faceQuads;
+        task.staged.liquidQuads = scratch.liquidQuads;
+    }
 
+    void workerLoop(std::stop_token st) {
         while (!st.stop_requested()) {
             MeshTask task;
             bool gotTask = false;
@@ -166,20 +211,30 @@ private:
             if (gotTask) {
                 if (task.chunk) {
                     if (task.type == MeshTask::Type::GENERATE) {
-                        FastNoiseLite noise;
-                        noise.SetSeed(task.config.seed);
-                        noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-                        noise.SetFractalType(FastNoiseLite::FractalType_FBm);
-                        noise.SetFractalOctaves(task.config.octaves);
-                        noise.SetFrequency(task.config.frequency);
-                        
-                        task.chunk->fillTerrain(task.config, &noise);
-                        task.chunk->m_state.store(ChunkState::READY, std::memory_order_release);
+                        // Noise layers and scratch live in this thread's TerrainGenerator.
+                        if (task.refine) {
+                            // Stays READY: the coarse payload keeps serving meshes until swapped.
+                            task.chunk->refineTerrain(task.config, task.lod);
+                        } else {
+                            task.chunk->fillTerrain(task.config, task.lod);
+                            task.chunk->m_state.store(ChunkState::READY, std::memory_order_release);
+                        }
+                        task.decorations = TerrainGenerator::takeLateDecorations();
                     } else if (task.type == MeshTask::Type::MESH) {
-                        task.result = task.chunk->generateMesh(task.neighbors, task.neighborLODs, task.lod);
+                        // Uniform chunks with nothing to show skip the mesher: the empty result
+                        // takes the usual isEmpty path in ChunkMesher::rebuildDirtyChunks().
+                        if (task.chunk->isMeshTriviallyEmpty(task.neighbors, task.neighborLODs, task.lod)) {
+                            m_skippedMeshes.fetch_add(1, std::memory_order_relaxed);
+                        } else if (m_staging) {
+                            meshIntoStaging(task);
+                        } else {
+                            task.result = task.chunk->generateMesh(task.neighbors, task.neighborLODs, task.lod);
+                        }
                     }
                 }
 
+                task.unpin(); // last access to the chunks; the pool may recycle them now
+
                 // Append to done
                 {
                     std::lock_guard<std::mutex> lk(m_doneMutex);
@@ -202,6 +257,7 @@ private:
     }
 
     uint32_t m_threadCount = 1;
+    ChunkMeshSink* m_staging = nullptr;
 
     // Lock-Free SPMC Ring Buffer HIGH
     std::vector<MeshTask> m_ringHigh;
@@ -225,6 +281,7 @@ private:
     std::condition_variable m_doneCv;
 
     std::atomic<int> m_activeTasks{0};
+    std::atomic<uint64_t> m_skippedMeshes{0};
     std::vector<std::jthread> m_threads;
 };
 
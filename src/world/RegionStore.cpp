@@ -0,0 +1,495 @@
+#include "world/RegionStore.hpp"
+#include "world/ChunkCodec.hpp"
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+namespace world {
+
+namespace {
+
+constexpr uint32_t REGION_MAGIC   = 0x4E475250; // "PRGN" little-endian
+constexpr uint32_t REGION_VERSION = 1;
+constexpr uint32_t MAX_SECTOR_RUN = 0xFF;
+constexpr uint32_t MAX_SECTOR     = 1u << 24;
+
+// Region files are written in host byte order; every supported target is little-endian.
+bool writeU32(std::fstream& f, uint32_t v) {
+    f.write(reinterpret_cast<const char*>(&v), sizeof(v));
+    return static_cast<bool>(f);
+}
+
+bool readU32(std::fstream& f, uint32_t& v) {
+    f.read(reinterpret_cast<char*>(&v), sizeof(v));
+    return static_cast<bool>(f);
+}
+
+} // namespace
+
+RegionStore::~RegionStore() {
+    close();
+}
+
+// ---------------------------------------------------------------------------
+// Lifecycle
+// ---------------------------------------------------------------------------
+bool RegionStore::open(const std::string& directory) {
+    close();
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        std::cerr << "[RegionStore] Cannot create save directory '" << directory
+                  << "': " << ec.message() << " — edits will stay in RAM.\n";
+        return false;
+    }
+
+    m_directory = directory;
+
+    // Existing region files make their chunks "maybe on disk" until the table is first read.
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        m_index.clear();
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            Coord rc{};
+            const std::string name = entry.path().filename().string();
+            if (std::sscanf(name.c_str(), "r.%d.%d.%d.region", &rc.x, &rc.y, &rc.z) == 3) {
+                m_index[rc] = RegionIndex{};
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stop     = false;
+        m_inFlight = false;
+    }
+    m_writer = std::thread(&RegionStore::writerLoop, this);
+    m_open   = true;
+    return true;
+}
+
+void RegionStore::close() {
+    if (!m_open) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stop = true;
+    }
+    m_queueCv.notify_all();
+    if (m_writer.joinable()) m_writer.join(); // the writer drains the queue before exiting
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        // Only payloads whose write failed are left here.
+        m_pending.clear();
+        m_queue.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        m_regions.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        m_index.clear();
+    }
+    m_open = false;
+}
+
+// ---------------------------------------------------------------------------
+// Write queue
+// ---------------------------------------------------------------------------
+void RegionStore::enqueueWrite(int cx, int cy, int cz, std::vector<uint8_t> payload) {
+    const Coord key{cx, cy, cz};
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        PendingWrite& entry = m_pending[key];
+        entry.payload = std::move(payload);
+        entry.seq     = m_nextSeq++;
+        m_queue.emplace_back(key, entry.seq);
+    }
+    m_queueCv.notify_one();
+}
+
+bool RegionStore::reclaim(int cx, int cy, int cz, std::vector<uint8_t>& payload) {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    auto it = m_pending.find(Coord{cx, cy, cz});
+    if (it == m_pending.end()) return false;
+
+    // A write already in progress for this chunk still completes with its own copy; the
+    // chunk comes back modified, so its next eviction overwrites that record anyway.
+    payload = std::move(it->second.payload);
+    m_pending.erase(it);
+    m_reclaimed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void RegionStore::flush() {
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    m_idleCv.wait(lock, [this]() { return m_queue.empty() && !m_inFlight; });
+}
+
+void RegionStore::writerLoop() {
+    std::vector<uint8_t> payload;
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+
+    while (true) {
+        if (m_queue.empty()) {
+            m_idleCv.notify_all();
+            if (m_stop) break;
+            m_queueCv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            continue;
+        }
+
+        const auto [key, seq] = m_queue.front();
+        m_queue.pop_front();
+
+        auto it = m_pending.find(key);
+        if (it == m_pending.end() || it->second.seq != seq) continue; // reclaimed or superseded
+
+        payload = it->second.payload; // copy: the entry stays reclaimable until it is on disk
+        m_inFlight = true;
+        lock.unlock();
+
+        bool written = false;
+        {
+            std::lock_guard<std::mutex> fileLock(m_fileMutex);
+            if (Region* region = getRegion(regionOf(key.x, key.y, key.z), true)) {
+                written = writeRecord(*region, localIndex(key.x, key.y, key.z), payload);
+            }
+        }
+
+        lock.lock();
+        m_inFlight = false;
+        it = m_pending.find(key);
+        if (it != m_pending.end() && it->second.seq == seq) {
+            // Failure: the payload stays in m_pending (still reclaimable), so the edit is not
+            // lost for this session.
+            if (written) m_pending.erase(it);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Synchronous access
+// ---------------------------------------------------------------------------
+bool RegionStore::writeNow(const Chunk& chunk) {
+    if (!m_open) return false;
+
+    std::vector<uint8_t> payload;
+    encodeChunkPayload(chunk, payload);
+
+    const int cx = chunk.getCX(), cy = chunk.getCY(), cz = chunk.getCZ();
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    Region* region = getRegion(regionOf(cx, cy, cz), true);
+    return region && writeRecord(*region, localIndex(cx, cy, cz), payload);
+}
+
+bool RegionStore::contains(int cx, int cy, int cz) {
+    if (!m_open) return false;
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    Region* region = getRegion(regionOf(cx, cy, cz), false);
+    return region && region->exists && region->table[localIndex(cx, cy, cz)] != 0;
+}
+
+bool RegionStore::mayContain(int cx, int cy, int cz) const {
+    if (!m_open) return false;
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    auto it = m_index.find(regionOf(cx, cy, cz));
+    if (it == m_index.end()) return false;
+    return !it->second.known || it->second.present.test(static_cast<size_t>(localIndex(cx, cy, cz)));
+}
+
+bool RegionStore::load(int cx, int cy, int cz, Chunk& chunk) {
+    if (!m_open) return false;
+
+    thread_local std::vector<uint8_t> tl_payload;
+    {
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        Region* region = getRegion(regionOf(cx, cy, cz), false);
+        if (!region || !region->exists) return false;
+        if (!readRecord(*region, localIndex(cx, cy, cz), tl_payload)) return false;
+    }
+
+    if (!decodeChunkPayload(tl_payload.data(), tl_payload.size(), chunk)) {
+        std::cerr << "[RegionStore] Corrupt record for chunk (" << cx << ", " << cy << ", " << cz
+                  << ") — regenerating.\n";
+        return false;
+    }
+    m_chunksRead.fetch_add(1, std::memory_order_relaxed);
+    m_bytesRead.fetch_add(tl_payload.size(), std::memory_order_relaxed);
+    return true;
+}
+
+size_t RegionStore::loadBatch(std::vector<LoadItem>& items) {
+    if (!m_open || items.empty()) return 0;
+
+    struct Read {
+        uint32_t sector;
+        size_t   item;
+    };
+    thread_local std::vector<Read>                 tl_reads;
+    thread_local std::vector<std::vector<uint8_t>> tl_payloads;
+    tl_reads.clear();
+    if (tl_payloads.size() < items.size()) tl_payloads.resize(items.size());
+
+    {
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        const LoadItem& first = items.front();
+        Region* region = getRegion(regionOf(first.cx, first.cy, first.cz), false);
+        if (!region || !region->exists) return 0;
+
+        for (size_t i = 0; i < items.size(); ++i) {
+            const uint32_t entry = region->table[localIndex(items[i].cx, items[i].cy, items[i].cz)];
+            if (entry != 0) tl_reads.push_back({entry >> 8, i});
+        }
+        // Ascending sector order: one forward sweep through the file per batch.
+        std::sort(tl_reads.begin(), tl_reads.end(),
+                  [](const Read& a, const Read& b) { return a.sector < b.sector; });
+        for (Read& r : tl_reads) {
+            const LoadItem& item = items[r.item];
+            if (!readRecord(*region, localIndex(item.cx, item.cy, item.cz), tl_payloads[r.item])) {
+                r.sector = 0; // mark failed
+            }
+        }
+    }
+
+    size_t hits = 0;
+    for (const Read& r : tl_reads) {
+        if (r.sector == 0) continue;
+        LoadItem& item = items[r.item];
+        const std::vector<uint8_t>& payload = tl_payloads[r.item];
+        if (!decodeChunkPayload(payload.data(), payload.size(), *item.chunk)) {
+            std::cerr << "[RegionStore] Corrupt record for chunk (" << item.cx << ", " << item.cy << ", "
+                      << item.cz << ") — regenerating.\n";
+            continue;
+        }
+        item.loaded = true;
+        ++hits;
+        m_chunksRead.fetch_add(1, std::memory_order_relaxed);
+        m_bytesRead.fetch_add(payload.size(), std::memory_order_relaxed);
+    }
+    return hits;
+}
+
+RegionStore::Stats RegionStore::getStats() const {
+    Stats s;
+    s.chunksWritten = m_chunksWritten.load(std::memory_order_relaxed);
+    s.bytesWritten  = m_bytesWritten.load(std::memory_order_relaxed);
+    s.chunksRead    = m_chunksRead.load(std::memory_order_relaxed);
+    s.bytesRead     = m_bytesRead.load(std::memory_order_relaxed);
+    s.reclaimed     = m_reclaimed.load(std::memory_order_relaxed);
+    s.pendingWrites = getPendingWrites();
+    {
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        s.openRegions = m_regions.size();
+    }
+    return s;
+}
+
+size_t RegionStore::getPendingWrites() const {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_pending.size();
+}
+
+// ---------------------------------------------------------------------------
+// Region files
+// ---------------------------------------------------------------------------
+RegionStore::Coord RegionStore::regionOf(int cx, int cy, int cz) {
+    return Coord{cx >> 5, cy >> 3, cz >> 5};
+}
+
+int RegionStore::localIndex(int cx, int cy, int cz) {
+    static_assert(REGION_COLUMNS == 32 && REGION_SLICES == 8, "regionOf() shifts assume 32x8x32 regions");
+    return (cx & (REGION_COLUMNS - 1))
+         + (cz & (REGION_COLUMNS - 1)) * REGION_COLUMNS
+         + (cy & (REGION_SLICES - 1)) * REGION_COLUMNS * REGION_COLUMNS;
+}
+
+RegionStore::Region* RegionStore::getRegion(const Coord& rc, bool create) {
+    ++m_useCounter;
+    auto it = m_regions.find(rc);
+    if (it != m_regions.end()) {
+        Region& cached = *it->second;
+        cached.lastUse = m_useCounter;
+        if (cached.exists || !create) return &cached;
+        m_regions.erase(it); // negative entry: the file is about to be created
+    }
+
+    if (m_regions.size() >= MAX_OPEN_REGIONS) {
+        auto oldest = std::min_element(m_regions.begin(), m_regions.end(),
+            [](const auto& a, const auto& b) { return a.second->lastUse < b.second->lastUse; });
+        m_regions.erase(oldest);
+    }
+
+    auto region = std::make_unique<Region>();
+    region->coord   = rc;
+    region->lastUse = m_useCounter;
+
+    const std::filesystem::path path = std::filesystem::path(m_directory)
+        / ("r." + std::to_string(rc.x) + "." + std::to_string(rc.y) + "." + std::to_string(rc.z) + ".region");
+
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        region->file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+        uint32_t magic = 0, version = 0;
+        if (!region->file || !readU32(region->file, magic) || !readU32(region->file, version)
+            || magic != REGION_MAGIC || version != REGION_VERSION) {
+            std::cerr << "[RegionStore] Unreadable region file " << path.string() << " — ignored.\n";
+            return nullptr;
+        }
+
+        region->table.resize(REGION_CHUNKS);
+        region->file.seekg(16);
+        region->file.read(reinterpret_cast<char*>(region->table.data()), REGION_CHUNKS * sizeof(uint32_t));
+        region->file.seekg(0, std::ios::end);
+        const uint64_t fileBytes = static_cast<uint64_t>(region->file.tellg());
+        if (!region->file) {
+            std::cerr << "[RegionStore] Truncated region file " << path.string() << " — ignored.\n";
+            return nullptr;
+        }
+
+        region->usedSectors.assign(std::max<uint64_t>(HEADER_SECTORS, fileBytes / SECTOR_BYTES), false);
+        std::fill_n(region->usedSectors.begin(), HEADER_SECTORS, true);
+        for (uint32_t& entry : region->table) {
+            const uint32_t start = entry >> 8, count = entry & 0xFF;
+            if (entry == 0) continue;
+            if (start < HEADER_SECTORS || start + count > region->usedSectors.size()) {
+                entry = 0; // points past EOF (interrupted append) — treat as absent
+                continue;
+            }
+            for (uint32_t s = 0; s < count; ++s) region->usedSectors[start + s] = true;
+        }
+        region->exists = true;
+
+        std::lock_guard<std::mutex> indexLock(m_indexMutex);
+        RegionIndex& index = m_index[rc];
+        index.known = true;
+        index.present.reset();
+        for (int i = 0; i < REGION_CHUNKS; ++i) {
+            if (region->table[static_cast<size_t>(i)] != 0) index.present.set(static_cast<size_t>(i));
+        }
+    } else if (create) {
+        {
+            std::ofstream init(path, std::ios::binary | std::ios::trunc);
+            std::vector<char> header(static_cast<size_t>(HEADER_SECTORS) * SECTOR_BYTES, 0);
+            std::memcpy(header.data(),     &REGION_MAGIC,   sizeof(uint32_t));
+            std::memcpy(header.data() + 4, &REGION_VERSION, sizeof(uint32_t));
+            init.write(header.data(), static_cast<std::streamsize>(header.size()));
+            if (!init) {
+                std::cerr << "[RegionStore] Cannot create region file " << path.string() << "\n";
+                return nullptr;
+            }
+        }
+        region->file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+        if (!region->file) {
+            std::cerr << "[RegionStore] Cannot open region file " << path.string() << "\n";
+            return nullptr;
+        }
+        region->table.assign(REGION_CHUNKS, 0);
+        region->usedSectors.assign(HEADER_SECTORS, true);
+        region->exists = true;
+
+        std::lock_guard<std::mutex> indexLock(m_indexMutex);
+        RegionIndex& index = m_index[rc];
+        index.known = true;
+        index.present.reset();
+    }
+    // else: negative cache entry — no file yet, nothing to read.
+
+    Region* raw = region.get();
+    m_regions.emplace(rc, std::move(region));
+    return raw;
+}
+
+bool RegionStore::writeRecord(Region& region, int index, const std::vector<uint8_t>& payload) {
+    const uint64_t recordBytes = sizeof(uint32_t) + payload.size();
+    const uint32_t needed = static_cast<uint32_t>((recordBytes + SECTOR_BYTES - 1) / SECTOR_BYTES);
+    if (needed > MAX_SECTOR_RUN) {
+        std::cerr << "[RegionStore] Chunk record too large (" << recordBytes << " bytes)\n";
+        return false;
+    }
+
+    const uint32_t oldEntry = region.table[index];
+    const uint32_t oldStart = oldEntry >> 8, oldCount = oldEntry & 0xFF;
+    auto& used = region.usedSectors;
+
+    // Never in place: first free run (the old record's sectors are still marked used, so it
+    // cannot overlap them — the old version stays valid until the table entry is switched),
+    // else append.
+    uint32_t start = static_cast<uint32_t>(used.size());
+    uint32_t runStart = HEADER_SECTORS, runLength = 0;
+    for (uint32_t s = HEADER_SECTORS; s < used.size(); ++s) {
+        if (used[s]) { runLength = 0; runStart = s + 1; continue; }
+        if (++runLength == needed) { start = runStart; break; }
+    }
+    if (start + needed >= MAX_SECTOR) {
+        std::cerr << "[RegionStore] Region file full\n";
+        return false;
+    }
+
+    std::fstream& f = region.file;
+    f.clear();
+    f.seekp(static_cast<std::streamoff>(start) * SECTOR_BYTES);
+    writeU32(f, static_cast<uint32_t>(payload.size()));
+    f.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    static const char zeros[SECTOR_BYTES] = {};
+    const uint64_t padding = static_cast<uint64_t>(needed) * SECTOR_BYTES - recordBytes;
+    f.write(zeros, static_cast<std::streamsize>(padding)); // keep the file sector-aligned
+    f.flush(); // the record reaches the file before the table entry that points at it
+    if (!f) {
+        std::cerr << "[RegionStore] Write failed for " << m_directory << "\n";
+        f.clear();
+        return false;
+    }
+
+    const uint32_t newEntry = (start << 8) | needed;
+    f.seekp(16 + static_cast<std::streamoff>(index) * sizeof(uint32_t));
+    writeU32(f, newEntry);
+    f.flush();
+    if (!f) {
+        std::cerr << "[RegionStore] Write failed for " << m_directory << "\n";
+        f.clear();
+        return false;
+    }
+
+    if (start + needed > used.size()) used.resize(start + needed, false);
+    if (oldEntry != 0) {
+        for (uint32_t s = 0; s < oldCount; ++s) used[oldStart + s] = false;
+    }
+    for (uint32_t s = 0; s < needed; ++s) used[start + s] = true;
+    region.table[index] = newEntry;
+    {
+        std::lock_guard<std::mutex> indexLock(m_indexMutex);
+        m_index[region.coord].present.set(static_cast<size_t>(index));
+    }
+
+    m_chunksWritten.fetch_add(1, std::memory_order_relaxed);
+    m_bytesWritten.fetch_add(payload.size(), std::memory_order_relaxed);
+    return true;
+}
+
+bool RegionStore::readRecord(Region& region, int index, std::vector<uint8_t>& payload) {
+    const uint32_t entry = region.table[index];
+    if (entry == 0) return false;
+    const uint32_t start = entry >> 8, count = entry & 0xFF;
+
+    std::fstream& f = region.file;
+    f.clear();
+    f.seekg(static_cast<std::streamoff>(start) * SECTOR_BYTES);
+    uint32_t length = 0;
+    if (!readU32(f, length) || sizeof(uint32_t) + static_cast<uint64_t>(length) > static_cast<uint64_t>(count) * SECTOR_BYTES) {
+        f.clear();
+        return false;
+    }
+    payload.resize(length);
+    f.read(reinterpret_cast<char*>(payload.data()), length);
+    if (!f) {
+        f.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace world
@@ -0,0 +1,176 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <bitset>
+#include <string>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "world/Chunk.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// RegionStore — on-disk persistence for player-modified chunks.
+//
+// One region file holds REGION_COLUMNS × REGION_COLUMNS chunk columns and REGION_SLICES
+// Y-slices (r.<rx>.<ry>.<rz>.region). The file is a sequence of SECTOR_BYTES sectors:
+//
+//   sectors [0, HEADER_SECTORS) : u32 magic, u32 version, u64 reserved,
+//                                 u32 table[REGION_CHUNKS] = (firstSector << 8) | sectorCount
+//   following sectors           : records — u32 byteLength + ChunkCodec payload
+//
+// A record is never rewritten in place: each write goes to the first free run that does not
+// overlap the live record (or the end of the file), the table entry is switched after the
+// record is flushed, and only then are the old sectors freed. An interrupted write therefore
+// leaves the previous version reachable.
+//
+// Writes are asynchronous: enqueueWrite() queues an already encoded payload (ColdChunkCache
+// compresses evicted chunks on its own worker) and the writer thread puts it on disk. A chunk
+// requested again before the writer got to it is returned by reclaim() without touching the
+// disk. load() / loadBatch() / contains() are thread-safe and may be called from worker
+// threads; mayContain() never touches the disk and is meant for the main thread.
+// ---------------------------------------------------------------------------
+class RegionStore {
+public:
+    static constexpr int      REGION_COLUMNS = 32; // chunk columns per region side (X / Z)
+    static constexpr int      REGION_SLICES  = 8;  // chunk Y-slices per region file
+    static constexpr int      REGION_CHUNKS  = REGION_COLUMNS * REGION_COLUMNS * REGION_SLICES;
+    static constexpr uint32_t SECTOR_BYTES   = 4096;
+    static constexpr uint32_t HEADER_BYTES   = 16 + REGION_CHUNKS * 4;
+    static constexpr uint32_t HEADER_SECTORS = (HEADER_BYTES + SECTOR_BYTES - 1) / SECTOR_BYTES;
+    static constexpr size_t   MAX_OPEN_REGIONS = 32; // LRU of open files + resident sector tables
+
+    struct Stats {
+        uint64_t chunksWritten = 0;
+        uint64_t bytesWritten  = 0; // encoded payload bytes
+        uint64_t chunksRead    = 0;
+        uint64_t bytesRead     = 0;
+        uint64_t reclaimed     = 0; // queued payloads taken back before they reached the disk
+        size_t   pendingWrites = 0;
+        size_t   openRegions   = 0;
+    };
+
+    struct Coord {
+        int x, y, z;
+        bool operator==(const Coord& o) const { return x == o.x && y == o.y && z == o.z; }
+    };
+    struct CoordHash {
+        size_t operator()(const Coord& c) const noexcept {
+            uint64_t h = static_cast<uint32_t>(c.x) * 0x9E3779B97F4A7C15ull;
+            h ^= static_cast<uint32_t>(c.y) * 0xC2B2AE3D27D4EB4Full;
+            h ^= static_cast<uint32_t>(c.z) * 0x165667B19E3779F9ull;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+
+    // Region file a chunk belongs to (arithmetic shifts floor negative coordinates).
+    static Coord regionOf(int cx, int cy, int cz);
+
+    // One chunk of a loadBatch() call.
+    struct LoadItem {
+        int    cx = 0, cy = 0, cz = 0;
+        Chunk* chunk  = nullptr;
+        bool   loaded = false; // out
+    };
+
+    RegionStore() = default;
+    ~RegionStore();
+    RegionStore(const RegionStore&) = delete;
+    RegionStore& operator=(const RegionStore&) = delete;
+
+    // Closes the current directory (draining queued writes) and starts persisting into
+    // `directory`, creating it if needed. Returns false and stays closed on I/O failure.
+    bool open(const std::string& directory);
+    // Drains queued writes, stops the writer thread and closes every region file.
+    void close();
+    bool isOpen() const { return m_open; }
+    const std::string& getDirectory() const { return m_directory; }
+
+    // Queues a ChunkCodec payload for chunk (cx,cy,cz); a newer payload replaces a queued one.
+    void enqueueWrite(int cx, int cy, int cz, std::vector<uint8_t> payload);
+    // Takes back a queued payload that has not reached the disk yet. Returns false if none.
+    bool reclaim(int cx, int cy, int cz, std::vector<uint8_t>& payload);
+    // Blocks until every queued write has reached the file.
+    void flush();
+
+    // Synchronous write on the calling thread (world reset / shutdown).
+    bool writeNow(const Chunk& chunk);
+
+    bool contains(int cx, int cy, int cz);
+    // Cheap, I/O-free pre-check: false means the chunk is definitely not on disk. May return
+    // true for a chunk whose region file exists but whose table has not been read yet.
+    bool mayContain(int cx, int cy, int cz) const;
+    // Replaces the payload of `chunk` with the stored record. Returns false if absent or corrupt.
+    bool load(int cx, int cy, int cz, Chunk& chunk);
+    // Loads several chunks of ONE region under a single file lock, reading records in sector
+    // order. Sets LoadItem::loaded per item; returns the number of hits.
+    size_t loadBatch(std::vector<LoadItem>& items);
+
+    Stats  getStats() const;
+    size_t getPendingWrites() const;
+
+private:
+    struct Region {
+        Coord                 coord{};
+        std::fstream          file;
+        bool                  exists = false; // false = negative cache entry (no file on disk yet)
+        std::vector<uint32_t> table;          // REGION_CHUNKS entries
+        std::vector<bool>     usedSectors;
+        uint64_t              lastUse = 0;
+    };
+
+    struct PendingWrite {
+        std::vector<uint8_t> payload;
+        uint64_t             seq = 0;
+    };
+
+    static int localIndex(int cx, int cy, int cz);
+
+    void writerLoop();
+
+    // Region file access — caller holds m_fileMutex.
+    Region* getRegion(const Coord& rc, bool create);
+    bool    writeRecord(Region& region, int index, const std::vector<uint8_t>& payload);
+    bool    readRecord(Region& region, int index, std::vector<uint8_t>& payload);
+
+    std::string m_directory;
+    std::atomic<bool> m_open{false};
+
+    mutable std::mutex m_fileMutex;
+    std::unordered_map<Coord, std::unique_ptr<Region>, CoordHash> m_regions;
+    uint64_t m_useCounter = 0;
+
+    // Which chunks are on disk, per region file that exists. `known` is false until the
+    // region's sector table has been read (then every chunk counts as "maybe").
+    // Guarded by m_indexMutex only, so the main thread never waits on file I/O.
+    struct RegionIndex {
+        bool                         known = false;
+        std::bitset<REGION_CHUNKS>   present;
+    };
+    mutable std::mutex m_indexMutex;
+    std::unordered_map<Coord, RegionIndex, CoordHash> m_index;
+
+    mutable std::mutex       m_queueMutex;
+    std::condition_variable  m_queueCv;  // writer wake-up
+    std::condition_variable  m_idleCv;   // flush() wake-up
+    std::unordered_map<Coord, PendingWrite, CoordHash> m_pending;
+    std::deque<std::pair<Coord, uint64_t>>             m_queue; // FIFO of (chunk, seq)
+    uint64_t    m_nextSeq  = 1;
+    bool        m_inFlight = false;
+    bool        m_stop     = false;
+    std::thread m_writer;
+
+    std::atomic<uint64_t> m_chunksWritten{0};
+    std::atomic<uint64_t> m_bytesWritten{0};
+    std::atomic<uint64_t> m_chunksRead{0};
+    std::atomic<uint64_t> m_bytesRead{0};
+    std::atomic<uint64_t> m_reclaimed{0};
+};
+
+} // namespace world
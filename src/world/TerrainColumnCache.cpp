@@ -0,0 +1,80 @@
+#include "world/TerrainColumnCache.hpp"
+#include "world/TerrainGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+namespace world {
+
+TerrainColumnCache::TerrainColumnCache(size_t capacity)
+    : m_shardCapacity(std::max<size_t>(1, (capacity + SHARDS - 1) / SHARDS))
+{
+}
+
+TerrainColumnCache& TerrainColumnCache::shared() {
+    static TerrainColumnCache s_cache;
+    return s_cache;
+}
+
+TerrainColumnCache::ColumnPtr TerrainColumnCache::get(const TerrainConfig& config, uint64_t configHash,
+                                                      int cx, int cz) {
+    const Key key{configHash, cx, cz};
+    const size_t hash = KeyHash{}(key);
+    Shard& shard = m_shards[(hash >> 7) % SHARDS];
+
+    std::optional<std::promise<ColumnPtr>> promise; // only the builder pays for one
+    std::shared_future<ColumnPtr>          column;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it != shard.map.end()) {
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruIt);
+            column = it->second.column;
+        } else {
+            column = promise.emplace().get_future().share();
+            shard.lru.push_front(key);
+            shard.map.emplace(key, Entry{column, shard.lru.begin()});
+            // In-flight entries may be evicted too: their waiters already hold the future.
+            while (shard.map.size() > m_shardCapacity) {
+                shard.map.erase(shard.lru.back());
+                shard.lru.pop_back();
+            }
+        }
+    }
+
+    if (promise) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        auto built = std::make_shared<TerrainColumn>();
+        TerrainGenerator::forThread(config, configHash).buildColumn(cx, cz, *built);
+        promise->set_value(built);
+        return built;
+    }
+
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    if (column.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        m_waits.fetch_add(1, std::memory_order_relaxed);
+    }
+    return column.get();
+}
+
+void TerrainColumnCache::clear() {
+    for (Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.map.clear();
+        shard.lru.clear();
+    }
+}
+
+TerrainColumnCache::Stats TerrainColumnCache::getStats() const {
+    Stats s;
+    s.hits   = m_hits.load(std::memory_order_relaxed);
+    s.misses = m_misses.load(std::memory_order_relaxed);
+    s.waits  = m_waits.load(std::memory_order_relaxed);
+    for (const Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        s.resident += shard.map.size();
+    }
+    return s;
+}
+
+} // namespace world
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "world/TerrainNoise.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// TerrainColumnCache — concurrent LRU of TerrainColumn contexts.
+//
+// Every Y-slice of a chunk column needs the same 2D terrain fields. The first caller for a
+// (config, cx, cz) key builds the column; callers arriving while it is being built wait for
+// that result instead of evaluating the noise again (generateWorld() hands the slices of one
+// column to neighbouring threads at the same moment). The cache is split into SHARDS
+// independently locked LRU lists, so worker threads rarely contend.
+//
+// Columns are immutable once built and handed out as shared_ptr, so eviction never
+// invalidates a column a generator is still reading.
+// ---------------------------------------------------------------------------
+class TerrainColumnCache {
+public:
+    static constexpr size_t SHARDS           = 16;
+    static constexpr size_t DEFAULT_CAPACITY = 1024; // columns (~3 KB each)
+
+    using ColumnPtr = std::shared_ptr<const TerrainColumn>;
+
+    struct Stats {
+        uint64_t hits     = 0;
+        uint64_t misses   = 0; // columns built
+        uint64_t waits    = 0; // hits that waited for a column still being built
+        size_t   resident = 0;
+    };
+
+    explicit TerrainColumnCache(size_t capacity = DEFAULT_CAPACITY);
+    TerrainColumnCache(const TerrainColumnCache&) = delete;
+    TerrainColumnCache& operator=(const TerrainColumnCache&) = delete;
+
+    // Process-wide instance used by Chunk::fillTerrain() and ColumnHeightmap.
+    static TerrainColumnCache& shared();
+
+    // `configHash` must be hashTerrainConfig(config); callers that look up many columns of
+    // one config compute it once.
+    ColumnPtr get(const TerrainConfig& config, uint64_t configHash, int cx, int cz);
+    ColumnPtr get(const TerrainConfig& config, int cx, int cz) {
+        return get(config, hashTerrainConfig(config), cx, cz);
+    }
+
+    void  clear();
+    Stats getStats() const;
+
+private:
+    struct Key {
+        uint64_t configHash;
+        int      cx, cz;
+        bool operator==(const Key& o) const { return configHash == o.configHash && cx == o.cx && cz == o.cz; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const noexcept {
+            uint64_t h = k.configHash;
+            h ^= static_cast<uint32_t>(k.cx) * 0x9E3779B97F4A7C15ull;
+            h ^= static_cast<uint32_t>(k.cz) * 0xC2B2AE3D27D4EB4Full;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+    struct Entry {
+        std::shared_future<ColumnPtr> column;
+        std::list<Key>::iterator      lruIt;
+    };
+    struct Shard {
+        mutable std::mutex                     mutex;
+        std::list<Key>                         lru; // most recent first
+        std::unordered_map<Key, Entry, KeyHash> map;
+    };
+
+    size_t                      m_shardCapacity;
+    std::array<Shard, SHARDS>   m_shards;
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_waits{0};
+};
+
+} // namespace world
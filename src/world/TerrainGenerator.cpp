@@ -0,0 +1,158 @@
+#include "world/TerrainGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace world {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t elapsedNs(Clock::time_point from, Clock::time_point to) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+} // namespace
+
+std::atomic<uint64_t> TerrainGenerator::s_columns{0};
+std::atomic<uint64_t> TerrainGenerator::s_chunks{0};
+std::atomic<uint64_t> TerrainGenerator::s_contexts{0};
+std::atomic<uint64_t> TerrainGenerator::s_stageNs[GEN_STAGE_COUNT]{};
+
+TerrainGenerator::TerrainGenerator(const TerrainConfig& config, uint64_t configHash)
+    : m_config(config)
+    , m_configHash(configHash)
+    , m_layers(config)
+    , m_stages(buildChunkStages(config))
+    , m_voxels(std::make_unique<VoxelData[]>(CHUNK_VOLUME))
+{
+    s_contexts.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+thread_local std::unique_ptr<TerrainGenerator> tl_generator;
+} // namespace
+
+TerrainGenerator& TerrainGenerator::forThread(const TerrainConfig& config, uint64_t configHash) {
+    if (!tl_generator) {
+        tl_generator = std::make_unique<TerrainGenerator>(config, configHash);
+    } else if (tl_generator->m_configHash != configHash) {
+        tl_generator->configure(config, configHash);
+    }
+    return *tl_generator;
+}
+
+void TerrainGenerator::configure(const TerrainConfig& config, uint64_t configHash) {
+    m_config     = config;
+    m_configHash = configHash;
+    m_layers     = TerrainNoiseLayers(config);
+    m_stages     = buildChunkStages(config);
+    s_contexts.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// buildColumn — NOISE (STEP grid) then INTERPOLATE (full resolution + biome classes)
+// ---------------------------------------------------------------------------
+void TerrainGenerator::buildColumn(int cx, int cz, TerrainColumn& out) {
+    const auto t0 = Clock::now();
+    sampleTerrainColumn(m_config, m_layers, cx, cz, m_samples);
+    const auto t1 = Clock::now();
+
+    out.minSample = out.maxSample = m_samples.height[0][0];
+    for (int sz = 0; sz < ColumnSamples::SAMPLES; ++sz)
+        for (int sx = 0; sx < ColumnSamples::SAMPLES; ++sx) {
+            out.minSample = std::min(out.minSample, m_samples.height[sz][sx]);
+            out.maxSample = std::max(out.maxSample, m_samples.height[sz][sx]);
+        }
+
+    // Rivers only shape the height (already folded into samples.height), so the river field
+    // is not interpolated.
+    interpolateColumnField(m_samples.height,   m_heightmap);
+    interpolateColumnField(m_samples.erosion,  m_erodemap);
+    interpolateColumnField(m_samples.moisture, m_moistmap);
+
+    out.minHeight = out.maxHeight = (int)m_heightmap[0][0];
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            const int   terrainH = (int)m_heightmap[z][x];
+            const float erode01  = m_erodemap[z][x];    // [0,1]: 0=flat plain, 1=sharp mountain
+            const float moist    = m_moistmap[z][x];    // [-1,1]: -1=dry, +1=wet
+
+            // ---------------------------------------------------------------
+            // Biome flags  (in priority order)
+            // ---------------------------------------------------------------
+
+            // Rocky cliff: very high erosion → bare stone face, grass cannot grip
+            const bool isRockyCliff = (erode01 > m_config.stoneErosionThresh);
+
+            // Desert: dry moisture AND not too high (low-elevation sandy zone)
+            const bool isDesert = (moist < m_config.desertMoistureThresh)
+                               && (terrainH < m_config.seaLevel + 50);
+
+            // Beach: within sandMargin blocks of sea level
+            const bool isBeach = (terrainH <= m_config.seaLevel + m_config.sandMargin);
+
+            // Snow cap: surface is above snowHeight
+            const bool isSnowCap = (terrainH > m_config.snowHeight);
+
+            SurfaceKind kind = SurfaceKind::GRASS;
+            if      (isSnowCap)           kind = SurfaceKind::SNOW;
+            else if (isRockyCliff)        kind = SurfaceKind::ROCK;
+            else if (isDesert || isBeach) kind = SurfaceKind::SAND;
+
+            out.height [z][x] = static_cast<int16_t>(std::clamp(terrainH, INT16_MIN + 1, INT16_MAX));
+            out.surface[z][x] = kind;
+            out.minHeight = std::min(out.minHeight, terrainH);
+            out.maxHeight = std::max(out.maxHeight, terrainH);
+        }
+    }
+
+    const auto t2 = Clock::now();
+    s_columns.fetch_add(1, std::memory_order_relaxed);
+    s_stageNs[static_cast<size_t>(Stage::NOISE)]      .fetch_add(elapsedNs(t0, t1), std::memory_order_relaxed);
+    s_stageNs[static_cast<size_t>(Stage::INTERPOLATE)].fetch_add(elapsedNs(t1, t2), std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// runChunkStages — SURFACE → CARVE → DECORATE (whichever the config enabled)
+// ---------------------------------------------------------------------------
+void TerrainGenerator::runChunkStages(ChunkGenContext& ctx) {
+    m_late.clear();
+    ctx.configHash = m_configHash;
+    ctx.late       = &m_late;
+
+    auto t0 = Clock::now();
+    for (const auto& stage : m_stages) {
+        stage->run(ctx);
+        const auto t1 = Clock::now();
+        s_stageNs[static_cast<size_t>(stage->stage())].fetch_add(elapsedNs(t0, t1), std::memory_order_relaxed);
+        t0 = t1;
+    }
+    s_chunks.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<DecorationDelivery> TerrainGenerator::takeLateDecorations() {
+    if (!tl_generator) return {};
+    return std::exchange(tl_generator->m_late, {});
+}
+
+// ---------------------------------------------------------------------------
+// Stats
+// ---------------------------------------------------------------------------
+void TerrainGenerator::recordStage(Stage stage, uint64_t ns) {
+    s_stageNs[static_cast<size_t>(stage)].fetch_add(ns, std::memory_order_relaxed);
+}
+
+TerrainGenerator::Stats TerrainGenerator::getStats() {
+    Stats s;
+    s.columns  = s_columns.load(std::memory_order_relaxed);
+    s.chunks   = s_chunks.load(std::memory_order_relaxed);
+    s.contexts = s_contexts.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < GEN_STAGE_COUNT; ++i) {
+        s.stageNs[i] = s_stageNs[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+} // namespace world
@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "world/TerrainNoise.hpp"
+#include "world/GenerationStages.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// TerrainGenerator — per-thread terrain generation context for one TerrainConfig.
+//
+// Owns the pre-configured 2D noise layers, the chunk stages of the pipeline (see
+// GenerationStages.hpp) and every scratch buffer generation needs (sample grid, interpolated
+// fields, the flat voxel volume fillTerrain() encodes from), so a GENERATE task allocates
+// and configures nothing. forThread() hands out the calling thread's instance and
+// reconfigures it only when the config hash changes (ImGui "Regenerate"); scratch memory is
+// kept across reconfigurations.
+//
+// Every pipeline stage is timed separately; the totals are accumulated process-wide for the
+// metrics log and the ImGui performance panel.
+// ---------------------------------------------------------------------------
+class TerrainGenerator {
+public:
+    using Stage = GenStage;
+
+    struct Stats {
+        uint64_t columns  = 0; // TerrainColumns built (COLUMN-scope stages)
+        uint64_t chunks   = 0; // chunks through the CHUNK-scope stages, uniform ones included
+        uint64_t contexts = 0; // generator (re)configurations across all threads
+        uint64_t stageNs[GEN_STAGE_COUNT]{};
+
+        // Per item of the stage's own scope: µs per column or per chunk.
+        double usPerItem(Stage s) const {
+            return perItemUs(s, stageScope(s) == StageScope::COLUMN ? columns : chunks);
+        }
+        // Amortized over generated chunks: column stages shrink as Y-slices share a column.
+        double usPerChunk(Stage s) const { return perItemUs(s, chunks); }
+        double totalUsPerChunk() const {
+            double us = 0.0;
+            for (size_t i = 0; i < GEN_STAGE_COUNT; ++i) us += usPerChunk(static_cast<Stage>(i));
+            return us;
+        }
+
+        Stats operator-(const Stats& o) const {
+            Stats d;
+            d.columns  = columns  - o.columns;
+            d.chunks   = chunks   - o.chunks;
+            d.contexts = contexts - o.contexts;
+            for (size_t i = 0; i < GEN_STAGE_COUNT; ++i) d.stageNs[i] = stageNs[i] - o.stageNs[i];
+            return d;
+        }
+
+    private:
+        double perItemUs(Stage s, uint64_t n) const {
+            return n ? static_cast<double>(stageNs[static_cast<size_t>(s)]) / 1000.0 / static_cast<double>(n) : 0.0;
+        }
+    };
+
+    TerrainGenerator(const TerrainConfig& config, uint64_t configHash);
+    TerrainGenerator(const TerrainGenerator&) = delete;
+    TerrainGenerator& operator=(const TerrainGenerator&) = delete;
+
+    // The calling thread's generator, switched to `config` if it was built for another one.
+    // `configHash` must be hashTerrainConfig(config).
+    static TerrainGenerator& forThread(const TerrainConfig& config, uint64_t configHash);
+    static TerrainGenerator& forThread(const TerrainConfig& config) {
+        return forThread(config, hashTerrainConfig(config));
+    }
+
+    const TerrainConfig& getConfig()     const { return m_config; }
+    uint64_t             getConfigHash() const { return m_configHash; }
+
+    // Samples, interpolates and classifies chunk column (cx, cz).
+    void buildColumn(int cx, int cz, TerrainColumn& out);
+
+    // Runs the chunk stages on `ctx` in order, timing each; counts one chunk.
+    void runChunkStages(ChunkGenContext& ctx);
+
+    // Structure writes the calling thread's last runChunkStages() spilled into chunks that may
+    // already have generated (see DecorationQueue). The caller applies them on the main thread
+    // to the targets that are resident.
+    static std::vector<DecorationDelivery> takeLateDecorations();
+
+    // CHUNK_VOLUME voxels of scratch for Chunk::fillTerrain() (idx() order).
+    VoxelData* voxelScratch() { return m_voxels.get(); }
+
+    // Adds `ns` to a stage counter (stages timed outside the generator, i.e. ENCODE).
+    static void recordStage(Stage stage, uint64_t ns);
+    static Stats getStats();
+
+private:
+    void configure(const TerrainConfig& config, uint64_t configHash);
+
+    TerrainConfig      m_config;
+    uint64_t           m_configHash = 0;
+    TerrainNoiseLayers m_layers;
+    std::vector<std::unique_ptr<ChunkStage>> m_stages;
+    std::vector<DecorationDelivery>          m_late;
+
+    ColumnSamples m_samples;
+    float         m_heightmap[CHUNK_SIZE][CHUNK_SIZE];
+    float         m_erodemap [CHUNK_SIZE][CHUNK_SIZE];
+    float         m_moistmap [CHUNK_SIZE][CHUNK_SIZE];
+    std::unique_ptr<VoxelData[]> m_voxels;
+
+    static std::atomic<uint64_t> s_columns;
+    static std::atomic<uint64_t> s_chunks;
+    static std::atomic<uint64_t> s_contexts;
+    static std::atomic<uint64_t> s_stageNs[GEN_STAGE_COUNT];
+};
+
+} // namespace world
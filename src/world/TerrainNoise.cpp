@@ -0,0 +1,178 @@
+#include "world/TerrainNoise.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// Island Generation Helpers
+// ---------------------------------------------------------------------------
+
+// Smooth hermite blend (C1 continuity): 0 at t=0, 1 at t=1
+static inline float smoothstep01(float t) {
+    t = std::clamp(t, 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+// Returns [0,1]: 1.0 = centre of island, 0.0 = ocean edge.
+// `warp` is the low-frequency mask noise at (wx, wz), so the coastline is organic/ragged.
+static float computeIslandMask(float wx, float wz, float warp, const TerrainConfig& cfg) {
+    const float rBlks = static_cast<float>(cfg.worldRadiusBlks);
+    // Normalised distance from world centre: 0 at centre, 1 at edge
+    float nx   = wx / rBlks;
+    float nz   = wz / rBlks;
+    float dist = std::sqrt(nx * nx + nz * nz);
+
+    // Low-frequency warp makes the shoreline non-circular
+    float raggedDist = dist - warp * cfg.islandEdgeNoise;
+
+    // Smooth falloff: full land inside falloff, ocean beyond 1.1
+    float t = (raggedDist - cfg.islandFalloff) / (1.1f - cfg.islandFalloff);
+    return 1.0f - smoothstep01(t);
+}
+
+// ---------------------------------------------------------------------------
+// TerrainNoiseLayers
+// ---------------------------------------------------------------------------
+TerrainNoiseLayers::TerrainNoiseLayers(const TerrainConfig& config)
+    : terrain (config.seed,     config.frequency, config.octaves)
+    , mask    (config.seed + 1, 0.003f)
+    , erosion (config.seed + 2, 0.006f, 4) // large-scale mountain/plain zones
+    , river   (config.seed + 3, 0.004f, 3)
+    , moisture(config.seed + 4, 0.005f)
+{
+}
+
+// ---------------------------------------------------------------------------
+// sampleTerrainColumn — island + erosion + rivers + moisture on the STEP grid
+// ---------------------------------------------------------------------------
+void sampleTerrainColumn(const TerrainConfig& config, const TerrainNoiseLayers& layers,
+                         int cx, int cz, ColumnSamples& out)
+{
+    // ---- World-space origins of this column -------------------------------
+    const int worldBaseX = cx * CHUNK_SIZE;
+    const int worldBaseZ = cz * CHUNK_SIZE;
+
+    // ---- Sample all noise layers at low-res grid (STEP=4, SAMPLES=9) -------
+    constexpr int STEP    = ColumnSamples::STEP;
+    constexpr int SAMPLES = ColumnSamples::SAMPLES;
+    constexpr int COUNT   = SAMPLES * SAMPLES;
+
+    // Sample coordinates, row-major [sz][sx]: world space for mask / moisture, worldScale'd
+    // for terrain / erosion / rivers. Each layer is then evaluated as one batch.
+    float wx[COUNT], wz[COUNT], qx[COUNT], qz[COUNT];
+    for (int sz = 0; sz < SAMPLES; ++sz) {
+        for (int sx = 0; sx < SAMPLES; ++sx) {
+            const int i = sz * SAMPLES + sx;
+            wx[i] = (float)(worldBaseX + sx * STEP);
+            wz[i] = (float)(worldBaseZ + sz * STEP);
+            qx[i] = wx[i] / config.worldScale;
+            qz[i] = wz[i] / config.worldScale;
+        }
+    }
+
+    float terrN[COUNT], warp[COUNT], erosionN[COUNT], riverN[COUNT], moistN[COUNT];
+    layers.terrain .sample(qx, qz, terrN,    COUNT); // [-1, 1]
+    layers.mask    .sample(wx, wz, warp,     COUNT); // freq ≈ 0.003
+    layers.erosion .sample(qx, qz, erosionN, COUNT);
+    layers.river   .sample(qx, qz, riverN,   COUNT);
+    layers.moisture.sample(wx, wz, moistN,   COUNT); // [-1, 1]
+
+    const float riverFloor = (float)(config.seaLevel - config.riverDepth);
+    const float rWidth     = std::max(config.riverWidth, 0.005f);
+    const float oceanFloor = (float)(config.seaLevel - 20);
+
+    for (int sz = 0; sz < SAMPLES; ++sz) {
+        for (int sx = 0; sx < SAMPLES; ++sx) {
+            const int i = sz * SAMPLES + sx;
+
+            // Island mask [0,1] — 1=island interior, 0=open ocean
+            const float mask   = computeIslandMask(wx[i], wz[i], warp[i], config);
+
+            // Erosion [0,1]: capped at island edges so coast is always flat
+            const float rawE   = (erosionN[i] + 1.0f) * 0.5f;
+            const float erode  = rawE * smoothstep01(mask * 1.6f);
+
+            // --- Height formula ---
+            // Plains contribution: gentle hills (40% amplitude)
+            const float plainH = (float)config.baseHeight + terrN[i] * config.amplitude * 0.40f;
+
+            // Mountain contribution: squared noise → sharp peaks
+            // absN²*2.2 reaches ~2.2 at |terrN|=1; subtract 0.25 to keep low
+            // areas from also rising
+            const float absN   = std::abs(terrN[i]);
+            const float mountH = (float)config.baseHeight
+                                 + (absN * absN * 2.2f - 0.25f)
+                                 * config.amplitude * config.mountainStrength;
+
+            // Blend plains↔mountains by erosion
+            const float blendH = plainH + (mountH - plainH) * erode;
+
+            // Apply island mask → lerp toward ocean floor at edges
+            float finalH = oceanFloor + (blendH - oceanFloor) * mask;
+
+            // --- River carving ---
+            // Ridged: |riverNoise| is small near river centrelines
+            const float rn     = std::abs(riverN[i]);
+            float rAmt         = std::max(0.0f, 1.0f - rn / rWidth); // 0→1
+            rAmt               = rAmt * rAmt; // sharpen profile
+            // Only carve rivers where island exists (not in city ocean zone)
+            const float coastBlend = std::clamp((mask - 0.25f) / 0.35f, 0.0f, 1.0f);
+            rAmt                  *= coastBlend;
+            // Pull height toward river floor
+            finalH = finalH + (riverFloor - finalH) * rAmt;
+
+            out.height  [sz][sx] = finalH;
+            out.erosion [sz][sx] = erode;
+            out.river   [sz][sx] = rAmt;
+            out.moisture[sz][sx] = moistN[i];
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// interpolateColumnField
+// ---------------------------------------------------------------------------
+void interpolateColumnField(const float (&samples)[ColumnSamples::SAMPLES][ColumnSamples::SAMPLES],
+                            float (&out)[CHUNK_SIZE][CHUNK_SIZE])
+{
+    constexpr int STEP    = ColumnSamples::STEP;
+    constexpr int SAMPLES = ColumnSamples::SAMPLES;
+    static_assert((SAMPLES - 1) * STEP == CHUNK_SIZE, "sample grid must cover the chunk exactly");
+
+#if defined(__GNUC__)
+    // One output row segment between two samples is exactly one 4-lane vector.
+    static_assert(STEP == 4, "X lerp below is one 4-wide vector per sample cell");
+    typedef float Vec4 __attribute__((vector_size(16)));
+    const Vec4 tx = {0.0f / STEP, 1.0f / STEP, 2.0f / STEP, 3.0f / STEP};
+#endif
+
+    for (int sz = 0; sz < SAMPLES - 1; ++sz) {
+        for (int dz = 0; dz < STEP; ++dz) {
+            const int   gz = sz * STEP + dz;
+            const float tz = (float)dz / STEP;
+
+            // Lerp along Z once per sample column, then X between neighbouring columns
+            float f[SAMPLES];
+            for (int sx = 0; sx < SAMPLES; ++sx) {
+                f[sx] = samples[sz][sx] + (samples[sz+1][sx] - samples[sz][sx]) * tz;
+            }
+
+            for (int sx = 0; sx < SAMPLES - 1; ++sx) {
+                const float f0 = f[sx], f1 = f[sx + 1];
+#if defined(__GNUC__)
+                const Vec4 row = f0 + (f1 - f0) * tx;
+                std::memcpy(&out[gz][sx * STEP], &row, sizeof(row));
+#else
+                for (int dx = 0; dx < STEP; ++dx) {
+                    const float tx = (float)dx / STEP;
+                    out[gz][sx * STEP + dx] = f0 + (f1 - f0) * tx;
+                }
+#endif
+            }
+        }
+    }
+}
+
+} // namespace world
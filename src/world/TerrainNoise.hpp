@@ -0,0 +1,63 @@
+#pragma once
+#include "world/Chunk.hpp"
+#include "world/BatchNoise.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// TerrainNoise — the 2D noise stack behind Chunk::fillTerrain().
+//
+// Every terrain field depends on (x, z) only, so it is sampled once per chunk column on a
+// STEP-spaced grid (SAMPLES × SAMPLES, one sample past the far edge) and bilinearly
+// interpolated to full resolution. fillTerrain() and ColumnHeightmap both go through these
+// functions (via TerrainGenerator), so the heights they see are bit-identical.
+// ---------------------------------------------------------------------------
+
+// The five pre-configured noise layers of one TerrainConfig.
+struct TerrainNoiseLayers {
+    explicit TerrainNoiseLayers(const TerrainConfig& config);
+
+    BatchNoise2D terrain;  // base terrain (FBm)
+    BatchNoise2D mask;     // island mask warp (very low frequency)
+    BatchNoise2D erosion;  // flat plains vs sharp mountains
+    BatchNoise2D river;    // river carving (ridged: trench where |n| < riverWidth)
+    BatchNoise2D moisture; // desert (dry) vs forest/plains (wet)
+};
+
+struct ColumnSamples {
+    static constexpr int STEP    = 4;
+    static constexpr int SAMPLES = CHUNK_SIZE / STEP + 1; // 9×9 sample grid
+
+    float height  [SAMPLES][SAMPLES]; // final terrain height (blocks)
+    float erosion [SAMPLES][SAMPLES]; // [0,1]:  0=plain, 1=mountain
+    float river   [SAMPLES][SAMPLES]; // [0,1]:  1=deepest trench
+    float moisture[SAMPLES][SAMPLES]; // [-1,1]: -1=desert, +1=tropical
+};
+
+// Samples every field for chunk column (cx, cz). `layers` must be built from `config`.
+void sampleTerrainColumn(const TerrainConfig& config, const TerrainNoiseLayers& layers,
+                         int cx, int cz, ColumnSamples& out);
+
+// Bilinear upsampling of one sampled field to CHUNK_SIZE × CHUNK_SIZE ([z][x]).
+void interpolateColumnField(const float (&samples)[ColumnSamples::SAMPLES][ColumnSamples::SAMPLES],
+                            float (&out)[CHUNK_SIZE][CHUNK_SIZE]);
+
+// Surface layering class of one block column, in fillTerrain()'s priority order.
+enum class SurfaceKind : uint8_t {
+    GRASS = 0, // grass -> dirt -> stone (plains and grassy slopes)
+    ROCK  = 1, // bare stone cliff (high erosion)
+    SAND  = 2, // desert / beach: sand -> stone
+    SNOW  = 3, // snow cap: snow -> stone
+};
+
+// Everything fillTerrain() needs from the 2D fields of one chunk column, computed once
+// (TerrainGenerator::buildColumn) and shared by every Y-slice of that column (see
+// TerrainColumnCache).
+struct TerrainColumn {
+    float minSample = 0.0f, maxSample = 0.0f; // STEP-grid height extremes (uniform early-out)
+    int   minHeight = 0,    maxHeight = 0;    // exact terrainH extremes
+    int16_t     height [CHUNK_SIZE][CHUNK_SIZE]; // terrainH: blocks below it are solid ([z][x])
+    SurfaceKind surface[CHUNK_SIZE][CHUNK_SIZE];
+};
+
+} // namespace world
@@ -2,7 +2,6 @@
 
 #include <cstdint>
 #include <array>
-#include <vulkan/vulkan.h>
 
 namespace world {
 
@@ -62,8 +61,16 @@ struct VoxelData {
     [[nodiscard]] constexpr bool isSolid()       const { return (getFlags() & VOXEL_FLAG_SOLID)       != 0; }
     [[nodiscard]] constexpr bool isTransparent() const { return (getFlags() & VOXEL_FLAG_TRANSPARENT) != 0; }
     [[nodiscard]] constexpr bool isEmissive()    const { return (getFlags() & VOXEL_FLAG_EMISSIVE)    != 0; }
+    [[nodiscard]] constexpr bool isLiquid()      const { return (getFlags() & VOXEL_FLAG_LIQUID)      != 0; }
     [[nodiscard]] constexpr bool isAir()         const { return raw == 0; }
 
+    // Mesh classes. Opaque voxels go to the opaque mesh and hide faces behind them; translucent
+    // ones (liquid / transparent, SOLID or not) go to the liquid mesh, which only shows surfaces
+    // towards cells that are neither (isOccupied() == false).
+    [[nodiscard]] constexpr bool isTranslucent() const { return (getFlags() & (VOXEL_FLAG_LIQUID | VOXEL_FLAG_TRANSPARENT)) != 0; }
+    [[nodiscard]] constexpr bool isOpaque()      const { return isSolid() && !isTranslucent(); }
+    [[nodiscard]] constexpr bool isOccupied()    const { return isOpaque() || isTranslucent(); }
+
     constexpr bool operator==(const VoxelData& o) const { return raw == o.raw; }
     constexpr bool operator!=(const VoxelData& o) const { return raw != o.raw; }
 };
@@ -72,60 +79,65 @@ struct VoxelData {
 inline constexpr VoxelData VOXEL_AIR = VoxelData{0u};
 
 // ---------------------------------------------------------------------------
-// VoxelVertex — compressed vertex for the voxel pipeline
+// VoxelQuad — one greedy quad, 8 bytes, pulled by voxel.vert (no vertex buffer)
+//
+// The vertex shader reads it through a buffer device address (per-chunk, instance SSBO)
+// and expands it into 4 corners: quad = gl_VertexIndex / 4, corner = gl_VertexIndex % 4.
 //
-// Total size: 8 bytes (4-byte aligned via uint16_t tail)
+// geometry (LSB → MSB):
+//   [ 5: 0] x, [11: 6] y, [17:12] z  — min corner, local chunk coords (0-32)
+//   [22:18] w - 1, [27:23] h - 1     — extent along the face's u / v axis (1-32 blocks)
+//   [30:28] faceID                   — 0=+X, 1=-X, 2=+Y, 3=-Y, 4=+Z, 5=-Z
+//   [31]    flip                     — AO diagonal flip (split along corners 1-3)
+// surface:
+//   [11: 0] paletteIdx               — block palette index (0-4095)
+//   [19:12] ao                       — 2 bits per corner c0..c3 (0-3)
+//   [31:20] reserved                 — future: light level
 //
-// Layout:
-//   byte 0   x          — local X in chunk (0-31)
-//   byte 1   y          — local Y in chunk (0-31)
-//   byte 2   z          — local Z in chunk (0-31)
-//   byte 3   faceID     — 0=+X, 1=-X, 2=+Y, 3=-Y, 4=+Z, 5=-Z
-//   byte 4   ao         — ambient occlusion level (0-3)
-//   byte 5   reserved   — future: light level
-//   bytes 6-7 paletteIdx — block palette index (0-4095)
+// Axes of face direction d = faceID / 2: u = (d + 1) % 3, v = (d + 2) % 3. Corners:
+// c0 = min, c1 = +w·u, c2 = +w·u +h·v, c3 = +h·v. Emission order: c0..c3 for +faces,
+// c3..c0 for -faces (CCW front), rotated by one when flipped — the triangles are then
+// (0,1,2)(0,2,3) of that order (k_quadIndices).
 // ---------------------------------------------------------------------------
-#pragma pack(push, 1)
-struct VoxelVertex {
-    uint8_t  x;
-    uint8_t  y;
-    uint8_t  z;
-    uint8_t  faceID;
-    uint8_t  ao;
-    uint8_t  reserved;
-    uint16_t paletteIdx;
-
-    // Vulkan vertex input binding description
-    static VkVertexInputBindingDescription getBindingDescription() {
-        VkVertexInputBindingDescription b{};
-        b.binding   = 0;
-        b.stride    = sizeof(VoxelVertex); // 8 bytes
-        b.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-        return b;
-    }
-
-    // Vulkan vertex attribute descriptions
-    // location 0: x,y,z,faceID  → VK_FORMAT_R8G8B8A8_UINT
-    // location 1: ao,reserved,paletteIdx lo,paletteIdx hi → VK_FORMAT_R8G8B8A8_UINT
-    static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() {
-        std::array<VkVertexInputAttributeDescription, 2> attrs{};
-
-        attrs[0].binding  = 0;
-        attrs[0].location = 0;
-        attrs[0].format   = VK_FORMAT_R8G8B8A8_UINT;
-        attrs[0].offset   = 0; // x at byte 0
-
-        attrs[1].binding  = 0;
-        attrs[1].location = 1;
-        attrs[1].format   = VK_FORMAT_R8G8B8A8_UINT;
-        attrs[1].offset   = 4; // ao at byte 4
+struct VoxelQuad {
+    uint32_t geometry;
+    uint32_t surface;
 
-        return attrs;
+    static constexpr VoxelQuad make(int x, int y, int z, int w, int h, uint8_t faceID, bool flip,
+                                    uint16_t paletteIdx, const uint8_t (&ao)[4])
+    {
+        VoxelQuad q{};
+        q.geometry = static_cast<uint32_t>(x & 63) | static_cast<uint32_t>(y & 63) << 6 |
+                     static_cast<uint32_t>(z & 63) << 12 |
+                     static_cast<uint32_t>((w - 1) & 31) << 18 | static_cast<uint32_t>((h - 1) & 31) << 23 |
+                     static_cast<uint32_t>(faceID & 7) << 28 | (flip ? 1u << 31 : 0u);
+        q.surface  = static_cast<uint32_t>(paletteIdx & 0xFFFu) |
+                     static_cast<uint32_t>(ao[0] & 3u) << 12 | static_cast<uint32_t>(ao[1] & 3u) << 14 |
+                     static_cast<uint32_t>(ao[2] & 3u) << 16 | static_cast<uint32_t>(ao[3] & 3u) << 18;
+        return q;
     }
+
+    [[nodiscard]] constexpr int      getX()          const { return static_cast<int>(geometry & 63u); }
+    [[nodiscard]] constexpr int      getY()          const { return static_cast<int>((geometry >> 6) & 63u); }
+    [[nodiscard]] constexpr int      getZ()          const { return static_cast<int>((geometry >> 12) & 63u); }
+    [[nodiscard]] constexpr int      getWidth()      const { return static_cast<int>((geometry >> 18) & 31u) + 1; }
+    [[nodiscard]] constexpr int      getHeight()     const { return static_cast<int>((geometry >> 23) & 31u) + 1; }
+    [[nodiscard]] constexpr uint8_t  getFaceID()     const { return static_cast<uint8_t>((geometry >> 28) & 7u); }
+    [[nodiscard]] constexpr bool     isFlipped()     const { return (geometry >> 31) != 0; }
+    [[nodiscard]] constexpr uint16_t getPaletteIdx() const { return static_cast<uint16_t>(surface & 0xFFFu); }
+    [[nodiscard]] constexpr uint8_t  getAO(int corner) const { return static_cast<uint8_t>((surface >> (12 + 2 * corner)) & 3u); }
+
+    constexpr bool operator==(const VoxelQuad& o) const { return geometry == o.geometry && surface == o.surface; }
 };
-#pragma pack(pop)
 
-static_assert(sizeof(VoxelVertex) == 8, "VoxelVertex must be 8 bytes");
+static_assert(sizeof(VoxelQuad) == 8, "VoxelQuad must be 8 bytes");
+
+// ---------------------------------------------------------------------------
+// Quad index pattern — the shared index buffer repeats it for every quad (vertex
+// q*4 + k_quadIndices[i]), so each corner runs the vertex shader once.
+// GeometryManager::bindQuadIndices().
+// ---------------------------------------------------------------------------
+inline constexpr uint32_t k_quadIndices[6] = {0, 1, 2, 0, 2, 3};
 
 // ---------------------------------------------------------------------------
 // Face tables (indexed by faceID 0-5)
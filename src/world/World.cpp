@@ -40,14 +40,15 @@ void World::rebuildMeshes() {
             continue;
         }
 
-        // Upload via template method (VoxelVertex — 8 bytes)
+        // Upload via template method (VoxelQuad — 8 bytes per quad)
         gfx::GeometryManager::UploadRequest req;
-        gfx::Mesh* raw = m_geometryManager.allocateMeshRaw(static_cast<uint32_t>(data.vertices.size()), static_cast<uint32_t>(data.indices.size()), req, data.vertices, data.indices);
+        m_geometryManager.reserveQuadIndices(MAX_CHUNK_QUADS);
+        gfx::Mesh* raw = m_geometryManager.allocateQuadMesh(data.quadCount(), req, data.quads);
         m_geometryManager.executeBatchUpload({req});
         m_meshes.push_back(std::unique_ptr<gfx::Mesh>(raw));
 
-        m_totalVertices += static_cast<uint32_t>(data.vertices.size());
-        m_totalIndices  += static_cast<uint32_t>(data.indices.size());
+        m_totalVertices += data.quadCount() * 4;
+        m_totalIndices  += data.indexCount();
     }
 
     std::cout << "[World] Rebuilt " << m_chunks.size() << " chunk(s). "
@@ -56,8 +57,12 @@ void World::rebuildMeshes() {
 }
 
 void World::render(VkCommandBuffer cmd) {
+    // voxel.vert pulls the quads: the caller's instance SSBO must carry
+    // GeometryManager::getQuadAddress(mesh) — there is no vertex buffer to bind.
+    m_geometryManager.bindQuadIndices(cmd);
     for (const auto& mesh : m_meshes) {
-        if (mesh) mesh->draw(cmd);
+        if (!mesh) continue;
+        vkCmdDrawIndexed(cmd, mesh->getIndexCount(), 1, 0, 0, 0);
     }
 }
 
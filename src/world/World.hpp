@@ -10,7 +10,7 @@ namespace world {
 
 // Legacy World class — kept for backward compatibility.
 // New code should use ChunkManager instead.
-// This class now uses the updated Chunk API (32³, VoxelData, VoxelVertex).
+// This class now uses the updated Chunk API (32³, VoxelData, VoxelQuad).
 class World {
 public:
     explicit World(gfx::GeometryManager& geometryManager);
@@ -0,0 +1,211 @@
+#include "world/WorldBaker.hpp"
+#include "world/ChunkGrid.hpp"
+#include "world/ColumnHeightmap.hpp"
+#include "world/DecorationQueue.hpp"
+#include "world/RegionStore.hpp"
+#include "world/TerrainGenerator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace world {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t DECOR_MAGIC   = 0x43454450; // "PDEC" little-endian
+constexpr uint32_t DECOR_VERSION = 1;
+constexpr const char* DECOR_FILE = "decor.bin";
+
+// Host byte order, like the region files.
+template <typename T>
+void writePod(std::ofstream& f, const T& v) { f.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+template <typename T>
+bool readPod(std::ifstream& f, T& v) {
+    f.read(reinterpret_cast<char*>(&v), sizeof(v));
+    return static_cast<bool>(f);
+}
+
+// decor.bin: u32 magic, u32 version, u64 config hash, u32 count,
+//            count × { i32 tx ty tz sx sy sz, u32 n, n × { u16 index, u32 voxel } }
+bool writeDecorations(const std::string& directory, uint64_t configHash,
+                      const std::vector<DecorationQueue::Posted>& spills) {
+    std::ofstream f(std::filesystem::path(directory) / DECOR_FILE, std::ios::binary | std::ios::trunc);
+    if (!f) return false;
+    writePod(f, DECOR_MAGIC);
+    writePod(f, DECOR_VERSION);
+    writePod(f, configHash);
+    writePod(f, static_cast<uint32_t>(spills.size()));
+    for (const auto& s : spills) {
+        for (int32_t c : {s.tx, s.ty, s.tz, s.sx, s.sy, s.sz}) writePod(f, c);
+        writePod(f, static_cast<uint32_t>(s.writes.size()));
+        for (const DecorationWrite& w : s.writes) {
+            writePod(f, w.index);
+            writePod(f, w.voxel.raw);
+        }
+    }
+    return static_cast<bool>(f);
+}
+
+} // namespace
+
+std::string bakedWorldDirectory(const std::string& saveRoot, const TerrainConfig& config) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "baked_%016llx",
+                  static_cast<unsigned long long>(hashTerrainConfig(config)));
+    return (std::filesystem::path(saveRoot) / name).string();
+}
+
+BakeResult bakeWorld(const TerrainConfig& config, const BakeOptions& options) {
+    BakeResult result;
+    result.directory = bakedWorldDirectory(options.saveRoot, config);
+    const uint64_t configHash = hashTerrainConfig(config);
+    const uint32_t threadCount = options.threads ? options.threads
+                                                 : std::max(1u, std::thread::hardware_concurrency());
+    const int radius = std::max(options.radius, 0);
+
+    // A bake is a snapshot of one config: start from an empty directory.
+    std::error_code ec;
+    std::filesystem::remove_all(result.directory, ec);
+    RegionStore store;
+    if (!store.open(result.directory)) return result;
+
+    // Runs `fn(thread, index)` for every index in [0, count) on threadCount threads.
+    auto parallelFor = [threadCount](size_t count, auto&& fn) {
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (uint32_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) fn(t, i);
+            });
+        }
+        for (auto& th : threads) th.join();
+    };
+
+    // ---- Generate ----------------------------------------------------------
+    // Same chunk set as ChunkStorage::generateWorld(): every occupied Y-slice of each column.
+    DecorationQueue::shared().clear();
+    const auto t0 = Clock::now();
+    ColumnHeightmap heightmap;
+    heightmap.reset(config);
+    heightmap.fill(-radius - 1, radius + 1, -radius - 1, radius + 1, threadCount);
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    for (int cz = -radius; cz <= radius; ++cz) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            const auto [lo, hi] = heightmap.getChunkSpan(cx, cz);
+            for (int cy = std::max(lo, 0); cy <= hi; ++cy)
+                chunks.push_back(std::make_unique<Chunk>(cx, cy, cz));
+        }
+    }
+
+    std::vector<std::vector<DecorationDelivery>> late(threadCount);
+    parallelFor(chunks.size(), [&](uint32_t t, size_t i) {
+        chunks[i]->fillTerrain(config);
+        for (auto& d : TerrainGenerator::takeLateDecorations()) late[t].push_back(std::move(d));
+    });
+
+    ChunkGrid grid;
+    for (const auto& chunk : chunks) grid.insert(chunk->getCX(), chunk->getCY(), chunk->getCZ(), chunk.get());
+    for (const auto& perThread : late) {
+        for (const auto& d : perThread) {
+            if (Chunk* target = grid.find(d.cx, d.cy, d.cz)) target->applyDecoration(d.writes);
+        }
+    }
+    result.chunks     = chunks.size();
+    result.generateMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    // ---- Write -------------------------------------------------------------
+    // writeNow() encodes on the calling thread; only the file write itself is serialized.
+    const auto t1 = Clock::now();
+    std::atomic<size_t> failed{0};
+    parallelFor(chunks.size(), [&](uint32_t, size_t i) {
+        if (!store.writeNow(*chunks[i])) failed.fetch_add(1, std::memory_order_relaxed);
+    });
+    const std::vector<DecorationQueue::Posted> spills = DecorationQueue::shared().snapshot(configHash);
+    const bool decorOk = writeDecorations(result.directory, configHash, spills);
+    result.bytes = store.getStats().bytesWritten;
+    store.close();
+    result.writeMs     = std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+    result.decorSpills = spills.size();
+    result.peakRss     = peakResidentBytes();
+
+    DecorationQueue::shared().clear();
+    if (failed.load() > 0 || !decorOk) {
+        std::cerr << "[WorldBaker] Write failed for " << result.directory << " (" << failed.load()
+                  << " chunks" << (decorOk ? "" : ", decor.bin") << ")\n";
+        return result;
+    }
+    result.ok = true;
+    return result;
+}
+
+size_t loadBakedDecorations(const std::string& directory, uint64_t configHash) {
+    std::ifstream f(std::filesystem::path(directory) / DECOR_FILE, std::ios::binary);
+    if (!f) return 0;
+
+    uint32_t magic = 0, version = 0, count = 0;
+    uint64_t hash = 0;
+    if (!readPod(f, magic) || !readPod(f, version) || !readPod(f, hash) || !readPod(f, count)) return 0;
+    if (magic != DECOR_MAGIC || version != DECOR_VERSION || hash != configHash) return 0;
+
+    DecorationQueue& queue = DecorationQueue::shared();
+    std::vector<DecorationWrite> writes;
+    size_t loaded = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        int32_t c[6];
+        uint32_t n = 0;
+        for (int32_t& v : c) if (!readPod(f, v)) return loaded;
+        if (!readPod(f, n) || n > static_cast<uint32_t>(CHUNK_VOLUME)) return loaded;
+        writes.resize(n);
+        for (DecorationWrite& w : writes) {
+            if (!readPod(f, w.index) || !readPod(f, w.voxel.raw)) return loaded;
+        }
+        queue.post(configHash, c[0], c[1], c[2], c[3], c[4], c[5], writes, true);
+        ++loaded;
+    }
+    return loaded;
+}
+
+void adoptBakedChunk(Chunk& chunk, uint64_t configHash) {
+    thread_local std::vector<DecorationWrite> tl_writes;
+    tl_writes.clear();
+    DecorationQueue::shared().collect(configHash, chunk.getCX(), chunk.getCY(), chunk.getCZ(), tl_writes);
+    // Writes from the bake itself are already in the payload and leave it unchanged.
+    if (!tl_writes.empty()) chunk.applyDecoration(tl_writes);
+}
+
+size_t peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return static_cast<size_t>(counters.PeakWorkingSetSize);
+    return 0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return static_cast<size_t>(usage.ru_maxrss) * 1024; // KB
+    return 0;
+#endif
+}
+
+} // namespace world
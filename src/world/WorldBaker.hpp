@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "world/Chunk.hpp"
+
+namespace world {
+
+// ---------------------------------------------------------------------------
+// WorldBaker — offline pre-generation of a world ("baked" world).
+//
+// bakeWorld() generates every occupied chunk of a radius on all cores (same chunk set and
+// stages as ChunkStorage::generateWorld(), late tree writes included) and stores it in
+// <saveRoot>/baked_<config hash>/:
+//
+//   r.<rx>.<ry>.<rz>.region   RegionStore files, ChunkCodec payloads (same layout as edits)
+//   decor.bin                 DecorationQueue spills, so chunks generated around the baked
+//                             area still receive the tree voxels rooted inside it
+//
+// The engine opens that directory in ChunkStorage::generateWorld() when it exists for the
+// config and loads chunks from it instead of generating them (edits in world_<hash> still
+// take precedence). Baked chunks are not "modified": they are never written back.
+//
+// No window, no Vulkan: used by the worldbake tool (src/tools/WorldBake.cpp).
+// ---------------------------------------------------------------------------
+
+struct BakeOptions {
+    int         radius   = 10;      // chunk columns in [-radius, radius]²
+    uint32_t    threads  = 0;       // 0 = hardware_concurrency()
+    std::string saveRoot = "saves";
+};
+
+struct BakeResult {
+    bool        ok          = false;
+    std::string directory;
+    size_t      chunks      = 0;
+    size_t      decorSpills = 0;    // spills saved to decor.bin
+    double      generateMs  = 0.0;  // terrain stages + late tree writes
+    double      writeMs     = 0.0;  // encode + region files
+    uint64_t    bytes       = 0;    // encoded payload bytes
+    size_t      peakRss     = 0;    // process peak resident set, bytes
+
+    double mvoxPerSec() const {
+        return generateMs > 0.0 ? static_cast<double>(chunks) * CHUNK_VOLUME / (generateMs * 1e3) : 0.0;
+    }
+    double chunksPerSec() const {
+        const double ms = generateMs + writeMs;
+        return ms > 0.0 ? static_cast<double>(chunks) / (ms * 1e-3) : 0.0;
+    }
+};
+
+// <saveRoot>/baked_<hashTerrainConfig(config)>
+std::string bakedWorldDirectory(const std::string& saveRoot, const TerrainConfig& config);
+
+// Replaces any earlier bake of the same config. Progress and errors go to stdout / stderr.
+BakeResult bakeWorld(const TerrainConfig& config, const BakeOptions& options);
+
+// Posts the spills saved in <directory>/decor.bin to DecorationQueue::shared() as persistent
+// (their baked sources are never regenerated, so DecorationQueue::prune() must keep them).
+// Returns the number of spills read (0 if the file is missing or does not match configHash).
+size_t loadBakedDecorations(const std::string& directory, uint64_t configHash);
+
+// A chunk just loaded from a baked world: applies the writes already posted for it (later
+// spills into it reach it as late deliveries, like into any generated chunk).
+void adoptBakedChunk(Chunk& chunk, uint64_t configHash);
+
+// Peak resident set size of this process in bytes (0 if unavailable).
+size_t peakResidentBytes();
+
+} // namespace world
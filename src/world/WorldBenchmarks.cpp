@@ -0,0 +1,1060 @@
+#include "world/WorldBenchmarks.hpp"
+#include "world/ChunkGrid.hpp"
+#include "world/Chunk.hpp"
+#include "world/BatchNoise.hpp"
+#include "world/ColumnHeightmap.hpp"
+#include "world/TerrainColumnCache.hpp"
+#include "world/TerrainGenerator.hpp"
+#include "world/DecorationQueue.hpp"
+#include "world/ChunkManager.hpp"
+#include "world/ChunkMeshSink.hpp"
+#include "scene/Frustum.hpp"
+#include "core/Math.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstring>
+
+namespace world::bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Small deterministic RNG so both containers see identical query streams.
+struct XorShift {
+    uint64_t s;
+    explicit XorShift(uint64_t seed) : s(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+    uint32_t next() {
+        s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+        return static_cast<uint32_t>(s >> 32);
+    }
+    int range(int lo, int hi) { return lo + static_cast<int>(next() % static_cast<uint32_t>(hi - lo + 1)); }
+};
+
+struct Coord { int x, y, z; };
+
+// The pre-paging ChunkStorage layout: one pointer per cell of the world AABB, rejected outside it.
+struct DenseGrid {
+    int minX = 0, maxX = 0, minY = 0, maxY = 0, minZ = 0, maxZ = 0;
+    int width = 0, height = 0;
+    std::vector<Chunk*> cells;
+
+    void init(int radius, int h) {
+        minX = minZ = -radius; maxX = maxZ = radius;
+        minY = 0; maxY = h - 1;
+        width = maxX - minX + 1; height = h;
+        cells.assign(static_cast<size_t>(width) * height * width, nullptr);
+    }
+    size_t index(int cx, int cy, int cz) const {
+        if (cx < minX || cx > maxX || cy < minY || cy > maxY || cz < minZ || cz > maxZ)
+            return static_cast<size_t>(-1);
+        return static_cast<size_t>((cx - minX) + (cy - minY) * width + (cz - minZ) * width * height);
+    }
+    Chunk* find(int cx, int cy, int cz) const {
+        const size_t i = index(cx, cy, cz);
+        return i == static_cast<size_t>(-1) ? nullptr : cells[i];
+    }
+};
+
+// Best-of-N wall time for one pass over `queries`; the checksum keeps lookups observable.
+template <typename Grid>
+double timeLookups(const Grid& grid, const std::vector<Coord>& queries, uintptr_t& checksum) {
+    constexpr int REPEATS = 5;
+    double best = 1e30;
+    for (int r = 0; r < REPEATS; ++r) {
+        uintptr_t sum = 0;
+        const auto t0 = Clock::now();
+        for (const Coord& q : queries) {
+            sum += reinterpret_cast<uintptr_t>(grid.find(q.x, q.y, q.z));
+        }
+        const auto t1 = Clock::now();
+        checksum ^= sum;
+        best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+    return best;
+}
+
+} // namespace
+
+void runChunkGridBenchmark(int radius, int height) {
+    std::cout << "[Bench] ChunkGrid: radius " << radius << " chunks, " << height << " Y-slices\n";
+
+    // Occupied span per column mimics generateWorld(): a few consecutive Y slices.
+    const int side = radius * 2 + 1;
+    std::vector<Coord> occupied;
+    occupied.reserve(static_cast<size_t>(side) * side * 4);
+    XorShift rng(42);
+    for (int cz = -radius; cz <= radius; ++cz) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            const int lo = rng.range(0, std::max(0, height / 2 - 1));
+            const int hi = std::min(height - 1, lo + rng.range(2, 4));
+            for (int cy = lo; cy <= hi; ++cy) occupied.push_back({cx, cy, cz});
+        }
+    }
+    std::unique_ptr<Chunk[]> chunks(new Chunk[occupied.size()]);
+
+    DenseGrid dense;
+    ChunkGrid paged;
+    double denseBuildMs = 0.0, pagedBuildMs = 0.0;
+    {
+        const auto t0 = Clock::now();
+        dense.init(radius, height);
+        for (size_t i = 0; i < occupied.size(); ++i) {
+            const Coord& c = occupied[i];
+            dense.cells[dense.index(c.x, c.y, c.z)] = &chunks[i];
+        }
+        const auto t1 = Clock::now();
+        for (size_t i = 0; i < occupied.size(); ++i) {
+            const Coord& c = occupied[i];
+            paged.insert(c.x, c.y, c.z, &chunks[i]);
+        }
+        const auto t2 = Clock::now();
+        denseBuildMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        pagedBuildMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    }
+
+    // Query streams ------------------------------------------------------------
+    constexpr size_t QUERY_COUNT = 1 << 21;
+
+    // 1) flushDirty(): the 6 face neighbours of random occupied chunks.
+    std::vector<Coord> neighbourQ;
+    neighbourQ.reserve(QUERY_COUNT);
+    while (neighbourQ.size() + 6 <= QUERY_COUNT) {
+        const Coord& c = occupied[rng.next() % occupied.size()];
+        neighbourQ.push_back({c.x + 1, c.y, c.z}); neighbourQ.push_back({c.x - 1, c.y, c.z});
+        neighbourQ.push_back({c.x, c.y + 1, c.z}); neighbourQ.push_back({c.x, c.y - 1, c.z});
+        neighbourQ.push_back({c.x, c.y, c.z + 1}); neighbourQ.push_back({c.x, c.y, c.z - 1});
+    }
+
+    // 2) raycast(): voxel-step walks, one chunk lookup per voxel like ChunkStorage::getVoxel().
+    std::vector<Coord> rayQ;
+    rayQ.reserve(QUERY_COUNT);
+    while (rayQ.size() + 256 <= QUERY_COUNT) {
+        float px = static_cast<float>(rng.range(-radius * CHUNK_SIZE, radius * CHUNK_SIZE));
+        float py = static_cast<float>(rng.range(0, height * CHUNK_SIZE - 1));
+        float pz = static_cast<float>(rng.range(-radius * CHUNK_SIZE, radius * CHUNK_SIZE));
+        const float dx = (static_cast<float>(rng.next() % 2001) - 1000.0f) / 1000.0f;
+        const float dy = (static_cast<float>(rng.next() % 2001) - 1000.0f) / 4000.0f;
+        const float dz = (static_cast<float>(rng.next() % 2001) - 1000.0f) / 1000.0f;
+        for (int s = 0; s < 256; ++s, px += dx, py += dy, pz += dz) {
+            rayQ.push_back({static_cast<int>(std::floor(px)) >> 5,
+                            static_cast<int>(std::floor(py)) >> 5,
+                            static_cast<int>(std::floor(pz)) >> 5});
+        }
+    }
+
+    // 3) Scattered lookups over 1.5× the world, ~half of them misses (streaming / bounds checks).
+    std::vector<Coord> randomQ;
+    randomQ.reserve(QUERY_COUNT);
+    const int span = radius + radius / 2;
+    for (size_t i = 0; i < QUERY_COUNT; ++i) {
+        randomQ.push_back({rng.range(-span, span), rng.range(-1, height), rng.range(-span, span)});
+    }
+
+    struct Pattern { const char* name; const std::vector<Coord>* q; };
+    const Pattern patterns[] = {
+        {"neighbours", &neighbourQ},
+        {"ray walk  ", &rayQ},
+        {"scattered ", &randomQ},
+    };
+
+    uintptr_t checksumDense = 0, checksumPaged = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const Pattern& p : patterns) {
+        const double dNs = timeLookups(dense, *p.q, checksumDense);
+        const double pNs = timeLookups(paged, *p.q, checksumPaged);
+        const double n   = static_cast<double>(p.q->size());
+        std::cout << "[Bench]   " << p.name
+                  << "  dense " << dNs / n << " ns/lookup"
+                  << " | paged " << pNs / n << " ns/lookup"
+                  << " | ratio " << (dNs > 0.0 ? pNs / dNs : 0.0) << "x\n";
+    }
+
+    const size_t denseBytes = dense.cells.capacity() * sizeof(Chunk*);
+    std::cout << "[Bench]   build       dense " << denseBuildMs << " ms | paged " << pagedBuildMs << " ms\n"
+              << "[Bench]   memory      dense " << denseBytes / 1024 << " KB | paged "
+              << paged.memoryBytes() / 1024 << " KB (" << paged.pageCount() << " pages, "
+              << paged.size() << " chunks)\n"
+              << "[Bench]   checksum    " << (checksumDense == checksumPaged ? "match" : "MISMATCH") << "\n"
+              << std::defaultfloat << std::flush;
+}
+
+void runTerrainNoiseBenchmark(int radius) {
+    std::cout << "[Bench] Terrain noise: kernel " << BatchNoise2D::kernelName()
+              << ", batch of " << BatchNoise2D::LANES << " vs FastNoiseLite per point\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    // 1) Kernel: the base terrain layer (FBm) over scattered points. Every lane must match
+    //    FastNoiseLite bit for bit.
+    const TerrainConfig config;
+    {
+        constexpr size_t POINTS = 1 << 20;
+        std::vector<float> xs(POINTS), ys(POINTS), scalar(POINTS), batch(POINTS);
+        XorShift rng(7);
+        for (size_t i = 0; i < POINTS; ++i) {
+            xs[i] = static_cast<float>(rng.range(-400000, 400000)) * 0.37f;
+            ys[i] = static_cast<float>(rng.range(-400000, 400000)) * 0.37f;
+        }
+        const BatchNoise2D layer(config.seed, config.frequency, config.octaves);
+
+        // Best of 3, scalar and batch alternating, so a slow moment on the machine hits both.
+        double sMs = 1e30, bMs = 1e30;
+        for (int r = 0; r < 3; ++r) {
+            BatchNoise2D::setScalarFallback(true);
+            auto t0 = Clock::now();
+            layer.sample(xs.data(), ys.data(), scalar.data(), POINTS);
+            BatchNoise2D::setScalarFallback(false);
+            auto t1 = Clock::now();
+            layer.sample(xs.data(), ys.data(), batch.data(), POINTS);
+            auto t2 = Clock::now();
+            sMs = std::min(sMs, std::chrono::duration<double, std::milli>(t1 - t0).count());
+            bMs = std::min(bMs, std::chrono::duration<double, std::milli>(t2 - t1).count());
+        }
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < POINTS; ++i) {
+            mismatches += std::memcmp(&scalar[i], &batch[i], sizeof(float)) != 0;
+        }
+        std::cout << "[Bench]   kernel      " << config.octaves << "-octave FBm, " << POINTS << " points"
+                  << "  scalar " << POINTS / (sMs * 1e3) << " Mpt/s"
+                  << " | batch " << POINTS / (bMs * 1e3) << " Mpt/s"
+                  << " | " << (bMs > 0.0 ? sMs / bMs : 0.0) << "x"
+                  << " | mismatches " << mismatches << "\n";
+    }
+
+    // 2) World: column spans (ColumnHeightmap, as getSurfaceBounds() uses it) from a cold column
+    //    cache, then fillTerrain() of every chunk inside them, single-threaded. The span pass
+    //    builds every column, so it is where the noise runs; fillTerrain() finds all of them in
+    //    TerrainColumnCache and only interpolates and writes voxels (reported for scale).
+    TerrainConfig world = config;
+    world.worldRadiusBlks = radius * CHUNK_SIZE;
+    struct Result { double boundsMs = 0.0, fillMs = 0.0; size_t chunks = 0; uint64_t hash = 1469598103934665603ull; };
+    auto runWorld = [&](bool scalar) {
+        Result r;
+        BatchNoise2D::setScalarFallback(scalar);
+        TerrainColumnCache::shared().clear();
+        ColumnHeightmap heightmap;
+        heightmap.reset(world);
+
+        auto t0 = Clock::now();
+        heightmap.fill(-radius - 1, radius + 1, -radius - 1, radius + 1, 1);
+        auto t1 = Clock::now();
+        for (int cz = -radius; cz <= radius; ++cz) {
+            for (int cx = -radius; cx <= radius; ++cx) {
+                const auto [lo, hi] = heightmap.getChunkSpan(cx, cz);
+                for (int cy = lo; cy <= hi; ++cy) {
+                    Chunk chunk(cx, cy, cz);
+                    chunk.fillTerrain(world);
+                    ++r.chunks;
+                    for (int i = 0; i < CHUNK_SIZE; ++i) { // sparse fingerprint: one diagonal per chunk
+                        r.hash = (r.hash ^ chunk.getVoxel(i, i, (i * 7) & (CHUNK_SIZE - 1)).raw) * 1099511628211ull;
+                    }
+                }
+            }
+        }
+        auto t2 = Clock::now();
+        BatchNoise2D::setScalarFallback(false);
+        TerrainColumnCache::shared().clear();
+        r.boundsMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        r.fillMs   = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        return r;
+    };
+    // Best of 5 per phase, alternating; every run must produce the same voxels.
+    constexpr int REPEATS = 5;
+    Result s, b;
+    bool same = true;
+    for (int i = 0; i < REPEATS; ++i) {
+        const Result rs = runWorld(true);
+        const Result rb = runWorld(false);
+        same = same && rs.hash == rb.hash && rs.chunks == rb.chunks && (i == 0 || rb.hash == b.hash);
+        if (i == 0) { s = rs; b = rb; continue; }
+        s.boundsMs = std::min(s.boundsMs, rs.boundsMs); s.fillMs = std::min(s.fillMs, rs.fillMs);
+        b.boundsMs = std::min(b.boundsMs, rb.boundsMs); b.fillMs = std::min(b.fillMs, rb.fillMs);
+    }
+
+    const int    side    = 2 * radius + 3;
+    const double columns = static_cast<double>(side) * side;
+    std::cout << "[Bench]   world       radius " << radius << ", " << b.chunks << " chunks, "
+              << static_cast<int>(columns) << " columns, best of " << REPEATS << "\n"
+              << "[Bench]   columns     scalar " << s.boundsMs << " ms | batch " << b.boundsMs << " ms | "
+              << (b.boundsMs > 0.0 ? s.boundsMs / b.boundsMs : 0.0) << "x"
+              << " (" << b.boundsMs * 1e3 / columns << " us/column)\n"
+              << "[Bench]   fillTerrain scalar " << s.fillMs << " ms | batch " << b.fillMs << " ms"
+              << " (columns cached: no noise)\n"
+              << "[Bench]   total       scalar " << s.boundsMs + s.fillMs << " ms | batch "
+              << b.boundsMs + b.fillMs << " ms | "
+              << (b.boundsMs + b.fillMs > 0.0 ? (s.boundsMs + s.fillMs) / (b.boundsMs + b.fillMs) : 0.0) << "x\n"
+              << "[Bench]   voxels      " << (same ? "match" : "MISMATCH") << "\n"
+              << std::defaultfloat << std::flush;
+}
+
+void runReducedGenerationBenchmark(int radius) {
+    std::cout << "[Bench] Reduced-resolution generation: payload LOD 0 / 1 / 2 (32^3 / 16^3 / 8^3)\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    TerrainConfig config;
+    config.worldRadiusBlks = radius * CHUNK_SIZE;
+    ColumnHeightmap heightmap;
+    heightmap.reset(config);
+    heightmap.fill(-radius - 1, radius + 1, -radius - 1, radius + 1, 1);
+
+    struct Key { int cx, cy, cz; };
+    std::vector<Key> keys;
+    for (int cz = -radius - 1; cz <= radius + 1; ++cz) {
+        for (int cx = -radius - 1; cx <= radius + 1; ++cx) {
+            const auto [lo, hi] = heightmap.getChunkSpan(cx, cz);
+            for (int cy = lo; cy <= hi; ++cy) keys.push_back({cx, cy, cz});
+        }
+    }
+    auto find = [&keys](int cx, int cy, int cz) -> size_t {
+        for (size_t i = 0; i < keys.size(); ++i)
+            if (keys[i].cx == cx && keys[i].cy == cy && keys[i].cz == cz) return i;
+        return keys.size();
+    };
+
+    // Full-resolution reference, generated once; every reduced world is compared against it.
+    // Tree voxels spilled into chunks generated earlier come back as late deliveries and are
+    // applied like ChunkStorage::generateWorld() does (later worlds collect them directly).
+    DecorationQueue::shared().clear();
+    std::vector<std::unique_ptr<Chunk>> full;
+    for (const Key& k : keys) {
+        full.push_back(std::make_unique<Chunk>(k.cx, k.cy, k.cz));
+        full.back()->fillTerrain(config);
+        for (const auto& d : TerrainGenerator::takeLateDecorations()) {
+            const size_t j = find(d.cx, d.cy, d.cz);
+            if (j < full.size()) full[j]->applyDecoration(d.writes);
+        }
+    }
+
+    // A reduced payload must hold exactly the full world's voxels at its block origins.
+    auto sameOrigins = [&](const std::vector<std::unique_ptr<Chunk>>& world, int lod) {
+        const int step = 1 << lod;
+        for (size_t i = 0; i < keys.size(); ++i)
+            for (int z = 0; z < CHUNK_SIZE; z += step)
+                for (int y = 0; y < CHUNK_SIZE; y += step)
+                    for (int x = 0; x < CHUNK_SIZE; x += step)
+                        if (world[i]->getVoxel(x, y, z) != full[i]->getVoxel(x, y, z)) return false;
+        return true;
+    };
+
+    for (int lod = 0; lod <= 2; ++lod) {
+        // Cold: column noise included (a streamed-in column); warm: voxel fill + encode only.
+        double coldMs = 0.0, warmMs = 0.0;
+        size_t bytes = 0;
+        std::vector<std::unique_ptr<Chunk>> world;
+        for (int pass = 0; pass < 2; ++pass) {
+            if (pass == 0) TerrainColumnCache::shared().clear();
+            world.clear();
+            bytes = 0;
+            auto t0 = Clock::now();
+            for (const Key& k : keys) {
+                world.push_back(std::make_unique<Chunk>(k.cx, k.cy, k.cz));
+                world.back()->fillTerrain(config, lod);
+            }
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            (pass == 0 ? coldMs : warmMs) = ms;
+            for (const auto& c : world) bytes += c->getVoxelBytes();
+        }
+        const double voxels = static_cast<double>(keys.size()) * CHUNK_VOLUME;
+        const bool   same   = sameOrigins(world, lod);
+        std::cout << "[Bench]   lod " << lod << "  " << keys.size() << " chunks"
+                  << "  cold " << coldMs << " ms (" << voxels / (coldMs * 1e3) << " Mvox/s)"
+                  << " | fill " << warmMs << " ms (" << voxels / (warmMs * 1e3) << " Mvox/s)"
+                  << " | voxel RAM " << bytes / 1024.0 << " KB"
+                  << " | origins vs full " << (same ? "match" : "MISMATCH") << "\n";
+    }
+    TerrainColumnCache::shared().clear();
+    std::cout << std::defaultfloat << std::flush;
+}
+
+void runCaveGenerationBenchmark(int radius) {
+    std::cout << "[Bench] Cave generation: 3D density lattice off / on\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        TerrainConfig config;
+        config.worldRadiusBlks = radius * CHUNK_SIZE;
+        config.caves = (pass == 1);
+
+        // Same chunk set the engine streams: caves extend every column down to the floor.
+        ColumnHeightmap heightmap;
+        heightmap.reset(config);
+        heightmap.fill(-radius - 1, radius + 1, -radius - 1, radius + 1, 1);
+        struct Key { int cx, cy, cz; };
+        std::vector<Key> keys;
+        for (int cz = -radius; cz <= radius; ++cz) {
+            for (int cx = -radius; cx <= radius; ++cx) {
+                const auto [lo, hi] = heightmap.getChunkSpan(cx, cz);
+                for (int cy = std::max(lo, 0); cy <= hi; ++cy) keys.push_back({cx, cy, cz});
+            }
+        }
+
+        // Warm the column cache so the timing covers the 3D stage + voxel fill only.
+        TerrainColumnCache::shared().clear();
+        for (const Key& k : keys) Chunk(k.cx, k.cy, k.cz).fillTerrain(config);
+
+        const TerrainGenerator::Stats before = TerrainGenerator::getStats();
+        std::vector<std::unique_ptr<Chunk>> world;
+        world.reserve(keys.size());
+        auto t0 = Clock::now();
+        for (const Key& k : keys) {
+            world.push_back(std::make_unique<Chunk>(k.cx, k.cy, k.cz));
+            world.back()->fillTerrain(config);
+        }
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        const TerrainGenerator::Stats after = TerrainGenerator::getStats();
+
+        const TerrainGenerator::Stats delta = after - before;
+
+        size_t bytes = 0, uniform = 0;
+        for (const auto& c : world) {
+            bytes += c->getVoxelBytes();
+            uniform += c->isUniform();
+        }
+        const double voxels = static_cast<double>(keys.size()) * CHUNK_VOLUME;
+        std::cout << "[Bench]   caves " << (config.caves ? "on " : "off") << "  " << keys.size() << " chunks"
+                  << "  fill " << ms << " ms (" << voxels / (ms * 1e3) << " Mvox/s)"
+                  << " | surface/carve/encode "
+                  << delta.usPerChunk(TerrainGenerator::Stage::SURFACE) << "/"
+                  << delta.usPerChunk(TerrainGenerator::Stage::CARVE) << "/"
+                  << delta.usPerChunk(TerrainGenerator::Stage::ENCODE) << " us/chunk"
+                  << " | uniform " << uniform << " | voxel RAM " << bytes / 1024.0 << " KB\n";
+    }
+    TerrainColumnCache::shared().clear();
+    std::cout << std::defaultfloat << std::flush;
+}
+
+void runForestGenerationBenchmark(int radius) {
+    std::cout << "[Bench] Forest generation: DECORATE stage + cross-chunk DecorationQueue\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    struct Key { int cx, cy, cz; };
+    using World = std::vector<std::unique_ptr<Chunk>>;
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Fills keys[order[i]] on `nThreads` workers, then applies the late deliveries the way
+    // ChunkStorage::generateWorld() does. Returns wall ms; `applied` = chunks a delivery changed.
+    auto generate = [](const TerrainConfig& config, const std::vector<Key>& keys,
+                       const std::vector<size_t>& order, unsigned nThreads, World& world, size_t& applied) {
+        world.clear();
+        std::unordered_map<uint64_t, size_t> index;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            world.push_back(std::make_unique<Chunk>(keys[i].cx, keys[i].cy, keys[i].cz));
+            index[(static_cast<uint64_t>(static_cast<uint16_t>(keys[i].cx)) << 32) |
+                  (static_cast<uint64_t>(static_cast<uint16_t>(keys[i].cy)) << 16) |
+                   static_cast<uint16_t>(keys[i].cz)] = i;
+        }
+        std::vector<std::vector<DecorationDelivery>> late(nThreads);
+        std::atomic<size_t> next{0};
+        auto work = [&](unsigned t) {
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < order.size();) {
+                world[order[i]]->fillTerrain(config);
+                for (auto& d : TerrainGenerator::takeLateDecorations()) late[t].push_back(std::move(d));
+            }
+        };
+
+        auto t0 = Clock::now();
+        if (nThreads == 1) {
+            work(0);
+        } else {
+            std::vector<std::thread> pool;
+            for (unsigned t = 0; t < nThreads; ++t) pool.emplace_back(work, t);
+            for (auto& th : pool) th.join();
+        }
+        applied = 0;
+        for (const auto& perThread : late) {
+            for (const auto& d : perThread) {
+                auto it = index.find((static_cast<uint64_t>(static_cast<uint16_t>(d.cx)) << 32) |
+                                     (static_cast<uint64_t>(static_cast<uint16_t>(d.cy)) << 16) |
+                                      static_cast<uint16_t>(d.cz));
+                if (it != index.end()) applied += world[it->second]->applyDecoration(d.writes);
+            }
+        }
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    };
+
+    auto voxelHash = [](const World& world) {
+        std::vector<VoxelData> voxels(CHUNK_VOLUME);
+        uint64_t h = 1469598103934665603ull;
+        for (const auto& c : world) {
+            c->decodeVoxels(voxels.data());
+            for (const VoxelData& v : voxels) h = (h ^ v.raw) * 1099511628211ull;
+        }
+        return h;
+    };
+
+    for (int pass = 0; pass < 2; ++pass) {
+        TerrainConfig config;
+        config.worldRadiusBlks = radius * CHUNK_SIZE;
+        config.trees       = (pass == 1);
+        config.treeDensity = 0.6f;
+
+        ColumnHeightmap heightmap;
+        heightmap.reset(config);
+        heightmap.fill(-radius - 1, radius + 1, -radius - 1, radius + 1, 1);
+        std::vector<Key> keys;
+        for (int cz = -radius; cz <= radius; ++cz) {
+            for (int cx = -radius; cx <= radius; ++cx) {
+                const auto [lo, hi] = heightmap.getChunkSpan(cx, cz);
+                for (int cy = std::max(lo, 0); cy <= hi; ++cy) keys.push_back({cx, cy, cz});
+            }
+        }
+        std::vector<size_t> forward(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) forward[i] = i;
+        const std::vector<size_t> reverse(forward.rbegin(), forward.rend());
+
+        // Warm the column cache so the timing covers the chunk stages only.
+        TerrainColumnCache::shared().clear();
+        for (const Key& k : keys) Chunk(k.cx, k.cy, k.cz).fillTerrain(config);
+
+        World  world;
+        size_t applied = 0;
+
+        DecorationQueue::shared().clear();
+        const TerrainGenerator::Stats before = TerrainGenerator::getStats();
+        const double singleMs = generate(config, keys, forward, 1, world, applied);
+        const TerrainGenerator::Stats delta = TerrainGenerator::getStats() - before;
+        const uint64_t forwardHash = voxelHash(world);
+
+        DecorationQueue::shared().clear();
+        const double reverseMs = generate(config, keys, reverse, 1, world, applied);
+        const uint64_t reverseHash = voxelHash(world);
+
+        DecorationQueue::shared().clear();
+        const DecorationQueue::Stats q0 = DecorationQueue::shared().getStats();
+        const double parallelMs = generate(config, keys, forward, threads, world, applied);
+        const DecorationQueue::Stats q = DecorationQueue::shared().getStats();
+        const uint64_t parallelHash = voxelHash(world);
+
+        const double voxels = static_cast<double>(keys.size()) * CHUNK_VOLUME;
+        auto rate = [&](double ms) {
+            std::ostringstream os;
+            os << std::fixed << std::setprecision(2) << ms << " ms (" << voxels / (ms * 1e3) << " Mvox/s, "
+               << keys.size() / (ms * 1e-3) << " chunks/s)";
+            return os.str();
+        };
+        std::cout << "[Bench]   trees " << (config.trees ? "on " : "off") << "  " << keys.size() << " chunks"
+                  << "  1 thread " << rate(singleMs) << " | " << threads << " threads " << rate(parallelMs)
+                  << " | decorate " << delta.usPerChunk(TerrainGenerator::Stage::DECORATE) << " us/chunk\n";
+        if (!config.trees) continue;
+        std::cout << "[Bench]   queue " << q.targets << " chunks / " << q.spills << " spills / " << q.writes
+                  << " writes / " << q.bytes / 1024.0 << " KB"
+                  << " | posts " << (q.posted - q0.posted) << ", late " << (q.late - q0.late)
+                  << " (" << applied << " chunks changed)"
+                  << " | reverse order " << (reverseHash == forwardHash ? "match" : "MISMATCH")
+                  << " (" << reverseMs << " ms)"
+                  << " | " << threads << " threads " << (parallelHash == forwardHash ? "match" : "MISMATCH") << "\n";
+    }
+    DecorationQueue::shared().clear();
+    TerrainColumnCache::shared().clear();
+    std::cout << std::defaultfloat << std::flush;
+}
+
+void runStreamingBenchmark(int radius) {
+    std::cout << "[Bench] Streaming + meshing: ChunkManager with a headless CountingMeshSink\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Staging on, like ChunkRenderer: workers write meshes into sink memory.
+    CountingMeshSink sink(true);
+    ChunkManager manager(sink);
+    // Open terrain, so the flight streams land the whole way.
+    TerrainConfig config;
+    config.seed            = 42;
+    config.islandMode      = false;
+    config.worldRadiusBlks = radius * CHUNK_SIZE;
+    manager.getUnloadRadius()  = 256.0f;
+    manager.getFrustumRadius() = 512.0f;
+
+    // Runs frames until the workers are idle and nothing is left to mesh. With a camera,
+    // chunks that finished generating meanwhile get their LOD (and mesh) assigned too.
+    auto drain = [&](float time, const core::math::Vec3* eye, const scene::Frustum* frustum) {
+        for (int i = 0; i < 256; ++i) {
+            manager.waitAllWorkers();
+            if (eye) manager.updateCamera(*eye, *frustum);
+            manager.rebuildDirtyChunks(time);
+            manager.flushDirty();
+            if (manager.getPendingMeshes() == 0) return;
+        }
+    };
+
+    // ---- Initial world: generateWorld() + first meshes ---------------------
+    const uint64_t genBefore = TerrainGenerator::getStats().chunks;
+    auto t0 = Clock::now();
+    manager.generateWorld(radius, radius, config);
+    auto t1 = Clock::now();
+    drain(0.0f, nullptr, nullptr);
+    auto t2 = Clock::now();
+    const double genMs  = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const double meshMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    const auto initial = sink.getStats();
+    std::cout << "[Bench]   initial radius " << radius << ": " << manager.getChunkCount() << " chunks, generate "
+              << genMs << " ms, mesh " << meshMs << " ms (" << initial.resident << " meshes, "
+              << initial.quads << " quads, " << initial.uploadedBytes / (1024.0 * 1024.0) << " MB)\n";
+
+    // ---- Flight: updateCamera() + rebuildDirtyChunks() per frame -----------
+    // Camera moves along +X at 8 blocks per frame (480 m/s at 60 FPS), looking ahead.
+    constexpr int   FRAMES = 600;
+    constexpr float SPEED  = 8.0f;
+    constexpr float DT     = 1.0f / 60.0f;
+    const core::math::Mat4 proj = core::math::Mat4::perspective(core::math::toRadians(70.0f), 16.0f / 9.0f, 0.1f, 1024.0f);
+
+    double totalMs = 0.0, maxMs = 0.0;
+    uint32_t peakChunks = 0;
+    const auto before = sink.getStats();
+    core::math::Vec3 eye{};
+    scene::Frustum frustum;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        eye = {frame * SPEED, 96.0f, 0.0f};
+        const core::math::Vec3 ahead{eye.x + 1.0f, eye.y - 0.2f, eye.z};
+        frustum.extractPlanes(proj * core::math::Mat4::lookAt(eye, ahead, {0.0f, 1.0f, 0.0f}));
+
+        const auto f0 = Clock::now();
+        manager.updateCamera(eye, frustum);
+        manager.rebuildDirtyChunks(frame * DT);
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - f0).count();
+        totalMs += ms;
+        maxMs = std::max(maxMs, ms);
+        peakChunks = std::max(peakChunks, manager.getChunkCount());
+    }
+    const auto f1 = Clock::now();
+    drain(FRAMES * DT, &eye, &frustum);
+    const double tailMs = std::chrono::duration<double, std::milli>(Clock::now() - f1).count();
+    const auto after = sink.getStats();
+    const uint64_t generated = TerrainGenerator::getStats().chunks - genBefore;
+    const uint64_t uploads   = after.uploads - before.uploads;
+
+    std::cout << "[Bench]   flight " << FRAMES << " frames x " << SPEED << " blocks: main thread avg "
+              << totalMs / FRAMES << " ms, max " << maxMs << " ms per frame (drain " << tailMs << " ms)\n"
+              << "[Bench]   chunks generated " << generated << " (incl. initial), mesh uploads " << uploads
+              << " (" << (totalMs + tailMs > 0.0 ? uploads / ((totalMs + tailMs) * 1e-3) : 0.0) << "/sec), releases "
+              << after.releases - before.releases << ", peak chunks " << peakChunks << "\n"
+              << "[Bench]   end: " << manager.getChunkCount() << " chunks, " << after.resident << " meshes, "
+              << after.quads << " quads, uploaded " << (after.uploadedBytes - before.uploadedBytes) / (1024.0 * 1024.0)
+              << " MB during flight\n"
+              << "[Bench]   staging: " << after.stagedUploads << " of " << after.uploads << " uploads meshed into sink memory, "
+              << after.stagingLive << " reservations leaked\n";
+    const ChunkLifecycleStats lifecycle = manager.getLifecycleStats();
+    std::cout << "[Bench]   voxel RAM " << lifecycle.voxelBytes / (1024.0 * 1024.0) << " MB, LOD mip chains "
+              << lifecycle.mipBytes / (1024.0 * 1024.0) << " MB (" << lifecycle.mipChunks << " chunks)\n";
+    // Spills stay only around the resident world; the rest is pruned as chunks stream out.
+    std::cout << "[Bench]   decoration queue " << lifecycle.decor.targets << " chunks / " << lifecycle.decor.spills
+              << " spills / " << lifecycle.decor.bytes / 1024.0 << " KB, " << lifecycle.decor.pruned
+              << " spills pruned, " << lifecycle.decor.late << " of " << lifecycle.decor.posted << " posts delivered late\n";
+
+    // Pool memory per resident mesh: 8-byte quad records vs the former 8-byte vertices (4 per
+    // quad), index-free and with a per-chunk uint32 index range (6 per quad). The shared quad
+    // index buffer is one-off and not counted.
+    if (after.resident > 0) {
+        const double quadsPerMesh = static_cast<double>(after.quads) / after.resident;
+        const double quadKB    = quadsPerMesh * sizeof(VoxelQuad) / 1024.0;
+        const double vertexKB  = quadsPerMesh * 4 * 8 / 1024.0;
+        const double indexedKB = vertexKB + quadsPerMesh * 6 * sizeof(uint32_t) / 1024.0;
+        std::cout << "[Bench]   GPU memory per mesh: " << quadKB << " KB quad records, was " << vertexKB
+                  << " KB vertices / " << indexedKB << " KB vertices + indices (x" << indexedKB / quadKB << ")\n";
+    }
+}
+
+void runMesherBenchmark() {
+    std::cout << "[Bench] Chunk mesher: binary (column bitmask) vs per-voxel reference, 1 chunk + 6 neighbours\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    const VoxelData stone = VoxelData::make(1, 255, 0, VOXEL_FLAG_SOLID);
+    const VoxelData grass = VoxelData::make(2, 255, 0, VOXEL_FLAG_SOLID);
+    const VoxelData dirt  = VoxelData::make(3, 255, 0, VOXEL_FLAG_SOLID);
+    const VoxelData water = VoxelData::make(6, 255, 0, VOXEL_FLAG_SOLID | VOXEL_FLAG_LIQUID);
+
+    // Fixtures in world block coordinates; the centre chunk spans [0, 32)^3.
+    // "coast" floods the hilly terrain below y = 18 (opaque + liquid streams).
+    struct Fixture { const char* name; std::function<VoxelData(int, int, int)> voxel; };
+    const Fixture fixtures[] = {
+        {"flat", [&](int, int y, int) {
+            return y < 15 ? stone : y == 15 ? grass : VOXEL_AIR;
+        }},
+        {"hilly", [&](int x, int y, int z) {
+            const int h = 16 + static_cast<int>(std::lround(10.0 * std::sin(x * 0.15) * std::cos(z * 0.11)));
+            return y > h ? VOXEL_AIR : y == h ? grass : y > h - 3 ? dirt : stone;
+        }},
+        {"coast", [&](int x, int y, int z) {
+            const int h = 16 + static_cast<int>(std::lround(10.0 * std::sin(x * 0.15) * std::cos(z * 0.11)));
+            return y > h ? (y < 18 ? water : VOXEL_AIR) : y == h ? grass : y > h - 3 ? dirt : stone;
+        }},
+        {"random", [&](int x, int y, int z) {
+            uint32_t r = static_cast<uint32_t>(x * 73856093) ^ static_cast<uint32_t>(y * 19349663) ^ static_cast<uint32_t>(z * 83492791);
+            r ^= r >> 13; r *= 0x5bd1e995u; r ^= r >> 15;
+            return (r & 1) ? VOXEL_AIR : (r & 6) == 0 ? grass : (r & 6) == 2 ? dirt : stone;
+        }},
+        {"checker", [&](int x, int y, int z) {
+            return ((x + y + z) & 1) ? VOXEL_AIR : stone;
+        }},
+    };
+
+    constexpr int OFFSETS[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    std::vector<VoxelData> buf(CHUNK_VOLUME);
+    auto makeChunk = [&](const Fixture& f, int cx, int cy, int cz) {
+        auto c = std::make_unique<Chunk>(cx, cy, cz);
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+            for (int y = 0; y < CHUNK_SIZE; ++y)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    buf[x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE] =
+                        f.voxel(cx * CHUNK_SIZE + x, cy * CHUNK_SIZE + y, cz * CHUNK_SIZE + z);
+        c->encodeVoxels(buf.data());
+        return c;
+    };
+    auto same = [](const VoxelMeshData& a, const VoxelMeshData& b) {
+        return a.quads == b.quads && a.faceQuads == b.faceQuads && a.liquidQuads == b.liquidQuads;
+    };
+
+    bool allMatch = true;
+    for (const Fixture& f : fixtures) {
+        const auto centre = makeChunk(f, 0, 0, 0);
+        std::vector<std::unique_ptr<Chunk>> ring;
+        std::array<const Chunk*, 6> neighbors{};
+        for (int n = 0; n < 6; ++n) {
+            ring.push_back(makeChunk(f, OFFSETS[n][0], OFFSETS[n][1], OFFSETS[n][2]));
+            neighbors[n] = ring.back().get();
+        }
+
+        for (int lod = 0; lod <= 2; ++lod) {
+            std::array<int, 6> lods;
+            lods.fill(lod);
+
+            // Best-of-N per mesher; the two are interleaved so both see the same cache state.
+            constexpr int REPS = 25;
+            double refUs = 1e30, binUs = 1e30;
+            VoxelMeshData ref, bin;
+            for (int r = 0; r < REPS; ++r) {
+                auto t0 = Clock::now();
+                ref = centre->generateMeshReference(neighbors, lods, lod);
+                auto t1 = Clock::now();
+                bin = centre->generateMesh(neighbors, lods, lod);
+                auto t2 = Clock::now();
+                refUs = std::min(refUs, std::chrono::duration<double, std::micro>(t1 - t0).count());
+                binUs = std::min(binUs, std::chrono::duration<double, std::micro>(t2 - t1).count());
+            }
+            bool match = same(ref, bin);
+
+            // Boundary cases, equality only: +X at another LOD (skirt), -Z missing (world edge),
+            // -Y still generating (treated as solid).
+            std::array<const Chunk*, 6> edgeNeighbors = neighbors;
+            std::array<int, 6> edgeLods = lods;
+            edgeLods[0] = (lod + 1) % 3;
+            edgeNeighbors[5] = nullptr;
+            ring[3]->m_state.store(ChunkState::GENERATING, std::memory_order_release);
+            match = match && same(centre->generateMeshReference(edgeNeighbors, edgeLods, lod),
+                                  centre->generateMesh(edgeNeighbors, edgeLods, lod));
+            ring[3]->m_state.store(ChunkState::READY, std::memory_order_release);
+            allMatch = allMatch && match;
+
+            std::cout << "[Bench]   " << std::left << std::setw(8) << f.name << std::right << " lod " << lod
+                      << "  reference " << std::setw(8) << refUs << " us/chunk | binary " << std::setw(8) << binUs
+                      << " us/chunk | x" << refUs / binUs << " | " << bin.quadCount() << " quads"
+                      << " | " << (match ? "match" : "MISMATCH") << "\n";
+        }
+    }
+    std::cout << "[Bench]   output " << (allMatch ? "identical to the reference mesher" : "DIFFERS from the reference mesher")
+              << "\n" << std::defaultfloat << std::flush;
+}
+
+void runFaceCullingBenchmark(int radius) {
+    std::cout << "[Bench] Chunk-level backface culling: per-direction draws on the default island\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    // The engine's start-up world: island defaults, seed 42, render radius = world radius.
+    CountingMeshSink sink(true);
+    ChunkManager manager(sink);
+    manager.setRenderRadius(radius);
+    TerrainConfig config;
+    config.seed            = 42;
+    config.worldRadiusBlks = radius * CHUNK_SIZE;
+    manager.generateWorld(radius, radius, config);
+
+    // Orbit at the start camera's height and distance ({0, 200, 250}, looking down at the island).
+    constexpr int   FRAMES = 360;
+    constexpr float ORBIT  = 250.0f;
+    const core::math::Mat4 proj = core::math::Mat4::perspective(core::math::toRadians(60.0f), 16.0f / 9.0f, 0.1f, 1024.0f);
+
+    uint64_t meshTris = 0, drawnTris = 0, chunkDraws = 0, faceDraws = 0;
+    scene::Frustum frustum;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        const float angle = frame * (2.0f * 3.14159265f / FRAMES);
+        const core::math::Vec3 eye{ORBIT * std::sin(angle), 200.0f, ORBIT * std::cos(angle)};
+        frustum.extractPlanes(proj * core::math::Mat4::lookAt(eye, {0.0f, 40.0f, 0.0f}, {0.0f, 1.0f, 0.0f}));
+
+        // Settle streaming / LOD for this view before counting (the measure is geometry, not time).
+        for (int i = 0; i < 64; ++i) {
+            manager.waitAllWorkers();
+            manager.updateCamera(eye, frustum);
+            manager.rebuildDirtyChunks(0.0f);
+            manager.flushDirty();
+            if (manager.getPendingMeshes() == 0) break;
+        }
+
+        // Same selection as ChunkRenderer::cull(): frustum test, then chunkFacingMask() directions,
+        // adjacent drawn directions merged into one command.
+        for (const auto& [key, size] : sink.getMeshes()) {
+            const FaceQuadCounts& faceQuads = size.faceQuads;
+            const float x = static_cast<float>(key.x * CHUNK_SIZE);
+            const float y = static_cast<float>(key.y * CHUNK_SIZE);
+            const float z = static_cast<float>(key.z * CHUNK_SIZE);
+            if (!frustum.isVisible({{x, y, z}, {x + CHUNK_SIZE, y + CHUNK_SIZE, z + CHUNK_SIZE}})) continue;
+
+            const uint32_t facing = chunkFacingMask(key.x, key.y, key.z, eye.x, eye.y, eye.z);
+            bool run = false;
+            for (int face = 0; face < 6; ++face) {
+                if (faceQuads[face] == 0) continue;
+                const bool drawn = (facing & (1u << face)) != 0;
+                meshTris += faceQuads[face] * 2;
+                if (drawn) drawnTris += faceQuads[face] * 2;
+                if (drawn && !run) faceDraws++;
+                run = drawn;
+            }
+            chunkDraws++;
+        }
+    }
+
+    const auto stats = sink.getStats();
+    std::cout << "[Bench]   radius " << radius << ": " << manager.getChunkCount() << " chunks, " << stats.resident
+              << " meshes, " << stats.quads << " quads resident at the end\n"
+              << "[Bench]   orbit " << FRAMES << " frames: frustum-visible " << meshTris / FRAMES
+              << " tris/frame, drawn " << drawnTris / FRAMES << " tris/frame ("
+              << (meshTris ? 100.0 * (1.0 - static_cast<double>(drawnTris) / meshTris) : 0.0)
+              << "% skipped as back faces)\n"
+              << "[Bench]   indirect commands " << static_cast<double>(faceDraws) / FRAMES << "/frame, was "
+              << static_cast<double>(chunkDraws) / FRAMES << " (one per chunk)\n"
+              << std::defaultfloat << std::flush;
+}
+
+void runLiquidMeshBenchmark(int radius) {
+    std::cout << "[Bench] Liquid mesh stream: water meshed as opaque vs opaque + liquid surface, default island\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    TerrainConfig config;
+    config.seed            = 42;
+    config.worldRadiusBlks = radius * CHUNK_SIZE;
+    ColumnHeightmap heightmap;
+    heightmap.reset(config);
+    heightmap.fill(-radius - 1, radius + 1, -radius - 1, radius + 1, 1);
+
+    struct Key { int cx, cy, cz; };
+    std::vector<Key> keys;
+    for (int cz = -radius - 1; cz <= radius + 1; ++cz) {
+        for (int cx = -radius - 1; cx <= radius + 1; ++cx) {
+            const auto [lo, hi] = heightmap.getChunkSpan(cx, cz);
+            for (int cy = lo; cy <= hi; ++cy) keys.push_back({cx, cy, cz});
+        }
+    }
+    std::unordered_map<uint64_t, size_t> index;
+    auto pack = [](int cx, int cy, int cz) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx) & 0x1FFFFFu) << 42) |
+               (static_cast<uint64_t>(static_cast<uint32_t>(cy) & 0x1FFFFFu) << 21) |
+                static_cast<uint64_t>(static_cast<uint32_t>(cz) & 0x1FFFFFu);
+    };
+    for (size_t i = 0; i < keys.size(); ++i) index.emplace(pack(keys[i].cx, keys[i].cy, keys[i].cz), i);
+
+    // The generated world, and a copy where water is a plain SOLID voxel — how it meshed before
+    // the liquid stream (one opaque mesh, water walls at the skirts, no seabed faces).
+    DecorationQueue::shared().clear();
+    std::vector<std::unique_ptr<Chunk>> world, asOpaque;
+    std::vector<VoxelData> buf(CHUNK_VOLUME);
+    for (const Key& k : keys) {
+        world.push_back(std::make_unique<Chunk>(k.cx, k.cy, k.cz));
+        world.back()->fillTerrain(config);
+        for (const auto& d : TerrainGenerator::takeLateDecorations()) {
+            auto it = index.find(pack(d.cx, d.cy, d.cz));
+            if (it != index.end() && it->second < world.size()) world[it->second]->applyDecoration(d.writes);
+        }
+    }
+    std::vector<bool> liquidPalette(4096, false);
+    for (const auto& c : world) {
+        c->decodeVoxels(buf.data());
+        for (VoxelData& v : buf) {
+            if (!v.isLiquid()) continue;
+            liquidPalette[v.getPaletteIndex()] = true;
+            v.setFlags(VOXEL_FLAG_SOLID);
+        }
+        asOpaque.push_back(std::make_unique<Chunk>(c->getCX(), c->getCY(), c->getCZ()));
+        asOpaque.back()->encodeVoxels(buf.data());
+    }
+
+    // Every inner chunk meshed at `lod` against same-LOD neighbours.
+    struct Totals { uint64_t opaque = 0, liquid = 0, water = 0; double ms = 0.0; };
+    auto meshWorld = [&](const std::vector<std::unique_ptr<Chunk>>& chunks, int lod) {
+        Totals t;
+        VoxelMeshData mesh;
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const Key& k = keys[i];
+            if (std::abs(k.cx) > radius || std::abs(k.cz) > radius) continue;
+            auto nb = [&](int dx, int dy, int dz) -> const Chunk* {
+                auto it = index.find(pack(k.cx + dx, k.cy + dy, k.cz + dz));
+                return it != index.end() ? chunks[it->second].get() : nullptr;
+            };
+            const std::array<const Chunk*, 6> neighbors = {
+                nb(1, 0, 0), nb(-1, 0, 0), nb(0, 1, 0), nb(0, -1, 0), nb(0, 0, 1), nb(0, 0, -1)
+            };
+            std::array<int, 6> lods;
+            lods.fill(lod);
+            chunks[i]->generateMesh(neighbors, lods, lod, mesh);
+            t.opaque += mesh.opaqueQuads();
+            t.liquid += mesh.liquidQuads;
+            for (uint32_t q = 0; q < mesh.opaqueQuads(); ++q) t.water += liquidPalette[mesh.quads[q].getPaletteIdx()];
+        }
+        t.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        return t;
+    };
+
+    for (int lod = 0; lod <= 2; ++lod) {
+        const Totals before = meshWorld(asOpaque, lod);
+        const Totals after  = meshWorld(world, lod);
+        const uint64_t total = after.opaque + after.liquid;
+        std::cout << "[Bench]   lod " << lod << "  water as opaque " << before.opaque << " quads, " << before.water
+                  << " of them water (" << before.ms << " ms)"
+                  << " | split " << after.opaque << " opaque + " << after.liquid << " liquid = " << total
+                  << " quads (" << after.ms << " ms) | x" << static_cast<double>(total) / std::max<uint64_t>(before.opaque, 1)
+                  << "\n";
+    }
+    TerrainColumnCache::shared().clear();
+    std::cout << std::defaultfloat << std::flush;
+}
+
+void runLodMipBenchmark(int radius) {
+    std::cout << "[Bench] LOD meshing from the voxel mip chain vs point-sampled (reduced payload) grids, default island\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    TerrainConfig config;
+    config.seed            = 42;
+    config.worldRadiusBlks = radius * CHUNK_SIZE;
+    ColumnHeightmap heightmap;
+    heightmap.reset(config);
+    heightmap.fill(-radius - 1, radius + 1, -radius - 1, radius + 1, 1);
+
+    struct Key { int cx, cy, cz; };
+    std::vector<Key> keys;
+    for (int cz = -radius - 1; cz <= radius + 1; ++cz) {
+        for (int cx = -radius - 1; cx <= radius + 1; ++cx) {
+            const auto [lo, hi] = heightmap.getChunkSpan(cx, cz);
+            for (int cy = lo; cy <= hi; ++cy) keys.push_back({cx, cy, cz});
+        }
+    }
+    std::unordered_map<uint64_t, size_t> index;
+    auto pack = [](int cx, int cy, int cz) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx) & 0x1FFFFFu) << 42) |
+               (static_cast<uint64_t>(static_cast<uint32_t>(cy) & 0x1FFFFFu) << 21) |
+                static_cast<uint64_t>(static_cast<uint32_t>(cz) & 0x1FFFFFu);
+    };
+    for (size_t i = 0; i < keys.size(); ++i) index.emplace(pack(keys[i].cx, keys[i].cy, keys[i].cz), i);
+
+    // Full-resolution world (late tree deliveries applied); reduced worlds generated after it
+    // collect their spilled voxels from the DecorationQueue directly.
+    DecorationQueue::shared().clear();
+    std::vector<std::unique_ptr<Chunk>> full;
+    for (const Key& k : keys) {
+        full.push_back(std::make_unique<Chunk>(k.cx, k.cy, k.cz));
+        full.back()->fillTerrain(config);
+        for (const auto& d : TerrainGenerator::takeLateDecorations()) {
+            auto it = index.find(pack(d.cx, d.cy, d.cz));
+            if (it != index.end() && it->second < full.size()) full[it->second]->applyDecoration(d.writes);
+        }
+    }
+
+    // Every inner chunk meshed at `lod` against same-LOD neighbours. Tree quads (WOOD / LEAVES)
+    // show how much of the one-block-wide structures survives the LOD.
+    struct Totals { uint64_t quads = 0, trees = 0; double ms = 0.0; };
+    auto meshWorld = [&](const std::vector<std::unique_ptr<Chunk>>& chunks, int lod) {
+        Totals t;
+        VoxelMeshData mesh;
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const Key& k = keys[i];
+            if (std::abs(k.cx) > radius || std::abs(k.cz) > radius) continue;
+            auto nb = [&](int dx, int dy, int dz) -> const Chunk* {
+                auto it = index.find(pack(k.cx + dx, k.cy + dy, k.cz + dz));
+                return it != index.end() ? chunks[it->second].get() : nullptr;
+            };
+            const std::array<const Chunk*, 6> neighbors = {
+                nb(1, 0, 0), nb(-1, 0, 0), nb(0, 1, 0), nb(0, -1, 0), nb(0, 0, 1), nb(0, 0, -1)
+            };
+            std::array<int, 6> lods;
+            lods.fill(lod);
+            chunks[i]->generateMesh(neighbors, lods, lod, mesh);
+            t.quads += mesh.quadCount();
+            for (const VoxelQuad& q : mesh.quads) {
+                const uint16_t p = q.getPaletteIdx();
+                t.trees += p == VOXEL_WOOD.getPaletteIndex() || p == VOXEL_LEAVES.getPaletteIndex();
+            }
+        }
+        t.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        return t;
+    };
+
+    const Totals lod0 = meshWorld(full, 0);
+    std::cout << "[Bench]   " << keys.size() << " chunks | lod 0  " << lod0.quads << " quads, "
+              << lod0.trees << " tree quads (" << lod0.ms << " ms)\n";
+
+    // Best of 3 per figure; the quad counts are the same in every repeat.
+    constexpr int REPEATS = 3;
+    auto best = [](Totals& t, const Totals& run) { if (t.ms == 0.0 || run.ms < t.ms) t = run; };
+    std::vector<VoxelData> buf(CHUNK_VOLUME);
+    for (int lod = 1; lod <= 2; ++lod) {
+        Totals cold, warm, point;
+        size_t mipBytes = 0;
+        for (int r = 0; r < REPEATS; ++r) {
+            // A fresh full-resolution copy, so the first pass pays for every mip build.
+            std::vector<std::unique_ptr<Chunk>> world;
+            for (const auto& c : full) {
+                c->decodeVoxels(buf.data());
+                world.push_back(std::make_unique<Chunk>(c->getCX(), c->getCY(), c->getCZ()));
+                world.back()->encodeVoxels(buf.data());
+            }
+            best(cold, meshWorld(world, lod));
+            best(warm, meshWorld(world, lod));
+            mipBytes = 0;
+            for (const auto& c : world) mipBytes += c->getMipBytes();
+
+            // The point-sampled grid: the block origins only, as a reduced payload stores them.
+            std::vector<std::unique_ptr<Chunk>> sampled;
+            for (const Key& k : keys) {
+                sampled.push_back(std::make_unique<Chunk>(k.cx, k.cy, k.cz));
+                sampled.back()->fillTerrain(config, lod);
+            }
+            TerrainGenerator::takeLateDecorations();
+            best(point, meshWorld(sampled, lod));
+        }
+
+        std::cout << "[Bench]   lod " << lod << "  mip: first mesh " << cold.ms << " ms, remesh " << warm.ms
+                  << " ms, " << mipBytes / 1024.0 << " KB mips | " << warm.quads << " quads, " << warm.trees
+                  << " tree quads | point-sampled: " << point.ms << " ms, " << point.quads << " quads, "
+                  << point.trees << " tree quads\n";
+    }
+    TerrainColumnCache::shared().clear();
+    std::cout << std::defaultfloat << std::flush;
+}
+
+bool runBenchmarks(const std::string& name) {
+    const bool all = (name == "all");
+    bool ran = false;
+    if (all || name == "grid")  { runChunkGridBenchmark();    ran = true; }
+    if (all || name == "noise") { runTerrainNoiseBenchmark(); ran = true; }
+    if (all || name == "lodgen") { runReducedGenerationBenchmark(); ran = true; }
+    if (all || name == "caves")  { runCaveGenerationBenchmark();    ran = true; }
+    if (all || name == "forest") { runForestGenerationBenchmark();  ran = true; }
+    if (all || name == "stream") { runStreamingBenchmark();         ran = true; }
+    if (all || name == "mesher") { runMesherBenchmark();            ran = true; }
+    if (all || name == "facecull") { runFaceCullingBenchmark();     ran = true; }
+    if (all || name == "liquid")   { runLiquidMeshBenchmark();      ran = true; }
+    if (all || name == "mip")      { runLodMipBenchmark();          ran = true; }
+    return ran;
+}
+
+} // namespace world::bench
@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+
+namespace world::bench {
+
+// ---------------------------------------------------------------------------
+// CPU-only micro-benchmarks for the world module (no window / GPU needed).
+//
+// Usage:  engine.exe --bench [name]   or   worldbench.exe [name]   (headless, src/tools/WorldBench.cpp)
+//   name = grid   — dense pointer grid vs sparse paged ChunkGrid lookups
+//          noise  — batched (SIMD) vs FastNoiseLite terrain noise: kernel Mpt/s, world Mvox/s
+//          lodgen — fillTerrain() at payload LOD 0/1/2: ms, Mvox/s, voxel RAM, voxels at the block
+//                   origins equal to the full generation
+//          caves  — fillTerrain() with the 3D cave stage off / on: ms, Mvox/s, stage us/chunk, RAM
+//          forest — trees off / on, 1 vs N threads: Mvox/s, chunks/s, DecorationQueue memory,
+//                   generation-order independence of the cross-chunk writes
+//          stream — ChunkManager with a CountingMeshSink: initial generate + mesh, then a camera
+//                   flight (updateCamera + rebuildDirtyChunks per frame): ms/frame, uploads/s,
+//                   staged uploads and leaked staging reservations
+//          mesher — generateMesh() (binary, column bitmasks) vs generateMeshReference() on flat /
+//                   hilly / coast (water) / random / checkerboard fixtures at LOD 0/1/2: us/chunk,
+//                   exact output match
+//          facecull — default island world, camera orbit like the engine's start view: triangles
+//                   of frustum-visible meshes with and without per-direction (backface) draws
+//          liquid — default island meshed with water as an opaque block vs the opaque + liquid
+//                   surface streams at LOD 0/1/2: quads, ms
+//          mip    — default island meshed at LOD 1/2 from the voxel mip chain (first mesh with the
+//                   build, remesh from the cache, mip RAM) vs point-sampled grids: ms, quads, tree quads
+//          all    — every benchmark (default)
+//
+// Results go to stdout, one "[Bench] ..." line per measurement.
+// Returns false if `name` is not a known benchmark.
+// ---------------------------------------------------------------------------
+bool runBenchmarks(const std::string& name = "all");
+
+void runChunkGridBenchmark(int radius = 64, int height = 8);
+void runTerrainNoiseBenchmark(int radius = 8);
+void runReducedGenerationBenchmark(int radius = 6);
+void runCaveGenerationBenchmark(int radius = 6);
+void runForestGenerationBenchmark(int radius = 6);
+void runStreamingBenchmark(int radius = 8);
+void runMesherBenchmark();
+void runFaceCullingBenchmark(int radius = 10);
+void runLiquidMeshBenchmark(int radius = 10);
+void runLodMipBenchmark(int radius = 6);
+
+} // namespace world::bench